@@ -4,19 +4,28 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../src/spd/core/AliasTable.cpp \
+../src/spd/core/FenwickTree.cpp \
 ../src/spd/core/Player.cpp \
 ../src/spd/core/Space.cpp \
-../src/spd/core/Strategy.cpp 
+../src/spd/core/Strategy.cpp \
+../src/spd/core/StrategyPool.cpp 
 
 OBJS += \
+./src/spd/core/AliasTable.o \
+./src/spd/core/FenwickTree.o \
 ./src/spd/core/Player.o \
 ./src/spd/core/Space.o \
-./src/spd/core/Strategy.o 
+./src/spd/core/Strategy.o \
+./src/spd/core/StrategyPool.o 
 
 CPP_DEPS += \
+./src/spd/core/AliasTable.d \
+./src/spd/core/FenwickTree.d \
 ./src/spd/core/Player.d \
 ./src/spd/core/Space.d \
-./src/spd/core/Strategy.d 
+./src/spd/core/Strategy.d \
+./src/spd/core/StrategyPool.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -4,13 +4,16 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
-../src/spd/rule/action/SimpleActionRule.cpp 
+../src/spd/rule/action/SimpleActionRule.cpp \
+../src/spd/rule/action/StrategyLengthTable.cpp 
 
 OBJS += \
-./src/spd/rule/action/SimpleActionRule.o 
+./src/spd/rule/action/SimpleActionRule.o \
+./src/spd/rule/action/StrategyLengthTable.o 
 
 CPP_DEPS += \
-./src/spd/rule/action/SimpleActionRule.d 
+./src/spd/rule/action/SimpleActionRule.d \
+./src/spd/rule/action/StrategyLengthTable.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -5,15 +5,27 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
 ../src/spd/rule/game/AverageGameRule.cpp \
-../src/spd/rule/game/SimpleSumGameRule.cpp 
+../src/spd/rule/game/FarFieldReport.cpp \
+../src/spd/rule/game/InverseSquareDiscountDistanceGameRule.cpp \
+../src/spd/rule/game/RingCountingGameRule.cpp \
+../src/spd/rule/game/SimpleSumGameRule.cpp \
+../src/spd/rule/game/UniformDiscountDistanceGameRule.cpp 
 
 OBJS += \
 ./src/spd/rule/game/AverageGameRule.o \
-./src/spd/rule/game/SimpleSumGameRule.o 
+./src/spd/rule/game/FarFieldReport.o \
+./src/spd/rule/game/InverseSquareDiscountDistanceGameRule.o \
+./src/spd/rule/game/RingCountingGameRule.o \
+./src/spd/rule/game/SimpleSumGameRule.o \
+./src/spd/rule/game/UniformDiscountDistanceGameRule.o 
 
 CPP_DEPS += \
 ./src/spd/rule/game/AverageGameRule.d \
-./src/spd/rule/game/SimpleSumGameRule.d 
+./src/spd/rule/game/FarFieldReport.d \
+./src/spd/rule/game/InverseSquareDiscountDistanceGameRule.d \
+./src/spd/rule/game/RingCountingGameRule.d \
+./src/spd/rule/game/SimpleSumGameRule.d \
+./src/spd/rule/game/UniformDiscountDistanceGameRule.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -4,13 +4,22 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
-../src/spd/rule/strategy/BestStrategyRule.cpp 
+../src/spd/rule/strategy/BestStrategyRule.cpp \
+../src/spd/rule/strategy/MutationRule.cpp \
+../src/spd/rule/strategy/NeighborArgMax.cpp \
+../src/spd/rule/strategy/RewireRule.cpp 
 
 OBJS += \
-./src/spd/rule/strategy/BestStrategyRule.o 
+./src/spd/rule/strategy/BestStrategyRule.o \
+./src/spd/rule/strategy/MutationRule.o \
+./src/spd/rule/strategy/NeighborArgMax.o \
+./src/spd/rule/strategy/RewireRule.o 
 
 CPP_DEPS += \
-./src/spd/rule/strategy/BestStrategyRule.d 
+./src/spd/rule/strategy/BestStrategyRule.d \
+./src/spd/rule/strategy/MutationRule.d \
+./src/spd/rule/strategy/NeighborArgMax.d \
+./src/spd/rule/strategy/RewireRule.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
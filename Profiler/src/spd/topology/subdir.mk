@@ -4,13 +4,25 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
-../src/spd/topology/Topology.cpp 
+../src/spd/topology/BoxCounter.cpp \
+../src/spd/topology/FftConvolver.cpp \
+../src/spd/topology/SlidingMaximum.cpp \
+../src/spd/topology/Topology.cpp \
+../src/spd/topology/TopologyEditor.cpp 
 
 OBJS += \
-./src/spd/topology/Topology.o 
+./src/spd/topology/BoxCounter.o \
+./src/spd/topology/FftConvolver.o \
+./src/spd/topology/SlidingMaximum.o \
+./src/spd/topology/Topology.o \
+./src/spd/topology/TopologyEditor.o 
 
 CPP_DEPS += \
-./src/spd/topology/Topology.d 
+./src/spd/topology/BoxCounter.d \
+./src/spd/topology/FftConvolver.d \
+./src/spd/topology/SlidingMaximum.d \
+./src/spd/topology/Topology.d \
+./src/spd/topology/TopologyEditor.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
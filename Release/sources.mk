@@ -23,6 +23,7 @@ C_UPPER_DEPS :=
 
 # Every subdirectory with source files must be described here
 SUBDIRS := \
+src/spd/rule/generated \
 src/spd/topology/network \
 src/spd/topology/lattice \
 src/spd/topology/cube \
@@ -4,12 +4,15 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
+../src/spd/rule/selfRepair/RecoveryTracker.cpp \
 ../src/spd/rule/selfRepair/RepairRule.cpp 
 
 OBJS += \
+./src/spd/rule/selfRepair/RecoveryTracker.o \
 ./src/spd/rule/selfRepair/RepairRule.o 
 
 CPP_DEPS += \
+./src/spd/rule/selfRepair/RecoveryTracker.d \
 ./src/spd/rule/selfRepair/RepairRule.d 
 
 
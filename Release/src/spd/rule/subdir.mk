@@ -4,13 +4,37 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 CPP_SRCS += \
-../src/spd/rule/SpdRule.cpp 
+../src/spd/rule/EventEngine.cpp \
+../src/spd/rule/GlobalRule.cpp \
+../src/spd/rule/GraphColoring.cpp \
+../src/spd/rule/HashLifeEngine.cpp \
+../src/spd/rule/MeanFieldPreview.cpp \
+../src/spd/rule/NeighborTable.cpp \
+../src/spd/rule/RuleContext.cpp \
+../src/spd/rule/SpdRule.cpp \
+../src/spd/rule/WorkerPool.cpp 
 
 OBJS += \
-./src/spd/rule/SpdRule.o 
+./src/spd/rule/EventEngine.o \
+./src/spd/rule/GlobalRule.o \
+./src/spd/rule/GraphColoring.o \
+./src/spd/rule/HashLifeEngine.o \
+./src/spd/rule/MeanFieldPreview.o \
+./src/spd/rule/NeighborTable.o \
+./src/spd/rule/RuleContext.o \
+./src/spd/rule/SpdRule.o \
+./src/spd/rule/WorkerPool.o 
 
 CPP_DEPS += \
-./src/spd/rule/SpdRule.d 
+./src/spd/rule/EventEngine.d \
+./src/spd/rule/GlobalRule.d \
+./src/spd/rule/GraphColoring.d \
+./src/spd/rule/HashLifeEngine.d \
+./src/spd/rule/MeanFieldPreview.d \
+./src/spd/rule/NeighborTable.d \
+./src/spd/rule/RuleContext.d \
+./src/spd/rule/SpdRule.d \
+./src/spd/rule/WorkerPool.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
@@ -0,0 +1,75 @@
+/**
+ * AliasTable.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "AliasTable.hpp"
+
+#include <cmath>
+#include <stdexcept>
+
+namespace spd {
+namespace core {
+
+/*
+ * 重みから表を作成する(Vose の方法)
+ * @param[in] weights 各要素の重み
+ */
+AliasTable::AliasTable(const std::vector<double>& weights) :
+	size(weights.size()), threshold(weights.size()), alias(weights.size()) {
+
+	double sum = 0;
+	for (double weight : weights) {
+		if (weight < 0) {
+			throw std::invalid_argument("Could not make an alias table from a negative weight.");
+		}
+		sum += weight;
+	}
+	if (weights.empty() || !(sum > 0)) {
+		throw std::invalid_argument("Could not make an alias table without positive weights.");
+	}
+
+	// 平均が1になるように正規化
+	std::vector<double> scaled(weights.size());
+	std::vector<int> small;
+	std::vector<int> large;
+	for (std::size_t i = 0; i < weights.size(); ++i) {
+		scaled[i] = weights[i] * weights.size() / sum;
+		if (scaled[i] < 1.0) {
+			small.push_back(i);
+		} else {
+			large.push_back(i);
+		}
+	}
+
+	// 1未満の列を、1以上の要素で埋める
+	while (!small.empty() && !large.empty()) {
+		int less = small.back();
+		small.pop_back();
+		int more = large.back();
+
+		threshold[less] = static_cast<std::uint64_t>(std::ldexp(scaled[less], 32));
+		alias[less] = more;
+
+		scaled[more] -= 1.0 - scaled[less];
+		if (scaled[more] < 1.0) {
+			large.pop_back();
+			small.push_back(more);
+		}
+	}
+
+	// 残りは丸め誤差の範囲で1なので、常に自身を選ぶ
+	for (int i : large) {
+		threshold[i] = 1ULL << 32;
+		alias[i] = i;
+	}
+	for (int i : small) {
+		threshold[i] = 1ULL << 32;
+		alias[i] = i;
+	}
+}
+
+} /* namespace core */
+} /* namespace spd */
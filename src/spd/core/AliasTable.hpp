@@ -0,0 +1,87 @@
+/**
+ * AliasTable.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef ALIASTABLE_HPP_
+#define ALIASTABLE_HPP_
+
+#include <cstdint>
+#include <vector>
+
+namespace spd {
+namespace core {
+
+/**
+ * 離散分布をエイリアス法(Walker's alias method)で標本化するクラス
+ *
+ * @par
+ * 重みから表を一度作成すれば、1回の64bit一様乱数と1回の表引きで、
+ * 要素数によらず定数時間で標本化できる。<br>
+ * 乱数の上位32bitで列を選び、下位32bitでその列の要素か別名(エイリアス)の要素かを選ぶ。
+ * @note 各列の確率は 2^-32 単位に丸める
+ */
+class AliasTable {
+public:
+
+	/**
+	 * 重みから表を作成する
+	 * @param[in] weights 各要素の重み(合計が1である必要はない)
+	 * @throw std::invalid_argument 重みが空の場合や、負の重みがある場合、重みの合計が0の場合
+	 */
+	explicit AliasTable(const std::vector<double>& weights);
+
+	/**
+	 * 要素を標本化する
+	 * @param[in] random 64bit の一様乱数
+	 * @return 要素の位置
+	 */
+	int sample(std::uint64_t random) const {
+		std::uint64_t column = ((random >> 32) * size) >> 32;
+		if ((random & 0xFFFFFFFFULL) < threshold[column]) {
+			return static_cast<int>(column);
+		}
+		return alias[column];
+	};
+
+	/**
+	 * 生成エンジンから要素を標本化する
+	 * @param[in, out] engine 64bit の一様乱数を生成するエンジン
+	 * @return 要素の位置
+	 */
+	template <typename Engine>
+	int operator()(Engine& engine) const {
+		return sample(engine());
+	};
+
+	/**
+	 * 要素数を取得
+	 * @return 要素数
+	 */
+	std::size_t getSize() const {
+		return size;
+	};
+
+private:
+
+	/**
+	 * 要素数
+	 */
+	std::uint64_t size;
+
+	/**
+	 * 各列で自身の要素を選ぶしきい値(2^32 で確率1)
+	 */
+	std::vector<std::uint64_t> threshold;
+
+	/**
+	 * 各列の別名の要素
+	 */
+	std::vector<int> alias;
+};
+
+} /* namespace core */
+} /* namespace spd */
+#endif /* ALIASTABLE_HPP_ */
@@ -0,0 +1,114 @@
+/**
+ * FenwickTree.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "FenwickTree.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace spd {
+namespace core {
+
+/*
+ * 重みを全て0として作成する
+ * @param[in] size 要素数
+ */
+FenwickTree::FenwickTree(int size) : total(0), topBit(0) {
+	reset(size);
+}
+
+/*
+ * 要素数を変えて、重みを全て0にする
+ */
+void FenwickTree::reset(int size) {
+
+	weights.assign(size, 0.0);
+	tree.assign(size + 1, 0.0);
+	total = 0;
+
+	topBit = 1;
+	while ((topBit << 1) <= size) {
+		topBit <<= 1;
+	}
+}
+
+/*
+ * 要素の重みを設定する
+ *
+ * 前の重みとの差分を、要素を含む区間に加える
+ */
+void FenwickTree::set(int index, double weight) {
+
+	if (weight < 0) {
+		throw std::invalid_argument("Could not set a negative weight to a Fenwick tree.");
+	}
+
+	double delta = weight - weights[index];
+	if (delta == 0) {
+		return;
+	}
+	weights[index] = weight;
+	total += delta;
+
+	for (int i = index + 1, size = tree.size(); i < size; i += (i & -i)) {
+		tree[i] += delta;
+	}
+}
+
+/*
+ * 保持している重みから木を作り直す
+ *
+ * 各区間に自身の重みを置き、親の区間へ順に足し込む
+ */
+void FenwickTree::rebuild() {
+
+	int size = weights.size();
+	total = 0;
+	for (int i = 1; i <= size; ++i) {
+		tree[i] = weights[i - 1];
+		total += weights[i - 1];
+	}
+	for (int i = 1; i <= size; ++i) {
+		int parent = i + (i & -i);
+		if (parent <= size) {
+			tree[parent] += tree[i];
+		}
+	}
+}
+
+/*
+ * 先頭からの累積和が target を超える最初の要素を選ぶ
+ *
+ * 上位の幅から順に、区間の和が残りの値以下なら区間を飛ばす
+ */
+int FenwickTree::find(double target) const {
+
+	int size = weights.size();
+	int position = 0;
+	for (int width = topBit; width > 0; width >>= 1) {
+		int next = position + width;
+		if ((next <= size) && (tree[next] <= target)) {
+			target -= tree[next];
+			position = next;
+		}
+	}
+
+	if ((position < size) && (weights[position] > 0)) {
+		return position;
+	}
+
+	// 丸め誤差で末尾を超えた場合や、重み0の要素で止まった場合は、前にある重みが正の要素
+	for (int index = std::min(position, size - 1); index >= 0; --index) {
+		if (weights[index] > 0) {
+			return index;
+		}
+	}
+	throw std::runtime_error("Could not find an element with a positive weight.");
+}
+
+} /* namespace core */
+} /* namespace spd */
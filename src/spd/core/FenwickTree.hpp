@@ -0,0 +1,108 @@
+/**
+ * FenwickTree.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef FENWICKTREE_HPP_
+#define FENWICKTREE_HPP_
+
+#include <vector>
+
+namespace spd {
+namespace core {
+
+/**
+ * 要素ごとの重みを Fenwick 木(Binary Indexed Tree)で保持し、重みに比例して要素を選ぶクラス
+ *
+ * @par
+ * 重みの変更と、累積和による要素の選択を、要素数 N に対して O(log N) で行う。<br>
+ * 差分の加算を繰り返すと丸め誤差が積もるので、重みそのものも保持し、
+ * rebuild で重みから木を作り直せるようにする。
+ */
+class FenwickTree {
+public:
+
+	/**
+	 * 重みを全て0として作成する
+	 * @param[in] size 要素数
+	 */
+	explicit FenwickTree(int size = 0);
+
+	/**
+	 * 要素数を変えて、重みを全て0にする
+	 * @param[in] size 要素数
+	 */
+	void reset(int size);
+
+	/**
+	 * 要素の重みを設定する
+	 * @param[in] index 要素の位置
+	 * @param[in] weight 重み(非負)
+	 */
+	void set(int index, double weight);
+
+	/**
+	 * 保持している重みから木を作り直す
+	 */
+	void rebuild();
+
+	/**
+	 * 要素の重みを取得
+	 * @param[in] index 要素の位置
+	 * @return 重み
+	 */
+	double get(int index) const {
+		return weights[index];
+	};
+
+	/**
+	 * 重みの合計を取得
+	 * @return 重みの合計
+	 */
+	double getTotal() const {
+		return total;
+	};
+
+	/**
+	 * 先頭からの累積和が target を超える最初の要素を選ぶ
+	 * @param[in] target 0 以上、重みの合計未満の値
+	 * @return 要素の位置(丸め誤差で超えない場合は、重みが正の最後の要素)
+	 */
+	int find(double target) const;
+
+	/**
+	 * 要素数を取得
+	 * @return 要素数
+	 */
+	int getSize() const {
+		return weights.size();
+	};
+
+private:
+
+	/**
+	 * 要素ごとの重み
+	 */
+	std::vector<double> weights;
+
+	/**
+	 * 木(1始まり、tree[i] は (i - (i & -i), i] の和)
+	 */
+	std::vector<double> tree;
+
+	/**
+	 * 重みの合計
+	 */
+	double total;
+
+	/**
+	 * 木をたどる最初の幅(要素数以下の最大の2のべき乗)
+	 */
+	int topBit;
+};
+
+} /* namespace core */
+} /* namespace spd */
+#endif /* FENWICKTREE_HPP_ */
@@ -74,6 +74,17 @@ public:
 		this->linkedPlayers = std::make_shared<std::vector<std::weak_ptr<Player>>>();
 	}
 
+	/**
+	 * このプレイヤからの接続を、接続リストを作り直さずに空にする
+	 *
+	 * resetLink と異なり、接続近傍として共有している近傍にもそのまま反映される
+	 */
+	void clearLink() {
+		if (this->linkedPlayers != nullptr) {
+			this->linkedPlayers->clear();
+		}
+	}
+
 	/**
 	 * 接続リストを削除する
 	 */
@@ -248,6 +259,15 @@ public:
 		throw std::invalid_argument("Could not found a property [" + name + "]");
 	}
 
+	/**
+	 * 指定する位置のプロパティを取得
+	 * @param[in] pos 位置
+	 * @return プロパティ
+	 */
+	Property& getPropertyAt(int pos) {
+		return properties.at(pos);
+	}
+
 	/**
 	 * プロパティを追加
 	 * @param[in] prop 追加するプロパティ
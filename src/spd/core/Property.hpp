@@ -85,6 +85,14 @@ public:
 		this->value = value;
 	}
 
+	/**
+	 * 値を取得
+	 * @return 値
+	 */
+	const boost::any& getValue() const {
+		return value;
+	}
+
 	/**
 	 * 値の型を指定して取得
 	 * @return 値
@@ -12,12 +12,18 @@
 #include "Space.hpp"
 
 #include <iostream>
+#include <fstream>
+#include <sstream>
 #include <iomanip>
 #include <ratio> // 時間
 #include <random>
 #include <stdexcept>
 #include <thread>
 #include <functional>
+#include <tuple>
+#include <algorithm>
+#include <limits>
+#include <unordered_map>
 
 #include "NeighborhoodType.hpp"
 
@@ -25,11 +31,15 @@
 #include "maker/PlayerMaker.hpp"
 
 #include "../rule/SpdRule.hpp"
+#include "../rule/EventEngine.hpp"
+#include "../rule/HashLifeEngine.hpp"
+#include "../rule/MeanFieldPreview.hpp"
 
 #include "../param/Parameter.hpp"
 #include "../param/InitParameter.hpp"
 #include "../param/OutputParameter.hpp"
 #include "../param/RandomParameter.hpp"
+#include "../param/RuntimeParameter.hpp"
 
 #include "../topology/Topology.hpp"
 
@@ -42,11 +52,50 @@ using namespace std::chrono;
 namespace spd {
 namespace core {
 
+namespace {
+
+/**
+ * 出力を行うステップかどうか
+ *
+ * 開始前(0ステップ)は必ず出力し、それ以外は開始ステップ以上、終了ステップ未満(正の場合)かつ、間隔のステップで出力する
+ * @param[in] output 出力方法と、開始ステップ・終了ステップ・間隔
+ * @param[in] step ステップ
+ * @return 出力を行うかどうか
+ */
+bool isOutputStep(const std::tuple<std::shared_ptr<spd::output::Output>, int, int, int>& output, int step) {
+
+	return (step == 0) ||
+			((std::get<1>(output) <= step) &&
+				((std::get<2>(output) < 0) || (std::get<2>(output) > step)) &&
+				((step - std::get<1>(output)) % std::get<3>(output) == 0));
+}
+
+/**
+ * 次に出力を行うステップ
+ * @param[in] output 出力方法と、開始ステップ・終了ステップ・間隔
+ * @param[in] step 現在のステップ
+ * @return step より後で出力を行う最初のステップ(無い場合は int の最大値)
+ */
+int nextOutputStep(const std::tuple<std::shared_ptr<spd::output::Output>, int, int, int>& output, int step) {
+
+	int next = std::get<1>(output);
+	if (next <= step) {
+		int interval = std::get<3>(output);
+		next += ((step + 1 - next + interval - 1) / interval) * interval;
+	}
+	if ((std::get<2>(output) >= 0) && (std::get<2>(output) <= next)) {
+		return std::numeric_limits<int>::max();
+	}
+	return next;
+}
+
+}
+
 /*
  * パラメタとルールを設定して盤面を作成
  */
 Space::Space(spd::param::Parameter& param) :
-		parameter(param), step(0), sim(0) , skipBeforeRules(false),
+		parameter(param), step(0), sim(0) , skipBeforeRules(false), forked(false),
 		startTime(std::chrono::system_clock::now()) {
 
 	// 乱数の除去
@@ -74,16 +123,257 @@ bool Space::run() {
 
 	// プレイヤの初期化
 	parameter.restore();
+	parameter.getRandomParameter()->setSim(sim);
 	this->parameter.getPlayerMaker()->initPlayer(this->players, *this);
 
-	// 出力の初期化
+	// 空間構造が作り直されている場合があるので、まとめた近傍を破棄
+	this->spdRule->resetNeighborTables();
+
+	if (parameter.getRuntimeParameter()->isPreview()) {
+		// シミュレーションの代わりに予測を出力する
+		runPreview();
+	} else {
+		// 出力の初期化
+		for (auto output : parameter.getOutputParameter()->getOutputs()) {
+			std::get<0>(output)->init(*this, parameter);
+		}
+
+		// 開始前の出力
+		compressOutputs(output());
+
+		// 分岐する場合は、分岐するステップまで進めてから分岐した空間で続ける
+		auto endStep = parameter.getInitialParameter()->getEndStep();
+		bool forks = !parameter.getForks().empty() && (parameter.getForkStep() < endStep);
+		runSteps(forks ? parameter.getForkStep() : endStep);
+		if (forks) {
+			runForks();
+		}
+	}
+	sim++;
+
+	if (sim == this->parameter.getInitialParameter()->getSimCount()) {
+		auto usedTime = duration_cast<seconds>(system_clock::now() - startTime);
+
+		std::cout << "Used " << duration_cast<hours>(usedTime).count() << ":" <<
+				duration_cast<minutes>(usedTime).count() % 60 << ":" <<
+				usedTime.count() %  60 << "    \n";
+
+		return true;
+	}
+	return false;
+}
+
+/*
+ * 分岐元の空間から、現在の状態を引き継いだ空間を作成する
+ *
+ * プレイヤの状態と空間構造は clonePlayers で複製する。
+ * ルールの状態は、近傍の表を共有してから引き継ぐ(影の盤面などが表を使うため)。
+ */
+Space::Space(const Space& base, spd::param::Parameter& param) :
+		parameter(param), step(base.step), sim(base.sim), skipBeforeRules(false), forked(true),
+		startTime(std::chrono::system_clock::now()) {
+
+	param.takeOverState(base.parameter);
+	this->spdRule = param.getInitialParameter()->getSpdRule();
+
+	// プレイヤの状態と、接続と近傍の複製
+	this->players = clonePlayers(base.players);
+
+	// ルールによるプロパティの初期化と分岐元の値の写し、まとめた近傍の共有
+	this->spdRule->init(this->players, param);
+	copyProperties(base.players, this->players);
+	this->spdRule->resetNeighborTables();
+	this->spdRule->shareNeighborTables(*(base.spdRule));
+
+	// ルールの状態の引き継ぎ
+	this->spdRule->takeOverState(*(base.spdRule), this->players, param);
+}
+
+/*
+ * プレイヤの状態を複製し、接続と近傍を複製したプレイヤにつなぎ直す
+ *
+ * 接続と近傍は、同じ位置座標の複製したプレイヤにつなぎ直す。
+ * 接続と近傍(近傍距離ごとのリスト)を共有していた場合は、複製でも同じように共有する。
+ * 空間構造はプレイヤ数と接続数に比例する時間で複製でき、探索はしない。
+ */
+AllPlayer Space::clonePlayers(const AllPlayer& basePlayers) {
+
+	AllPlayer players;
+
+	// プレイヤの状態の複製
+	players.reserve(basePlayers.size());
+	for (auto& basePlayer : basePlayers) {
+		auto player = std::make_shared<Player>(basePlayer->getId());
+		player->setPreAction(basePlayer->getPreAction());
+		player->setAction(basePlayer->getAction());
+		player->setPreScore(basePlayer->getPreScore());
+		player->setScore(basePlayer->getScore());
+		player->setPreStrategy(basePlayer->getPreStrategy());
+		player->setStrategy(basePlayer->getStrategy());
+		players.push_back(player);
+	}
+
+	// 接続と近傍のつなぎ直し
+	typedef std::vector<std::weak_ptr<Player>> PlayerList;
+	auto remap = [&players](const PlayerList& baseList, PlayerList& clonedList) {
+		clonedList.reserve(baseList.size());
+		for (auto& basePlayerWP : baseList) {
+			auto basePlayer = basePlayerWP.lock();
+			clonedList.push_back((basePlayer == nullptr) ?
+					std::weak_ptr<Player>() : std::weak_ptr<Player>(players[basePlayer->getId()]));
+		}
+	};
+	for (int id = 0, playerNum = basePlayers.size(); id < playerNum; ++id) {
+		auto& basePlayer = basePlayers[id];
+		auto& player = players[id];
+		std::unordered_map<const PlayerList*, std::shared_ptr<PlayerList>> lists;
+		std::unordered_map<const void*, Neighbors> neighborsMap;
+
+		auto& baseLinks = basePlayer->getLinkedPlayers();
+		if (baseLinks != nullptr) {
+			player->resetLink();
+			remap(*baseLinks, *(player->getLinkedPlayers()));
+			lists[baseLinks.get()] = player->getLinkedPlayers();
+		}
+
+		for (int type = 0; type < NeighborhoodType::TYPE_NUM; ++type) {
+			auto neighborType = static_cast<NeighborhoodType>(type);
+			auto& baseNeighbors = basePlayer->getNeighbors(neighborType);
+			if (baseNeighbors == nullptr) {
+				continue;
+			}
+			auto found = neighborsMap.find(baseNeighbors.get());
+			if (found != neighborsMap.end()) {
+				player->getNeighbors(neighborType) = found->second;
+				continue;
+			}
+
+			auto neighbors = std::make_shared<std::vector<std::shared_ptr<PlayerList>>>();
+			neighbors->reserve(baseNeighbors->size());
+			for (auto& baseList : *baseNeighbors) {
+				if (baseList == nullptr) {
+					neighbors->push_back(nullptr);
+					continue;
+				}
+				auto& list = lists[baseList.get()];
+				if (list == nullptr) {
+					list = std::make_shared<PlayerList>();
+					remap(*baseList, *list);
+				}
+				neighbors->push_back(list);
+			}
+			neighborsMap[baseNeighbors.get()] = neighbors;
+			player->getNeighbors(neighborType) = neighbors;
+		}
+	}
+
+	return players;
+}
+
+/*
+ * プロパティの値を、同じ位置座標のプレイヤの同じ名前のプロパティに写す
+ *
+ * 同じ名前のプロパティが複数ある場合は、現れる順に対応させる
+ */
+void Space::copyProperties(const AllPlayer& basePlayers, const AllPlayer& players) {
+
+	for (int id = 0, playerNum = basePlayers.size(); id < playerNum; ++id) {
+		auto& player = players[id];
+		std::unordered_map<std::string, int> nextPos;
+		for (auto& baseProperty : basePlayers[id]->getProperties()) {
+			auto& name = baseProperty.getName();
+			int pos = player->find(name, nextPos[name]);
+			if (pos >= 0) {
+				player->getPropertyAt(pos).setValue(baseProperty.getValue());
+				nextPos[name] = pos + 1;
+			} else if (baseProperty.getCountingMethod() == nullptr) {
+				player->addProperty(baseProperty);
+				nextPos[name] = player->getProperties().size();
+			}
+		}
+	}
+}
+
+/*
+ * 指定のステップまで進める
+ *
+ * 連続時間の場合は単位時間ずつ、記憶した区画の時間発展を使える場合は出力ステップごとに進める
+ */
+void Space::runSteps(int untilStep) {
+
+	if (parameter.getRuntimeParameter()->getEventRate() > 0) {
+		// 連続時間では、整数の時刻をステップとして出力する
+		spd::rule::EventEngine engine(players, parameter);
+		engine.initialize();
+		while(step < untilStep) {
+			execEventStep(engine);
+		}
+	} else {
+		// 決定的な格子なら、出力ステップまでまとめて進める
+		spd::rule::HashLifeEngine hashLife(players, parameter);
+		bool memoized = false;
+		if (parameter.getRuntimeParameter()->isHashLife()) {
+			std::string reason;
+			memoized = hashLife.initialize(*spdRule, reason);
+			if (!memoized) {
+				std::cout << "hashlife is not applicable (" << reason << "), updating every step." << std::endl;
+			}
+		}
+		while(step < untilStep) {
+			if (memoized) {
+				execHashLifeStep(hashLife, untilStep);
+			} else {
+				execStep();
+			}
+		}
+	}
+}
+
+/*
+ * 分岐した空間を作成し、それぞれを並行して終了ステップまで実行する
+ */
+void Space::runForks() {
+
+	auto& forks = parameter.getForks();
+	std::cout << "forking " << forks.size() << " spaces at step " << step << "." << std::endl;
+
+	std::vector<std::unique_ptr<Space>> spaces;
+	for (auto& fork : forks) {
+		spaces.push_back(std::unique_ptr<Space>(new Space(*this, *(fork.second))));
+	}
+
+	std::vector<std::thread> thr;
+	for (auto& space : spaces) {
+		thr.push_back(std::thread(
+				[&space]{
+			space->runFork();
+		}
+		));
+	}
+	for (std::thread& t : thr) {
+		t.join();
+	}
+}
+
+/*
+ * 分岐した空間で、分岐したステップから終了ステップまで実行する
+ *
+ * 分岐したステップの出力と後処理ルールは分岐元で済んでいるので、次のステップから出力する
+ */
+void Space::runFork() {
+
 	for (auto output : parameter.getOutputParameter()->getOutputs()) {
 		std::get<0>(output)->init(*this, parameter);
 	}
 
-	// 開始前の出力
-	auto outputResults = output();
-	// 圧縮
+	runSteps(parameter.getInitialParameter()->getEndStep());
+}
+
+/*
+ * 出力したファイルのうち、圧縮するものを並行して圧縮する
+ */
+void Space::compressOutputs(const OutputResultType& outputResults) const {
+
 	std::vector<std::thread> thr;
 	for (auto& outputResult : outputResults) {
 		thr.push_back(std::thread(
@@ -102,23 +392,58 @@ bool Space::run() {
 	for (std::thread& t : thr) {
 		t.join();
 	}
+}
 
-	auto endStep = parameter.getInitialParameter()->getEndStep();
-	while(step < endStep) {
-		execStep();
+/*
+ * シミュレーションの代わりに、平均場近似の予測を出力する
+ *
+ * 開始前と、いずれかの出力を行うステップ(出力が無い場合は毎ステップ)に1行ずつ出力する
+ */
+void Space::runPreview() {
+
+	spd::rule::MeanFieldPreview preview(parameter);
+	std::string reason;
+	if (!preview.initialize(*spdRule, players, reason)) {
+		std::cout << "preview is not applicable (" << reason << ")." << std::endl;
+		return;
 	}
-	sim++;
 
-	if (sim == this->parameter.getInitialParameter()->getSimCount()) {
-		auto usedTime = duration_cast<seconds>(system_clock::now() - startTime);
+	std::ostringstream simCount;
+	simCount.setf(std::ios::right);
+	simCount.fill('0');
+	simCount.width(3); // 桁数は3
+	simCount << sim;
+	std::string filename = parameter.getOutputParameter()->getDirectory() +
+			"/preview/spd_preview_" + simCount.str() + ".txt";
+
+	// ディレクトリの作成
+	if (sim == 0) {
+		spd::output::FileSystemOperation fso;
+		if (!fso.createDirectory(filename)) {
+			throw std::runtime_error("Could not create a directory for the preview.");
+		}
+	}
 
-		std::cout << "Used " << duration_cast<hours>(usedTime).count() << ":" <<
-				duration_cast<minutes>(usedTime).count() % 60 << ":" <<
-				usedTime.count() %  60 << "    \n";
+	std::ofstream out(filename.c_str(), std::ios::out);
+	if (out.fail()) {
+		throw std::runtime_error("Could not open a file (" + filename + ").");
+	}
+	parameter.showParameter(out);
 
-		return true;
+	auto& outputs = parameter.getOutputParameter()->getOutputs();
+	auto endStep = parameter.getInitialParameter()->getEndStep();
+	preview.write(out, step);
+	while (step < endStep) {
+		preview.advance(step);
+		++step;
+		bool written = outputs.empty();
+		for (auto& output : outputs) {
+			written = written || isOutputStep(output, step);
+		}
+		if (written) {
+			preview.write(out, step);
+		}
 	}
-	return false;
 }
 
 /*
@@ -139,11 +464,7 @@ inline Space::OutputResultType Space::output() {
 		auto& output = outputs.at(i);
 		thr[i] = std::thread(
 					[&, i]{
-				if ((step == 0) ||
-					// 開始ステップ以上、終了ステップ未満(整数の場合)かつ、間隔のステップの場合
-					((std::get<1>(output) <= step) &&
-						((std::get<2>(output) < 0) || (std::get<2>(output) > step)) &&
-						((step - std::get<1>(output)) % std::get<3>(output) == 0))) {
+				if (isOutputStep(output, step)) {
 				// 出力
 				outputResults.at(i) = std::get<0>(output)->output(*this);
 			}
@@ -157,6 +478,19 @@ inline Space::OutputResultType Space::output() {
 	return outputResults;
 }
 
+/*
+ * そのステップに、プレイヤのプロパティを読む出力があるかどうか
+ */
+bool Space::requiresAnalysis(int outputStep) const {
+
+	for (auto& output : parameter.getOutputParameter()->getOutputs()) {
+		if (std::get<0>(output)->readsProperties() && isOutputStep(output, outputStep)) {
+			return true;
+		}
+	}
+	return false;
+}
+
 /*
  * 1ステップ実行
  */
@@ -166,7 +500,8 @@ inline void Space::execStep() {
 
 	if (!skipBeforeRules) {
 		// 表示前処理
-		this->spdRule->runRulesBeforeOutput(players, parameter, step);
+		// 解析ルールは、次のステップで結果を読む出力がある時のみ
+		this->spdRule->runRulesBeforeOutput(players, parameter, step, requiresAnalysis(step + 1));
 
 		// ステップを進める
 		++step;
@@ -180,32 +515,72 @@ inline void Space::execStep() {
 	}
 
 	// 圧縮開始
-	std::vector<std::thread> thr;
-	for (auto& outputResult : outputResults) {
-		thr.push_back(std::thread(
-				[&]{
-			if (outputResult.second) {
-				std::string outputFile (outputResult.first + spd::output::compressor::COMPRESS_TYPE);
-				if (spd::output::compressor::compress(outputResult.first, outputFile)) {
-					// 圧縮できたら元のファイルを削除
-					spd::output::FileSystemOperation fso;
-					fso.removeFile(outputResult.first);
-				}
-			}
-		}
-		));
-	}
-	
+	std::thread compressor([&]{
+		compressOutputs(outputResults);
+	});
+
 	skipBeforeRules = false;
 
 	// 表示後処理
 	this->spdRule->runRulesAfterOutput(players, parameter, step);
 
 	// 圧縮はここまでに終わればいい
-	for (std::thread& t : thr) {
-		t.join();
+	compressor.join();
+}
+
+/*
+ * 連続時間のシミュレーションを単位時間実行
+ *
+ * ルールは使わず、時刻 step から step + 1 までの事象を実行してから出力する
+ */
+inline void Space::execEventStep(spd::rule::EventEngine& engine) {
+
+	engine.advance(step);
+
+	// ステップを進める
+	++step;
+
+	// 出力
+	auto outputResults = output();
+
+	// 進捗の表示
+	printProgress();
+
+	// 圧縮
+	compressOutputs(outputResults);
+}
+
+/*
+ * 記憶した区画の時間発展で、次の出力ステップまで進める
+ *
+ * 開始直後は戦略を更新せずに行動を決めるので、通常のルールで1ステップ進める
+ */
+inline void Space::execHashLifeStep(spd::rule::HashLifeEngine& engine, int untilStep) {
+
+	int nextStep = untilStep;
+	for (auto& output : parameter.getOutputParameter()->getOutputs()) {
+		nextStep = std::min(nextStep, nextOutputStep(output, step));
 	}
-	
+
+	if ((step == 0) && !skipBeforeRules) {
+		this->spdRule->runRulesBeforeOutput(players, parameter, step, false);
+		++step;
+	}
+	skipBeforeRules = false;
+
+	if (step < nextStep) {
+		engine.advance(nextStep - step);
+		step = nextStep;
+	}
+
+	// 出力
+	auto outputResults = output();
+
+	// 進捗の表示
+	printProgress();
+
+	// 圧縮
+	compressOutputs(outputResults);
 }
 
 /*
@@ -213,6 +588,11 @@ inline void Space::execStep() {
  */
 inline void Space::printProgress() const {
 
+	// 分岐した空間は並行して実行するので表示しない
+	if (forked) {
+		return;
+	}
+
 	// 終了ステップ
 	auto endStep = this->parameter.getInitialParameter()->getEndStep();
 
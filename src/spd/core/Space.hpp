@@ -23,6 +23,8 @@ class Parameter;
 
 namespace rule {
 class SpdRule;
+class EventEngine;
+class HashLifeEngine;
 }
 
 namespace core {
@@ -30,6 +32,10 @@ class Player;
 
 /**
  * 空間を表すクラス
+ *
+ * @par
+ * 分岐した空間は、空間構造と戦略、まとめた近傍の表を分岐元と共有するが、
+ * プレイヤの状態(行動、利得、戦略の参照、プロパティの値)は複製し、分岐元とは共有しない。
  */
 class Space {
 public:
@@ -40,6 +46,37 @@ public:
 	 */
 	Space(param::Parameter& param);
 
+	/**
+	 * 分岐元の空間から、現在の状態を引き継いだ空間を作成する
+	 *
+	 * @par
+	 * 空間構造と戦略、まとめた近傍の表は分岐元と共有し、プレイヤの状態は複製する(共有しない)。
+	 * プロパティは分岐先のルールで初期化してから分岐元の値を写し、
+	 * ルールが持つ状態(回復の追跡、膜と影響の検知結果など)は、同じ種類のルールから引き継ぐ。
+	 * @param[in] base 分岐元の空間
+	 * @param[in] param 分岐先のパラメタ(Parameter::fork で複製したもの)
+	 */
+	Space(const Space& base, param::Parameter& param);
+
+	/**
+	 * プレイヤの状態を複製し、接続と近傍を複製したプレイヤにつなぎ直す
+	 *
+	 * 接続と近傍を共有していた場合は、複製でも同じように共有する。戦略は共有する
+	 * @param[in] basePlayers 複製元のプレイヤ
+	 * @return 複製したプレイヤ
+	 */
+	static AllPlayer clonePlayers(const AllPlayer& basePlayers);
+
+	/**
+	 * プロパティの値を、同じ位置座標のプレイヤの同じ名前のプロパティに写す
+	 *
+	 * 写し先に無いプロパティは、特別な数え上げを持たない場合のみ追加する
+	 * (数え上げは写し先のルールが持つものを使う)
+	 * @param[in] basePlayers 写し元のプレイヤ
+	 * @param[in] players 写し先のプレイヤ
+	 */
+	static void copyProperties(const AllPlayer& basePlayers, const AllPlayer& players);
+
 	/**
 	 * 1シミュレーションの実行
 	 * @return 最後のシミュレーションが終了したかどうか
@@ -117,14 +154,52 @@ private:
 	// 出力前のルールを飛ばすかどうか
 	bool skipBeforeRules;
 
+	// 分岐した空間かどうか
+	bool forked;
+
 	// シミュレーション開始時間
 	const decltype(std::chrono::system_clock::now()) startTime;
 
+	/*
+	 * 指定のステップまで進める
+	 */
+	void runSteps(int untilStep);
+
+	/*
+	 * 分岐した空間を作成し、それぞれを並行して終了ステップまで実行する
+	 */
+	void runForks();
+
+	/*
+	 * 分岐した空間で、分岐したステップから終了ステップまで実行する
+	 */
+	void runFork();
+
+	/*
+	 * 出力したファイルのうち、圧縮するものを圧縮する
+	 */
+	void compressOutputs(const OutputResultType& outputResults) const;
+
 	/*
 	 * シミュレーションを1ステップ実行
 	 */
 	void execStep();
 
+	/*
+	 * 連続時間のシミュレーションを単位時間(1ステップ)実行
+	 */
+	void execEventStep(spd::rule::EventEngine& engine);
+
+	/*
+	 * 記憶した区画の時間発展で、次の出力ステップ(untilStep を越えない)まで進める
+	 */
+	void execHashLifeStep(spd::rule::HashLifeEngine& engine, int untilStep);
+
+	/*
+	 * シミュレーションの代わりに、平均場近似の予測を出力する
+	 */
+	void runPreview();
+
 	/*
 	 * 進捗の表示
 	 */
@@ -135,6 +210,13 @@ private:
 	 */
 	OutputResultType output();
 
+	/**
+	 * そのステップに、プレイヤのプロパティを読む出力があるかどうか
+	 * @param[in] outputStep 出力するステップ
+	 * @return 解析ルールを実行する必要があるかどうか
+	 */
+	bool requiresAnalysis(int outputStep) const;
+
 };
 
 } /* namespace core */
@@ -30,6 +30,15 @@ Strategy::Strategy(const char* strategy, int minLen, int maxLen) : id(-1) {
 
 	this->shortStrategy = toShortStrategy(this->longStrategy);
 }
+
+/*
+ * 冗長な列挙型戦略列から戦略を作成
+ */
+Strategy::Strategy(const std::vector<Action>& longStrategy) :
+		longStrategy(longStrategy), id(-1) {
+
+	this->shortStrategy = toShortStrategy(this->longStrategy);
+}
 /*
  * 文字配列を冗長な列挙型戦略列に変換
  * @param[in] strategy 戦略の文字配列
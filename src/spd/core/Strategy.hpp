@@ -38,6 +38,12 @@ public:
 	 */
 	Strategy(const char* strategy, int minLen = 0, int maxLen = 0);
 
+	/**
+	 * 冗長な列挙型戦略列から戦略を作成
+	 * @param[in] longStrategy 冗長な列挙型戦略列
+	 */
+	explicit Strategy(const std::vector<Action>& longStrategy);
+
 	/**
 	 * 戦略が指定行動の All 戦略かどうかを調べる
 	 * @param[in] action 調べる行動
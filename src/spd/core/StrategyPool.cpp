@@ -0,0 +1,165 @@
+/**
+ * StrategyPool.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "StrategyPool.hpp"
+
+#include <stdexcept>
+
+#include "Strategy.hpp"
+
+namespace spd {
+namespace core {
+
+/*
+ * 全ての戦略を破棄する
+ */
+void StrategyPool::clear() {
+
+	strategies.clear();
+	retirables.clear();
+	ids.clear();
+	freeIds = decltype(freeIds)();
+}
+
+/*
+ * 戦略を、その ID の位置に登録する
+ *
+ * 間の ID は破棄したものとして扱う
+ */
+void StrategyPool::add(const std::shared_ptr<Strategy>& strategy, bool retirable) {
+
+	int id = strategy->getId();
+	if (id < 0) {
+		throw std::invalid_argument("A strategy " + strategy->getShortStrategy() + " has no id.");
+	}
+	if ((id < getIdLimit() && strategies[id] != nullptr) || (ids.count(strategy->getShortStrategy()) != 0)) {
+		throw std::invalid_argument("A strategy " + strategy->getShortStrategy() + " is already in the pool.");
+	}
+
+	if (id >= getIdLimit()) {
+		for (int freeId = getIdLimit(); freeId < id; ++freeId) {
+			freeIds.push(freeId);
+		}
+		strategies.resize(id + 1);
+		retirables.resize(id + 1, true);
+	} else {
+		// 空いている ID から除く
+		decltype(freeIds) others;
+		for (; !freeIds.empty(); freeIds.pop()) {
+			if (freeIds.top() != id) {
+				others.push(freeIds.top());
+			}
+		}
+		freeIds.swap(others);
+	}
+
+	strategies[id] = strategy;
+	retirables[id] = retirable;
+	ids.emplace(strategy->getShortStrategy(), id);
+}
+
+/*
+ * 冗長な列挙型戦略列に対応する戦略を取得する
+ */
+std::shared_ptr<Strategy> StrategyPool::intern(const std::vector<Action>& longStrategy) {
+
+	auto strategy = std::make_shared<Strategy>(longStrategy);
+	auto found = ids.find(strategy->getShortStrategy());
+	if (found != ids.end()) {
+		return strategies[found->second];
+	}
+
+	int id = getIdLimit();
+	if (!freeIds.empty()) {
+		id = freeIds.top();
+		freeIds.pop();
+	} else {
+		strategies.emplace_back();
+		retirables.push_back(true);
+	}
+
+	strategy->setId(id);
+	strategies[id] = strategy;
+	retirables[id] = true;
+	ids.emplace(strategy->getShortStrategy(), id);
+	return strategy;
+}
+
+/*
+ * プレイヤから参照されなくなった、破棄できる戦略を破棄する
+ *
+ * 参照がこのクラスの保持だけになったものを破棄する
+ */
+int StrategyPool::retireUnused() {
+
+	int retired = 0;
+	for (int id = 0, idLimit = getIdLimit(); id < idLimit; ++id) {
+		if (retirables[id] && (strategies[id] != nullptr) && strategies[id].unique()) {
+			ids.erase(strategies[id]->getShortStrategy());
+			strategies[id] = nullptr;
+			freeIds.push(id);
+			++retired;
+		}
+	}
+
+	// 末尾の空いた ID は詰める
+	while (!strategies.empty() && (strategies.back() == nullptr)) {
+		strategies.pop_back();
+		retirables.pop_back();
+	}
+	if (freeIds.size() + ids.size() != strategies.size()) {
+		decltype(freeIds) others;
+		for (; !freeIds.empty(); freeIds.pop()) {
+			if (freeIds.top() < getIdLimit()) {
+				others.push(freeIds.top());
+			}
+		}
+		freeIds.swap(others);
+	}
+	return retired;
+}
+
+/*
+ * 略記から戦略を取得
+ */
+std::shared_ptr<Strategy> StrategyPool::find(const std::string& shortStrategy) const {
+
+	auto found = ids.find(shortStrategy);
+	return (found == ids.end()) ? nullptr : strategies[found->second];
+}
+
+/*
+ * 登録されている戦略を ID 順に取得
+ */
+std::vector<std::shared_ptr<Strategy>> StrategyPool::getActiveStrategies() const {
+
+	std::vector<std::shared_ptr<Strategy>> active;
+	active.reserve(ids.size());
+	for (auto& strategy : strategies) {
+		if (strategy != nullptr) {
+			active.push_back(strategy);
+		}
+	}
+	return active;
+}
+
+/*
+ * 破棄できる戦略を ID 順に取得
+ */
+std::vector<std::shared_ptr<Strategy>> StrategyPool::getRetirableStrategies() const {
+
+	std::vector<std::shared_ptr<Strategy>> retirable;
+	for (int id = 0, idLimit = getIdLimit(); id < idLimit; ++id) {
+		if (retirables[id] && (strategies[id] != nullptr)) {
+			retirable.push_back(strategies[id]);
+		}
+	}
+	return retirable;
+}
+
+} /* namespace core */
+} /* namespace spd */
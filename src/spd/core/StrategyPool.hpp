@@ -0,0 +1,135 @@
+/**
+ * StrategyPool.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef STRATEGYPOOL_HPP_
+#define STRATEGYPOOL_HPP_
+
+#include <functional>
+#include <memory>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "Action.hpp"
+
+namespace spd {
+namespace core {
+
+class Strategy;
+
+/**
+ * シミュレーション中に使われている戦略を、略記から引けるようにまとめたクラス
+ *
+ * @par
+ * 初期の戦略(-s で指定した戦略)は ID 0 から順に登録し、破棄しない。<br>
+ * 突然変異で作られた戦略は、同じ略記の戦略があればそれを返し、無ければ
+ * 空いている最小の ID で登録する。<br>
+ * プレイヤ(戦略と前の戦略)から参照されなくなった戦略は retireUnused で破棄し、
+ * その ID を再利用するので、ID の上限は同時に使われている戦略数程度に収まる。
+ */
+class StrategyPool {
+public:
+
+	/**
+	 * 全ての戦略を破棄する
+	 */
+	void clear();
+
+	/**
+	 * 戦略を、その ID の位置に登録する
+	 * @param[in] strategy ID を設定した戦略
+	 * @param[in] retirable 参照されなくなったら破棄するかどうか(初期の戦略は false)
+	 * @throw std::invalid_argument ID が負の場合や、その ID または略記の戦略が既にある場合
+	 */
+	void add(const std::shared_ptr<Strategy>& strategy, bool retirable);
+
+	/**
+	 * 冗長な列挙型戦略列に対応する戦略を取得する
+	 *
+	 * 無い場合は、空いている最小の ID で、破棄できる戦略として登録する
+	 * @param[in] longStrategy 冗長な列挙型戦略列
+	 * @return 戦略
+	 */
+	std::shared_ptr<Strategy> intern(const std::vector<Action>& longStrategy);
+
+	/**
+	 * プレイヤから参照されなくなった、破棄できる戦略を破棄する
+	 * @return 破棄した戦略の数
+	 */
+	int retireUnused();
+
+	/**
+	 * ID から戦略を取得
+	 * @param[in] id 戦略ID
+	 * @return 戦略(破棄した ID の場合は nullptr)
+	 */
+	const std::shared_ptr<Strategy>& at(int id) const {
+		return strategies.at(id);
+	};
+
+	/**
+	 * 略記から戦略を取得
+	 * @param[in] shortStrategy 略記の戦略
+	 * @return 戦略(無い場合は nullptr)
+	 */
+	std::shared_ptr<Strategy> find(const std::string& shortStrategy) const;
+
+	/**
+	 * 戦略ID の上限
+	 * @return 使われている戦略の ID はこれより小さい
+	 */
+	int getIdLimit() const {
+		return strategies.size();
+	};
+
+	/**
+	 * 登録されている戦略の数
+	 * @return 戦略の数
+	 */
+	int getActiveNum() const {
+		return ids.size();
+	};
+
+	/**
+	 * 登録されている戦略を ID 順に取得
+	 * @return 戦略
+	 */
+	std::vector<std::shared_ptr<Strategy>> getActiveStrategies() const;
+
+	/**
+	 * 破棄できる戦略を ID 順に取得
+	 * @return 突然変異で作られた戦略
+	 */
+	std::vector<std::shared_ptr<Strategy>> getRetirableStrategies() const;
+
+private:
+
+	/**
+	 * ID ごとの戦略(破棄した ID は nullptr)
+	 */
+	std::vector<std::shared_ptr<Strategy>> strategies;
+
+	/**
+	 * ID ごとの、破棄できるかどうか
+	 */
+	std::vector<bool> retirables;
+
+	/**
+	 * 略記から ID への表
+	 */
+	std::unordered_map<std::string, int> ids;
+
+	/**
+	 * 破棄した ID (小さい順に再利用する)
+	 */
+	std::priority_queue<int, std::vector<int>, std::greater<int>> freeIds;
+};
+
+} /* namespace core */
+} /* namespace spd */
+#endif /* STRATEGYPOOL_HPP_ */
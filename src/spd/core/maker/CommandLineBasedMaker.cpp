@@ -8,8 +8,11 @@
 #include "CommandLineBasedMaker.hpp"
 
 #include <cmath>
+#include <random>
 #include <stdexcept>
 #include <iostream>
+#include <thread>
+#include <vector>
 
 #include "../Player.hpp"
 #include "../Space.hpp"
@@ -72,46 +75,82 @@ AllPlayer CommandLineBasedMaker::makePlayers() {
 
 /*
  * プレイヤの初期化を行う
+ *
+ * 戦略と初期行動は、プレイヤごとの乱数列から並列に割り当てる。
  */
 void CommandLineBasedMaker::initPlayer(const AllPlayer& players, spd::core::Space& space) {
 
-	auto strategyList = parameter.getStrategyList();
+	const auto& strategyList = parameter.getStrategyList();
+	const auto& initParam = parameter.getInitialParameter();
+	const auto& randParam = parameter.getRandomParameter();
+	auto topology = this->parameter.getNeighborhoodParameter()->getTopology();
 
-	for (int i = 0, playerNum = players.size(); i < playerNum; ++i) {
-		auto player = players.at(i);
+	// 初期クラスタがあるときは、最初の戦略を割り当てない
+	bool startsCluster = initParam->startsCluster();
+	int startIndex = startsCluster ? 1 : 0;
+	auto strategyTable = makeStrategyTable(startIndex);
+
+	// 中心座標
+	int centerIndex = topology->getCenterIndex(players.size());
+	int clusterSize = initParam->getStartClusterSize();
+	// 座標からクラスタ内か判定できる場合は、割り当てと同時に設定する
+	bool overlaysCluster = startsCluster && (topology->getDistance(centerIndex, centerIndex) >= 0);
+
+	// 1コアが担当するプレイヤ数
+	int core = parameter.getCore();
+	int playerNum = players.size();
+	int breadth = playerNum / core;
+	std::vector<std::thread> thr(core);
+
+	for (int i = 0; i < core; ++i) {
+		thr[i] = std::thread(
+				[&, i]{
+
+			int from = breadth * i;
+			int to = (i + 1 < core) ? breadth * (i + 1) : playerNum;
+			for (int id = from; id < to; ++id) {
+				auto& player = players[id];
+
+				// 戦略の割り当て
+				auto strategyEngine = randParam->getStream(
+						0, player->getId(), spd::param::RandomPurpose::INITIAL_STRATEGY);
+				int strategyNumber = startIndex + strategyTable(strategyEngine);
+
+				Action initAction;
+				if (initParam->startsInitialFixedAction()) {
+					initAction = initParam->getFixedAction();
+				} else {
+					// 乱数の生成
+					auto actionEngine = randParam->getStream(
+							0, player->getId(), spd::param::RandomPurpose::INITIAL_ACTION);
+					std::uniform_int_distribution<int> distribution(0, 1);
+					if (distribution(actionEngine) == 0) {
+						initAction = Action::ACTION_C;
+					} else {
+						initAction = Action::ACTION_D;
+					}
+				}
 
-		int strategyNumber = getStrategyNumber();
-		if (strategyNumber == -1) {
-			throw std::runtime_error("The strategy number corresponding to random number was not found.");
-		}
+				// クラスタ内は初めの戦略で初期化
+				if (overlaysCluster && topology->getDistance(centerIndex, player->getId()) <= clusterSize) {
+					strategyNumber = 0;
+				}
 
-		Action initAction;
-		if (parameter.getInitialParameter()->startsInitialFixedAction()) {
-			initAction = parameter.getInitialParameter()->getFixedAction();
-		} else {
-			// 乱数の生成
-			std::uniform_int_distribution<int> distribution(0, 1);
-			if (distribution(parameter.getRandomParameter()->getEngine()) == 0) {
-				initAction = Action::ACTION_C;
-			} else {
-				initAction = Action::ACTION_D;
+				// 初期化
+				player->init(initAction, strategyList.at(strategyNumber).first);
 			}
-			parameter.getRandomParameter()->addGenerated(1);
 		}
-
-		// 初期化
-		player->init(initAction, strategyList.at(strategyNumber).first);
+		);
 	}
 
-	// クラスタがある場合の初期化
-	if (parameter.getInitialParameter()->startsCluster()) {
-
-		auto topology = this->parameter.getNeighborhoodParameter()->getTopology();
+	for (std::thread& t : thr) {
+		t.join();
+	}
 
-		// 中心座標
-		int centerIndex = topology->getCenterIndex(players.size());
+	// 座標から判定できない構造で、クラスタがある場合の初期化
+	if (startsCluster && !overlaysCluster) {
 
-		auto clusters = topology->getNeighbors(players, centerIndex, parameter.getInitialParameter()->getStartClusterSize());
+		auto clusters = topology->getNeighbors(players, centerIndex, clusterSize);
 
 		for (int r = 0, rMax = clusters->size(); r < rMax; ++r) {
 			for (int i = 0, rPlayerNum = clusters->at(r)->size(); i < rPlayerNum; ++i) {
@@ -131,40 +170,24 @@ void CommandLineBasedMaker::initPlayer(const AllPlayer& players, spd::core::Spac
 	parameter.getInitialParameter()->getSpdRule()->init(players, this->parameter);
 }
 
-int CommandLineBasedMaker::getStrategyNumber() {
-
-	// 乱数の最大値
-	int randMax = 0;
-
-	// 戦略表
-	auto strategyList = parameter.getStrategyList();
-
-	int startIndex = 0;
-
-	for (auto strategy : strategyList) {
-		randMax += strategy.second;
-	}
-	// 初期クラスタがあるときは、最初の戦略を考えない
-	if (parameter.getInitialParameter()->startsCluster()) {
-		startIndex++;
-		randMax -= strategyList.front().second;
-	}
+/*
+ * 戦略の割合から、戦略を割り当てるエイリアス表を作成する
+ * @param[in] startIndex 割り当てる最初の戦略番号
+ */
+AliasTable CommandLineBasedMaker::makeStrategyTable(int startIndex) const {
 
-	// 乱数の生成
-	std::uniform_int_distribution<int> distribution(0, randMax - 1);
-	auto key = distribution(parameter.getRandomParameter()->getEngine());
-	parameter.getRandomParameter()->addGenerated(1);
+	const auto& strategyList = parameter.getStrategyList();
 
-	int level = 0;
+	std::vector<double> weights;
 	for (int i = startIndex, size = strategyList.size(); i < size; ++i) {
-
-		level += strategyList.at(i).second;
-		if (key < level) {
-			return i;
-		}
+		weights.push_back(strategyList.at(i).second);
 	}
 
-	return -1;
+	try {
+		return AliasTable(weights);
+	} catch (std::invalid_argument&) {
+		throw std::runtime_error("Could not assign strategies, because no strategy has a positive ratio.");
+	}
 }
 
 
@@ -9,6 +9,7 @@
 #define COMMANDLINEBASEDMAKER_H_
 
 #include "PlayerMaker.hpp"
+#include "../AliasTable.hpp"
 
 namespace spd {
 namespace param {
@@ -58,11 +59,12 @@ private:
 	spd::param::Parameter& parameter;
 
 	/**
-	 * 戦略番号を取得する
-	 * @return 戦略番号
-	 * @retval 戦略が見つからない場合 -1
+	 * 戦略の割合から、戦略を割り当てるエイリアス表を作成する
+	 * @param[in] startIndex 割り当てる最初の戦略番号
+	 * @return 戦略番号 - startIndex を標本化するエイリアス表
+	 * @throw std::runtime_error 割合が正の戦略がない場合
 	 */
-	int getStrategyNumber();
+	AliasTable makeStrategyTable(int startIndex) const;
 };
 
 } /* namespace core */
@@ -10,11 +10,13 @@
 #include <stdexcept>
 #include <fstream>
 #include <iostream>
+#include <unordered_map>
 
 #include <boost/any.hpp>
 
 #include "../Space.hpp"
 #include "../Strategy.hpp"
+#include "../StrategyPool.hpp"
 #include "../BoostAnyConverter.hpp"
 
 #include "../msgpack/SerializedSpace.hpp"
@@ -97,7 +99,12 @@ AllPlayer DeserializedMaker::makePlayers() {
 
 		// 乱数情報
 		unsigned long long generated = ss.getParam().getGeneratedRand();
-		param.getRandomParameter()->getEngine().discard(generated);
+		if (ss.getParam().getRandomEngine().empty()) {
+			// 内部状態のない古い形式は、生成した数だけ読み飛ばす
+			param.getRandomParameter()->getEngine().discard(generated);
+		} else {
+			param.getRandomParameter()->setEngineState(ss.getParam().getRandomEngine());
+		}
 		param.getRandomParameter()->addGenerated(generated);
 
 	} catch (msgpack::unpack_error&) {
@@ -140,19 +147,31 @@ void DeserializedMaker::initPlayer(const AllPlayer& allPlayer, spd::core::Space&
 		auto sl = ss.getParam().getStrategyList();
 		param.clearList();
 
+		// 戦略ID から位置を引く
+		std::unordered_map<int, int> indices;
+		for (int index = 0, size = sl.size(); index < size; ++index) {
+			indices.emplace(sl.at(index).getId(), index);
+		}
 		for (int id = 0, size = sl.size(); id < size; ++id) {
-			int index = findStrategyById(id, sl);
-			if (index < 0) {
+			auto index = indices.find(id);
+			if (index == indices.end()) {
 				std::cerr << "Could not rebuild a strategy from mpac file." << std::endl;
 				exit(EXIT_FAILURE);
 			}
 			param.addStrategy(
 					std::make_pair(
-							std::make_shared<Strategy>(sl.at(index).getShortStrategy().c_str()),
+							std::make_shared<Strategy>(sl.at(index->second).getShortStrategy().c_str()),
 							1
 					));
 		}
 
+		// 突然変異した戦略は、同じ ID に戻す
+		for (auto& mutant : ss.getParam().getMutantList()) {
+			auto strategy = std::make_shared<Strategy>(mutant.getShortStrategy().c_str());
+			strategy->setId(mutant.getId());
+			param.getStrategyPool()->add(strategy, true);
+		}
+
 		// step 情報
 		int step = ss.getStep();
 		space.setStep(step);
@@ -195,8 +214,8 @@ void DeserializedMaker::restorePlayer(
 	player->setPreScore(sp.getPreScore());
 	player->setScore(sp.getScore());
 
-	player->setPreStrategy(param.getStrategyList().at(sp.getPreStrategyId()).first);
-	player->setStrategy(param.getStrategyList().at(sp.getStrategyId()).first);
+	player->setPreStrategy(param.getStrategyPool()->at(sp.getPreStrategyId()));
+	player->setStrategy(param.getStrategyPool()->at(sp.getStrategyId()));
 
 	// プロパティ
 	player->clearProperty();
@@ -207,18 +226,6 @@ void DeserializedMaker::restorePlayer(
 	}
 }
 
-// 戦略ID からシリアライズした戦略を探す
-int DeserializedMaker::findStrategyById(int id, std::vector<serialize::SerializedStrategy>& strategies) {
-
-	for (int i = 0, size = strategies.size(); i < size; ++i) {
-		if (strategies.at(i).getId() == id) {
-			return i;
-		}
-	}
-
-	return -1;
-}
-
 /**
  * 構造と近傍の再初期化を行う
  * @param[in, out] allPlayer すべてのプレイヤ
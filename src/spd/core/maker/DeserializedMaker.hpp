@@ -71,8 +71,6 @@ private:
 	// load connections and set neighbors
 	void loadConnectionFromMpac(AllPlayer& allPlayer);
 
-	int findStrategyById(int id, std::vector<serialize::SerializedStrategy>& strategies);
-
 	void restorePlayer(const std::shared_ptr<Player>& player, const serialize::SerializedPlayer& sp);
 
 
@@ -13,6 +13,7 @@
 #include "../Space.hpp"
 #include "../Player.hpp"
 #include "../Strategy.hpp"
+#include "../StrategyPool.hpp"
 #include "../Converter.hpp"
 #include "../BoostAnyConverter.hpp"
 
@@ -99,16 +100,25 @@ AllPlayer GEXFBasedMaker::makePlayers() {
 		this->param.getNeighborhoodParameter()->setTopology(topology);
 
 		// 乱数生成情報の取得
+		unsigned long long generated = 0;
+		std::string engineState;
 		for (auto meta : metaDatas) {
 			auto pos = getKeywordPos(meta, "generated-rand");
 			if (pos != std::string::npos) {
-				// 乱数の除去
-				unsigned long long generated = std::stoull(meta.second.data().substr(pos));
-				param.getRandomParameter()->getEngine().discard(generated);
-				param.getRandomParameter()->addGenerated(generated);
-				break;
+				generated = std::stoull(meta.second.data().substr(pos));
 			}
+			pos = getKeywordPos(meta, "random-engine");
+			if (pos != std::string::npos) {
+				engineState = meta.second.data().substr(pos);
+			}
+		}
+		if (engineState.empty()) {
+			// 内部状態のない古い形式は、乱数の除去
+			param.getRandomParameter()->getEngine().discard(generated);
+		} else {
+			param.getRandomParameter()->setEngineState(engineState);
 		}
+		param.getRandomParameter()->addGenerated(generated);
 
 	} catch (boost::property_tree::ptree_bad_path& e){
 		std::cerr << "Could not create players from gexf file." << std::endl;
@@ -264,7 +274,7 @@ void GEXFBasedMaker::setPlayerVal(
 						+ value + "(player id : " + std::to_string(player->getId()) + ")");
 				throw std::invalid_argument(errMsg);
 			}
-			player->setPreStrategy(param.getStrategyList().at(strategyNum).first);
+			player->setPreStrategy(param.getStrategyPool()->at(strategyNum));
 			break;
 		case 5:
 			strategyNum = getStrategyNum(value);
@@ -273,7 +283,7 @@ void GEXFBasedMaker::setPlayerVal(
 						+ value + "(player id : " + std::to_string(player->getId()) + ")");
 				throw std::invalid_argument(errMsg);
 			}
-			player->setStrategy(param.getStrategyList().at(strategyNum).first);
+			player->setStrategy(param.getStrategyPool()->at(strategyNum));
 			break;
 		default:
 
@@ -288,14 +298,8 @@ void GEXFBasedMaker::setPlayerVal(
 
 int GEXFBasedMaker::getStrategyNum(std::string strategy) {
 
-	auto strategyList = param.getStrategyList();
-
-	for (int i = 0, size = strategyList.size(); i < size; ++i) {
-		if (strategyList.at(i).first->getShortStrategy() == strategy) {
-			return i;
-		}
-	}
-	return -1;
+	auto found = param.getStrategyPool()->find(strategy);
+	return (found == nullptr) ? -1 : found->getId();
 }
 
 /*
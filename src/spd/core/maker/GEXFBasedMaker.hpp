@@ -79,7 +79,9 @@ private:
 			std::string value);
 
 	/**
-	 * 同じ戦略のものを戦略リストからとってくる
+	 * 同じ略記の戦略の ID を、使われている戦略から引く
+	 * @param[in] strategy 略記の戦略
+	 * @return 戦略ID(無い場合は -1)
 	 */
 	int getStrategyNum(std::string strategy);
 
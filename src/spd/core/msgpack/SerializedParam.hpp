@@ -13,6 +13,7 @@
 
 #include "Serializer.hpp"
 #include "SerializedStrategy.hpp"
+#include "../StrategyPool.hpp"
 #include "../../param/Parameter.hpp"
 #include "../../param/NeighborhoodParameter.hpp"
 #include "../../param/RuntimeParameter.hpp"
@@ -50,6 +51,9 @@ public:
 		for (auto original : originalList) {
 			strategyList.push_back(SerializedStrategy(original.first));
 		}
+		for (auto& mutant : param.getStrategyPool()->getRetirableStrategies()) {
+			mutantList.push_back(SerializedStrategy(mutant));
+		}
 
 		// 構造
 		topology = param.getNeighborhoodParameter()->getTopology()->toString();
@@ -67,6 +71,7 @@ public:
 
 		// 乱数
 		generatedRand = param.getRandomParameter()->getGenerated();
+		randomEngine = param.getRandomParameter()->getEngineState();
 	}
 
 	/**
@@ -77,6 +82,14 @@ public:
 		return strategyList;
 	}
 
+	/**
+	 * 突然変異で作られ、使われている戦略のリストを取得する
+	 * @return 突然変異した戦略のリスト
+	 */
+	const std::vector<SerializedStrategy>& getMutantList() const {
+		return mutantList;
+	}
+
 	/**
 	 * 空間構造を取得する
 	 * @return 空間構造
@@ -141,12 +154,21 @@ public:
 		return generatedRand;
 	}
 
+	/**
+	 * 乱数生成エンジンの内部状態を取得する
+	 * @return 乱数生成エンジンの内部状態
+	 * @retval 内部状態を保存していない古い形式の場合は空文字列
+	 */
+	const std::string& getRandomEngine() const {
+		return randomEngine;
+	}
+
 	/**
 	 * シリアライズ
 	 */
 	MSGPACK_DEFINE(strategyList, topology,
 			payoffR, payoffS, payoffT, payoffP,
-			strategyUpdateCycle, selfInteraction, generatedRand)
+			strategyUpdateCycle, selfInteraction, generatedRand, randomEngine, mutantList)
 
 private:
 
@@ -164,6 +186,12 @@ private:
 	bool selfInteraction;
 
 	unsigned long long generatedRand;
+
+	// 末尾に追加したので、古い形式では読み込まれず空のまま
+	std::string randomEngine;
+
+	// 末尾に追加したので、古い形式では読み込まれず空のまま
+	std::vector<SerializedStrategy> mutantList;
 };
 
 } /* namespace serialize */
@@ -48,6 +48,14 @@ public:
 		return "dump";
 	}
 
+	/**
+	 * プレイヤのプロパティを読む出力かどうか
+	 * @return true
+	 */
+	bool readsProperties() const {
+		return true;
+	}
+
 private:
 
 	/**
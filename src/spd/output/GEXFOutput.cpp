@@ -18,6 +18,7 @@
 #include "../core/Space.hpp"
 #include "../core/Player.hpp"
 #include "../core/Strategy.hpp"
+#include "../core/StrategyPool.hpp"
 #include "../core/Converter.hpp"
 
 #include "../param/Parameter.hpp"
@@ -67,9 +68,9 @@ std::pair<std::string, bool> GEXFOutput::output(spd::core::Space& space) {
 			"\t<meta>\n\t\t<keywords>topology=" <<
 			param.getNeighborhoodParameter()->getTopology()->toString(); // 空間構造
 
-	for (auto strategy : param.getStrategyList()) {
-		outputfile << "</keywords>\n\t\t<keywords>strategy=" << // 戦略
-				strategy.first->getShortStrategy();
+	for (auto& strategy : param.getStrategyPool()->getActiveStrategies()) {
+		outputfile << "</keywords>\n\t\t<keywords>strategy=" << // 戦略(突然変異した戦略を含む)
+				strategy->getShortStrategy();
 	}
 	outputfile << "</keywords>\n\t\t<keywords>payoff-R=" << runtimeParam->getPayoffR() << // payoff
 			"</keywords>\n\t\t<keywords>payoff-S=" << runtimeParam->getPayoffS() <<
@@ -79,7 +80,9 @@ std::pair<std::string, bool> GEXFOutput::output(spd::core::Space& space) {
 			"</keywords>\n\t\t<keywords>self-interaction=" << runtimeParam->isSelfInteraction() << // 自己対戦
 			"</keywords>\n\t\t<keywords>step=" << space.getStep() << // ステップ
 			"</keywords>\n\t\t<keywords>generated-rand=" <<
-			param.getRandomParameter()->getGenerated() << "</keywords>\n\t</meta>\n"; // 乱数の生成回数
+			param.getRandomParameter()->getGenerated() << // 乱数の生成回数
+			"</keywords>\n\t\t<keywords>random-engine=" <<
+			param.getRandomParameter()->getEngineState() << "</keywords>\n\t</meta>\n"; // 乱数の内部状態
 
 	// グラフの出力
 	outputfile << "\t<graph mode=\"static\" defaultedgetype=\"undirected\">\n" <<
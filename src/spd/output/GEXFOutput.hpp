@@ -49,6 +49,14 @@ public:
 		return "gexf";
 	}
 
+	/**
+	 * プレイヤのプロパティを読む出力かどうか
+	 * @return true
+	 */
+	bool readsProperties() const {
+		return true;
+	}
+
 private:
 
 	/**
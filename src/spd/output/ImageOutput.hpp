@@ -77,6 +77,14 @@ public:
 		return "image";
 	}
 
+	/**
+	 * プレイヤのプロパティを読む出力かどうか
+	 * @return 色の選択がプロパティを読むかどうか
+	 */
+	bool readsProperties() const {
+		return color->readsProperties();
+	}
+
 private:
 
 	/**
@@ -14,6 +14,7 @@
 
 #include "../core/Space.hpp"
 #include "../core/Strategy.hpp"
+#include "../core/StrategyPool.hpp"
 #include "../core/Player.hpp"
 #include "../param/Parameter.hpp"
 #include "../param/OutputParameter.hpp"
@@ -28,40 +29,39 @@ namespace output {
  */
 std::pair<std::string, bool> NumberOutput::output(spd::core::Space& space) {
 
-	auto strategyList = space.getParameter().getStrategyList();
+	// 使われている戦略を ID 順に出力する(突然変異した戦略を含む)
+	auto& pool = space.getParameter().getStrategyPool();
+	auto strategyList = pool->getActiveStrategies();
 	int strategyListSize = strategyList.size();
 
-	std::vector<int> countList(strategyListSize * 2, 0);
-
-	// 数える
-	for (auto player : space.getPlayers()) {
-		for (int i = 0; i < strategyListSize; ++i) {
-			if (strategyList.at(i).first->equals(*(player->getStrategy()))) {
-				// 行動によって数え分ける
-				if (player->getAction() == Action::ACTION_C) {
-					countList.at(i * 2 + static_cast<int>(Action::ACTION_C)) += 1;
-				} else if (player->getAction() == Action::ACTION_D) {
-					countList.at(i * 2 + static_cast<int>(Action::ACTION_D)) += 1;
-				}
-				break;
-			}
-			if (i == strategyListSize - 1) {
-				throw std::runtime_error("Could not find a player's strategy from the strategy list.");
-			}
+	std::vector<int> countList(pool->getIdLimit() * 2, 0);
+
+	// 戦略ID ごとに数える
+	for (auto& player : space.getPlayers()) {
+		int strategyId = player->getStrategy()->getId();
+		if ((strategyId < 0) || (strategyId >= pool->getIdLimit()) ||
+				(pool->at(strategyId) != player->getStrategy())) {
+			throw std::runtime_error("Could not find a player's strategy from the strategy list.");
+		}
+		// 行動によって数え分ける
+		if (player->getAction() == Action::ACTION_C) {
+			countList[strategyId * 2 + static_cast<int>(Action::ACTION_C)] += 1;
+		} else if (player->getAction() == Action::ACTION_D) {
+			countList[strategyId * 2 + static_cast<int>(Action::ACTION_D)] += 1;
 		}
 	}
 
 	// 出力
 	*(this->outputFile.get()) << std::setw(5) << std::setfill('0') << space.getStep() << ":<" <<
-			strategyList.front().first->getShortStrategy() << "-C:" << countList.front() << ">,<" <<
-			strategyList.front().first->getShortStrategy() << "-D:" << countList.at(1) << ">";
+			strategyList.front()->getShortStrategy() << "-C:" << countList.at(strategyList.front()->getId() * 2 + static_cast<int>(Action::ACTION_C)) << ">,<" <<
+			strategyList.front()->getShortStrategy() << "-D:" << countList.at(strategyList.front()->getId() * 2 + static_cast<int>(Action::ACTION_D)) << ">";
 
 	for (int i = 1; i < strategyListSize; ++i) {
 		*(this->outputFile.get()) << ",<" <<
-				strategyList.at(i).first->getShortStrategy() << "-C:" <<
-				countList.at(i * 2 +  static_cast<int>(Action::ACTION_C)) << ">,<" <<
-				strategyList.at(i).first->getShortStrategy() << "-D:" <<
-				countList.at(i * 2 +  static_cast<int>(Action::ACTION_D)) << ">";
+				strategyList.at(i)->getShortStrategy() << "-C:" <<
+				countList.at(strategyList.at(i)->getId() * 2 + static_cast<int>(Action::ACTION_C)) << ">,<" <<
+				strategyList.at(i)->getShortStrategy() << "-D:" <<
+				countList.at(strategyList.at(i)->getId() * 2 + static_cast<int>(Action::ACTION_D)) << ">";
 	}
 	*(this->outputFile.get()) << std::endl;
 
@@ -47,6 +47,16 @@ public:
 	 * @param[in, out] param パラメタ
 	 */
 	virtual void init(spd::core::Space& space, spd::param::Parameter& param) = 0;
+
+	/**
+	 * プレイヤのプロパティを読む出力かどうか
+	 *
+	 * 読む出力がある時だけ、解析ルールを実行する
+	 * @return プロパティを読むかどうか
+	 */
+	virtual bool readsProperties() const {
+		return false;
+	};
 };
 
 } /* namespace core */
@@ -43,6 +43,14 @@ class PropertyOutput: public spd::output::Output {
 	std::string toString() const {
 		return "property";
 	}
+
+	/**
+	 * プレイヤのプロパティを読む出力かどうか
+	 * @return true
+	 */
+	bool readsProperties() const {
+		return true;
+	}
 	
 private:
 
@@ -36,6 +36,14 @@ public:
 		return "affect";
 	}
 
+	/**
+	 * プレイヤのプロパティから色を選ぶかどうか
+	 * @return true
+	 */
+	bool readsProperties() const {
+		return true;
+	}
+
 
 };
 
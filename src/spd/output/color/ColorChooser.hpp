@@ -44,6 +44,14 @@ public:
 	 */
 	virtual const std::string colorTypeNmae() const = 0;
 
+	/**
+	 * プレイヤのプロパティから色を選ぶかどうか
+	 * @return プロパティを読むかどうか
+	 */
+	virtual bool readsProperties() const {
+		return false;
+	}
+
 protected:
 
 
@@ -35,6 +35,14 @@ public:
 	const std::string colorTypeNmae() const {
 		return "membrane";
 	}
+
+	/**
+	 * プレイヤのプロパティから色を選ぶかどうか
+	 * @return true
+	 */
+	bool readsProperties() const {
+		return true;
+	}
 };
 
 } /* namespace color */
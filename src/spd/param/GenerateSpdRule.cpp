@@ -7,9 +7,12 @@
 
 #include <stdexcept>
 #include <algorithm>
+#include <typeinfo>
 #include "GenerateSpdRule.hpp"
 #include "../rule/SpdRule.hpp"
 #include "../rule/AllRules.hpp"
+#include "../rule/FusedPipeline.hpp"
+#include "../rule/generated/GeneratedRule.hpp"
 
 namespace spd {
 namespace param {
@@ -72,7 +75,7 @@ GenerateSpdRule::GenerateSpdRule() {
 	// ルールを設定
 	// 膜チェックだけを行う、シンプルルール
 	string memRuleName = "membrane_check_simple_rule";
-	auto memRule = make_shared<spd::rule::SpdRule>(bestRuleName);
+	auto memRule = make_shared<spd::rule::SpdRule>(memRuleName);
 	memRule->addRuleBeforeOutput(make_shared<spd::rule::SimpleActionRule>());
 	memRule->addRuleBeforeOutput(make_shared<spd::rule::SimpleSumGameRule>());
 	memRule->addRuleBeforeOutput(make_shared<spd::rule::PromoteStateRule>());
@@ -86,12 +89,14 @@ GenerateSpdRule::GenerateSpdRule() {
 
 	// 膜チェックと、影響を調べる、シンプルルール
 	string fullRuleName = "membrane_and_effect_check_simple_rule";
-	auto fullRule = make_shared<spd::rule::SpdRule>(bestRuleName);
+	auto fullRule = make_shared<spd::rule::SpdRule>(fullRuleName);
 	fullRule->addRuleBeforeOutput(make_shared<spd::rule::SimpleActionRule>());
 	fullRule->addRuleBeforeOutput(make_shared<spd::rule::SimpleSumGameRule>());
 	fullRule->addRuleBeforeOutput(make_shared<spd::rule::PromoteStateRule>());
-	fullRule->addRuleBeforeOutput(make_shared<spd::rule::MembraneDetectRule>());
-	fullRule->addRuleBeforeOutput(make_shared<spd::rule::AffectedPlayerRule>());
+	// 影響検知は、膜検知の分類と結果を使う
+	auto membraneRule = make_shared<spd::rule::MembraneDetectRule>();
+	fullRule->addRuleBeforeOutput(membraneRule);
+	fullRule->addRuleBeforeOutput(make_shared<spd::rule::AffectedPlayerRule>(membraneRule));
 
 	fullRule->addRuleAfterOutput(make_shared<spd::rule::BestStrategyRule>());
 
@@ -99,6 +104,45 @@ GenerateSpdRule::GenerateSpdRule() {
 	transform(fullRuleName.begin(), fullRuleName.end(), fullRuleName.begin(), ::tolower);
 
 
+	// 突然変異する、シンプルルール
+	string mutationRuleName = "mutation_rule";
+	auto mutationRule = make_shared<spd::rule::SpdRule>(mutationRuleName);
+	mutationRule->addRuleBeforeOutput(make_shared<spd::rule::SimpleActionRule>());
+	mutationRule->addRuleBeforeOutput(make_shared<spd::rule::SimpleSumGameRule>());
+	mutationRule->addRuleBeforeOutput(make_shared<spd::rule::PromoteStateRule>());
+
+	mutationRule->addRuleAfterOutput(make_shared<spd::rule::BestStrategyRule>());
+	mutationRule->addRuleAfterOutput(make_shared<spd::rule::MutationRule>());
+
+	transform(mutationRuleName.begin(), mutationRuleName.end(), mutationRuleName.begin(), ::tolower);
+
+
+	// 接続を張り替える、シンプルルール
+	string rewireRuleName = "rewire_rule";
+	auto rewireRule = make_shared<spd::rule::SpdRule>(rewireRuleName);
+	rewireRule->addRuleBeforeOutput(make_shared<spd::rule::SimpleActionRule>());
+	rewireRule->addRuleBeforeOutput(make_shared<spd::rule::SimpleSumGameRule>());
+	rewireRule->addRuleBeforeOutput(make_shared<spd::rule::PromoteStateRule>());
+
+	rewireRule->addRuleAfterOutput(make_shared<spd::rule::BestStrategyRule>());
+	rewireRule->addRuleAfterOutput(make_shared<spd::rule::RewireRule>());
+
+	transform(rewireRuleName.begin(), rewireRuleName.end(), rewireRuleName.begin(), ::tolower);
+
+
+	// 損傷を与えて回復を調べる、シンプルルール
+	string repairRuleName = "self_repair_rule";
+	auto repairRule = make_shared<spd::rule::SpdRule>(repairRuleName);
+	repairRule->addRuleBeforeOutput(make_shared<spd::rule::SimpleActionRule>());
+	repairRule->addRuleBeforeOutput(make_shared<spd::rule::SimpleSumGameRule>());
+	repairRule->addRuleBeforeOutput(make_shared<spd::rule::PromoteStateRule>());
+
+	repairRule->addRuleAfterOutput(make_shared<spd::rule::BestStrategyRule>());
+	repairRule->addRuleAfterOutput(make_shared<spd::rule::RepairRule>());
+
+	transform(repairRuleName.begin(), repairRuleName.end(), repairRuleName.begin(), ::tolower);
+
+
 	// ルールの追加
 	map<string, shared_ptr<spd::rule::SpdRule>> m {
 		{bestRuleName, bestRule},
@@ -106,10 +150,34 @@ GenerateSpdRule::GenerateSpdRule() {
 		{uniDiscoutRuleName, uniDiscountRule},
 		{inverseSquareDiscoutRuleName, inverseSquareDiscoutRule},
 		{memRuleName, memRule},
-		{fullRuleName, fullRule}
+		{fullRuleName, fullRule},
+		{mutationRuleName, mutationRule},
+		{rewireRuleName, rewireRule},
+		{repairRuleName, repairRule}
 	};
 
 	this->spdRuleMap = m;
+
+	// 組み込みの組み合わせは、まとめて実行する
+	for (auto& rule : spdRuleMap) {
+		choosePipeline(*(rule.second));
+	}
+
+	// ルールの記述に使える部品
+	componentMap = {
+		{"simple_action", []{ return make_shared<spd::rule::SimpleActionRule>(); }},
+		{"sum_game", []{ return make_shared<spd::rule::SimpleSumGameRule>(); }},
+		{"average_game", []{ return make_shared<spd::rule::AverageGameRule>(); }},
+		{"uniform_discount_game", []{ return make_shared<spd::rule::UniformDiscountDistance>(); }},
+		{"inverse_square_game", []{ return make_shared<spd::rule::InverseSquareDiscountDistance>(); }},
+		{"store", []{ return make_shared<spd::rule::PromoteStateRule>(); }},
+		{"membrane", []{ return make_shared<spd::rule::MembraneDetectRule>(); }},
+		{"affected", []{ return make_shared<spd::rule::AffectedPlayerRule>(); }},
+		{"best_strategy", []{ return make_shared<spd::rule::BestStrategyRule>(); }},
+		{"mutation", []{ return make_shared<spd::rule::MutationRule>(); }},
+		{"rewire", []{ return make_shared<spd::rule::RewireRule>(); }},
+		{"repair", []{ return make_shared<spd::rule::RepairRule>(); }}
+	};
 }
 
 /*
@@ -131,6 +199,11 @@ std::shared_ptr<spd::rule::SpdRule> GenerateSpdRule::generate(const std::string&
 		return itr->second;
 	}
 
+	// 部品の組み合わせとして記述されている場合(生成するルールのファイル名は大文字小文字を区別する)
+	if (spdRuleName.find_first_of("+|") != std::string::npos) {
+		return compose(spdRule);
+	}
+
 	std::string err = "";
 	for (auto m : this->spdRuleMap) {
 		err += " " + m.first;
@@ -139,6 +212,130 @@ std::shared_ptr<spd::rule::SpdRule> GenerateSpdRule::generate(const std::string&
 			"Settable rule(s): [" + err + " ]");
 }
 
+/*
+ * ルールの記述から、ルールを組み立てる
+ * @param[in] description ルールの記述
+ */
+std::shared_ptr<spd::rule::SpdRule> GenerateSpdRule::compose(const std::string& description) const {
+
+	// 前処理と後処理に分ける
+	auto bar = description.find('|');
+	if (bar != std::string::npos && description.find('|', bar + 1) != std::string::npos) {
+		throw std::invalid_argument("A rule description " + description + " has more than one '|'.");
+	}
+
+	// 部品名を小文字にした記述を名前とし、再開時にも同じルールを組み立てる
+	std::string normalized;
+	std::vector<shared_ptr<spd::rule::Rule>> components[2];
+	shared_ptr<const spd::rule::MembraneDetectRule> membraneRule = nullptr;
+
+	for (int phase = 0; phase < 2; ++phase) {
+		std::string phaseDescription = (phase == 0) ? description.substr(0, bar)
+				: (bar == std::string::npos) ? "" : description.substr(bar + 1);
+		if (phaseDescription.empty()) {
+			continue;
+		}
+
+		std::string::size_type from = 0;
+		while (true) {
+			auto to = phaseDescription.find('+', from);
+			std::string componentName = phaseDescription.substr(from,
+					(to == std::string::npos) ? std::string::npos : to - from);
+
+			// 生成するルールは、ファイル名以外を小文字にする
+			std::string prefix = componentName.substr(0, KERNEL_PREFIX.size());
+			transform(prefix.begin(), prefix.end(), prefix.begin(), ::tolower);
+			if (prefix == KERNEL_PREFIX) {
+				componentName = KERNEL_PREFIX + componentName.substr(KERNEL_PREFIX.size());
+			} else {
+				transform(componentName.begin(), componentName.end(), componentName.begin(), ::tolower);
+			}
+			normalized += ((from == 0) ? ((phase == 0) ? "" : "|") : "+") + componentName;
+
+			shared_ptr<spd::rule::Rule> component = nullptr;
+			if (prefix == KERNEL_PREFIX) {
+				// ルールの記述言語で書かれたルール
+				component = make_shared<spd::rule::GeneratedRule>(componentName.substr(KERNEL_PREFIX.size()));
+			} else if (componentName == "affected" && membraneRule != nullptr) {
+				// 影響検知は、膜検知の分類と結果を使う
+				component = make_shared<spd::rule::AffectedPlayerRule>(membraneRule);
+			} else {
+				auto itr = componentMap.find(componentName);
+				if (itr == componentMap.end()) {
+					std::string err = "";
+					for (auto& name : getComponentNames()) {
+						err += " " + name;
+					}
+					throw std::invalid_argument("Could not find a rule component "
+							+ (componentName.empty() ? "(empty)" : componentName)
+							+ " in " + description + ".\n"
+							"Settable component(s): [" + err + " ]");
+				}
+				component = itr->second();
+				if (componentName == "membrane") {
+					membraneRule = std::static_pointer_cast<const spd::rule::MembraneDetectRule>(component);
+				}
+			}
+
+			components[phase].push_back(component);
+
+			if (to == std::string::npos) {
+				break;
+			}
+			from = to + 1;
+		}
+	}
+
+	auto spdRule = make_shared<spd::rule::SpdRule>(normalized);
+	for (auto& component : components[0]) {
+		spdRule->addRuleBeforeOutput(component);
+	}
+	for (auto& component : components[1]) {
+		spdRule->addRuleAfterOutput(component);
+	}
+	choosePipeline(*spdRule);
+
+	return spdRule;
+}
+
+/*
+ * 前処理ルールの先頭が組み込みの組み合わせの場合、まとめて実行するクラスを設定する
+ *
+ * 派生したルールで置き換えられていないよう、型は完全に一致するものだけを扱う
+ */
+void GenerateSpdRule::choosePipeline(spd::rule::SpdRule& spdRule) const {
+
+	auto& rules = spdRule.getRulesBeforeOutput();
+	if ((rules.size() < 3) ||
+			(typeid(*rules[0]) != typeid(spd::rule::SimpleActionRule)) ||
+			(typeid(*rules[2]) != typeid(spd::rule::PromoteStateRule))) {
+		return;
+	}
+
+	auto action = std::static_pointer_cast<spd::rule::SimpleActionRule>(rules[0]);
+	auto store = std::static_pointer_cast<spd::rule::PromoteStateRule>(rules[2]);
+
+	if (typeid(*rules[1]) == typeid(spd::rule::SimpleSumGameRule)) {
+		spdRule.setPipeline(make_shared<spd::rule::FusedPipeline<spd::rule::SimpleSumGameRule, false>>(
+				action, std::static_pointer_cast<spd::rule::SimpleSumGameRule>(rules[1]), store));
+	} else if (typeid(*rules[1]) == typeid(spd::rule::AverageGameRule)) {
+		spdRule.setPipeline(make_shared<spd::rule::FusedPipeline<spd::rule::AverageGameRule, true>>(
+				action, std::static_pointer_cast<spd::rule::AverageGameRule>(rules[1]), store));
+	}
+}
+
+/*
+ * ルールの記述に使える部品名を取得
+ */
+std::vector<std::string> GenerateSpdRule::getComponentNames() const {
+
+	std::vector<std::string> names;
+	for (auto& component : componentMap) {
+		names.push_back(component.first);
+	}
+	return names;
+}
+
 /*
  * SPDルール名とSPDルールの対応を取得
  */
@@ -11,10 +11,13 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
+#include <functional>
 
 namespace spd {
 namespace rule {
 class SpdRule;
+class Rule;
 }
 namespace param {
 
@@ -31,7 +34,9 @@ public:
 
 	/**
 	 * 文字列から、ルールを作成する
-	 * @param[in] spdRule ルール名
+	 *
+	 * ルール名が登録されていない場合は、ルールの記述として組み立てる
+	 * @param[in] spdRule ルール名、またはルールの記述
 	 * @retval nullptr ルール名に対応する構造を作成できない場合
 	 * @throw invalid_argument 文字列が空の場合または、ルール名に対応する構造を作成できない場合
 	 */
@@ -42,8 +47,46 @@ public:
 	 */
 	const std::map<std::string, std::shared_ptr<spd::rule::SpdRule>>& getSpdRuleMap() const;
 
+	/**
+	 * ルールの記述に使える部品名を取得
+	 * @return 部品名
+	 */
+	std::vector<std::string> getComponentNames() const;
+
 private:
 
+	/**
+	 * ルールの記述から、ルールを組み立てる
+	 *
+	 * 記述は "前処理部品+前処理部品+...|後処理部品+..." とし、部品は記述順に実行する。
+	 * 影響検知(affected)は、それより前に膜検知(membrane)があれば、その結果を使う。<br>
+	 * "kernel:ファイル名" の部品は、ルールの記述言語で書かれたファイルからカーネルを生成して実行する
+	 * (GeneratedRule)。ファイル名には + と | を使えない。
+	 * @param[in] description ルールの記述(部品名の大文字小文字は区別しない)
+	 * @return 組み立てたルール
+	 * @throw invalid_argument 部品が空の場合や、部品名が登録されていない場合
+	 */
+	std::shared_ptr<spd::rule::SpdRule> compose(const std::string& description) const;
+
+	/**
+	 * 前処理ルールの先頭が組み込みの組み合わせの場合、まとめて実行するクラスを設定する
+	 *
+	 * 行動更新(SimpleActionRule)、総和または平均の対戦、状態の保存(PromoteStateRule)の順の場合のみ設定し、
+	 * それ以外はルールごとに実行する
+	 * @param[in, out] spdRule ルール
+	 */
+	void choosePipeline(spd::rule::SpdRule& spdRule) const;
+
+	/**
+	 * ルールの記述で、生成するルールのファイル名の前につける接頭辞
+	 */
+	const std::string KERNEL_PREFIX = "kernel:";
+
+	/**
+	 * ルールの記述に使える部品名と、部品の作成を結びつけているmap
+	 */
+	std::map<std::string, std::function<std::shared_ptr<spd::rule::Rule>()>> componentMap;
+
 	/**
 	 * SPDルール名とSPDルールを結びつけているmap
 	 */
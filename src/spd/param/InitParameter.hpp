@@ -192,6 +192,14 @@ public:
 		return this->properties;
 	}
 
+	/**
+	 * プロパティの種類と初期値を設定
+	 * @param[in] properties プロパティの種類と初期値
+	 */
+	void setProperties(const std::shared_ptr<std::vector<std::pair<std::string, std::string>>>& properties) {
+		this->properties = properties;
+	}
+
 	/**
 	 * パラメタを出力する
 	 * @param out 出力先
@@ -50,6 +50,23 @@ public:
 	 */
 	std::vector<std::tuple<std::shared_ptr<output::Output>, int, int, int>>& getOutputs();
 
+	/**
+	 * 出力方法の指定(出力方法と各ステップを「:」で区切った文字列)のリストを取得
+	 * @return 出力方法の指定のリスト
+	 */
+	const std::vector<std::string>& getOutputSettings() const {
+		return outputSettings;
+	}
+
+	/**
+	 * 出力方法の指定のリストを設定
+	 * @note 出力方法は状態を持つので、分岐した空間ではこの指定から作り直す
+	 * @param[in] settings 出力方法の指定のリスト
+	 */
+	void setOutputSettings(const std::vector<std::string>& settings) {
+		outputSettings = settings;
+	}
+
 	/**
 	 * セルサイズを設定する
 	 * @param[in] size セルサイズ
@@ -84,6 +101,9 @@ private:
 	// 出力
 	std::vector<std::tuple<std::shared_ptr<output::Output>, int, int, int>> outputs;
 
+	// 出力方法の指定
+	std::vector<std::string> outputSettings;
+
 	// 画像の出力のセルサイズ
 	int cellSize;
 };
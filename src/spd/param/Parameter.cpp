@@ -15,9 +15,13 @@
 #include "RuntimeParameter.hpp"
 #include "NeighborhoodParameter.hpp"
 #include "RandomParameter.hpp"
+#include "GenerateSpdRule.hpp"
+#include "GenerateOutput.hpp"
 
 #include "../core/Strategy.hpp"
+#include "../core/StrategyPool.hpp"
 #include "../core/Action.hpp"
+#include "../rule/SpdRule.hpp"
 
 namespace spd {
 namespace param {
@@ -25,13 +29,14 @@ namespace param {
 /*
  * デフォルト値で初期化
  */
-Parameter::Parameter() : core(1) {
+Parameter::Parameter() : core(1), forkStep(0) {
 	std::vector<std::pair<std::shared_ptr<core::Strategy>, int>> strategyList;
 	this->strategyList = strategyList;
 
 	std::vector<std::pair<std::shared_ptr<core::Strategy>, int>> s_strategyList;
 	this->s_strategyList = s_strategyList;
 
+	this->strategyPool = std::make_shared<core::StrategyPool>();
 	this->initParam = std::make_shared<InitParameter>();
 	this->neighborParam = std::make_shared<NeighborhoodParameter>();
 	this->outputParam = std::make_shared<OutputParameter>();
@@ -56,9 +61,65 @@ void Parameter::restore() {
 		strategyList.push_back(strategyPair);
 	}
 
+	// 突然変異した戦略は破棄する
+	strategyPool->clear();
+	for (auto& strategyPair : strategyList) {
+		strategyPool->add(strategyPair.first, false);
+	}
+
 	runtimeParam->restore();
 }
 
+/*
+ * 分岐した空間用に、このパラメタを複製する
+ */
+std::shared_ptr<Parameter> Parameter::fork() const {
+
+	auto forked = std::make_shared<Parameter>();
+	forked->strategyList = strategyList;
+	forked->s_strategyList = s_strategyList;
+	forked->strategyPool = std::make_shared<core::StrategyPool>(*strategyPool);
+
+	// ルールは状態を持つので、同じ名前から作り直す
+	forked->initParam = std::make_shared<InitParameter>(*initParam);
+	forked->initParam->setProperties(
+			std::make_shared<std::vector<std::pair<std::string, std::string>>>(*(initParam->getProperties())));
+	GenerateSpdRule ruleGenerator;
+	forked->initParam->setSpdRule(ruleGenerator.generate(initParam->getSpdRule()->getName()));
+
+	// 空間構造は共有する
+	forked->neighborParam = neighborParam;
+
+	// 出力方法も状態を持つので、同じ指定から作り直す
+	forked->outputParam = std::make_shared<OutputParameter>(*outputParam);
+	GenerateOutput outputGenerator;
+	auto& outputs = forked->outputParam->getOutputs();
+	outputs.clear();
+	for (auto& setting : outputParam->getOutputSettings()) {
+		outputs.push_back(outputGenerator.generate(setting));
+	}
+
+	forked->runtimeParam = std::make_shared<RuntimeParameter>(*runtimeParam);
+	forked->randomParam->setSeed(randomParam->getSeed());
+	forked->randomParam->setDiscardNum(randomParam->getDiscardNum());
+	forked->pm = pm;
+	forked->core = core;
+	return forked;
+}
+
+/*
+ * 分岐元の実行中の状態を引き継ぐ
+ *
+ * 突然変異した戦略も含めて引き継ぐ。戦略は変更されないので、分岐元と共有する。
+ */
+void Parameter::takeOverState(const Parameter& base) {
+
+	strategyList = base.strategyList;
+	s_strategyList = base.s_strategyList;
+	*strategyPool = *(base.strategyPool);
+	randomParam->takeOver(*(base.randomParam));
+}
+
 /*
  * getter
  */
@@ -77,6 +138,15 @@ void Parameter::addStrategy(std::pair<std::shared_ptr<core::Strategy>, int> stra
 	}
 	strategyPair.first->setId(strategyList.size());
 	this->strategyList.push_back(strategyPair);
+	strategyPool->add(strategyPair.first, false);
+}
+
+/*
+ * 戦略リストを空にする
+ */
+void Parameter::clearList() {
+	strategyList.clear();
+	strategyPool->clear();
 }
 
 /*
@@ -100,6 +170,12 @@ void Parameter::showParameter(std::ostream& out) const {
 	outputParam->showParameter(out);
 	randomParam->showParameter(out);
 
+	if (!forks.empty()) {
+		out << "fork-step = " << forkStep << "\n";
+		for (auto& forked : forks) {
+			out << "fork = " << forked.first << "\n";
+		}
+	}
 	out << "core = " << core <<
 			"\n#---------------------------------#\n";
 
@@ -18,6 +18,7 @@
 namespace spd {
 namespace core {
 class Strategy;
+class StrategyPool;
 class PlayerMaker;
 }
 
@@ -57,8 +58,14 @@ public:
 	/**
 	 * 戦略リストを空にする
 	 */
-	void clearList() {
-		strategyList.clear();
+	void clearList();
+
+	/**
+	 * シミュレーション中に使われている戦略(初期の戦略と突然変異した戦略)を取得
+	 * @return 戦略ID と略記から引ける戦略
+	 */
+	const std::shared_ptr<core::StrategyPool>& getStrategyPool() const {
+		return strategyPool;
 	}
 
 
@@ -134,6 +141,55 @@ public:
 		this->core = core;
 	}
 
+	/**
+	 * 空間を分岐するステップを取得
+	 * @return 空間を分岐するステップ
+	 */
+	int getForkStep() const {
+		return forkStep;
+	}
+
+	/**
+	 * 空間を分岐するステップを設定
+	 * @param[in] forkStep 空間を分岐するステップ
+	 */
+	void setForkStep(int forkStep) {
+		this->forkStep = forkStep;
+	}
+
+	/**
+	 * 分岐した空間の設定ファイル名とパラメタのリストを取得
+	 * @return 分岐した空間の設定ファイル名とパラメタのリスト
+	 */
+	const std::vector<std::pair<std::string, std::shared_ptr<Parameter>>>& getForks() const {
+		return forks;
+	}
+
+	/**
+	 * 分岐した空間のパラメタを追加
+	 * @param[in] configFile 分岐先の設定ファイル名
+	 * @param[in] forked 分岐先のパラメタ
+	 */
+	void addFork(const std::string& configFile, const std::shared_ptr<Parameter>& forked) {
+		forks.push_back(std::make_pair(configFile, forked));
+	}
+
+	/**
+	 * 分岐した空間用に、このパラメタを複製する
+	 *
+	 * @par
+	 * 近傍用パラメタ(空間構造)とプレイヤ作成方法は共有し、それ以外は複製する。
+	 * ルールと出力方法は状態を持つので、同じ指定から作り直す。分岐の設定は複製しない。
+	 * @return 複製したパラメタ
+	 */
+	std::shared_ptr<Parameter> fork() const;
+
+	/**
+	 * 分岐元の実行中の状態(戦略と乱数)を引き継ぐ
+	 * @param[in] base 分岐元のパラメタ
+	 */
+	void takeOverState(const Parameter& base);
+
 	/**
 	 * すべてのパラメタを出力する
 	 * @param[in] out 出力先
@@ -159,6 +215,9 @@ private:
 	// 保存用
 	std::vector<std::pair<std::shared_ptr<core::Strategy>, int>> s_strategyList;
 
+	// 使われている戦略
+	std::shared_ptr<core::StrategyPool> strategyPool;
+
 	// 初期化パラメタ
 	std::shared_ptr<InitParameter> initParam;
 
@@ -179,6 +238,12 @@ private:
 
 	// コア数
 	int core;
+
+	// 空間を分岐するステップ
+	int forkStep;
+
+	// 分岐した空間の設定ファイル名とパラメタ
+	std::vector<std::pair<std::string, std::shared_ptr<Parameter>>> forks;
 };
 
 } /* namespace core */
@@ -0,0 +1,158 @@
+/**
+ * PhiloxEngine.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef PHILOXENGINE_HPP_
+#define PHILOXENGINE_HPP_
+
+#include <cstdint>
+
+namespace spd {
+namespace param {
+
+/**
+ * カウンタベースの乱数生成エンジン(Philox4x32-10)
+ *
+ * @par
+ * 内部状態を持ち回らず、鍵とカウンタから乱数を直接計算する。<br>
+ * 同じ鍵とカウンタからは常に同じ乱数列が得られるため、
+ * スレッドごとに生成しても、スレッド数によらず結果が一致する。<br>
+ * 標準ライブラリの乱数分布に渡せるよう、UniformRandomBitGenerator の要件を満たす。
+ */
+class PhiloxEngine {
+public:
+
+	/**
+	 * 生成する乱数の型
+	 */
+	typedef std::uint64_t result_type;
+
+	/**
+	 * コンストラクタ
+	 * @param[in] key 鍵
+	 * @param[in] counter1 カウンタの2ワード目
+	 * @param[in] counter2 カウンタの3ワード目
+	 * @param[in] counter3 カウンタの4ワード目
+	 * @note カウンタの1ワード目は、ストリーム内の位置として使用する
+	 */
+	PhiloxEngine(std::uint64_t key,
+			std::uint32_t counter1, std::uint32_t counter2, std::uint32_t counter3) :
+		key{static_cast<std::uint32_t>(key), static_cast<std::uint32_t>(key >> 32)},
+		counter{0, counter1, counter2, counter3},
+		block{0, 0, 0, 0}, used(BLOCK_SIZE) {
+	};
+
+	/**
+	 * 生成する乱数の最小値
+	 * @return 最小値
+	 */
+	static constexpr result_type min() {
+		return 0;
+	};
+
+	/**
+	 * 生成する乱数の最大値
+	 * @return 最大値
+	 */
+	static constexpr result_type max() {
+		return ~static_cast<result_type>(0);
+	};
+
+	/**
+	 * 乱数を生成する
+	 * @return 64bit の一様乱数
+	 */
+	result_type operator()() {
+		if (used >= BLOCK_SIZE) {
+			generateBlock();
+		}
+		result_type result = (static_cast<result_type>(block[used]) << 32) | block[used + 1];
+		used += 2;
+		return result;
+	};
+
+	/**
+	 * 乱数を読み飛ばす
+	 * @note カウンタを進めるだけなので、読み飛ばす数によらず定数時間で終わる
+	 * @param[in] num 読み飛ばす乱数の数
+	 */
+	void discard(unsigned long long num) {
+		unsigned long long rest = (BLOCK_SIZE - used) / 2;
+		if (num < rest) {
+			used += 2 * num;
+			return;
+		}
+		num -= rest;
+		counter[0] += static_cast<std::uint32_t>(num / (BLOCK_SIZE / 2));
+		used = BLOCK_SIZE;
+		if (num % (BLOCK_SIZE / 2) != 0) {
+			generateBlock();
+			used = 2 * (num % (BLOCK_SIZE / 2));
+		}
+	};
+
+private:
+
+	/**
+	 * 1ブロック(1回の暗号化)で得られる32bit値の数
+	 */
+	static constexpr int BLOCK_SIZE = 4;
+
+	/**
+	 * 現在のカウンタを暗号化し、カウンタを進める
+	 */
+	void generateBlock() {
+		std::uint32_t c[4] = {counter[0], counter[1], counter[2], counter[3]};
+		std::uint32_t k[2] = {key[0], key[1]};
+
+		for (int round = 0; round < 10; ++round) {
+			std::uint64_t product0 = static_cast<std::uint64_t>(0xD2511F53) * c[0];
+			std::uint64_t product1 = static_cast<std::uint64_t>(0xCD9E8D57) * c[2];
+			std::uint32_t next[4] = {
+					static_cast<std::uint32_t>(product1 >> 32) ^ c[1] ^ k[0],
+					static_cast<std::uint32_t>(product1),
+					static_cast<std::uint32_t>(product0 >> 32) ^ c[3] ^ k[1],
+					static_cast<std::uint32_t>(product0)};
+			c[0] = next[0];
+			c[1] = next[1];
+			c[2] = next[2];
+			c[3] = next[3];
+			k[0] += 0x9E3779B9;
+			k[1] += 0xBB67AE85;
+		}
+
+		block[0] = c[0];
+		block[1] = c[1];
+		block[2] = c[2];
+		block[3] = c[3];
+		used = 0;
+		++counter[0];
+	};
+
+	/**
+	 * 鍵
+	 */
+	std::uint32_t key[2];
+
+	/**
+	 * カウンタ
+	 */
+	std::uint32_t counter[4];
+
+	/**
+	 * 暗号化したブロック
+	 */
+	std::uint32_t block[BLOCK_SIZE];
+
+	/**
+	 * ブロック内で使用済みの32bit値の数
+	 */
+	int used;
+};
+
+} /* namespace param */
+} /* namespace spd */
+#endif /* PHILOXENGINE_HPP_ */
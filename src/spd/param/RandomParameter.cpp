@@ -7,19 +7,60 @@
 
 #include "RandomParameter.hpp"
 
+#include <sstream>
+#include <stdexcept>
+
 namespace spd {
 namespace param {
 
 /*
  * デフォルトコンストラクタ
  */
-RandomParameter::RandomParameter() : discardNum(0), generatedNum(0) {
+RandomParameter::RandomParameter() : discardNum(0), generatedNum(0), sim(0) {
 
 	std::random_device rd;
 	this->seed = rd();
 	this->engine = std::mt19937_64(seed);
 }
 
+/*
+ * 生成エンジンの内部状態を文字列で取得
+ */
+std::string RandomParameter::getEngineState() const {
+
+	std::ostringstream oss;
+	oss << engine;
+	return oss.str();
+}
+
+/*
+ * 生成エンジンの内部状態を文字列から復元
+ * @param[in] state 内部状態
+ */
+void RandomParameter::setEngineState(const std::string& state) {
+
+	std::istringstream iss(state);
+	std::mt19937_64 restored;
+	iss >> restored;
+	if (iss.fail()) {
+		throw std::invalid_argument("Could not restore the random number generator's state.");
+	}
+	engine = restored;
+}
+
+/*
+ * 分岐元の乱数の状態を引き継ぐ
+ * @param[in] base 分岐元の乱数パラメタ
+ */
+void RandomParameter::takeOver(const RandomParameter& base) {
+
+	sim = base.sim;
+	generatedNum = base.generatedNum.load();
+	if (seed == base.seed) {
+		engine = base.engine;
+	}
+}
+
 void RandomParameter::showParameter(std::ostream& out) const {
 
 	out << "seed = " << seed << "\n";
@@ -8,12 +8,33 @@
 #ifndef RANDOMPARAMETER_H_
 #define RANDOMPARAMETER_H_
 
+#include <atomic>
+#include <cstdint>
 #include <random>
+#include <string>
 #include "IShowParameter.hpp"
+#include "PhiloxEngine.hpp"
 
 namespace spd {
 namespace param {
 
+/**
+ * 乱数の用途
+ * @note 用途ごとに異なる乱数列を使用する
+ */
+enum class RandomPurpose : std::uint32_t {
+	INITIAL_STRATEGY, /**< 初期戦略の割り当て */
+	INITIAL_ACTION, /**< 初期行動の割り当て */
+	ACTION_ADJUST, /**< 近傍数と戦略の長さの調整 */
+	UPDATE_ORDER, /**< 非同期更新での色の順番 */
+	EVENT, /**< 連続時間での事象の時刻と選択 */
+	MUTATION, /**< 戦略の突然変異 */
+	REWIRE, /**< 接続の張り替え */
+	DAMAGE, /**< 自己修復を調べるための損傷 */
+	TOPOLOGY, /**< ランダムグラフの接続 */
+	GENERATED_RULE, /**< ルールの記述から生成したカーネル */
+};
+
 /**
  * 乱数に関わるパラメタを表すクラス
  */
@@ -34,6 +55,38 @@ public:
 		return engine;
 	}
 
+	/**
+	 * 乱数の種・シミュレーション回数・ステップ・プレイヤ・用途から決まる乱数列を取得
+	 * @note 生成エンジンの状態を変更しないので、複数のスレッドから同時に呼び出せる
+	 * @param[in] step ステップ数
+	 * @param[in] playerId プレイヤID
+	 * @param[in] purpose 乱数の用途
+	 * @return 乱数列の生成エンジン
+	 */
+	PhiloxEngine getStream(int step, int playerId, RandomPurpose purpose) const {
+		return PhiloxEngine(
+				(static_cast<std::uint64_t>(sim) << 32) | seed,
+				static_cast<std::uint32_t>(playerId),
+				static_cast<std::uint32_t>(step),
+				static_cast<std::uint32_t>(purpose));
+	}
+
+	/**
+	 * 現在のシミュレーション回数を設定
+	 * @param[in] sim シミュレーション回数
+	 */
+	void setSim(int sim) {
+		this->sim = sim;
+	}
+
+	/**
+	 * 分岐元の乱数の状態(シミュレーション回数と生成した乱数の数)を引き継ぐ
+	 *
+	 * 種が同じ場合は、生成エンジンも同じ位置から続ける
+	 * @param[in] base 分岐元の乱数パラメタ
+	 */
+	void takeOver(const RandomParameter& base);
+
 	/**
 	 * 初期で切り捨てる乱数の数を取得
 	 * @return 生成した乱数の数
@@ -60,12 +113,27 @@ public:
 
 	/**
 	 * シミュレーション中で作成した乱数の数を加える
+	 * @note 複数のスレッドから同時に呼び出せる
 	 * @param[in] generated 新たに生成した乱数の数
 	 */
 	void addGenerated(unsigned long long generated) {
 		this->generatedNum += generated;
 	}
 
+	/**
+	 * 生成エンジンの内部状態を文字列で取得
+	 * @return 生成エンジンの内部状態
+	 */
+	std::string getEngineState() const;
+
+	/**
+	 * 生成エンジンの内部状態を文字列から復元
+	 * @note 生成した乱数の数だけ読み飛ばす必要がないため、定数時間で復元できる
+	 * @param[in] state getEngineState で取得した内部状態
+	 * @throw std::invalid_argument 内部状態として読み込めない場合
+	 */
+	void setEngineState(const std::string& state);
+
 	/**
 	 * 乱数の種を取得
 	 * @return 乱数の種
@@ -100,7 +168,12 @@ private:
 	unsigned long long discardNum;
 
 	// シミュレーション中に生成された数
-	unsigned long long generatedNum;
+	std::atomic<unsigned long long> generatedNum;
+
+	/**
+	 * 現在のシミュレーション回数
+	 */
+	int sim;
 
 	/**
 	 * 生成エンジン
@@ -7,6 +7,8 @@
 
 #include "RuntimeParameter.hpp"
 
+#include <stdexcept>
+
 namespace spd {
 namespace param {
 
@@ -16,8 +18,28 @@ namespace param {
 RuntimeParameter::RuntimeParameter() :
 		strategyUpdateCycle(DEFAULT_STRATEGY_UPDATE_CYCLE),
 		selfInteraction(DEFAULT_SELF_INTERACTION) ,
+		asynchronous(DEFAULT_ASYNCHRONOUS),
+		farFieldTolerance(DEFAULT_FAR_FIELD_TOLERANCE),
+		eventRate(DEFAULT_EVENT_RATE),
+		mutationRate(DEFAULT_MUTATION_RATE),
+		rewireRate(DEFAULT_REWIRE_RATE),
+		damageType(DEFAULT_DAMAGE_TYPE),
+		damageSize(DEFAULT_DAMAGE_SIZE),
+		damageInterval(DEFAULT_DAMAGE_INTERVAL),
+		hashLife(DEFAULT_HASH_LIFE),
+		preview(DEFAULT_PREVIEW),
 		s_strategyUpdateCycle(DEFAULT_STRATEGY_UPDATE_CYCLE),
-		s_selfInteraction(DEFAULT_SELF_INTERACTION) {
+		s_selfInteraction(DEFAULT_SELF_INTERACTION),
+		s_asynchronous(DEFAULT_ASYNCHRONOUS),
+		s_farFieldTolerance(DEFAULT_FAR_FIELD_TOLERANCE),
+		s_eventRate(DEFAULT_EVENT_RATE),
+		s_mutationRate(DEFAULT_MUTATION_RATE),
+		s_rewireRate(DEFAULT_REWIRE_RATE),
+		s_damageType(DEFAULT_DAMAGE_TYPE),
+		s_damageSize(DEFAULT_DAMAGE_SIZE),
+		s_damageInterval(DEFAULT_DAMAGE_INTERVAL),
+		s_hashLife(DEFAULT_HASH_LIFE),
+		s_preview(DEFAULT_PREVIEW) {
 
 	payoffMatrix[static_cast<int>(Action::ACTION_C)][static_cast<int>(Action::ACTION_C)] = DEFAULT_R_VALUE;
 	payoffMatrix[static_cast<int>(Action::ACTION_C)][static_cast<int>(Action::ACTION_D)] = DEFAULT_S_VALUE;
@@ -39,6 +61,8 @@ void RuntimeParameter::store() {
 	s_strategyUpdateCycle = strategyUpdateCycle;
 	// 自己対戦
 	s_selfInteraction = selfInteraction;
+	// 非同期に更新する
+	s_asynchronous = asynchronous;
 	// 利得行列
 	s_payoffMatrix[static_cast<int>(Action::ACTION_C)][static_cast<int>(Action::ACTION_C)] =
 			payoffMatrix[static_cast<int>(Action::ACTION_C)][static_cast<int>(Action::ACTION_C)];
@@ -48,6 +72,22 @@ void RuntimeParameter::store() {
 			payoffMatrix[static_cast<int>(Action::ACTION_D)][static_cast<int>(Action::ACTION_C)];
 	s_payoffMatrix[static_cast<int>(Action::ACTION_D)][static_cast<int>(Action::ACTION_D)] =
 			payoffMatrix[static_cast<int>(Action::ACTION_D)][static_cast<int>(Action::ACTION_D)];
+	// 遠方近似の許容誤差
+	s_farFieldTolerance = farFieldTolerance;
+	// 連続時間の事象率
+	s_eventRate = eventRate;
+	// 突然変異率
+	s_mutationRate = mutationRate;
+	// 接続の張り替え率
+	s_rewireRate = rewireRate;
+	// 損傷
+	s_damageType = damageType;
+	s_damageSize = damageSize;
+	s_damageInterval = damageInterval;
+	// 記憶した区画の時間発展で進める
+	s_hashLife = hashLife;
+	// 平均場近似で予測する
+	s_preview = preview;
 
 }
 
@@ -60,6 +100,8 @@ void RuntimeParameter::restore() {
 	strategyUpdateCycle = s_strategyUpdateCycle;
 	// 自己対戦
 	selfInteraction = s_selfInteraction;
+	// 非同期に更新する
+	asynchronous = s_asynchronous;
 	// 利得行列
 	payoffMatrix[static_cast<int>(Action::ACTION_C)][static_cast<int>(Action::ACTION_C)] =
 			s_payoffMatrix[static_cast<int>(Action::ACTION_C)][static_cast<int>(Action::ACTION_C)];
@@ -69,6 +111,22 @@ void RuntimeParameter::restore() {
 			s_payoffMatrix[static_cast<int>(Action::ACTION_D)][static_cast<int>(Action::ACTION_C)];
 	payoffMatrix[static_cast<int>(Action::ACTION_D)][static_cast<int>(Action::ACTION_D)] =
 			s_payoffMatrix[static_cast<int>(Action::ACTION_D)][static_cast<int>(Action::ACTION_D)];
+	// 遠方近似の許容誤差
+	farFieldTolerance = s_farFieldTolerance;
+	// 連続時間の事象率
+	eventRate = s_eventRate;
+	// 突然変異率
+	mutationRate = s_mutationRate;
+	// 接続の張り替え率
+	rewireRate = s_rewireRate;
+	// 損傷
+	damageType = s_damageType;
+	damageSize = s_damageSize;
+	damageInterval = s_damageInterval;
+	// 記憶した区画の時間発展で進める
+	hashLife = s_hashLife;
+	// 平均場近似で予測する
+	preview = s_preview;
 
 }
 
@@ -85,6 +143,11 @@ void RuntimeParameter::showParameter(std::ostream& out) const {
 		out << "# Do Not self-interaction\n";
 	}
 
+	// 非同期の場合のみ
+	if (asynchronous) {
+		out << "asynchronous = true\n";
+	}
+
 	out << "payoff-R = " <<
 			payoffMatrix[static_cast<int>(Action::ACTION_C)][static_cast<int>(Action::ACTION_C)] << "\n";
 
@@ -97,6 +160,75 @@ void RuntimeParameter::showParameter(std::ostream& out) const {
 	out << "payoff-P = " <<
 			payoffMatrix[static_cast<int>(Action::ACTION_D)][static_cast<int>(Action::ACTION_D)] << "\n";
 
+	// 近似する場合のみ
+	if (farFieldTolerance > 0) {
+		out << "far-field-tolerance = " << farFieldTolerance << "\n";
+	}
+
+	// 連続時間の場合のみ
+	if (eventRate > 0) {
+		out << "event-rate = " << eventRate << "\n";
+	}
+
+	// 突然変異する場合のみ
+	if (mutationRate > 0) {
+		out << "mutation-rate = " << mutationRate << "\n";
+	}
+
+	// 張り替える場合のみ
+	if (rewireRate > 0) {
+		out << "rewire-rate = " << rewireRate << "\n";
+	}
+
+	// 損傷を与える場合のみ
+	if (damageType != DamageType::NONE) {
+		out << "damage = " << toString(damageType) << ":" << damageSize << ":" << damageInterval << "\n";
+	}
+
+	// 記憶する場合のみ
+	if (hashLife) {
+		out << "hashlife = true\n";
+	}
+
+	// 予測する場合のみ
+	if (preview) {
+		out << "preview = true\n";
+	}
+
+}
+
+/*
+ * 損傷の種類を名前から求める
+ * @param[in] name 名前
+ * @throw std::invalid_argument 対応する種類が無い場合
+ */
+DamageType RuntimeParameter::toDamageType(const std::string& name) {
+
+	for (auto type : {DamageType::SITES, DamageType::DISC, DamageType::SWAP}) {
+		if (toString(type) == name) {
+			return type;
+		}
+	}
+	throw std::invalid_argument("Could not find a damage type " + name + ".\n"
+			"Settable damage type(s): [ sites disc swap ]");
+}
+
+/*
+ * 損傷の種類の名前を求める
+ * @param[in] damageType 損傷の種類
+ */
+std::string RuntimeParameter::toString(DamageType damageType) {
+
+	switch (damageType) {
+		case DamageType::SITES:
+			return "sites";
+		case DamageType::DISC:
+			return "disc";
+		case DamageType::SWAP:
+			return "swap";
+		default:
+			return "none";
+	}
 }
 
 } /* namespace param */
@@ -8,12 +8,24 @@
 #ifndef RUNTIMEPARAMETERETER_H_
 #define RUNTIMEPARAMETERETER_H_
 
+#include <string>
+
 #include "IShowParameter.hpp"
 #include "../core/Action.hpp"
 
 namespace spd {
 namespace param {
 
+/**
+ * 自己修復を調べるための損傷の種類
+ */
+enum class DamageType {
+	NONE, /**< 損傷を与えない */
+	SITES, /**< 一様に選んだプレイヤの行動を反転する */
+	DISC, /**< 一様に選んだ中心から近傍半径以内のプレイヤの行動を反転する */
+	SWAP, /**< 一様に選んだ2プレイヤの戦略と行動を入れ替える */
+};
+
 /**
  * 実行時に用いるパラメタを保持するクラス
  */
@@ -61,6 +73,175 @@ public:
 	}
 
 
+	/**
+	 * 非同期に更新するかどうかを取得
+	 * @return 非同期に更新するかどうか
+	 * @retval true 対応するルールは、近傍の現在の状態を読みながら、プレイヤを順に更新する
+	 * @retval false 全プレイヤを前の状態から同時に更新する
+	 */
+	bool isAsynchronous() const {
+		return asynchronous;
+	}
+
+	/**
+	 * 非同期に更新するかどうかを設定する
+	 * @param[in] asynchronous 非同期に更新するかどうか
+	 */
+	void setAsynchronous(bool asynchronous) {
+		this->asynchronous = asynchronous;
+	}
+
+	/**
+	 * 決定的な格子のシミュレーションを、記憶した区画の時間発展で進めるかどうかを取得
+	 * @return 記憶した区画の時間発展で進めるかどうか
+	 * @retval true 適用できる場合、出力ステップまでまとめて進める
+	 * @retval false 1ステップずつルールを実行する
+	 */
+	bool isHashLife() const {
+		return hashLife;
+	}
+
+	/**
+	 * 決定的な格子のシミュレーションを、記憶した区画の時間発展で進めるかどうかを設定する
+	 * @param[in] hashLife 記憶した区画の時間発展で進めるかどうか
+	 */
+	void setHashLife(bool hashLife) {
+		this->hashLife = hashLife;
+	}
+
+	/**
+	 * シミュレーションの代わりに、平均場近似で割合の時間発展を予測するかどうかを取得
+	 * @return 平均場近似で予測するかどうか
+	 */
+	bool isPreview() const {
+		return preview;
+	}
+
+	/**
+	 * シミュレーションの代わりに、平均場近似で割合の時間発展を予測するかどうかを設定する
+	 * @param[in] preview 平均場近似で予測するかどうか
+	 */
+	void setPreview(bool preview) {
+		this->preview = preview;
+	}
+
+	/**
+	 * 連続時間の事象率を取得する
+	 * @return 単位時間(1ステップ)あたりの、プレイヤごとの最大の戦略更新回数
+	 * @retval 0 ステップごとに全プレイヤを更新する場合
+	 */
+	double getEventRate() const {
+		return eventRate;
+	}
+
+	/**
+	 * 連続時間の事象率を設定する
+	 * @param[in] eventRate 単位時間あたりの最大の戦略更新回数
+	 */
+	void setEventRate(double eventRate) {
+		this->eventRate = eventRate;
+	}
+
+	/**
+	 * 突然変異率を取得する
+	 * @return 戦略更新ごとに、プレイヤの戦略の1か所の行動が反転する確率
+	 */
+	double getMutationRate() const {
+		return mutationRate;
+	}
+
+	/**
+	 * 突然変異率を設定する
+	 * @param[in] mutationRate 戦略更新ごとの突然変異の確率
+	 */
+	void setMutationRate(double mutationRate) {
+		this->mutationRate = mutationRate;
+	}
+
+	/**
+	 * 接続の張り替え率を取得する
+	 * @return 戦略更新ごとに、Dの接続相手との接続を張り替える確率
+	 */
+	double getRewireRate() const {
+		return rewireRate;
+	}
+
+	/**
+	 * 接続の張り替え率を設定する
+	 * @param[in] rewireRate 戦略更新ごとの張り替えの確率
+	 */
+	void setRewireRate(double rewireRate) {
+		this->rewireRate = rewireRate;
+	}
+
+	/**
+	 * 損傷の種類を取得する
+	 * @return 損傷の種類
+	 */
+	DamageType getDamageType() const {
+		return damageType;
+	}
+
+	/**
+	 * 損傷の大きさを取得する
+	 * @return 反転するプレイヤ数、円の半径、または入れ替える組数
+	 */
+	int getDamageSize() const {
+		return damageSize;
+	}
+
+	/**
+	 * 損傷を与える間隔を取得する
+	 * @return 損傷を与えるステップの間隔
+	 */
+	int getDamageInterval() const {
+		return damageInterval;
+	}
+
+	/**
+	 * 損傷を設定する
+	 * @param[in] damageType 損傷の種類
+	 * @param[in] damageSize 損傷の大きさ
+	 * @param[in] damageInterval 損傷を与えるステップの間隔
+	 */
+	void setDamage(DamageType damageType, int damageSize, int damageInterval) {
+		this->damageType = damageType;
+		this->damageSize = damageSize;
+		this->damageInterval = damageInterval;
+	}
+
+	/**
+	 * 損傷の種類を名前から求める
+	 * @param[in] name 名前("sites", "disc", "swap")
+	 * @return 損傷の種類
+	 * @throw std::invalid_argument 対応する種類が無い場合
+	 */
+	static DamageType toDamageType(const std::string& name);
+
+	/**
+	 * 損傷の種類の名前を求める
+	 * @param[in] damageType 損傷の種類
+	 * @return 名前
+	 */
+	static std::string toString(DamageType damageType);
+
+	/**
+	 * 遠方近似の許容誤差を取得する
+	 * @return 許容誤差(割引された対戦数の総和に対する比)
+	 * @retval 0 遠方近似をしない場合
+	 */
+	double getFarFieldTolerance() const {
+		return farFieldTolerance;
+	}
+
+	/**
+	 * 遠方近似の許容誤差を設定する
+	 * @param[in] farFieldTolerance 許容誤差
+	 */
+	void setFarFieldTolerance(double farFieldTolerance) {
+		this->farFieldTolerance = farFieldTolerance;
+	}
+
 	/**
 	 * 利得行列全てを取得する
 	 * @return 利得行列
@@ -176,11 +357,26 @@ private:
 
 	static const bool DEFAULT_SELF_INTERACTION = false;
 
+	static const bool DEFAULT_ASYNCHRONOUS = false;
+
 	static constexpr double DEFAULT_P_VALUE = 0.0;
 	static constexpr double DEFAULT_R_VALUE = 1.0;
 	static constexpr double DEFAULT_S_VALUE = 0.0;
 	static constexpr double DEFAULT_T_VALUE = 1.80001;
 
+	static constexpr double DEFAULT_FAR_FIELD_TOLERANCE = 0.0;
+
+	static constexpr double DEFAULT_EVENT_RATE = 0.0;
+	static constexpr double DEFAULT_MUTATION_RATE = 0.0;
+	static constexpr double DEFAULT_REWIRE_RATE = 0.0;
+
+	static const DamageType DEFAULT_DAMAGE_TYPE = DamageType::NONE;
+	static const int DEFAULT_DAMAGE_SIZE = 1;
+	static const int DEFAULT_DAMAGE_INTERVAL = 100;
+
+	static const bool DEFAULT_HASH_LIFE = false;
+	static const bool DEFAULT_PREVIEW = false;
+
 	// パラメタの実態
 	// 戦略更新周期
 	int strategyUpdateCycle;
@@ -188,16 +384,64 @@ private:
 	// 自己対戦を行う
 	bool selfInteraction;
 
+	// 非同期に更新する
+	bool asynchronous;
+
 	// 利得行列
 	double payoffMatrix[2][2];
 
+	// 遠方近似の許容誤差
+	double farFieldTolerance;
+
+	// 連続時間の事象率
+	double eventRate;
+
+	// 突然変異率
+	double mutationRate;
+
+	// 接続の張り替え率
+	double rewireRate;
+
+	// 損傷の種類
+	DamageType damageType;
+
+	// 損傷の大きさ
+	int damageSize;
+
+	// 損傷を与える間隔
+	int damageInterval;
+
+	// 記憶した区画の時間発展で進める
+	bool hashLife;
+
+	// 平均場近似で予測する
+	bool preview;
+
 	// パラメタのストア値
 	// 戦略更新周期
 	int s_strategyUpdateCycle;
 	// 自己対戦
 	bool s_selfInteraction;
+	// 非同期に更新する
+	bool s_asynchronous;
 	// 利得行列
 	double s_payoffMatrix[2][2];
+	// 遠方近似の許容誤差
+	double s_farFieldTolerance;
+	// 連続時間の事象率
+	double s_eventRate;
+	// 突然変異率
+	double s_mutationRate;
+	// 接続の張り替え率
+	double s_rewireRate;
+	// 損傷
+	DamageType s_damageType;
+	int s_damageSize;
+	int s_damageInterval;
+	// 記憶した区画の時間発展で進める
+	bool s_hashLife;
+	// 平均場近似で予測する
+	bool s_preview;
 
 };
 
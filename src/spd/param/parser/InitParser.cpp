@@ -46,6 +46,12 @@ InitParser::InitParser(const std::shared_ptr<InitParameter>& initParam) : ip(ini
 		for (auto rule : ruleMap) {
 			ruleDescription += "\t-- " + rule.first + "\n";
 		}
+		ruleDescription += "Or compose a rule from components as "
+				"BEFORE+BEFORE+...|AFTER+... (e.g. simple_action+sum_game+store|best_strategy), "
+				"where the components run in order. The components are:\n";
+		for (auto& component : generator->getComponentNames()) {
+			ruleDescription += "\t-- " + component + "\n";
+		}
 		ruleDescription += "Note this option is case-insensitive.";
 
 	options->add_options()
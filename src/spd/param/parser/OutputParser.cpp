@@ -102,6 +102,7 @@ void OutputParser::parse(
 				}
 			}
 			this->op->getOutputs() = outputs;
+			this->op->setOutputSettings(outputsString);
 		}
 
 		auto directory = vm["dir"].as<std::string>();
@@ -10,6 +10,7 @@
 #include <iostream>
 #include <vector>
 #include <cmath>
+#include <fstream>
 #include <boost/program_options.hpp>
 
 #include "ParseParam.hpp"
@@ -24,6 +25,9 @@
 
 #include "../Parameter.hpp"
 #include "../NeighborhoodParameter.hpp"
+#include "../InitParameter.hpp"
+#include "../OutputParameter.hpp"
+#include "../RuntimeParameter.hpp"
 
 #include "../../core/Strategy.hpp"
 #include "../../core/maker/CommandLineBasedMaker.hpp"
@@ -45,29 +49,8 @@ namespace parser {
 
 void ParseParam::parse(int argc, char* argv[], Parameter& param) const {
 
-	// 一般的なオプションの生成
-	auto generalOpt = po::options_description("General options",
-			LINE_LENGTH, MIN_DESCRIPTION_LENGTH);
-
-	generalOpt.add_options()
-		("config", 	po::value<std::string>(), 	"Loading the configurations from the specified file."
-				" But, an option is overridden by command line.")
-		("state", 		po::value<std::string>(), 	"Loading the states of all players from the specified"
-				" gexf or mpac file or these gziped file.")
-		("core", 		po::value<int>()->default_value(param.getCore()),
-														"Thread count for this simulation.")
-		("help,h", 									"Output a brief help message.");
-
-	// 戦略用のオプション
-	auto strategyOpt = po::options_description("Strategy",
-			LINE_LENGTH, MIN_DESCRIPTION_LENGTH);
-
-	strategyOpt.add_options()
-		("strategy,s", po::value<std::vector<std::string>>(),
-				"Interaction strategies. To also set an initial ratio of the strategy, input a colon,"
-				" followed by a number.\n"
-				"The both patterns below are recognized.\n\t"
-				"-s c6D3:2 -s ddddDDd3 d9.\nNote this option is case-insensitive and default option.");
+	// 一般的なオプションと戦略用のオプション
+	auto generalOpt = makeGeneralOptions(param);
 
 	po::positional_options_description p;
 	p.add("strategy", -1);
@@ -80,8 +63,7 @@ void ParseParam::parse(int argc, char* argv[], Parameter& param) const {
 	RandomParser randomP(param.getRandomParameter());
 
 	// オプションの結合
-	generalOpt.add(strategyOpt)
-		.add(*(initP.getOptions().get()))
+	generalOpt.add(*(initP.getOptions().get()))
 		.add(*(runtimeP.getOptions().get()))
 		.add(*(neiP.getOptions().get()))
 		.add(*(outputP.getOptions().get()))
@@ -166,6 +148,16 @@ void ParseParam::parse(int argc, char* argv[], Parameter& param) const {
 				param.addStrategy(strategyPair);
 			}
 		}
+
+		// 分岐した空間の設定
+		param.setForkStep(std::abs(vm["fork-step"].as<int>()));
+		if (vm.count("fork")) {
+			for (auto& configFile : vm["fork"].as<std::vector<std::string>>()) {
+				auto forked = param.fork();
+				parseFork(configFile, param, *forked);
+				param.addFork(configFile, forked);
+			}
+		}
 	} catch (const po::required_option& e) {
 		std::cerr << e.what() << " from option: " << e.get_option_name() << std::endl;
 		exit(EXIT_FAILURE);
@@ -182,6 +174,100 @@ void ParseParam::parse(int argc, char* argv[], Parameter& param) const {
 	}
 }
 
+/*
+ * 一般的なオプションと戦略のオプションを作成する
+ * @param[in] param 既定値を取るパラメタ
+ */
+po::options_description ParseParam::makeGeneralOptions(const Parameter& param) const {
+
+	// 一般的なオプションの生成
+	auto generalOpt = po::options_description("General options",
+			LINE_LENGTH, MIN_DESCRIPTION_LENGTH);
+	generalOpt.add_options()
+		("config", 	po::value<std::string>(), 	"Loading the configurations from the specified file."
+				" But, an option is overridden by command line.")
+		("state", 		po::value<std::string>(), 	"Loading the states of all players from the specified"
+				" gexf or mpac file or these gziped file.")
+		("core", 		po::value<int>()->default_value(param.getCore()),
+														"Thread count for this simulation.")
+		("fork", 		po::value<std::vector<std::string>>(),
+				"At the fork step, branch the simulation into spaces running concurrently, one for each"
+				" specified configuration file. A file is written like that of the config option, and"
+				" overrides the changeable values, the rule and the outputs (set another dir)."
+				" The branched spaces share the topology and start from the states of the players.")
+		("fork-step", 	po::value<int>()->default_value(param.getForkStep()),
+				"Step to branch the simulation with the fork option.")
+		("help,h", 									"Output a brief help message.");
+
+	// 戦略用のオプション
+	auto strategyOpt = po::options_description("Strategy",
+			LINE_LENGTH, MIN_DESCRIPTION_LENGTH);
+	strategyOpt.add_options()
+		("strategy,s", po::value<std::vector<std::string>>(),
+				"Interaction strategies. To also set an initial ratio of the strategy, input a colon,"
+				" followed by a number.\n"
+				"The both patterns below are recognized.\n\t"
+				"-s c6D3:2 -s ddddDDd3 d9.\nNote this option is case-insensitive and default option.");
+
+	generalOpt.add(strategyOpt);
+	return generalOpt;
+}
+
+/*
+ * 分岐先の設定ファイルから、分岐先のパラメタの解析を行う
+ *
+ * 解析器は分岐先のパラメタの値を既定値とするので、設定ファイルに無い値は分岐元の値のままになる
+ */
+void ParseParam::parseFork(const std::string& configFile, const Parameter& base, Parameter& forked) const {
+
+	if (!std::ifstream(configFile)) {
+		throw std::invalid_argument("Could not open a fork configuration file (" + configFile + ").");
+	}
+
+	// 設定ファイルだけを指定したコマンドライン
+	std::string programName = "fork";
+	std::string configOption = "--config=" + configFile;
+	char* argv[] = {&programName[0], &configOption[0]};
+	int argc = 2;
+
+	auto generalOpt = makeGeneralOptions(forked);
+	InitParser initP(forked.getInitialParameter());
+	RuntimeParser runtimeP(forked.getRuntimeParameter());
+	NeighborParser neiP(forked.getNeighborhoodParameter());
+	OutputParser outputP(forked.getOutputParameter());
+	RandomParser randomP(forked.getRandomParameter());
+	generalOpt.add(*(initP.getOptions().get()))
+		.add(*(runtimeP.getOptions().get()))
+		.add(*(neiP.getOptions().get()))
+		.add(*(outputP.getOptions().get()))
+		.add(*(randomP.getOptions().get()));
+
+	po::variables_map vm;
+	po::store(po::command_line_parser(argc, argv).options(generalOpt).run(), vm);
+	std::ifstream ifs(configFile);
+	po::store(po::parse_config_file(ifs, generalOpt), vm);
+	forked.setCore(vm["core"].as<int>());
+
+	// 近傍用パラメタは分岐元と共有しているので、解析しない
+	initP.parse(argc, argv, generalOpt);
+	runtimeP.parse(argc, argv, generalOpt);
+	outputP.parse(argc, argv, generalOpt);
+	randomP.parse(argc, argv, generalOpt);
+
+	if (forked.getInitialParameter()->getPlayerNum() != base.getInitialParameter()->getPlayerNum()) {
+		throw std::invalid_argument("Could not change the player-unit in a fork configuration ("
+				+ configFile + ").");
+	}
+	if (forked.getOutputParameter()->getDirectory() == base.getOutputParameter()->getDirectory()) {
+		throw std::invalid_argument("Please set another dir in a fork configuration ("
+				+ configFile + ").");
+	}
+	if (forked.getRuntimeParameter()->getRewireRate() > 0) {
+		throw std::invalid_argument("Could not rewire links in a fork, which shares the topology ("
+				+ configFile + ").");
+	}
+}
+
 /*
  * コマンドラインの戦略引数から戦略と割合のペアを作る
  * @param strategyOptValue コマンドラインの戦略引数の値
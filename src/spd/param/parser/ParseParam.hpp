@@ -12,6 +12,8 @@
 #include <string>
 #include <memory>
 
+#include <boost/program_options.hpp>
+
 namespace spd {
 namespace core {
 class Strategy;
@@ -37,6 +39,25 @@ public:
 
 private:
 
+	/**
+	 * 一般的なオプションと戦略のオプションを作成する
+	 * @param[in] param 既定値を取るパラメタ
+	 * @return オプション説明
+	 */
+	boost::program_options::options_description makeGeneralOptions(const Parameter& param) const;
+
+	/**
+	 * 分岐先の設定ファイルから、分岐先のパラメタの解析を行う
+	 *
+	 * 設定ファイルに無い値は分岐元の値のままとする。
+	 * 空間構造と戦略は分岐元から引き継ぐので、それらの設定は読み飛ばす。
+	 * @param[in] configFile 分岐先の設定ファイル名
+	 * @param[in] base 分岐元のパラメタ
+	 * @param[in, out] forked 分岐先のパラメタ(Parameter::fork で複製したもの)
+	 * @throw std::invalid_argument 設定ファイルが開けない場合や、分岐先で変えられない値を変えた場合
+	 */
+	void parseFork(const std::string& configFile, const Parameter& base, Parameter& forked) const;
+
 	/**
 	 * コマンドラインの戦略引数から戦略と割合のペアを作る
 	 * @param[in] strategyOptValue コマンドラインの戦略引数の値
@@ -7,6 +7,7 @@
 
 #include <stdexcept>
 #include <fstream>
+#include <iostream>
 #include "Option.hpp"
 #include "RandomParser.hpp"
 #include "../RandomParameter.hpp"
@@ -9,6 +9,7 @@
 #include <cmath>
 #include <vector>
 #include <fstream>
+#include <iostream>
 #include "../../core/Action.hpp"
 #include "Option.hpp"
 #include "RuntimeParser.hpp"
@@ -33,6 +34,8 @@ RuntimeParser::RuntimeParser(const std::shared_ptr<RuntimeParameter>& runtimePar
 		("strategy-update-cycle,c", po::value<int>()->default_value(rp->getStrategyUpdateCycle()),
 				"Player updates own strategy after every interval steps.")
 		("self-interaction,i", "Do a self-interaction.")
+		("asynchronous", "Update actions asynchronously: players read the current actions of "
+				"their neighbors, in a random order of colors where no two players of a color are neighbors.")
 		("payoff-R,R",
 				po::value<double>()->default_value(rp->getPayoff(Action::ACTION_C, Action::ACTION_C)),
 				"Reward for mutual cooperation.")
@@ -44,7 +47,37 @@ RuntimeParser::RuntimeParser(const std::shared_ptr<RuntimeParameter>& runtimePar
 				"Temptation to defect.")
 		("payoff-P,P",
 				po::value<double>()->default_value(rp->getPayoff(Action::ACTION_D, Action::ACTION_D)),
-				"Punishment for mutual defection.");
+				"Punishment for mutual defection.")
+		("far-field-tolerance",
+				po::value<double>()->default_value(rp->getFarFieldTolerance()),
+				"Approximate far rings of a discounted game within this relative error. "
+				"Zero means an exact game.")
+		("event-rate",
+				po::value<double>()->default_value(rp->getEventRate()),
+				"Simulate in continuous time: each player revises its strategy at a Poisson rate of "
+				"this value times its scaled payoff gap to the best neighbor, per step. "
+				"Zero means updating all players every step.")
+		("mutation-rate",
+				po::value<double>()->default_value(rp->getMutationRate()),
+				"Probability that a player's strategy flips the action at one random position "
+				"after each strategy update, with a rule including the mutation component.")
+		("rewire-rate",
+				po::value<double>()->default_value(rp->getRewireRate()),
+				"Probability that a cooperator cuts its link to a random defecting neighbor and links to "
+				"a neighbor of that defector after each strategy update, "
+				"with a rule including the rewire component on a network.")
+		("damage", po::value<std::string>(),
+				"Inject a damage every interval steps to study self-repair, with a rule including "
+				"the repair component: type[:size[:interval]]. "
+				"The type is sites (flip the actions of size random players), "
+				"disc (flip the actions within the radius size of a random player) "
+				"or swap (swap the strategies and actions of size random pairs). "
+				"Default size - 1, interval - 100.")
+		("hashlife", "Jump to the next output step by memoizing block evolutions (Hashlife), "
+				"when the rules are deterministic on a lattice whose side is a power of two. "
+				"Otherwise players are updated every step.")
+		("preview", "Instead of simulating, write the mean-field prediction of the strategy and action "
+				"fractions in the format of the number output, to preview a payoff sweep.");
 
 }
 
@@ -79,6 +112,18 @@ void RuntimeParser::parse(
 			this->rp->setSelfInteraction(true);
 		}
 
+		if (vm.count("asynchronous")) {
+			this->rp->setAsynchronous(true);
+		}
+
+		if (vm.count("hashlife")) {
+			this->rp->setHashLife(true);
+		}
+
+		if (vm.count("preview")) {
+			this->rp->setPreview(true);
+		}
+
 		this->rp->setStrategyUpdateCycle(std::abs(vm["strategy-update-cycle"].as<int>()));
 
 		this->rp->setPayoffR(vm["payoff-R"].as<double>());
@@ -86,6 +131,53 @@ void RuntimeParser::parse(
 		this->rp->setPayoffT(vm["payoff-T"].as<double>());
 		this->rp->setPayoffP(vm["payoff-P"].as<double>());
 
+		double tolerance = vm["far-field-tolerance"].as<double>();
+		if (tolerance < 0) {
+			throw std::invalid_argument("Could not set a minus far-field tolerance.");
+		}
+		this->rp->setFarFieldTolerance(tolerance);
+
+		double eventRate = vm["event-rate"].as<double>();
+		if (eventRate < 0) {
+			throw std::invalid_argument("Could not set a minus event rate.");
+		}
+		this->rp->setEventRate(eventRate);
+
+		double mutationRate = vm["mutation-rate"].as<double>();
+		if ((mutationRate < 0) || (mutationRate > 1)) {
+			throw std::invalid_argument("Could not set a mutation rate outside [0, 1].");
+		}
+		this->rp->setMutationRate(mutationRate);
+
+		double rewireRate = vm["rewire-rate"].as<double>();
+		if ((rewireRate < 0) || (rewireRate > 1)) {
+			throw std::invalid_argument("Could not set a rewire rate outside [0, 1].");
+		}
+		this->rp->setRewireRate(rewireRate);
+
+		if (vm.count("damage")) {
+			// 種類[:大きさ[:間隔]]
+			auto damage = vm["damage"].as<std::string>();
+			std::vector<std::string> values;
+			std::string::size_type from = 0;
+			for (auto colonPos = damage.find(':'); colonPos != std::string::npos;
+					colonPos = damage.find(':', from)) {
+				values.push_back(damage.substr(from, colonPos - from));
+				from = colonPos + 1;
+			}
+			values.push_back(damage.substr(from));
+
+			auto type = RuntimeParameter::toDamageType(values.at(0));
+			int size = ((values.size() > 1) && !values.at(1).empty()) ?
+					std::stoi(values.at(1)) : rp->getDamageSize();
+			int interval = ((values.size() > 2) && !values.at(2).empty()) ?
+					std::stoi(values.at(2)) : rp->getDamageInterval();
+			if ((size < 1) || (interval < 1)) {
+				throw std::invalid_argument("Could not set a damage size or interval less than 1.");
+			}
+			this->rp->setDamage(type, size, interval);
+		}
+
 	} catch (const boost::program_options::multiple_occurrences& e) {
 		std::cerr << e.what() << " from option: " << e.get_option_name() << std::endl;
 		throw std::exception();
@@ -22,11 +22,16 @@
 
 // 戦略ルール
 #include "strategy/BestStrategyRule.hpp"
+#include "strategy/MutationRule.hpp"
+#include "strategy/RewireRule.hpp"
 
 // プロパティ
 #include "property/MembraneDetectRule.hpp"
 #include "property/AffectedPlayerRule.hpp"
 
+// 自己修復
+#include "selfRepair/RepairRule.hpp"
+
 // TODO テストルール
 #include "property/PropertyTest.hpp"
 
@@ -0,0 +1,60 @@
+/**
+ * DegreeDispatch.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef DEGREEDISPATCH_HPP_
+#define DEGREEDISPATCH_HPP_
+
+#include <utility>
+
+namespace spd {
+namespace rule {
+
+/**
+ * 全プレイヤで共通の近傍数に応じて、近傍数をコンパイル時定数としたカーネルを選ぶ
+ *
+ * @par
+ * 近傍数が空間構造から決まる場合(Ring: 2r, Neumann: 2r(r+1), Hexagon: 3r(r+1),
+ * NeumannCube: 6, 24, 正則ネットワークなど)は、その近傍数で特殊化した kernel.runDegree<N> を呼ぶ。<br>
+ * それ以外は kernel.runDegree<0> (プレイヤごとに近傍数を読む)を呼ぶ。
+ * @param[in] degree 全プレイヤで共通の近傍数(異なる場合は -1)
+ * @param[in, out] kernel カーネル
+ * @param[in] args カーネルの引数
+ */
+template <class Kernel, class... Args>
+inline void dispatchDegree(int degree, Kernel& kernel, Args&&... args) {
+
+	switch (degree) {
+		case 2:
+			kernel.template runDegree<2>(std::forward<Args>(args)...);
+			break;
+		case 4:
+			kernel.template runDegree<4>(std::forward<Args>(args)...);
+			break;
+		case 6:
+			kernel.template runDegree<6>(std::forward<Args>(args)...);
+			break;
+		case 8:
+			kernel.template runDegree<8>(std::forward<Args>(args)...);
+			break;
+		case 12:
+			kernel.template runDegree<12>(std::forward<Args>(args)...);
+			break;
+		case 18:
+			kernel.template runDegree<18>(std::forward<Args>(args)...);
+			break;
+		case 24:
+			kernel.template runDegree<24>(std::forward<Args>(args)...);
+			break;
+		default:
+			kernel.template runDegree<0>(std::forward<Args>(args)...);
+			break;
+	}
+}
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* DEGREEDISPATCH_HPP_ */
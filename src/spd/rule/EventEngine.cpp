@@ -0,0 +1,249 @@
+/**
+ * EventEngine.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "EventEngine.hpp"
+
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "../core/Action.hpp"
+#include "../core/Player.hpp"
+#include "../core/Strategy.hpp"
+#include "../core/StrategyPool.hpp"
+#include "../param/Parameter.hpp"
+#include "../param/RuntimeParameter.hpp"
+
+namespace spd {
+namespace rule {
+
+/*
+ * コンストラクタ
+ * @param[in] allPlayers 全てのプレイヤ
+ * @param[in] param パラメタ
+ */
+EventEngine::EventEngine(const spd::core::AllPlayer& allPlayers, const spd::param::Parameter& param)
+	: allPlayers(allPlayers), param(param), payoffRange(0), selfInteraction(false), eventRate(0),
+	  eventNum(0) {
+}
+
+/*
+ * 近傍をまとめ、現在の行動から利得と率を求める
+ */
+void EventEngine::initialize() {
+
+	for (int type = 0; type < NeighborhoodType::TYPE_NUM; ++type) {
+		if (!tables[type].build(allPlayers, static_cast<NeighborhoodType>(type))) {
+			throw std::runtime_error("The event-driven simulation requires players holding their neighbors.");
+		}
+		readers[type] = tables[type].reverse();
+	}
+
+	auto& runtime = param.getRuntimeParameter();
+	const Action actions[] = {Action::ACTION_C, Action::ACTION_D};
+	double minPayoff = runtime->getPayoff(Action::ACTION_C, Action::ACTION_C);
+	double maxPayoff = minPayoff;
+	for (int own = 0; own < 2; ++own) {
+		for (int opponent = 0; opponent < 2; ++opponent) {
+			payoffMatrix[own][opponent] = runtime->getPayoff(actions[own], actions[opponent]);
+			minPayoff = std::min(minPayoff, payoffMatrix[own][opponent]);
+			maxPayoff = std::max(maxPayoff, payoffMatrix[own][opponent]);
+		}
+	}
+	payoffRange = maxPayoff - minPayoff;
+	selfInteraction = runtime->isSelfInteraction();
+	eventRate = runtime->getEventRate();
+
+	int playerNum = allPlayers.size();
+	for (auto& player : allPlayers) {
+		if (player->getAction() == Action::ACTION_UN) {
+			// 未定義の行動があった場合終了
+			throw std::runtime_error("The player's action is undefined.");
+		}
+	}
+
+	scores.resize(playerNum);
+	for (int id = 0; id < playerNum; ++id) {
+		scores[id] = computeScore(id);
+	}
+
+	rates.reset(playerNum);
+	for (int id = 0; id < playerNum; ++id) {
+		rates.set(id, computeRate(id));
+	}
+	rates.rebuild();
+
+	marks.assign(playerNum, -1);
+	eventNum = 0;
+}
+
+/*
+ * 時刻 step から step + 1 までの事象を実行し、利得をプレイヤに設定する
+ *
+ * 待ち時間は指数分布なので、区間を超えた事象は捨てて次の区間で引き直してよい。
+ * ステップごとの乱数列なので、区間の境界で出力しても結果は変わらない。
+ */
+void EventEngine::advance(int step) {
+
+	auto engine = param.getRandomParameter()->getStream(
+			step, 0, spd::param::RandomPurpose::EVENT);
+
+	int playerNum = allPlayers.size();
+	double time = 0.0;
+	while (rates.getTotal() > 0) {
+		double total = rates.getTotal();
+		time += std::exponential_distribution<double>(total)(engine);
+		if (time >= 1.0) {
+			break;
+		}
+
+		int id = rates.find(std::uniform_real_distribution<double>(0.0, total)(engine));
+		fire(id, engine);
+
+		// 差分の丸め誤差が積もらないように、プレイヤ数の事象ごとに木を作り直す
+		if (++eventNum % playerNum == 0) {
+			rates.rebuild();
+		}
+	}
+
+	for (auto& player : allPlayers) {
+		player->setScore(scores[player->getId()]);
+		player->storePreviousStates();
+	}
+}
+
+/*
+ * 戦略を更新し、行動を決め直す
+ *
+ * 戦略は決定的最大値戦略更新と同じく、利得が同じなら自身の戦略を維持し、
+ * そうでなければ走査順で先の近傍の戦略とする。
+ */
+void EventEngine::fire(int id, spd::param::PhiloxEngine& engine) {
+
+	auto& player = allPlayers[id];
+	int ownStrategyId = player->getStrategy()->getId();
+
+	// 最大値は自身ので初期化
+	double maxScore = scores[id];
+	int maxStrategyId = ownStrategyId;
+	auto& strategyTable = tables[NeighborhoodType::STRATEGY];
+	for (const int* it = strategyTable.begin(id), *last = strategyTable.end(id); it != last; ++it) {
+		int opponentStrategyId = allPlayers[*it]->getStrategy()->getId();
+		if (maxScore < scores[*it]) {
+			maxStrategyId = opponentStrategyId;
+			maxScore = scores[*it];
+		} else if ((maxScore == scores[*it]) && (ownStrategyId == opponentStrategyId)) {
+			// 利得が同じなら、戦略を維持する
+			maxStrategyId = opponentStrategyId;
+		}
+	}
+	if (maxStrategyId != ownStrategyId) {
+		player->setStrategy(param.getStrategyPool()->at(maxStrategyId));
+	}
+
+	// 近傍の現在の行動から、Dの数で行動を決め直す
+	auto& actionTable = tables[NeighborhoodType::ACTION];
+	int dMax = actionTable.getCount(id);
+	int playersDNum = 0;
+	for (const int* it = actionTable.begin(id), *last = actionTable.end(id); it != last; ++it) {
+		if (allPlayers[*it]->getAction() == Action::ACTION_D) {
+			++playersDNum;
+		}
+	}
+
+	// dの最大値+1 と、戦略の長さが異なる場合は調整
+	int length = player->getStrategy()->getLength();
+	if ((dMax + 1) != length) {
+		auto key = std::make_pair(dMax, length);
+		auto table = lengthTables.find(key);
+		if (table == lengthTables.end()) {
+			table = lengthTables.insert(std::make_pair(key, StrategyLengthTable(dMax, length))).first;
+		}
+		playersDNum = table->second.sample(playersDNum, engine());
+	}
+
+	Action action = player->getStrategy()->actionAt(playersDNum);
+	if (action == player->getAction()) {
+		// 利得は変わらない
+		return;
+	}
+	player->setAction(action);
+
+	// 利得が変わるのは、自身と、自身を対戦近傍に持つプレイヤ
+	affected.clear();
+	scores[id] = computeScore(id);
+	markAffected(id);
+	auto& gameReaders = readers[NeighborhoodType::GAME];
+	for (const int* it = gameReaders.begin(id), *last = gameReaders.end(id); it != last; ++it) {
+		scores[*it] = computeScore(*it);
+		markAffected(*it);
+	}
+
+	// 率が変わるのは、利得が変わったプレイヤと、それを戦略更新近傍に持つプレイヤ
+	auto& strategyReaders = readers[NeighborhoodType::STRATEGY];
+	for (int index = 0, changedNum = affected.size(); index < changedNum; ++index) {
+		int changed = affected[index];
+		for (const int* it = strategyReaders.begin(changed), *last = strategyReaders.end(changed);
+				it != last; ++it) {
+			markAffected(*it);
+		}
+	}
+	for (int target : affected) {
+		rates.set(target, computeRate(target));
+	}
+}
+
+/*
+ * 現在の行動から利得を計算する
+ */
+double EventEngine::computeScore(int id) const {
+
+	auto ownAction = static_cast<int>(allPlayers[id]->getAction());
+	const double* payoffRow = payoffMatrix[ownAction];
+
+	double payoffSum = selfInteraction ? payoffRow[ownAction] : 0.0;
+	auto& gameTable = tables[NeighborhoodType::GAME];
+	for (const int* it = gameTable.begin(id), *last = gameTable.end(id); it != last; ++it) {
+		payoffSum += payoffRow[static_cast<int>(allPlayers[*it]->getAction())];
+	}
+	return payoffSum;
+}
+
+/*
+ * 現在の利得から率を計算する
+ *
+ * 利得の差を、取りうる利得の差の最大値で割り、事象率を上限とする
+ */
+double EventEngine::computeRate(int id) const {
+
+	int gameNum = tables[NeighborhoodType::GAME].getCount(id) + (selfInteraction ? 1 : 0);
+	if ((gameNum == 0) || !(payoffRange > 0)) {
+		return 0.0;
+	}
+
+	double maxScore = scores[id];
+	auto& strategyTable = tables[NeighborhoodType::STRATEGY];
+	for (const int* it = strategyTable.begin(id), *last = strategyTable.end(id); it != last; ++it) {
+		maxScore = std::max(maxScore, scores[*it]);
+	}
+
+	return eventRate * std::min(1.0, (maxScore - scores[id]) / (payoffRange * gameNum));
+}
+
+/*
+ * 率を計算し直すプレイヤとして印を付ける
+ */
+inline void EventEngine::markAffected(int id) {
+
+	if (marks[id] != eventNum) {
+		marks[id] = eventNum;
+		affected.push_back(id);
+	}
+}
+
+} /* namespace rule */
+} /* namespace spd */
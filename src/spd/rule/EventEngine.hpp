@@ -0,0 +1,178 @@
+/**
+ * EventEngine.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef EVENTENGINE_HPP_
+#define EVENTENGINE_HPP_
+
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "NeighborTable.hpp"
+#include "action/StrategyLengthTable.hpp"
+#include "../core/FenwickTree.hpp"
+#include "../core/OriginalType.hpp"
+#include "../core/NeighborhoodType.hpp"
+#include "../param/RandomParameter.hpp"
+
+namespace spd {
+namespace param {
+	class Parameter;
+}
+namespace rule {
+
+/**
+ * 連続時間で戦略を更新する、事象駆動(Gillespie 法)のシミュレーション
+ *
+ * @par
+ * 各プレイヤは、戦略更新近傍の最大利得と自身の利得の差に比例する率(Poisson 過程)で戦略を更新する。<br>
+ * 率 = 事象率 × max(0, 近傍の最大利得 - 自身の利得) / (利得行列の幅 × 対戦数)
+ * であり、事象率は単位時間(1ステップ)あたりの最大更新回数となる。<br>
+ * 更新では、決定的最大値戦略更新と同じく最大利得の近傍の戦略を選び、
+ * 近傍の現在の行動から Dの数に従って自身の行動を決め直す。<br>
+ * 利得は現在の行動どうしの合計対戦利得である。
+ *
+ * @par
+ * 率は Fenwick 木に保持し、事象の選択と率の変更を O(log N) で行う。<br>
+ * 行動が変わった場合は、そのプレイヤを対戦近傍に持つプレイヤの利得と、
+ * 利得が変わったプレイヤを戦略更新近傍に持つプレイヤの率だけを計算し直す。
+ *
+ * @note ルールは使わないため、解析ルールによるプロパティは更新されない
+ */
+class EventEngine {
+public:
+
+	/**
+	 * コンストラクタ
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 */
+	EventEngine(const spd::core::AllPlayer& allPlayers, const spd::param::Parameter& param);
+
+	/**
+	 * 近傍をまとめ、現在の行動から利得と率を求める
+	 * @throw std::runtime_error プレイヤが近傍を保持していない場合
+	 */
+	void initialize();
+
+	/**
+	 * 時刻 step から step + 1 までの事象を実行し、利得をプレイヤに設定する
+	 * @param[in] step 開始時刻(ステップ)
+	 */
+	void advance(int step);
+
+	/**
+	 * 実行した事象の数を取得
+	 * @return 事象の数
+	 */
+	long long getEventNum() const {
+		return eventNum;
+	};
+
+private:
+
+	/**
+	 * 戦略を更新し、行動を決め直す
+	 * @param[in] id 更新するプレイヤの位置座標
+	 * @param[in, out] engine 乱数生成エンジン
+	 */
+	void fire(int id, spd::param::PhiloxEngine& engine);
+
+	/**
+	 * 現在の行動から利得を計算する
+	 * @param[in] id プレイヤの位置座標
+	 * @return 合計対戦利得
+	 */
+	double computeScore(int id) const;
+
+	/**
+	 * 現在の利得から率を計算する
+	 * @param[in] id プレイヤの位置座標
+	 * @return 戦略更新の率
+	 */
+	double computeRate(int id) const;
+
+	/**
+	 * 率を計算し直すプレイヤとして印を付ける
+	 * @param[in] id プレイヤの位置座標
+	 */
+	void markAffected(int id);
+
+	/**
+	 * 全てのプレイヤ
+	 */
+	const spd::core::AllPlayer& allPlayers;
+
+	/**
+	 * パラメタ
+	 */
+	const spd::param::Parameter& param;
+
+	/**
+	 * 近傍の種類ごとの近傍の表
+	 */
+	NeighborTable tables[NeighborhoodType::TYPE_NUM];
+
+	/**
+	 * 近傍の種類ごとの、自身を近傍に持つプレイヤの表
+	 */
+	NeighborTable readers[NeighborhoodType::TYPE_NUM];
+
+	/**
+	 * 利得行列
+	 */
+	double payoffMatrix[2][2];
+
+	/**
+	 * 利得行列の幅(最大値 - 最小値)
+	 */
+	double payoffRange;
+
+	/**
+	 * 自己対戦をするかどうか
+	 */
+	bool selfInteraction;
+
+	/**
+	 * 単位時間あたりの最大更新回数
+	 */
+	double eventRate;
+
+	/**
+	 * プレイヤごとの現在の利得
+	 */
+	std::vector<double> scores;
+
+	/**
+	 * プレイヤごとの戦略更新の率
+	 */
+	spd::core::FenwickTree rates;
+
+	/**
+	 * 率を計算し直すプレイヤ
+	 */
+	std::vector<int> affected;
+
+	/**
+	 * 率を計算し直すプレイヤの印(事象の番号)
+	 */
+	std::vector<long long> marks;
+
+	/**
+	 * 実行した事象の数
+	 */
+	long long eventNum;
+
+	/**
+	 * (近傍プレイヤ数, 戦略の長さ) ごとの、戦略の長さへの調整表
+	 */
+	std::map<std::pair<int, int>, StrategyLengthTable> lengthTables;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* EVENTENGINE_HPP_ */
@@ -0,0 +1,197 @@
+/**
+ * FusedPipeline.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef FUSEDPIPELINE_HPP_
+#define FUSEDPIPELINE_HPP_
+
+#include <memory>
+#include <vector>
+
+#include "StepPipeline.hpp"
+#include "NeighborTable.hpp"
+#include "DegreeDispatch.hpp"
+#include "PromoteStateRule.hpp"
+#include "action/SimpleActionRule.hpp"
+#include "../core/Player.hpp"
+#include "../param/Parameter.hpp"
+#include "../param/RuntimeParameter.hpp"
+
+namespace spd {
+namespace rule {
+
+/**
+ * 行動更新、近傍との対戦、状態の保存の組み合わせを、対戦ルールと近傍数で特殊化して実行するクラス
+ *
+ * @par
+ * 組み込みのルールの多くは、前処理が SimpleActionRule, 総和または平均の対戦, PromoteStateRule の順になっている。<br>
+ * 対戦はプレイヤ自身の利得と状態しか書き換えず、近傍の現在の行動しか読まないので、
+ * 対戦と状態の保存は同じプレイヤに続けて行っても結果は変わらない。<br>
+ * そこで、行動更新の後の2つのルールを、プレイヤの範囲ごとに1回の走査にまとめ、ワーカの待ち合わせを1回減らす。<br>
+ * 対戦の走査は、対戦ルールの型と全プレイヤで共通の近傍数(空間構造と近傍半径から決まる)を
+ * コンパイル時定数としたカーネルで行い、仮想呼び出しを含まない。
+ * @par
+ * 次の場合は何もせず、SpdRule がルールごとに実行する。
+ * - 非同期更新の場合
+ * - 行動近傍または対戦近傍の表が無い場合
+ * @par
+ * 対戦ルールが箱型近傍で集計した場合は、対戦と状態の保存をルールごとに実行する。
+ * @tparam GameRule 対戦ルール(SimpleSumGameRule または AverageGameRule)
+ * @tparam AVERAGED 利得を対戦数で割るかどうか
+ */
+template <class GameRule, bool AVERAGED>
+class FusedPipeline : public StepPipeline {
+public:
+
+	/**
+	 * コンストラクタ
+	 * @param[in] action 行動更新ルール
+	 * @param[in] game 対戦ルール
+	 * @param[in] store 状態を進めるルール
+	 */
+	FusedPipeline(
+			const std::shared_ptr<SimpleActionRule>& action,
+			const std::shared_ptr<GameRule>& game,
+			const std::shared_ptr<PromoteStateRule>& store) :
+				action(action), game(game), store(store) {};
+
+	/**
+	 * まとめて実行する、前処理ルールの先頭の個数
+	 * @return 3
+	 */
+	int getRuleNum() const {
+		return 3;
+	};
+
+	/**
+	 * 前処理ルールの先頭が、まとめて実行するルールと同じかどうか
+	 * @param[in] rules 前処理ルール
+	 * @return 同じインスタンスが同じ順に並んでいる場合 true
+	 */
+	bool covers(const std::vector<std::shared_ptr<Rule>>& rules) const {
+		return (rules.size() >= 3) && (rules[0] == action) && (rules[1] == game) && (rules[2] == store);
+	};
+
+	/**
+	 * 行動近傍と対戦近傍の表を使う
+	 * @param[in] type 近傍の種類
+	 * @return 行動近傍または対戦近傍の場合 true
+	 */
+	bool usesNeighborTable(NeighborhoodType type) const {
+		return (type == NeighborhoodType::ACTION) || (type == NeighborhoodType::GAME);
+	};
+
+	/**
+	 * 行動更新の後、対戦と状態の保存をプレイヤの範囲ごとにまとめて実行する
+	 * @param[in] context 解決済みの情報
+	 * @param[in] workers 共有のワーカ
+	 * @return 実行した場合 true
+	 */
+	bool run(const RuleContext& context, const WorkerPool& workers) {
+
+		auto actionTable = context.neighborTables[NeighborhoodType::ACTION];
+		auto gameTable = context.neighborTables[NeighborhoodType::GAME];
+		if (context.param.getRuntimeParameter()->isAsynchronous() ||
+				(actionTable == nullptr) || (gameTable == nullptr)) {
+			return false;
+		}
+
+		auto& allPlayers = context.allPlayers;
+		int playerNum = allPlayers.size();
+
+		// 行動更新(近傍数の特殊化はルール自身が選ぶ)
+		action->prepare(allPlayers, context.param, context.step);
+		workers.run(playerNum,
+				[&](int worker, int from, int to) {
+			action->runRange(from, to, context);
+		});
+
+		// 対戦ルールが集計した場合は、ルールごとに実行
+		game->prepare(allPlayers, context.param, context.step);
+		if (game->isCounted()) {
+			workers.run(playerNum,
+					[&](int worker, int from, int to) {
+				game->runRange(from, to, context);
+			});
+			store->prepare(allPlayers, context.param, context.step);
+			workers.run(playerNum,
+					[&](int worker, int from, int to) {
+				store->runRange(from, to, context);
+			});
+			return true;
+		}
+
+		// 対戦と状態の保存をまとめる
+		workers.run(playerNum,
+				[&](int worker, int from, int to) {
+			dispatchDegree(gameTable->getUniformCount(), *this, from, to, context, *gameTable);
+		});
+		return true;
+	};
+
+	/**
+	 * 近傍数を固定して、プレイヤ位置座標の範囲に対戦と状態の保存を行う
+	 * @note dispatchDegree から呼ばれる。加算の順番は対戦ルールの runRange と同じ
+	 * @param[in] begin 開始プレイヤ位置座標
+	 * @param[in] end 終了プレイヤ位置座標(これを含まない)
+	 * @param[in] context 解決済みの情報
+	 * @param[in] table 対戦近傍の表
+	 * @tparam DEGREE 全プレイヤで共通の近傍数(0 の場合はプレイヤごとに読む)
+	 */
+	template <int DEGREE>
+	void runDegree(int begin, int end, const RuleContext& context, const NeighborTable& table) const {
+
+		auto& allPlayers = context.allPlayers;
+		for (int id = begin; id < end; ++id) {
+			auto& player = allPlayers[id];
+
+			// 自身の利得行
+			const double* payoffRow = context.payoffMatrix[static_cast<int>(player->getAction())];
+
+			double payoffSum = 0.0;
+			int opponentNum = 0;
+
+			// 自己対戦(近傍半径0は自身)
+			if (context.selfInteraction) {
+				payoffSum += payoffRow[static_cast<int>(player->getAction())];
+				++opponentNum;
+			}
+
+			// 近傍対戦
+			int count = (DEGREE > 0) ? DEGREE : table.getCount(id);
+			const int* neighbors = table.begin(id);
+			for (int k = 0; k < count; ++k) {
+				payoffSum += payoffRow[static_cast<int>(allPlayers[neighbors[k]]->getAction())];
+			}
+			opponentNum += count;
+
+			// 利得を加え、状態を進める
+			player->addScore(AVERAGED ? payoffSum / opponentNum : payoffSum);
+			player->storePreviousStates();
+		}
+	};
+
+private:
+
+	/**
+	 * 行動更新ルール
+	 */
+	std::shared_ptr<SimpleActionRule> action;
+
+	/**
+	 * 対戦ルール
+	 */
+	std::shared_ptr<GameRule> game;
+
+	/**
+	 * 状態を進めるルール
+	 */
+	std::shared_ptr<PromoteStateRule> store;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* FUSEDPIPELINE_HPP_ */
@@ -0,0 +1,38 @@
+/**
+ * GlobalRule.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "GlobalRule.hpp"
+
+#include "NeighborTable.hpp"
+#include "../core/Player.hpp"
+#include "../param/Parameter.hpp"
+
+namespace spd {
+namespace rule {
+
+/*
+ * プレイヤごとの更新ルール
+ *
+ * 先頭プレイヤの時だけ、近傍の表なしの情報で空間全体に対する更新ルールを実行する
+ */
+void GlobalRule::runRule(
+		const std::shared_ptr<Player>& player,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step) {
+
+	if (player->getId() != 0) {
+		return;
+	}
+
+	const NeighborTable* const tables[NeighborhoodType::TYPE_NUM] = {};
+	RuleContext context(allPlayers, param, step, tables);
+	runGlobal(context, WorkerPool(param.getCore()));
+}
+
+} /* namespace rule */
+} /* namespace spd */
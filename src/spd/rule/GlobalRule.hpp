@@ -0,0 +1,67 @@
+/**
+ * GlobalRule.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef GLOBALRULE_HPP_
+#define GLOBALRULE_HPP_
+
+#include "Rule.hpp"
+#include "RuleContext.hpp"
+#include "WorkerPool.hpp"
+
+namespace spd {
+namespace rule {
+
+/**
+ * 全プレイヤ(空間全体)を一度に扱うルールを表す抽象クラス
+ *
+ * @par
+ * SpdRule はこのルールをプレイヤごとに呼ばず、実行ごとに一度だけ runGlobal を呼ぶ。<br>
+ * 並列化は、渡されたワーカで自ら行う。
+ */
+class GlobalRule : public Rule {
+public:
+
+	/**
+	 * デストラクタ
+	 */
+	virtual ~GlobalRule(){};
+
+	/**
+	 * 空間全体に対する更新ルール
+	 * @param[in] context 解決済みの情報
+	 * @param[in] workers 共有のワーカ
+	 */
+	virtual void runGlobal(const RuleContext& context, const WorkerPool& workers) = 0;
+
+	/**
+	 * プレイヤごとの更新ルール
+	 *
+	 * 先頭プレイヤの時だけ、空間全体に対する更新ルールを実行する
+	 * @note SpdRule からは呼ばれない
+	 * @param[in, out] player 対象プレイヤ
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @param[in] step 実行ステップ
+	 */
+	void runRule(
+		const std::shared_ptr<Player>& player,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step);
+
+	/**
+	 * 空間全体を扱うルール
+	 * @return this
+	 */
+	GlobalRule* asGlobalRule() {
+		return this;
+	};
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* GLOBALRULE_HPP_ */
@@ -0,0 +1,145 @@
+/**
+ * GraphColoring.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "GraphColoring.hpp"
+
+#include <algorithm>
+
+namespace spd {
+namespace rule {
+
+/*
+ * 色を塗り、色ごとにプレイヤをまとめる
+ * @param[in] table 近傍の表
+ * @param[in] colors 空間構造が座標から塗った色
+ */
+void GraphColoring::build(const NeighborTable& table, const std::vector<int>& colors) {
+
+	clear();
+
+	int playerNum = table.getPlayerNum();
+	if ((static_cast<int>(colors.size()) == playerNum) && isProper(table, colors)) {
+		playerColors = colors;
+	} else {
+		playerColors = colorGreedily(table);
+	}
+
+	// 色ごとに数えてから、位置座標の小さいプレイヤから順に詰める
+	int colorNum = playerColors.empty() ? 0 :
+			*std::max_element(playerColors.begin(), playerColors.end()) + 1;
+	offsets.assign(colorNum + 1, 0);
+	for (int color : playerColors) {
+		offsets[color + 1]++;
+	}
+	for (int color = 0; color < colorNum; ++color) {
+		offsets[color + 1] += offsets[color];
+	}
+
+	std::vector<int> filled(offsets.begin(), offsets.end() - 1);
+	ids.resize(playerNum);
+	for (int id = 0; id < playerNum; ++id) {
+		ids[filled[playerColors[id]]++] = id;
+	}
+
+	// 使われない色は詰める
+	int used = 0;
+	for (int color = 0; color < colorNum; ++color) {
+		if (offsets[color + 1] != offsets[color]) {
+			offsets[++used] = offsets[color + 1];
+		}
+	}
+	offsets.resize(used + 1);
+
+	built = true;
+}
+
+/*
+ * 指定したプレイヤの近傍に、同じ色のプレイヤがいないかどうか
+ *
+ * 編集で増えた近傍は、近傍が変わったプレイヤの行にしか現れない。
+ */
+bool GraphColoring::isProperAt(const NeighborTable& table, const std::vector<int>& changed) const {
+
+	if (!built || (static_cast<int>(playerColors.size()) != table.getPlayerNum())) {
+		return false;
+	}
+	for (int id : changed) {
+		for (const int* it = table.begin(id), *last = table.end(id); it != last; ++it) {
+			if ((*it != id) && (playerColors[*it] == playerColors[id])) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/*
+ * まとめた色を破棄する
+ */
+void GraphColoring::clear() {
+
+	built = false;
+	offsets.clear();
+	ids.clear();
+	playerColors.clear();
+}
+
+/*
+ * 近傍と同じ色のプレイヤがいないかどうか
+ *
+ * 近傍が回り込んで自身となる場合は、自身の状態を読むだけなので許す。
+ */
+bool GraphColoring::isProper(const NeighborTable& table, const std::vector<int>& colors) {
+
+	for (int id = 0, playerNum = table.getPlayerNum(); id < playerNum; ++id) {
+		for (const int* it = table.begin(id), *last = table.end(id); it != last; ++it) {
+			if ((*it != id) && (colors[*it] == colors[id])) {
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+/*
+ * 近傍と、自身を近傍に持つプレイヤに無い、最小の色を順に塗る
+ */
+std::vector<int> GraphColoring::colorGreedily(const NeighborTable& table) {
+
+	int playerNum = table.getPlayerNum();
+	NeighborTable readers = table.reverse();
+
+	std::vector<int> colors(playerNum, -1);
+	// 色ごとに、最後に使えないとしたプレイヤ
+	std::vector<int> forbidden;
+
+	for (int id = 0; id < playerNum; ++id) {
+		auto forbid = [&](int other) {
+			if ((other != id) && (colors[other] >= 0)) {
+				forbidden[colors[other]] = id;
+			}
+		};
+		forbidden.resize(table.getCount(id) + readers.getCount(id) + 1, -1);
+		for (const int* it = table.begin(id), *last = table.end(id); it != last; ++it) {
+			forbid(*it);
+		}
+		for (const int* it = readers.begin(id), *last = readers.end(id); it != last; ++it) {
+			forbid(*it);
+		}
+
+		int color = 0;
+		while (forbidden[color] == id) {
+			++color;
+		}
+		colors[id] = color;
+	}
+
+	return colors;
+}
+
+} /* namespace rule */
+} /* namespace spd */
@@ -0,0 +1,126 @@
+/**
+ * GraphColoring.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef GRAPHCOLORING_HPP_
+#define GRAPHCOLORING_HPP_
+
+#include <vector>
+
+#include "NeighborTable.hpp"
+
+namespace spd {
+namespace rule {
+
+/**
+ * 互いに近傍でないプレイヤを同じ色に分けた、色ごとのプレイヤ位置座標の表
+ *
+ * @par
+ * 同じ色のプレイヤは互いの状態を読まないので、並列に更新しても
+ * 任意の順番で一人ずつ更新した場合と同じ結果になる。<br>
+ * 空間構造が座標から色を塗れる場合はその色を使い、塗れない場合や
+ * 近傍と矛盾する場合は、近傍の表から貪欲に塗る。
+ */
+class GraphColoring {
+public:
+
+	/**
+	 * 色を塗り、色ごとにプレイヤをまとめる
+	 * @param[in] table 近傍の表
+	 * @param[in] colors 空間構造が座標から塗った色(塗れない場合は空)
+	 */
+	void build(const NeighborTable& table, const std::vector<int>& colors);
+
+	/**
+	 * 指定したプレイヤの近傍に、同じ色のプレイヤがいないかどうか
+	 *
+	 * 構造の編集で近傍が変わったプレイヤだけを調べれば、塗った色を使い続けられるか分かる
+	 * @param[in] table 編集後の近傍の表
+	 * @param[in] changed 近傍が変わったプレイヤ位置座標
+	 * @return 同じ色のプレイヤがいないかどうか(プレイヤ数が変わっていた場合 false)
+	 */
+	bool isProperAt(const NeighborTable& table, const std::vector<int>& changed) const;
+
+	/**
+	 * まとめた色を破棄する
+	 */
+	void clear();
+
+	/**
+	 * 色をまとめたかどうか
+	 * @return まとめたかどうか
+	 */
+	bool isBuilt() const {
+		return built;
+	};
+
+	/**
+	 * 色の数
+	 * @return 色の数
+	 */
+	int getColorNum() const {
+		return offsets.empty() ? 0 : offsets.size() - 1;
+	};
+
+	/**
+	 * 色のプレイヤの先頭
+	 * @param[in] color 色
+	 * @return プレイヤ位置座標の先頭
+	 */
+	const int* begin(int color) const {
+		return ids.data() + offsets[color];
+	};
+
+	/**
+	 * 色のプレイヤ数
+	 * @param[in] color 色
+	 * @return プレイヤ数
+	 */
+	int getCount(int color) const {
+		return offsets[color + 1] - offsets[color];
+	};
+
+private:
+
+	/**
+	 * 近傍と同じ色のプレイヤがいないかどうか
+	 * @param[in] table 近傍の表
+	 * @param[in] colors プレイヤ位置座標ごとの色
+	 * @return 近傍と同じ色のプレイヤがいないかどうか
+	 */
+	static bool isProper(const NeighborTable& table, const std::vector<int>& colors);
+
+	/**
+	 * 近傍と、自身を近傍に持つプレイヤに無い、最小の色を順に塗る
+	 * @param[in] table 近傍の表
+	 * @return プレイヤ位置座標ごとの色
+	 */
+	static std::vector<int> colorGreedily(const NeighborTable& table);
+
+	/**
+	 * 色をまとめたかどうか
+	 */
+	bool built = false;
+
+	/**
+	 * 色ごとの、プレイヤ配列の開始位置(色数 + 1)
+	 */
+	std::vector<int> offsets;
+
+	/**
+	 * 色ごとに並べたプレイヤ位置座標
+	 */
+	std::vector<int> ids;
+
+	/**
+	 * プレイヤ位置座標ごとの色
+	 */
+	std::vector<int> playerColors;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* GRAPHCOLORING_HPP_ */
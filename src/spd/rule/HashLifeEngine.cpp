@@ -0,0 +1,484 @@
+/**
+ * HashLifeEngine.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "HashLifeEngine.hpp"
+
+#include <algorithm>
+#include <cstdlib>
+#include <typeinfo>
+
+#include "SpdRule.hpp"
+#include "NeighborTable.hpp"
+#include "PromoteStateRule.hpp"
+#include "action/SimpleActionRule.hpp"
+#include "game/SimpleSumGameRule.hpp"
+#include "strategy/BestStrategyRule.hpp"
+#include "../core/Action.hpp"
+#include "../core/Player.hpp"
+#include "../core/Strategy.hpp"
+#include "../param/Parameter.hpp"
+#include "../param/RuntimeParameter.hpp"
+#include "../param/NeighborhoodParameter.hpp"
+#include "../topology/BoxCounter.hpp"
+#include "../topology/lattice/Lattice.hpp"
+
+namespace spd {
+namespace rule {
+
+namespace {
+
+/**
+ * 共有する節点数の上限(超えたら進める前に破棄する)
+ */
+const std::size_t MAX_NODE_NUM = 1 << 23;
+
+/**
+ * ルールの型が一致するかどうか
+ * @param[in] rule ルール
+ * @return 型が一致するかどうか
+ */
+template <class T>
+bool isRuleOf(const std::shared_ptr<Rule>& rule) {
+	return typeid(*rule) == typeid(T);
+}
+
+}
+
+/*
+ * コンストラクタ
+ * @param[in] allPlayers 全てのプレイヤ
+ * @param[in] param パラメタ
+ */
+HashLifeEngine::HashLifeEngine(const spd::core::AllPlayer& allPlayers, const spd::param::Parameter& param)
+	: allPlayers(allPlayers), param(param), side(0), sideLevel(0), speedLevel(0), baseLevel(0),
+	  ringCounted(false), selfInteraction(false), stateNum(0) {
+}
+
+/*
+ * 適用できるかを調べ、近傍の相対位置を求める
+ *
+ * 決定的なルールの組み合わせで、辺の長さが2のべき乗の格子であり、
+ * 全プレイヤの近傍が同じ相対位置(平行移動で不変)の場合に適用できる
+ */
+bool HashLifeEngine::initialize(const SpdRule& spdRule, std::string& reason) {
+
+	auto& before = spdRule.getRulesBeforeOutput();
+	auto& after = spdRule.getRulesAfterOutput();
+	if ((before.size() != 3) || (after.size() != 1) ||
+			!isRuleOf<SimpleActionRule>(before[0]) || !isRuleOf<SimpleSumGameRule>(before[1]) ||
+			!isRuleOf<PromoteStateRule>(before[2]) || !isRuleOf<BestStrategyRule>(after[0])) {
+		reason = "the rule is not deterministic best-strategy imitation";
+		return false;
+	}
+
+	auto& runtime = param.getRuntimeParameter();
+	if ((runtime->getStrategyUpdateCycle() != 1) || runtime->isAsynchronous()) {
+		reason = "strategies are not updated synchronously every step";
+		return false;
+	}
+
+	auto lattice = std::dynamic_pointer_cast<spd::topology::Lattice>(
+			param.getNeighborhoodParameter()->getTopology());
+	if (lattice == nullptr) {
+		reason = "the topology is not a lattice";
+		return false;
+	}
+	side = lattice->getSide();
+	sideLevel = 0;
+	while ((1 << sideLevel) < side) {
+		++sideLevel;
+	}
+	if ((1 << sideLevel) != side) {
+		reason = "the side of the lattice is not a power of two";
+		return false;
+	}
+
+	// 近傍の相対位置を先頭プレイヤから求め、全プレイヤで同じか確かめる
+	int span[NeighborhoodType::TYPE_NUM] = {};
+	for (int type = 0; type < NeighborhoodType::TYPE_NUM; ++type) {
+		NeighborTable table;
+		if (!table.build(allPlayers, static_cast<NeighborhoodType>(type))) {
+			reason = "players do not hold their neighbors";
+			return false;
+		}
+
+		auto wrap = [&](int diff) {
+			diff = ((diff % side) + side) % side;
+			return (diff >= side / 2) ? diff - side : diff;
+		};
+		offsets[type].clear();
+		for (int id = 0; id < side * side; ++id) {
+			int x = id % side;
+			int y = id / side;
+			int index = 0;
+			if ((id != 0) && (table.getCount(id) * 2 != static_cast<int>(offsets[type].size()))) {
+				reason = "neighbors are not translation invariant";
+				return false;
+			}
+			for (const int* it = table.begin(id), *last = table.end(id); it != last; ++it, index += 2) {
+				int dx = wrap(*it % side - x);
+				int dy = wrap(*it / side - y);
+				if (id == 0) {
+					offsets[type].push_back(dx);
+					offsets[type].push_back(dy);
+					span[type] = std::max(span[type], std::max(std::abs(dx), std::abs(dy)));
+				} else if ((offsets[type][index] != dx) || (offsets[type][index + 1] != dy)) {
+					reason = "neighbors are not translation invariant";
+					return false;
+				}
+			}
+		}
+	}
+
+	// 戦略の長さが近傍数と異なると、乱数で調整される
+	strategies.clear();
+	int actionNum = offsets[NeighborhoodType::ACTION].size() / 2;
+	for (auto& strategy : param.getStrategyList()) {
+		if (strategy.first->getLength() != actionNum + 1) {
+			reason = "a strategy length differs from the number of action neighbors";
+			return false;
+		}
+		strategies.push_back(strategy.first);
+	}
+
+	// 1ステップで情報が伝わる距離
+	int radius = std::max(span[NeighborhoodType::STRATEGY] + span[NeighborhoodType::GAME],
+			span[NeighborhoodType::ACTION]);
+	speedLevel = 0;
+	while ((1 << speedLevel) < radius) {
+		++speedLevel;
+	}
+	baseLevel = speedLevel + 2;
+	if (baseLevel > sideLevel) {
+		reason = "the lattice is too small for the neighborhood radius";
+		return false;
+	}
+
+	const Action actions[] = {Action::ACTION_C, Action::ACTION_D};
+	for (int own = 0; own < 2; ++own) {
+		for (int opponent = 0; opponent < 2; ++opponent) {
+			payoffMatrix[own][opponent] = runtime->getPayoff(actions[own], actions[opponent]);
+		}
+	}
+	selfInteraction = runtime->isSelfInteraction();
+
+	// 対戦ルールと同じ条件で、集計による対戦かどうか
+	auto& neighborParam = param.getNeighborhoodParameter();
+	auto dCounter = neighborParam->getTopology()->createBoxCounter(allPlayers.size());
+	ringCounted = (dCounter != nullptr) &&
+			dCounter->isApplicable(neighborParam->getNeiborhoodRadius(NeighborhoodType::GAME));
+	auto& gameOffsets = offsets[NeighborhoodType::GAME];
+	gameRings.assign(span[NeighborhoodType::GAME] + 1, std::vector<int>());
+	for (int k = 0, size = gameOffsets.size(); k < size; k += 2) {
+		int ring = std::max(std::abs(gameOffsets[k]), std::abs(gameOffsets[k + 1]));
+		gameRings[ring].push_back(gameOffsets[k]);
+		gameRings[ring].push_back(gameOffsets[k + 1]);
+	}
+
+	stateNum = strategies.size() * 2;
+	nodes.clear();
+	for (int state = 0; state < stateNum; ++state) {
+		nodes.push_back(Node{-1, -1, -1, -1, 0});
+	}
+	clear();
+
+	return true;
+}
+
+/*
+ * 出力時点のプレイヤの状態から、指定したステップ数進め、プレイヤに書き戻す
+ */
+void HashLifeEngine::advance(int steps) {
+
+	if (nodes.size() > MAX_NODE_NUM) {
+		clear();
+	}
+
+	// セル状態 = 戦略ID × 2 + 行動
+	std::vector<int> cells(side * side);
+	for (auto& player : allPlayers) {
+		cells[player->getId()] =
+				player->getStrategy()->getId() * 2 + static_cast<int>(player->getAction());
+	}
+	int torus = build(cells, side, 0, 0, sideLevel);
+
+	for (int j = 30; j >= 0; --j) {
+		if (steps & (1 << j)) {
+			torus = advanceTorus(torus, j);
+		}
+	}
+	flatten(torus, cells, side, 0, 0);
+
+	// 利得は現在の行動から求め直す
+	for (auto& player : allPlayers) {
+		int id = player->getId();
+		int x = id % side;
+		int y = id / side;
+		double payoffSum = sumPayoff(cells[id] & 1, [&](int dx, int dy) {
+			return cells[((y + dy + side) % side) * side + (x + dx + side) % side] & 1;
+		});
+
+		player->setStrategy(strategies[cells[id] >> 1]);
+		player->setAction((cells[id] & 1) ? Action::ACTION_D : Action::ACTION_C);
+		player->setScore(payoffSum);
+		player->storePreviousStates();
+	}
+}
+
+/*
+ * 4つの子から節点を得る
+ */
+int HashLifeEngine::makeNode(int nw, int ne, int sw, int se) {
+
+	Node node{nw, ne, sw, se, nodes[nw].level + 1};
+	auto found = nodeIndex.find(node);
+	if (found != nodeIndex.end()) {
+		return found->second;
+	}
+
+	int index = nodes.size();
+	nodes.push_back(node);
+	nodeIndex.insert(std::make_pair(node, index));
+	return index;
+}
+
+/*
+ * 中央 2^(k-1) 四方の節点
+ */
+int HashLifeEngine::centerOf(int node) {
+
+	Node n = nodes[node];
+	return makeNode(nodes[n.nw].se, nodes[n.ne].sw, nodes[n.sw].ne, nodes[n.se].nw);
+}
+
+/*
+ * 節点の中央 2^(k-1) 四方を 2^j ステップ進める
+ *
+ * 重なり合う9つの 2^(k-1) 四方を進めてから4つに組み直し、
+ * 最大まで進める場合はもう一度進め、そうでない場合は中央を切り出す
+ */
+int HashLifeEngine::advanceNode(int node, int j) {
+
+	std::uint64_t key = (static_cast<std::uint64_t>(node) << 6) | j;
+	auto found = results.find(key);
+	if (found != results.end()) {
+		return found->second;
+	}
+
+	Node n = nodes[node];
+	int result;
+	if (n.level == baseLevel) {
+		result = stepBase(node);
+	} else {
+		Node nw = nodes[n.nw];
+		Node ne = nodes[n.ne];
+		Node sw = nodes[n.sw];
+		Node se = nodes[n.se];
+
+		// 重なり合う9つの節点
+		int parts[9] = {
+			n.nw, makeNode(nw.ne, ne.nw, nw.se, ne.sw), n.ne,
+			makeNode(nw.sw, nw.se, sw.nw, sw.ne), centerOf(node), makeNode(ne.sw, ne.se, se.nw, se.ne),
+			n.sw, makeNode(sw.ne, se.nw, sw.se, se.sw), n.se
+		};
+
+		bool full = (j == n.level - 2 - speedLevel);
+		int subJ = full ? j - 1 : j;
+		for (int& part : parts) {
+			part = advanceNode(part, subJ);
+		}
+
+		int quarters[4] = {
+			makeNode(parts[0], parts[1], parts[3], parts[4]),
+			makeNode(parts[1], parts[2], parts[4], parts[5]),
+			makeNode(parts[3], parts[4], parts[6], parts[7]),
+			makeNode(parts[4], parts[5], parts[7], parts[8])
+		};
+		for (int& quarter : quarters) {
+			quarter = full ? advanceNode(quarter, subJ) : centerOf(quarter);
+		}
+		result = makeNode(quarters[0], quarters[1], quarters[2], quarters[3]);
+	}
+
+	results.insert(std::make_pair(key, result));
+	return result;
+}
+
+/*
+ * 最下層の節点を、状態を並べて1ステップ計算する
+ *
+ * 出力時点の状態から、戦略更新(前の利得と戦略)、行動更新(前の行動)の順に行う
+ */
+int HashLifeEngine::stepBase(int node) {
+
+	int width = 1 << baseLevel;
+	int margin = width / 4;
+	std::vector<int> cells(width * width);
+	flatten(node, cells, width, 0, 0);
+
+	// 利得は、対戦近傍が配列に収まるセルだけ求める(中央の戦略更新はその範囲しか読まない)
+	int gameSpan = gameRings.size() - 1;
+	std::vector<double> scores(width * width, 0.0);
+	for (int y = gameSpan; y < width - gameSpan; ++y) {
+		for (int x = gameSpan; x < width - gameSpan; ++x) {
+			scores[y * width + x] = sumPayoff(cells[y * width + x] & 1, [&](int dx, int dy) {
+				return cells[(y + dy) * width + x + dx] & 1;
+			});
+		}
+	}
+
+	auto& strategyOffsets = offsets[NeighborhoodType::STRATEGY];
+	auto& actionOffsets = offsets[NeighborhoodType::ACTION];
+	int half = width / 2;
+	std::vector<int> nextCells(half * half);
+	for (int y = margin; y < margin + half; ++y) {
+		for (int x = margin; x < margin + half; ++x) {
+			int id = y * width + x;
+
+			// 決定的最大値戦略更新(利得が同じなら自身の戦略を維持)
+			int ownStrategyId = cells[id] >> 1;
+			double maxScore = scores[id];
+			int maxStrategyId = ownStrategyId;
+			for (int k = 0, size = strategyOffsets.size(); k < size; k += 2) {
+				int neighbor = (y + strategyOffsets[k + 1]) * width + x + strategyOffsets[k];
+				int opponentStrategyId = cells[neighbor] >> 1;
+				if (maxScore < scores[neighbor]) {
+					maxStrategyId = opponentStrategyId;
+					maxScore = scores[neighbor];
+				} else if ((maxScore == scores[neighbor]) && (ownStrategyId == opponentStrategyId)) {
+					maxStrategyId = opponentStrategyId;
+				}
+			}
+
+			// Dの数による行動更新
+			int dNum = 0;
+			for (int k = 0, size = actionOffsets.size(); k < size; k += 2) {
+				dNum += cells[(y + actionOffsets[k + 1]) * width + x + actionOffsets[k]] & 1;
+			}
+			int action = static_cast<int>(strategies[maxStrategyId]->actionAt(dNum));
+
+			nextCells[(y - margin) * half + (x - margin)] = maxStrategyId * 2 + action;
+		}
+	}
+
+	return build(nextCells, half, 0, 0, baseLevel - 1);
+}
+
+/*
+ * セル状態の配列から節点を作る
+ */
+int HashLifeEngine::build(const std::vector<int>& cells, int width, int x, int y, int level) {
+
+	if (level == 0) {
+		return cells[y * width + x];
+	}
+
+	int half = 1 << (level - 1);
+	return makeNode(
+			build(cells, width, x, y, level - 1),
+			build(cells, width, x + half, y, level - 1),
+			build(cells, width, x, y + half, level - 1),
+			build(cells, width, x + half, y + half, level - 1));
+}
+
+/*
+ * 節点をセル状態の配列に書き出す
+ */
+void HashLifeEngine::flatten(int node, std::vector<int>& cells, int width, int x, int y) const {
+
+	const Node& n = nodes[node];
+	if (n.level == 0) {
+		cells[y * width + x] = node;
+		return;
+	}
+
+	int half = 1 << (n.level - 1);
+	flatten(n.nw, cells, width, x, y);
+	flatten(n.ne, cells, width, x + half, y);
+	flatten(n.sw, cells, width, x, y + half);
+	flatten(n.se, cells, width, x + half, y + half);
+}
+
+/*
+ * 現在の行動から合計対戦利得を求める
+ */
+template <class ActionOf>
+double HashLifeEngine::sumPayoff(int ownAction, ActionOf actionOf) const {
+
+	const double* payoffRow = payoffMatrix[ownAction];
+	double payoffSum = 0.0;
+
+	if (!ringCounted) {
+		// 自己対戦
+		if (selfInteraction) {
+			payoffSum += payoffRow[ownAction];
+		}
+		// 近傍対戦
+		auto& gameOffsets = offsets[NeighborhoodType::GAME];
+		for (int k = 0, size = gameOffsets.size(); k < size; k += 2) {
+			payoffSum += payoffRow[actionOf(gameOffsets[k], gameOffsets[k + 1])];
+		}
+		return payoffSum;
+	}
+
+	// 自己対戦がないなら、半径1から
+	for (int r = selfInteraction ? 0 : 1, rMax = gameRings.size(); r < rMax; ++r) {
+		long long dNum = 0;
+		long long ringSize = 1;
+		if (r == 0) {
+			dNum = ownAction;
+		} else {
+			auto& ring = gameRings[r];
+			ringSize = ring.size() / 2;
+			for (int k = 0, size = ring.size(); k < size; k += 2) {
+				dNum += actionOf(ring[k], ring[k + 1]);
+			}
+		}
+		long long cNum = ringSize - dNum;
+		payoffSum += payoffRow[static_cast<int>(Action::ACTION_C)] * cNum
+				+ payoffRow[static_cast<int>(Action::ACTION_D)] * dNum;
+	}
+	return payoffSum;
+}
+
+/*
+ * 周期境界の空間を 2^j ステップ進める
+ *
+ * 空間全体を 2^m 四方に並べた節点を進める。<br>
+ * 結果の中央は m = 1 なら半周ずれるので四分を入れ替え、m >= 2 ならずれないので左上を切り出す
+ */
+int HashLifeEngine::advanceTorus(int torus, int j) {
+
+	int m = std::max(1, j - sideLevel + 2 + speedLevel);
+	int universe = torus;
+	for (int i = 0; i < m; ++i) {
+		universe = makeNode(universe, universe, universe, universe);
+	}
+
+	int result = advanceNode(universe, j);
+	if (m == 1) {
+		Node r = nodes[result];
+		return makeNode(r.se, r.sw, r.ne, r.nw);
+	}
+	for (int i = 1; i < m; ++i) {
+		result = nodes[result].nw;
+	}
+	return result;
+}
+
+/*
+ * 共有した節点と記憶した結果を破棄する
+ */
+void HashLifeEngine::clear() {
+
+	nodes.resize(stateNum);
+	nodeIndex.clear();
+	results.clear();
+}
+
+} /* namespace rule */
+} /* namespace spd */
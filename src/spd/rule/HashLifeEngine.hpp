@@ -0,0 +1,265 @@
+/**
+ * HashLifeEngine.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef HASHLIFEENGINE_HPP_
+#define HASHLIFEENGINE_HPP_
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../core/OriginalType.hpp"
+#include "../core/NeighborhoodType.hpp"
+
+namespace spd {
+namespace core {
+	class Strategy;
+}
+namespace param {
+	class Parameter;
+}
+namespace rule {
+
+class SpdRule;
+
+/**
+ * 決定的な格子上のシミュレーションを、四分木とハッシュによる共有(Hashlife)で進めるクラス
+ *
+ * @par
+ * 決定的最大値戦略更新・Dの数による行動更新・合計対戦を、戦略の長さが近傍数と合う
+ * 二次元格子(辺の長さが2のべき乗)で行う場合、出力時点の状態は
+ * (戦略ID, 行動) のセル状態だけで決まり、1ステップは近傍半径 R のセル・オートマトンとなる。<br>
+ * R = max(戦略更新近傍 + 対戦近傍, 行動近傍) であり、利得は状態から求め直す。
+ *
+ * @par
+ * 2^k 四方のセルを同じ内容なら同じ節点として共有し、節点ごとに
+ * 「中央 2^(k-1) 四方を 2^j ステップ進めた節点」を記憶する。<br>
+ * 一辺 S (R 以上の2のべき乗) を 1 とみなすと光速が 1 となるため、
+ * 2^k 四方の節点は最大 2^(k-2)/S ステップ進められる。<br>
+ * 周期境界の空間は同じ節点を並べた空間とみなし、中央を切り出して戻す。
+ */
+class HashLifeEngine {
+public:
+
+	/**
+	 * コンストラクタ
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 */
+	HashLifeEngine(const spd::core::AllPlayer& allPlayers, const spd::param::Parameter& param);
+
+	/**
+	 * 適用できるかを調べ、近傍の相対位置を求める
+	 * @param[in] spdRule ルール
+	 * @param[out] reason 適用できない理由
+	 * @return 適用できるかどうか
+	 */
+	bool initialize(const SpdRule& spdRule, std::string& reason);
+
+	/**
+	 * 出力時点のプレイヤの状態から、指定したステップ数進め、プレイヤに書き戻す
+	 *
+	 * 戦略・行動・利得を設定し、前の状態にも保存する
+	 * @param[in] steps 進めるステップ数
+	 */
+	void advance(int steps);
+
+private:
+
+	/**
+	 * 四分木の節点
+	 */
+	struct Node {
+		int nw;
+		int ne;
+		int sw;
+		int se;
+		int level;
+	};
+
+	/**
+	 * 節点の共有に用いるハッシュ
+	 */
+	struct NodeHash {
+		std::size_t operator()(const Node& node) const {
+			std::uint64_t hash = static_cast<std::uint32_t>(node.nw);
+			hash = hash * 0x9E3779B97F4A7C15ULL + static_cast<std::uint32_t>(node.ne);
+			hash = hash * 0x9E3779B97F4A7C15ULL + static_cast<std::uint32_t>(node.sw);
+			hash = hash * 0x9E3779B97F4A7C15ULL + static_cast<std::uint32_t>(node.se);
+			return static_cast<std::size_t>(hash ^ (hash >> 29));
+		};
+	};
+
+	/**
+	 * 節点の比較
+	 */
+	struct NodeEqual {
+		bool operator()(const Node& lhs, const Node& rhs) const {
+			return (lhs.nw == rhs.nw) && (lhs.ne == rhs.ne) && (lhs.sw == rhs.sw) && (lhs.se == rhs.se);
+		};
+	};
+
+	/**
+	 * 4つの子から節点を得る(同じ内容なら既存の節点)
+	 * @return 節点
+	 */
+	int makeNode(int nw, int ne, int sw, int se);
+
+	/**
+	 * 中央 2^(k-1) 四方の節点
+	 * @param[in] node 節点
+	 * @return 1つ下の階層の節点
+	 */
+	int centerOf(int node);
+
+	/**
+	 * 節点の中央 2^(k-1) 四方を 2^j ステップ進める
+	 * @param[in] node 節点
+	 * @param[in] j 進めるステップ数の指数
+	 * @return 1つ下の階層の節点
+	 */
+	int advanceNode(int node, int j);
+
+	/**
+	 * 最下層の節点を、状態を並べて1ステップ計算する
+	 * @param[in] node 最下層の節点
+	 * @return 1つ下の階層の節点
+	 */
+	int stepBase(int node);
+
+	/**
+	 * セル状態の配列から節点を作る
+	 * @param[in] cells セル状態(行ごと)
+	 * @param[in] width 配列の幅
+	 * @param[in] x 左端
+	 * @param[in] y 上端
+	 * @param[in] level 階層
+	 * @return 節点
+	 */
+	int build(const std::vector<int>& cells, int width, int x, int y, int level);
+
+	/**
+	 * 節点をセル状態の配列に書き出す
+	 * @param[in] node 節点
+	 * @param[out] cells セル状態(行ごと)
+	 * @param[in] width 配列の幅
+	 * @param[in] x 左端
+	 * @param[in] y 上端
+	 */
+	void flatten(int node, std::vector<int>& cells, int width, int x, int y) const;
+
+	/**
+	 * 現在の行動から合計対戦利得を求める
+	 *
+	 * 丸めまで通常の実行と一致するよう、集計による対戦ならリングごとの C と D の数から、
+	 * そうでなければ近傍の表の順に加える
+	 * @param[in] ownAction 自身の行動
+	 * @param[in] actionOf 近傍の相対位置から行動を返す関数
+	 * @return 合計対戦利得
+	 */
+	template <class ActionOf>
+	double sumPayoff(int ownAction, ActionOf actionOf) const;
+
+	/**
+	 * 周期境界の空間を 2^j ステップ進める
+	 * @param[in] torus 空間全体の節点
+	 * @param[in] j 進めるステップ数の指数
+	 * @return 空間全体の節点
+	 */
+	int advanceTorus(int torus, int j);
+
+	/**
+	 * 共有した節点と記憶した結果を破棄する
+	 */
+	void clear();
+
+	/**
+	 * 全てのプレイヤ
+	 */
+	const spd::core::AllPlayer& allPlayers;
+
+	/**
+	 * パラメタ
+	 */
+	const spd::param::Parameter& param;
+
+	/**
+	 * 辺の長さ
+	 */
+	int side;
+
+	/**
+	 * 空間全体の階層(辺の長さ = 2^sideLevel)
+	 */
+	int sideLevel;
+
+	/**
+	 * 光速を 1 とする一辺 S の指数
+	 */
+	int speedLevel;
+
+	/**
+	 * 最下層の階層(一辺 4S)
+	 */
+	int baseLevel;
+
+	/**
+	 * 近傍の種類ごとの、近傍の相対位置(x, y の順、走査順)
+	 */
+	std::vector<int> offsets[NeighborhoodType::TYPE_NUM];
+
+	/**
+	 * 対戦近傍の、リング(近傍半径)ごとの相対位置
+	 */
+	std::vector<std::vector<int>> gameRings;
+
+	/**
+	 * 対戦を箱型近傍の集計で行うかどうか
+	 */
+	bool ringCounted;
+
+	/**
+	 * 利得行列
+	 */
+	double payoffMatrix[2][2];
+
+	/**
+	 * 自己対戦をするかどうか
+	 */
+	bool selfInteraction;
+
+	/**
+	 * 戦略ID ごとの戦略
+	 */
+	std::vector<std::shared_ptr<spd::core::Strategy>> strategies;
+
+	/**
+	 * セル状態の数(戦略数 × 2)、先頭の節点はセル状態そのもの
+	 */
+	int stateNum;
+
+	/**
+	 * 節点
+	 */
+	std::vector<Node> nodes;
+
+	/**
+	 * 節点の共有表
+	 */
+	std::unordered_map<Node, int, NodeHash, NodeEqual> nodeIndex;
+
+	/**
+	 * (節点, 指数) ごとの、進めた結果
+	 */
+	std::unordered_map<std::uint64_t, int> results;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* HASHLIFEENGINE_HPP_ */
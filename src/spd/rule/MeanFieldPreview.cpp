@@ -0,0 +1,420 @@
+/**
+ * MeanFieldPreview.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "MeanFieldPreview.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+#include <map>
+#include <typeinfo>
+
+#include "SpdRule.hpp"
+#include "PromoteStateRule.hpp"
+#include "action/SimpleActionRule.hpp"
+#include "action/StrategyLengthTable.hpp"
+#include "game/RingCountingGameRule.hpp"
+#include "game/AverageGameRule.hpp"
+#include "strategy/BestStrategyRule.hpp"
+#include "../core/Action.hpp"
+#include "../core/Player.hpp"
+#include "../core/Strategy.hpp"
+#include "../param/Parameter.hpp"
+#include "../param/RuntimeParameter.hpp"
+#include "../param/NeighborhoodParameter.hpp"
+#include "../topology/Topology.hpp"
+
+namespace spd {
+namespace rule {
+
+namespace {
+
+/**
+ * 二項分布の確率
+ * @param[in] n 試行回数
+ * @param[in] p 成功確率
+ * @return 成功回数ごとの確率
+ */
+std::vector<double> binomial(int n, double p) {
+
+	std::vector<double> pmf(n + 1, 0.0);
+	if (p <= 0.0) {
+		pmf[0] = 1.0;
+		return pmf;
+	}
+	if (p >= 1.0) {
+		pmf[n] = 1.0;
+		return pmf;
+	}
+
+	double logP = std::log(p);
+	double logQ = std::log1p(-p);
+	for (int k = 0; k <= n; ++k) {
+		pmf[k] = std::exp(std::lgamma(n + 1.0) - std::lgamma(k + 1.0) - std::lgamma(n - k + 1.0)
+				+ k * logP + (n - k) * logQ);
+	}
+	return pmf;
+}
+
+}
+
+/*
+ * コンストラクタ
+ * @param[in] param パラメタ
+ */
+MeanFieldPreview::MeanFieldPreview(const spd::param::Parameter& param)
+	: param(param), averaged(false), selfInteraction(false) {
+}
+
+/*
+ * ルールと近傍数を読み、初期化したプレイヤから割合を求める
+ *
+ * 近傍数はプレイヤが保持する近傍のリングごとの平均とする
+ */
+bool MeanFieldPreview::initialize(
+		const SpdRule& spdRule,
+		const spd::core::AllPlayer& allPlayers,
+		std::string& reason) {
+
+	// 行動更新・対戦・戦略更新を1つずつ(解析ルールと状態の保存は予測に影響しない)
+	const RingCountingGameRule* gameRule = nullptr;
+	int actionRuleNum = 0;
+	for (auto& rule : spdRule.getRulesBeforeOutput()) {
+		if (typeid(*rule) == typeid(SimpleActionRule)) {
+			++actionRuleNum;
+		} else if (dynamic_cast<const RingCountingGameRule*>(rule.get()) != nullptr) {
+			if (gameRule != nullptr) {
+				reason = "more than one game rule";
+				return false;
+			}
+			gameRule = dynamic_cast<const RingCountingGameRule*>(rule.get());
+			averaged = (typeid(*rule) == typeid(AverageGameRule));
+		} else if ((typeid(*rule) != typeid(PromoteStateRule)) && !rule->isAnalysis()) {
+			reason = "an unsupported rule " + rule->toString();
+			return false;
+		}
+	}
+	auto& after = spdRule.getRulesAfterOutput();
+	if ((actionRuleNum != 1) || (gameRule == nullptr) ||
+			(after.size() != 1) || (typeid(*after.front()) != typeid(BestStrategyRule))) {
+		reason = "the rule is not action update, game and best-strategy imitation";
+		return false;
+	}
+
+	// リングごとの近傍数
+	auto& neighborParam = param.getNeighborhoodParameter();
+	int playerNum = allPlayers.size();
+	for (int type = 0; type < NeighborhoodType::TYPE_NUM; ++type) {
+		auto phase = static_cast<NeighborhoodType>(type);
+		std::vector<double> sums;
+		int counted = 0;
+		auto accumulate = [&](const spd::core::Neighbors& neighbors) {
+			sums.resize(std::max(sums.size(), neighbors->size()), 0.0);
+			for (int r = 1, rMax = neighbors->size(); r < rMax; ++r) {
+				sums[r] += neighbors->at(r)->size();
+			}
+			++counted;
+		};
+		for (auto& player : allPlayers) {
+			if (player->getNeighbors(phase) != nullptr) {
+				accumulate(player->getNeighbors(phase));
+			}
+		}
+		// 近傍を保持していない場合は先頭プレイヤの近傍だけ求める
+		if (counted == 0) {
+			accumulate(neighborParam->getTopology()->getNeighbors(
+					allPlayers, 0, neighborParam->getNeiborhoodRadius(phase)));
+		}
+		ringSizes[type].assign(sums.size(), 0);
+		for (int r = 1, rMax = sums.size(); r < rMax; ++r) {
+			ringSizes[type][r] = static_cast<int>(std::lround(sums[r] / counted));
+		}
+	}
+
+	auto& runtime = param.getRuntimeParameter();
+	selfInteraction = runtime->isSelfInteraction();
+	const Action actions[] = {Action::ACTION_C, Action::ACTION_D};
+	for (int own = 0; own < 2; ++own) {
+		for (int opponent = 0; opponent < 2; ++opponent) {
+			payoffMatrix[own][opponent] = runtime->getPayoff(actions[own], actions[opponent]);
+		}
+	}
+
+	int gameRadius = neighborParam->getNeiborhoodRadius(NeighborhoodType::GAME);
+	int ringNum = std::max<int>(ringSizes[NeighborhoodType::GAME].size(), 1);
+	ringWeights.resize(ringNum);
+	for (int r = 0; r < ringNum; ++r) {
+		ringWeights[r] = gameRule->getRingWeight(r, gameRadius);
+	}
+
+	// 戦略の長さが近傍数と異なる場合の調整表
+	int dMax = 0;
+	for (int size : ringSizes[NeighborhoodType::ACTION]) {
+		dMax += size;
+	}
+	strategies.clear();
+	lengthTables.clear();
+	for (auto& strategy : param.getStrategyList()) {
+		strategies.push_back(strategy.first);
+		int length = strategy.first->getLength();
+		lengthTables.push_back((length == dMax + 1) ?
+				nullptr : std::make_shared<StrategyLengthTable>(dMax, length));
+	}
+
+	// 初期状態の割合
+	fractions.assign(strategies.size() * 2, 0.0);
+	for (auto& player : allPlayers) {
+		if (player->getAction() == Action::ACTION_UN) {
+			reason = "a player's action is undefined";
+			return false;
+		}
+		fractions[player->getStrategy()->getId() * 2 + static_cast<int>(player->getAction())] += 1.0 / playerNum;
+	}
+
+	return true;
+}
+
+/*
+ * ステップ step の出力時点から、次の出力時点まで進める
+ *
+ * 出力後に戦略を更新し(開始直後と戦略更新周期以外は行わない)、
+ * 出力前に、更新した戦略と前の行動から行動を更新する
+ */
+void MeanFieldPreview::advance(int step) {
+
+	int strategyNum = strategies.size();
+
+	double dRatio = 0.0;
+	for (int strategyId = 0; strategyId < strategyNum; ++strategyId) {
+		dRatio += fractions[strategyId * 2 + static_cast<int>(Action::ACTION_D)];
+	}
+
+	std::vector<double> strategyFractions(strategyNum, 0.0);
+	if ((step != 0) && (step % param.getRuntimeParameter()->getStrategyUpdateCycle() == 0)) {
+		strategyFractions = imitate(dRatio);
+	} else {
+		for (int strategyId = 0; strategyId < strategyNum; ++strategyId) {
+			strategyFractions[strategyId] = fractions[strategyId * 2] + fractions[strategyId * 2 + 1];
+		}
+	}
+
+	for (int strategyId = 0; strategyId < strategyNum; ++strategyId) {
+		double defect = defectProbability(strategyId, dRatio);
+		fractions[strategyId * 2 + static_cast<int>(Action::ACTION_C)] = strategyFractions[strategyId] * (1.0 - defect);
+		fractions[strategyId * 2 + static_cast<int>(Action::ACTION_D)] = strategyFractions[strategyId] * defect;
+	}
+}
+
+/*
+ * 割合を NumberOutput と同じ形式で出力する
+ */
+void MeanFieldPreview::write(std::ostream& out, int step) const {
+
+	// 丸め誤差による負の値や -0 を、0 として出力する
+	auto printable = [](double fraction) {
+		return std::max(fraction, 0.0) + 0.0;
+	};
+
+	auto flags = out.flags();
+	out << std::setw(5) << std::setfill('0') << step << std::setfill(' ') << std::fixed << std::setprecision(6);
+	for (int strategyId = 0, strategyNum = strategies.size(); strategyId < strategyNum; ++strategyId) {
+		out << ((strategyId == 0) ? ":<" : ",<") <<
+				strategies[strategyId]->getShortStrategy() << "-C:" <<
+				printable(fractions[strategyId * 2 + static_cast<int>(Action::ACTION_C)]) << ">,<" <<
+				strategies[strategyId]->getShortStrategy() << "-D:" <<
+				printable(fractions[strategyId * 2 + static_cast<int>(Action::ACTION_D)]) << ">";
+	}
+	out << std::endl;
+	out.flags(flags);
+}
+
+/*
+ * 行動更新後に D となる確率
+ *
+ * Dの数ごとに、戦略の位置(長さが異なる場合は調整した位置の確率)の行動を足し合わせる
+ */
+double MeanFieldPreview::defectProbability(int strategyId, double dRatio) {
+
+	auto& strategy = strategies[strategyId];
+	auto& table = lengthTables[strategyId];
+	int dMax = 0;
+	for (int size : ringSizes[NeighborhoodType::ACTION]) {
+		dMax += size;
+	}
+
+	auto pmf = binomial(dMax, dRatio);
+	double defect = 0.0;
+	for (int dNum = 0; dNum <= dMax; ++dNum) {
+		if (table == nullptr) {
+			defect += (strategy->actionAt(dNum) == Action::ACTION_D) ? pmf[dNum] : 0.0;
+			continue;
+		}
+		for (int position = 0, length = strategy->getLength(); position < length; ++position) {
+			if (strategy->actionAt(position) == Action::ACTION_D) {
+				defect += pmf[dNum] * table->getProbability(dNum, position);
+			}
+		}
+	}
+	return defect;
+}
+
+/*
+ * 自身の行動ごとの利得の分布を求める
+ *
+ * 自己対戦は自身の行動で決まり、リングごとのDの数を畳み込む
+ */
+void MeanFieldPreview::scoreDistribution(int ownAction, double dRatio,
+		std::vector<double>& values, std::vector<double>& probabilities) const {
+
+	const double* payoffRow = payoffMatrix[ownAction];
+	auto& gameRings = ringSizes[NeighborhoodType::GAME];
+
+	double weightSum = 0.0;
+	std::map<double, double> distribution;
+	if (selfInteraction) {
+		distribution[ringWeights[0] * payoffRow[ownAction]] = 1.0;
+		weightSum += ringWeights[0];
+	} else {
+		distribution[0.0] = 1.0;
+	}
+
+	for (int r = 1, rMax = gameRings.size(); r < rMax; ++r) {
+		int size = gameRings[r];
+		auto pmf = binomial(size, dRatio);
+		std::map<double, double> next;
+		for (auto& entry : distribution) {
+			for (int dNum = 0; dNum <= size; ++dNum) {
+				if (pmf[dNum] > 0) {
+					double payoff = payoffRow[static_cast<int>(Action::ACTION_C)] * (size - dNum)
+							+ payoffRow[static_cast<int>(Action::ACTION_D)] * dNum;
+					next[entry.first + ringWeights[r] * payoff] += entry.second * pmf[dNum];
+				}
+			}
+		}
+		distribution.swap(next);
+		weightSum += ringWeights[r] * size;
+	}
+
+	values.clear();
+	probabilities.clear();
+	for (auto& entry : distribution) {
+		values.push_back((averaged && weightSum > 0) ? entry.first / weightSum : entry.first);
+		probabilities.push_back(entry.second);
+	}
+}
+
+/*
+ * 決定的最大値戦略更新後の、戦略ごとの割合を求める
+ *
+ * 近傍 k 人の (戦略, 利得) を独立に同じ分布 q とし、利得 v の累積を F(v) とすると
+ * 最大が自身の利得以下なら維持: F(v0)^k<br>
+ * 最大 v > v0 の近傍に自身の戦略がいれば維持: (F(v))^k - (F(v) - q(s0, v))^k<br>
+ * いなければ最初の最大の近傍の戦略: ((F(v) - q(s0, v))^k - F(v-)^k) × q(s, v) / (q(v) - q(s0, v))
+ */
+std::vector<double> MeanFieldPreview::imitate(double dRatio) const {
+
+	int strategyNum = strategies.size();
+	int neighborNum = 0;
+	for (int size : ringSizes[NeighborhoodType::STRATEGY]) {
+		neighborNum += size;
+	}
+
+	// 行動ごとの利得の分布を、共通の利得の並びにまとめる
+	std::vector<double> values[2];
+	std::vector<double> probabilities[2];
+	std::map<double, int> indexOf;
+	for (int action = 0; action < 2; ++action) {
+		scoreDistribution(action, dRatio, values[action], probabilities[action]);
+		for (double value : values[action]) {
+			indexOf[value] = 0;
+		}
+	}
+	int valueNum = 0;
+	for (auto& entry : indexOf) {
+		entry.second = valueNum++;
+	}
+
+	// 近傍の (戦略, 利得) の分布と、行動ごとの自身の利得の分布
+	std::vector<std::vector<double>> neighborQ(valueNum, std::vector<double>(strategyNum, 0.0));
+	std::vector<std::vector<double>> ownScore(2, std::vector<double>(valueNum, 0.0));
+	for (int action = 0; action < 2; ++action) {
+		for (int k = 0, size = values[action].size(); k < size; ++k) {
+			int index = indexOf[values[action][k]];
+			ownScore[action][index] = probabilities[action][k];
+			for (int strategyId = 0; strategyId < strategyNum; ++strategyId) {
+				neighborQ[index][strategyId] += fractions[strategyId * 2 + action] * probabilities[action][k];
+			}
+		}
+	}
+
+	// 累積の最大が丸め誤差で 1 からずれると、近傍数乗で割合の合計が発散するので、合計で割る
+	double total = 0.0;
+	for (auto& qs : neighborQ) {
+		for (double q : qs) {
+			total += q;
+		}
+	}
+	if (total > 0) {
+		for (auto& qs : neighborQ) {
+			for (double& q : qs) {
+				q /= total;
+			}
+		}
+	}
+
+	std::vector<double> below(valueNum + 1, 0.0);
+	std::vector<double> atValue(valueNum, 0.0);
+	for (int index = 0; index < valueNum; ++index) {
+		for (double q : neighborQ[index]) {
+			atValue[index] += q;
+		}
+		below[index + 1] = below[index] + atValue[index];
+	}
+
+	std::vector<double> result(strategyNum, 0.0);
+	for (int ownId = 0; ownId < strategyNum; ++ownId) {
+		double ownFraction = fractions[ownId * 2] + fractions[ownId * 2 + 1];
+		if (ownFraction <= 0) {
+			continue;
+		}
+
+		// 利得の大きい方から、それより大きい最大による更新先を累積する
+		std::vector<double> higher(strategyNum, 0.0);
+		for (int index = valueNum - 1; index >= 0; --index) {
+			double atMost = below[index] + atValue[index];
+			double keep = std::pow(atMost, neighborNum);
+
+			// 自身の利得がこの値の場合
+			double focal = fractions[ownId * 2] * ownScore[0][index] + fractions[ownId * 2 + 1] * ownScore[1][index];
+			if (focal > 0) {
+				result[ownId] += focal * keep;
+				for (int strategyId = 0; strategyId < strategyNum; ++strategyId) {
+					result[strategyId] += focal * higher[strategyId];
+				}
+			}
+
+			// この値が最大となる場合を、これより小さい自身の利得のために加える
+			double own = neighborQ[index][ownId];
+			double withoutOwn = std::pow(atMost - own, neighborNum);
+			higher[ownId] += keep - withoutOwn;
+			double others = atValue[index] - own;
+			if (others > 0) {
+				double switched = withoutOwn - std::pow(below[index], neighborNum);
+				for (int strategyId = 0; strategyId < strategyNum; ++strategyId) {
+					if (strategyId != ownId) {
+						higher[strategyId] += switched * neighborQ[index][strategyId] / others;
+					}
+				}
+			}
+		}
+	}
+
+	return result;
+}
+
+} /* namespace rule */
+} /* namespace spd */
@@ -0,0 +1,152 @@
+/**
+ * MeanFieldPreview.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef MEANFIELDPREVIEW_HPP_
+#define MEANFIELDPREVIEW_HPP_
+
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "../core/OriginalType.hpp"
+#include "../core/NeighborhoodType.hpp"
+
+namespace spd {
+namespace core {
+	class Strategy;
+}
+namespace param {
+	class Parameter;
+}
+namespace rule {
+
+class SpdRule;
+class StrategyLengthTable;
+
+/**
+ * 平均場近似で、(戦略, 行動) ごとの割合の時間発展を予測するクラス
+ *
+ * @par
+ * 近傍は空間全体から独立に選ばれるとみなし、各ステップの D の割合 p から
+ * Dの数を二項分布とする。<br>
+ * 行動更新は、戦略の長さへの調整も確率として含めて D となる確率を求める。<br>
+ * 対戦は、リングごとのDの数の二項分布から利得の分布を求める(割引・平均も同じ重みで扱う)。<br>
+ * 決定的最大値戦略更新は、自身と独立な近傍の利得の最大値から、
+ * 同点なら自身の戦略を維持し、そうでなければ最初の最大の近傍の戦略となる確率を求める。
+ *
+ * @par
+ * 空間相関(対近似の項)は含まないため、格子上の結果の予測ではなく、
+ * 利得行列の走査範囲を絞るための目安として用いる。
+ */
+class MeanFieldPreview {
+public:
+
+	/**
+	 * コンストラクタ
+	 * @param[in] param パラメタ
+	 */
+	explicit MeanFieldPreview(const spd::param::Parameter& param);
+
+	/**
+	 * ルールと近傍数を読み、初期化したプレイヤから割合を求める
+	 * @param[in] spdRule ルール
+	 * @param[in] allPlayers 初期化した全てのプレイヤ
+	 * @param[out] reason 予測できない理由
+	 * @return 予測できるかどうか
+	 */
+	bool initialize(const SpdRule& spdRule, const spd::core::AllPlayer& allPlayers, std::string& reason);
+
+	/**
+	 * ステップ step の出力時点から、次の出力時点まで進める
+	 * @param[in] step 現在のステップ
+	 */
+	void advance(int step);
+
+	/**
+	 * 割合を NumberOutput と同じ形式で出力する
+	 * @param[out] out 出力先
+	 * @param[in] step 現在のステップ
+	 */
+	void write(std::ostream& out, int step) const;
+
+private:
+
+	/**
+	 * 行動更新後に D となる確率
+	 * @param[in] strategyId 戦略ID
+	 * @param[in] dRatio 近傍の D の割合
+	 * @return D となる確率
+	 */
+	double defectProbability(int strategyId, double dRatio);
+
+	/**
+	 * 自身の行動ごとの利得の分布を求める
+	 * @param[in] ownAction 自身の行動
+	 * @param[in] dRatio 近傍の D の割合
+	 * @param[out] values 利得
+	 * @param[out] probabilities 利得の確率
+	 */
+	void scoreDistribution(int ownAction, double dRatio,
+			std::vector<double>& values, std::vector<double>& probabilities) const;
+
+	/**
+	 * 決定的最大値戦略更新後の、戦略ごとの割合を求める
+	 * @param[in] dRatio D の割合
+	 * @return 戦略ごとの割合
+	 */
+	std::vector<double> imitate(double dRatio) const;
+
+	/**
+	 * パラメタ
+	 */
+	const spd::param::Parameter& param;
+
+	/**
+	 * 近傍の種類ごとの、リング(近傍半径)ごとのプレイヤ数(添字0は自身で使わない)
+	 */
+	std::vector<int> ringSizes[NeighborhoodType::TYPE_NUM];
+
+	/**
+	 * 対戦のリングごとの重み(添字0は自己対戦)
+	 */
+	std::vector<double> ringWeights;
+
+	/**
+	 * 対戦の重みの和で割るかどうか(平均利得)
+	 */
+	bool averaged;
+
+	/**
+	 * 自己対戦するかどうか
+	 */
+	bool selfInteraction;
+
+	/**
+	 * 利得行列
+	 */
+	double payoffMatrix[2][2];
+
+	/**
+	 * 戦略ID ごとの戦略
+	 */
+	std::vector<std::shared_ptr<spd::core::Strategy>> strategies;
+
+	/**
+	 * (戦略ID × 2 + 行動) ごとの割合
+	 */
+	std::vector<double> fractions;
+
+	/**
+	 * 戦略の長さごとの、長さへの調整表(近傍数 + 1 と同じ長さは空)
+	 */
+	std::vector<std::shared_ptr<StrategyLengthTable>> lengthTables;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* MEANFIELDPREVIEW_HPP_ */
@@ -0,0 +1,204 @@
+/**
+ * NeighborTable.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "NeighborTable.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#include "../core/Player.hpp"
+
+namespace spd {
+namespace rule {
+
+namespace {
+
+/*
+ * プレイヤの近傍を走査順に追加する
+ * @return 追加できたかどうか(近傍を保持していない場合 false)
+ */
+bool appendNeighbors(const std::shared_ptr<spd::core::Player>& player, NeighborhoodType type,
+		std::vector<int>& ids) {
+
+	auto& neighbors = player->getNeighbors(type);
+	if (neighbors == nullptr) {
+		// 近傍を保持していない
+		return false;
+	}
+
+	// 自身は含めないので1から
+	for (int r = 1, rMax = neighbors->size(); r < rMax; ++r) {
+		for (auto& opponentWP : *(neighbors->at(r))) {
+			auto opponent = opponentWP.lock();
+			if (opponent == nullptr) {
+				// 近傍がいない場合終了
+				throw std::runtime_error("Could not find a neighbor of a player.");
+			}
+			ids.push_back(opponent->getId());
+		}
+	}
+	return true;
+}
+
+} /* namespace */
+
+/*
+ * 全プレイヤの近傍をまとめる
+ * @param[in] allPlayers 全てのプレイヤ
+ * @param[in] type 近傍の種類
+ */
+bool NeighborTable::build(const spd::core::AllPlayer& allPlayers, NeighborhoodType type) {
+
+	clear();
+	std::vector<int> builtOffsets;
+	std::vector<int> builtIds;
+	builtOffsets.reserve(allPlayers.size() + 1);
+	builtOffsets.push_back(0);
+
+	for (auto& player : allPlayers) {
+		if (!appendNeighbors(player, type, builtIds)) {
+			return false;
+		}
+		builtOffsets.push_back(builtIds.size());
+	}
+
+	attach(std::move(builtOffsets), std::move(builtIds));
+	findUniformCount();
+	built = true;
+	return true;
+}
+
+/*
+ * 指定したプレイヤの近傍だけをまとめ直す
+ *
+ * 変わらない行は前の配列からまとめて写し、開始位置をずらすだけにする。
+ * 前の配列は書き換えないので、コピーした表(分岐した空間)は前の近傍のまま使える。
+ */
+bool NeighborTable::patch(const spd::core::AllPlayer& allPlayers, NeighborhoodType type,
+		const std::vector<int>& repaired) {
+
+	if (!built) {
+		return false;
+	}
+	if (playerNum != static_cast<int>(allPlayers.size())) {
+		return build(allPlayers, type);
+	}
+	if (repaired.empty()) {
+		return true;
+	}
+
+	std::vector<int> patchedOffsets;
+	std::vector<int> patchedIds;
+	patchedOffsets.reserve(playerNum + 1);
+	patchedIds.reserve(ids->size());
+	patchedOffsets.push_back(0);
+
+	// [copied, until) の行を前の配列から写す
+	int copied = 0;
+	auto copyRows = [&](int until) {
+		int shift = static_cast<int>(patchedIds.size()) - offsetData[copied];
+		patchedIds.insert(patchedIds.end(), idData + offsetData[copied], idData + offsetData[until]);
+		for (int id = copied; id < until; ++id) {
+			patchedOffsets.push_back(offsetData[id + 1] + shift);
+		}
+	};
+
+	for (int id : repaired) {
+		copyRows(id);
+		if (!appendNeighbors(allPlayers[id], type, patchedIds)) {
+			clear();
+			return false;
+		}
+		patchedOffsets.push_back(patchedIds.size());
+		copied = id + 1;
+	}
+	copyRows(playerNum);
+
+	attach(std::move(patchedOffsets), std::move(patchedIds));
+	findUniformCount();
+	return true;
+}
+
+/*
+ * 向きを逆にした表を作る
+ *
+ * 近傍として現れる回数を数えてから、位置座標の小さいプレイヤから順に詰める。
+ */
+NeighborTable NeighborTable::reverse() const {
+
+	NeighborTable reversed;
+	if (!built) {
+		return reversed;
+	}
+
+	std::vector<int> reversedOffsets(playerNum + 1, 0);
+	for (int target : *ids) {
+		reversedOffsets[target + 1]++;
+	}
+	for (int id = 0; id < playerNum; ++id) {
+		reversedOffsets[id + 1] += reversedOffsets[id];
+	}
+
+	std::vector<int> filled(reversedOffsets.begin(), reversedOffsets.end() - 1);
+	std::vector<int> reversedIds(ids->size());
+	for (int id = 0; id < playerNum; ++id) {
+		for (const int* it = begin(id); it != end(id); ++it) {
+			reversedIds[filled[*it]++] = id;
+		}
+	}
+
+	reversed.attach(std::move(reversedOffsets), std::move(reversedIds));
+	reversed.findUniformCount();
+	reversed.built = true;
+	return reversed;
+}
+
+/*
+ * まとめた近傍を破棄する
+ */
+void NeighborTable::clear() {
+
+	built = false;
+	uniformCount = -1;
+	playerNum = 0;
+	offsets = nullptr;
+	ids = nullptr;
+	offsetData = nullptr;
+	idData = nullptr;
+}
+
+/*
+ * まとめた配列を設定する
+ *
+ * 配列はこれ以降書き換えないので、表をコピーしても共有したままでよい
+ */
+void NeighborTable::attach(std::vector<int>&& newOffsets, std::vector<int>&& newIds) {
+
+	offsets = std::make_shared<const std::vector<int>>(std::move(newOffsets));
+	ids = std::make_shared<const std::vector<int>>(std::move(newIds));
+	playerNum = offsets->size() - 1;
+	offsetData = offsets->data();
+	idData = ids->data();
+}
+
+/*
+ * 全プレイヤで共通の近傍数を求める
+ */
+void NeighborTable::findUniformCount() {
+
+	int playerNum = getPlayerNum();
+	uniformCount = (playerNum > 0) ? getCount(0) : -1;
+	for (int id = 1; id < playerNum; ++id) {
+		if (getCount(id) != uniformCount) {
+			uniformCount = -1;
+			return;
+		}
+	}
+}
+
+} /* namespace rule */
+} /* namespace spd */
@@ -0,0 +1,172 @@
+/**
+ * NeighborTable.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef NEIGHBORTABLE_HPP_
+#define NEIGHBORTABLE_HPP_
+
+#include <memory>
+#include <vector>
+
+#include "../core/OriginalType.hpp"
+#include "../core/NeighborhoodType.hpp"
+
+namespace spd {
+namespace rule {
+
+/**
+ * 全プレイヤの近傍を、プレイヤ位置座標の配列(CSR形式)にまとめたクラス
+ *
+ * @par
+ * プレイヤ位置座標ごとに近傍配列の開始位置を持ち、近傍は走査順(近傍距離1から)に並べる。
+ * 自身(近傍距離0)は含めない。<br>
+ * 構造が変わらない限り使い回せるため、ルールは初期化時に clear し、必要な時に build する。
+ * @par
+ * まとめた配列は書き換えず、build と patch のたびに作り直すので、コピーした表は配列を共有する
+ * (分岐した空間は、構造を編集するまで分岐元の表をそのまま使う)。<br>
+ * 構造の編集後は、patch で近傍が変わったプレイヤの行だけを探索し直せる。
+ */
+class NeighborTable {
+public:
+
+	/**
+	 * 全プレイヤの近傍をまとめる
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] type 近傍の種類
+	 * @return まとめられたかどうか
+	 * @retval false 近傍を保持していないプレイヤがいる場合
+	 * @throw std::runtime_error 近傍のプレイヤが存在しない場合
+	 */
+	bool build(const spd::core::AllPlayer& allPlayers, NeighborhoodType type);
+
+	/**
+	 * 指定したプレイヤの近傍だけをまとめ直す
+	 * @note プレイヤ数が変わっていた場合は、すべてまとめ直す
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] type 近傍の種類
+	 * @param[in] repaired 近傍が変わったプレイヤ位置座標(昇順)
+	 * @return まとめ直せたかどうか
+	 * @retval false まとめていなかった場合または、近傍を保持していないプレイヤがいる場合(表は破棄する)
+	 * @throw std::runtime_error 近傍のプレイヤが存在しない場合
+	 */
+	bool patch(const spd::core::AllPlayer& allPlayers, NeighborhoodType type,
+			const std::vector<int>& repaired);
+
+	/**
+	 * 向きを逆にした表(各プレイヤを近傍に持つプレイヤの表)を作る
+	 * @return 逆向きの表
+	 */
+	NeighborTable reverse() const;
+
+	/**
+	 * まとめた近傍を破棄する
+	 */
+	void clear();
+
+	/**
+	 * 近傍をまとめたかどうか
+	 * @return まとめたかどうか
+	 */
+	bool isBuilt() const {
+		return built;
+	};
+
+	/**
+	 * まとめたプレイヤ数
+	 * @return プレイヤ数
+	 */
+	int getPlayerNum() const {
+		return playerNum;
+	};
+
+	/**
+	 * 近傍の先頭
+	 * @param[in] id プレイヤ位置座標
+	 * @return 近傍のプレイヤ位置座標の先頭
+	 */
+	const int* begin(int id) const {
+		return idData + offsetData[id];
+	};
+
+	/**
+	 * 近傍の末尾
+	 * @param[in] id プレイヤ位置座標
+	 * @return 近傍のプレイヤ位置座標の末尾
+	 */
+	const int* end(int id) const {
+		return idData + offsetData[id + 1];
+	};
+
+	/**
+	 * 近傍数
+	 * @param[in] id プレイヤ位置座標
+	 * @return 近傍数
+	 */
+	int getCount(int id) const {
+		return offsetData[id + 1] - offsetData[id];
+	};
+
+	/**
+	 * 全プレイヤで共通の近傍数
+	 * @return 近傍数(プレイヤごとに異なる場合は -1)
+	 */
+	int getUniformCount() const {
+		return uniformCount;
+	};
+
+private:
+
+	/**
+	 * 近傍をまとめたかどうか
+	 */
+	bool built = false;
+
+	/**
+	 * 全プレイヤで共通の近傍数(異なる場合は -1)
+	 */
+	int uniformCount = -1;
+
+	/**
+	 * 全プレイヤで共通の近傍数を求める
+	 */
+	void findUniformCount();
+
+	/**
+	 * まとめた配列を設定する
+	 * @param[in] newOffsets プレイヤ位置座標ごとの、近傍配列の開始位置
+	 * @param[in] newIds 走査順に並べた近傍のプレイヤ位置座標
+	 */
+	void attach(std::vector<int>&& newOffsets, std::vector<int>&& newIds);
+
+	/**
+	 * まとめたプレイヤ数
+	 */
+	int playerNum = 0;
+
+	/**
+	 * プレイヤ位置座標ごとの、近傍配列の開始位置(プレイヤ数 + 1)
+	 */
+	std::shared_ptr<const std::vector<int>> offsets;
+
+	/**
+	 * 走査順に並べた近傍のプレイヤ位置座標
+	 */
+	std::shared_ptr<const std::vector<int>> ids;
+
+	/**
+	 * offsets の先頭(参照のたびに共有ポインタをたどらないため)
+	 */
+	const int* offsetData = nullptr;
+
+	/**
+	 * ids の先頭
+	 */
+	const int* idData = nullptr;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* NEIGHBORTABLE_HPP_ */
@@ -11,6 +11,8 @@
 #include <memory.h>
 #include "../IToString.hpp"
 #include "../core/OriginalType.hpp"
+#include "../core/NeighborhoodType.hpp"
+#include "RuleContext.hpp"
 
 namespace spd {
 namespace core {
@@ -25,6 +27,8 @@ using spd::core::AllPlayer;
 using spd::core::Neighbors;
 using spd::core::Player;
 
+class GlobalRule;
+
 /**
  *  ルールを表す抽象クラス
  */
@@ -61,6 +65,125 @@ public:
 		const spd::param::Parameter& param,
 		int step) = 0;
 
+	/**
+	 * プレイヤ位置座標の範囲 [begin, end) に更新ルールを実行
+	 * @note デフォルトでは、プレイヤごとに runRule を呼ぶ
+	 * @param[in] begin 開始プレイヤ位置座標
+	 * @param[in] end 終了プレイヤ位置座標(これを含まない)
+	 * @param[in] context 解決済みの情報
+	 */
+	virtual void runRange(int begin, int end, const RuleContext& context) {
+		for (int id = begin; id < end; ++id) {
+			runRule(context.allPlayers[id], context.allPlayers, context.param, context.step);
+		}
+	};
+
+	/**
+	 * runRange で近傍の表を使うかどうか
+	 * @note デフォルトでは使わない
+	 * @param[in] type 近傍の種類
+	 * @return 近傍の表を使うかどうか
+	 */
+	virtual bool usesNeighborTable(NeighborhoodType type) const {
+		return false;
+	};
+
+	/**
+	 * 非同期更新で読む近傍の種類
+	 * @note デフォルトでは非同期更新に対応しないので TYPE_NUM
+	 * @return 近傍の種類(対応しない場合は TYPE_NUM)
+	 */
+	virtual NeighborhoodType getAsynchronousNeighborhood() const {
+		return NeighborhoodType::TYPE_NUM;
+	};
+
+	/**
+	 * 非同期更新で、指定したプレイヤを更新
+	 *
+	 * 近傍の前の状態ではなく、現在の状態を読む。
+	 * 渡されるプレイヤは互いに近傍でない(同じ色の)ため、並列に呼ばれる
+	 * @note getAsynchronousNeighborhood が TYPE_NUM でない場合のみ呼ばれる
+	 * @param[in] ids プレイヤ位置座標の先頭
+	 * @param[in] num プレイヤ数
+	 * @param[in] context 解決済みの情報
+	 */
+	virtual void runAsynchronous(const int* ids, int num, const RuleContext& context) {};
+
+	/**
+	 * 全プレイヤに対する更新ルールの実行前に、一度だけ行う準備処理
+	 * @note デフォルトではなにもしない
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @param[in] step 実行ステップ
+	 */
+	virtual void prepare(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step) {};
+
+	/**
+	 * 空間構造が編集された場合に、ルールがまとめた近傍を破棄する
+	 * @note デフォルトではなにもしない
+	 */
+	virtual void resetNeighborTables() {};
+
+	/**
+	 * 空間構造が編集された場合に、ルールがまとめた近傍のうち、近傍が変わったプレイヤの分だけをまとめ直す
+	 * @note デフォルトではまとめた近傍をすべて破棄する(resetNeighborTables)
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @param[in] repaired 近傍が変わったプレイヤ位置座標(昇順)
+	 */
+	virtual void repairNeighborTables(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		const std::vector<int>& repaired) {
+		resetNeighborTables();
+	};
+
+	/**
+	 * 分岐した空間で、分岐元の同じ種類のルールが持つ状態を引き継ぐ
+	 * @note デフォルトではなにもしない(状態は初期化時のまま)
+	 * @param[in] base 分岐元のルール(このルールと同じ型)
+	 * @param[in] allPlayers 分岐先のプレイヤ
+	 * @param[in] param 分岐先のパラメタ
+	 */
+	virtual void takeOverState(
+		const Rule& base,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param) {};
+
+	/**
+	 * 解析ルールかどうか
+	 *
+	 * 解析ルールは、結果(プロパティ)を出力だけが読むルールであり、
+	 * プロパティを読む出力が行われるステップの直前にのみ実行される
+	 * @note デフォルトでは解析ルールではない
+	 * @return 解析ルールかどうか
+	 */
+	virtual bool isAnalysis() const {
+		return false;
+	};
+
+	/**
+	 * 空間構造や戦略プールなど、複製した盤面と共有するものを書き換えるかどうか
+	 *
+	 * 書き換えるルールは、複製した盤面では実行できない
+	 * @note デフォルトでは書き換えない
+	 * @return 書き換えるかどうか
+	 */
+	virtual bool editsSharedState() const {
+		return false;
+	};
+
+	/**
+	 * 空間全体を扱うルールとして取得
+	 * @note デフォルトではプレイヤごとのルールなので nullptr
+	 * @return 空間全体を扱うルール(そうでなければ nullptr)
+	 */
+	virtual GlobalRule* asGlobalRule() {
+		return nullptr;
+	};
 
 };
 
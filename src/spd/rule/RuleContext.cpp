@@ -0,0 +1,50 @@
+/**
+ * RuleContext.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "RuleContext.hpp"
+
+#include "../core/Action.hpp"
+#include "../param/Parameter.hpp"
+#include "../param/RuntimeParameter.hpp"
+#include "../param/NeighborhoodParameter.hpp"
+
+namespace spd {
+namespace rule {
+
+/*
+ * 情報を解決する
+ * @param[in] allPlayers 全てのプレイヤ
+ * @param[in] param パラメタ
+ * @param[in] step 実行ステップ
+ * @param[in] neighborTables 近傍の種類ごとの近傍の表
+ */
+RuleContext::RuleContext(
+		const spd::core::AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step,
+		const NeighborTable* const (&neighborTables)[NeighborhoodType::TYPE_NUM])
+	: allPlayers(allPlayers), param(param), step(step),
+	  random(param.getRandomParameter().get()) {
+
+	auto& runtime = param.getRuntimeParameter();
+	const Action actions[] = {Action::ACTION_C, Action::ACTION_D};
+	for (int own = 0; own < 2; ++own) {
+		for (int opponent = 0; opponent < 2; ++opponent) {
+			payoffMatrix[own][opponent] = runtime->getPayoff(actions[own], actions[opponent]);
+		}
+	}
+	selfInteraction = runtime->isSelfInteraction();
+
+	auto& neighborParam = param.getNeighborhoodParameter();
+	for (int type = 0; type < NeighborhoodType::TYPE_NUM; ++type) {
+		radii[type] = neighborParam->getNeiborhoodRadius(static_cast<NeighborhoodType>(type));
+		this->neighborTables[type] = neighborTables[type];
+	}
+}
+
+} /* namespace rule */
+} /* namespace spd */
@@ -0,0 +1,99 @@
+/**
+ * RuleContext.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef RULECONTEXT_HPP_
+#define RULECONTEXT_HPP_
+
+#include "../core/OriginalType.hpp"
+#include "../core/NeighborhoodType.hpp"
+#include "../param/RandomParameter.hpp"
+
+namespace spd {
+namespace param {
+	class Parameter;
+}
+namespace rule {
+
+class NeighborTable;
+
+/**
+ * プレイヤの範囲に対してルールを実行する際の、ステップごとに解決済みの情報
+ *
+ * @par
+ * パラメタから毎回 shared_ptr を辿って取得していた値(利得行列、自己対戦、近傍半径、乱数)を
+ * ステップの開始時に一度だけ取り出しておく。<br>
+ * 近傍の表は、プレイヤが近傍を保持していない場合 nullptr となる。
+ */
+struct RuleContext {
+
+	/**
+	 * 情報を解決する
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @param[in] step 実行ステップ
+	 * @param[in] neighborTables 近傍の種類ごとの近傍の表(まとめられない場合は nullptr)
+	 */
+	RuleContext(
+			const spd::core::AllPlayer& allPlayers,
+			const spd::param::Parameter& param,
+			int step,
+			const NeighborTable* const (&neighborTables)[NeighborhoodType::TYPE_NUM]);
+
+	/**
+	 * プレイヤとステップごとの乱数列を取得
+	 * @param[in] playerId プレイヤID
+	 * @param[in] purpose 乱数の用途
+	 * @return 乱数列の生成エンジン
+	 */
+	spd::param::PhiloxEngine getStream(int playerId, spd::param::RandomPurpose purpose) const {
+		return random->getStream(step, playerId, purpose);
+	};
+
+	/**
+	 * 全てのプレイヤ
+	 */
+	const spd::core::AllPlayer& allPlayers;
+
+	/**
+	 * パラメタ
+	 */
+	const spd::param::Parameter& param;
+
+	/**
+	 * 実行ステップ
+	 */
+	int step;
+
+	/**
+	 * 利得行列(自身の行動, 相手の行動)
+	 */
+	double payoffMatrix[2][2];
+
+	/**
+	 * 自己対戦を行うかどうか
+	 */
+	bool selfInteraction;
+
+	/**
+	 * 近傍の種類ごとの近傍半径
+	 */
+	int radii[NeighborhoodType::TYPE_NUM];
+
+	/**
+	 * 近傍の種類ごとの近傍の表
+	 */
+	const NeighborTable* neighborTables[NeighborhoodType::TYPE_NUM];
+
+	/**
+	 * 乱数
+	 */
+	const spd::param::RandomParameter* random;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* RULECONTEXT_HPP_ */
@@ -7,6 +7,15 @@
 
 #include "SpdRule.hpp"
 
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <typeinfo>
+
+#include "../param/NeighborhoodParameter.hpp"
+#include "../param/RuntimeParameter.hpp"
+#include "../topology/Topology.hpp"
+
 namespace spd {
 namespace rule {
 
@@ -40,6 +49,236 @@ void SpdRule::init(
 	}
 }
 
+/*
+ * まとめた近傍を破棄する
+ */
+void SpdRule::resetNeighborTables() {
+
+	for (auto& table : neighborTables) {
+		table.clear();
+	}
+	for (auto& coloring : colorings) {
+		coloring.clear();
+	}
+	neighborTablesBuilt = false;
+}
+
+/*
+ * 分岐元のルールがまとめた近傍を、このルールでも使う
+ *
+ * 表のコピーは配列を共有するので、近傍数によらず定数時間で済む。
+ * このルールが使わない種類は共有しない。
+ */
+void SpdRule::shareNeighborTables(const SpdRule& base) {
+
+	for (int type = 0; type < NeighborhoodType::TYPE_NUM; ++type) {
+		if (usesNeighborTable(static_cast<NeighborhoodType>(type)) && base.neighborTables[type].isBuilt()) {
+			neighborTables[type] = base.neighborTables[type];
+		}
+	}
+}
+
+/*
+ * 分岐元のルールが持つ状態を引き継ぐ
+ *
+ * 分岐元のルールのうち、まだ対応させていない同じ種類の最初のルールから引き継ぐ
+ */
+void SpdRule::takeOverState(
+		const SpdRule& base,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param) {
+
+	std::vector<std::shared_ptr<Rule>> baseRules(base.rulesBeforeOutput);
+	baseRules.insert(baseRules.end(), base.rulesAfterOutput.begin(), base.rulesAfterOutput.end());
+	std::vector<bool> used(baseRules.size(), false);
+
+	auto takeOver = [&](const std::shared_ptr<Rule>& rule) {
+		for (std::size_t i = 0; i < baseRules.size(); ++i) {
+			if (!used[i] && (typeid(*(baseRules[i])) == typeid(*rule))) {
+				used[i] = true;
+				rule->takeOverState(*(baseRules[i]), allPlayers, param);
+				return;
+			}
+		}
+	};
+	for (auto& rule : rulesBeforeOutput) {
+		takeOver(rule);
+	}
+	for (auto& rule : rulesAfterOutput) {
+		takeOver(rule);
+	}
+}
+
+/*
+ * 前処理ルールの先頭をまとめて実行するクラスを設定
+ */
+void SpdRule::setPipeline(const std::shared_ptr<StepPipeline>& pipeline) {
+
+	if (pipeline != nullptr && !pipeline->covers(rulesBeforeOutput)) {
+		throw std::invalid_argument("The pipeline does not match the leading rules of " + name + ".");
+	}
+	this->pipeline = pipeline;
+}
+
+/*
+ * いずれかのルールが近傍の表を使うかどうか
+ */
+bool SpdRule::usesNeighborTable(NeighborhoodType type) const {
+
+	auto uses = [type](const std::shared_ptr<Rule>& rule) {
+		return rule->usesNeighborTable(type);
+	};
+	return std::any_of(rulesBeforeOutput.begin(), rulesBeforeOutput.end(), uses) ||
+			std::any_of(rulesAfterOutput.begin(), rulesAfterOutput.end(), uses) ||
+			((pipeline != nullptr) && pipeline->usesNeighborTable(type));
+}
+
+/*
+ * ルールを順番に、コアごとのプレイヤの範囲に対して実行
+ *
+ * 利得行列などの情報はステップごとに一度だけ解決し、近傍の表は構造が変わるまで使い回す。
+ * 空間全体を扱うルールは、プレイヤごとに呼ばずワーカを渡して一度だけ実行する。
+ */
+void SpdRule::runRules(
+		const std::vector<std::shared_ptr<Rule>>& rules,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step,
+		bool analyzes) {
+
+	if (!neighborTablesBuilt) {
+		for (int type = 0; type < NeighborhoodType::TYPE_NUM; ++type) {
+			auto phase = static_cast<NeighborhoodType>(type);
+
+			// いずれかのルールが使い、分岐元から共有していない場合のみ(近傍を保持していなければ、まとめない)
+			if (usesNeighborTable(phase) && !neighborTables[type].isBuilt()) {
+				neighborTables[type].build(allPlayers, phase);
+			}
+		}
+		neighborTablesBuilt = true;
+	}
+
+	const NeighborTable* tables[NeighborhoodType::TYPE_NUM];
+	for (int type = 0; type < NeighborhoodType::TYPE_NUM; ++type) {
+		tables[type] = neighborTables[type].isBuilt() ? &neighborTables[type] : nullptr;
+	}
+	RuleContext context(allPlayers, param, step, tables);
+
+	// ワーカのスレッドはステップをまたいで使い回す
+	if (workers == nullptr || workers->getCore() != param.getCore()) {
+		workers = std::make_shared<WorkerPool>(param.getCore());
+	}
+	int playerNum = allPlayers.size();
+	auto& topology = param.getNeighborhoodParameter()->getTopology();
+	bool asynchronous = param.getRuntimeParameter()->isAsynchronous();
+
+	// 前処理ルールの先頭は、まとめて実行できればまとめて実行
+	std::size_t first = 0;
+	if ((pipeline != nullptr) && (&rules == &rulesBeforeOutput) && pipeline->run(context, *workers)) {
+		first = pipeline->getRuleNum();
+	}
+
+	// 順番に処理
+	for (std::size_t index = first; index < rules.size(); ++index) {
+		auto& rule = rules[index];
+
+		// 結果を読む出力がなければ、解析ルールは飛ばす
+		if (!analyzes && rule->isAnalysis()) {
+			continue;
+		}
+
+		// 全プレイヤ分の準備
+		rule->prepare(allPlayers, param, step);
+
+		auto global = rule->asGlobalRule();
+		auto asynchronousType = rule->getAsynchronousNeighborhood();
+		if (global != nullptr) {
+			// 空間全体を扱うルール
+			global->runGlobal(context, *workers);
+		} else if (asynchronous && (asynchronousType != NeighborhoodType::TYPE_NUM) &&
+				(tables[asynchronousType] != nullptr)) {
+			// 非同期更新(近傍の表が無ければ同期更新のまま)
+			runAsynchronous(*rule, asynchronousType, context, *workers);
+		} else {
+			// コアごとのプレイヤの範囲
+			workers->run(playerNum,
+					[&](int worker, int from, int to) {
+				rule->runRange(from, to, context);
+			});
+		}
+
+		// ルールの区切りで、空間構造の編集を反映
+		if (topology->getEditor().hasEdits()) {
+			applyTopologyEdits(allPlayers, param);
+		}
+	}
+}
+
+/*
+ * ルールが記録した空間構造の編集を反映し、近傍が変わったプレイヤの分だけ近傍をまとめ直す
+ *
+ * 表の参照先は変えないので、実行中の RuleContext はそのまま使える。
+ * 色分けは、近傍が変わったプレイヤの近傍に同じ色がいなければ使い続ける。
+ */
+void SpdRule::applyTopologyEdits(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param) {
+
+	auto repaired = param.getNeighborhoodParameter()->getTopology()->applyEdits(allPlayers, param);
+
+	for (int type = 0; type < NeighborhoodType::TYPE_NUM; ++type) {
+		auto& table = neighborTables[type];
+		if (table.isBuilt()) {
+			table.patch(allPlayers, static_cast<NeighborhoodType>(type), repaired);
+		}
+		if (!table.isBuilt() || !colorings[type].isProperAt(table, repaired)) {
+			colorings[type].clear();
+		}
+	}
+	for (auto& rule : rulesBeforeOutput) {
+		rule->repairNeighborTables(allPlayers, param, repaired);
+	}
+	for (auto& rule : rulesAfterOutput) {
+		rule->repairNeighborTables(allPlayers, param, repaired);
+	}
+}
+
+/*
+ * 非同期更新で、色ごとにルールを実行
+ *
+ * 色分けは構造が変わるまで使い回す。
+ */
+void SpdRule::runAsynchronous(
+		Rule& rule,
+		NeighborhoodType type,
+		const RuleContext& context,
+		const WorkerPool& workers) {
+
+	auto& coloring = colorings[type];
+	if (!coloring.isBuilt()) {
+		auto& topology = context.param.getNeighborhoodParameter()->getTopology();
+		coloring.build(neighborTables[type], topology->colorPlayers(context.radii[type]));
+	}
+
+	// 色の順番を、ステップごとの乱数列で並べ替える(Fisher-Yates)
+	int colorNum = coloring.getColorNum();
+	std::vector<int> order(colorNum);
+	std::iota(order.begin(), order.end(), 0);
+	auto engine = context.getStream(0, spd::param::RandomPurpose::UPDATE_ORDER);
+	for (int i = colorNum - 1; i > 0; --i) {
+		int j = static_cast<int>(((engine() >> 32) * static_cast<std::uint64_t>(i + 1)) >> 32);
+		std::swap(order[i], order[j]);
+	}
+
+	for (int color : order) {
+		const int* ids = coloring.begin(color);
+		workers.run(coloring.getCount(color),
+				[&](int worker, int from, int to) {
+			rule.runAsynchronous(ids + from, to - from, context);
+		});
+	}
+}
+
 std::string SpdRule::toString() const {
 	std::string result = "[ ";
 
@@ -8,12 +8,20 @@
 #ifndef SPDRULE_H_
 #define SPDRULE_H_
 
+#include <memory>
 #include <string>
 #include <vector>
 #include <thread>
 #include <functional>
 
 #include "Rule.hpp"
+#include "GlobalRule.hpp"
+#include "WorkerPool.hpp"
+#include "StepPipeline.hpp"
+#include "RuleContext.hpp"
+#include "NeighborTable.hpp"
+#include "GraphColoring.hpp"
+#include "../core/NeighborhoodType.hpp"
 #include "../param/Parameter.hpp"
 
 namespace spd {
@@ -42,39 +50,15 @@ public:
 	 * @param[in] allPlayers 全てのプレイヤ
 	 * @param[in] param パラメタ
 	 * @param[in] step 実行ステップ
+	 * @param[in] analyzes 解析ルールも実行するかどうか
 	 */
 	void runRulesBeforeOutput(
 		const AllPlayer& allPlayers,
 		const spd::param::Parameter& param,
-		int step) const {
-
-		int core = param.getCore();
-		std::vector<std::thread> thr(core);
-
-		// 順番に処理
-		for (auto& rule : rulesBeforeOutput) {
-
-			// 1コアが担当するプレイヤ数
-			int playerNum = allPlayers.size();
-			int breadth = playerNum / core;
-
-			for (int i = 0, size = thr.size(); i < size; ++i) {
-				thr[i] = std::thread(
-						[&, i]{
-
-					int from = breadth * i;
-					int to = (i + 1 < core) ? breadth * (i + 1) : playerNum;
-					for (int id = from; id < to; ++id) {
-						rule->runRule(allPlayers[id], allPlayers, param, step);
-					}
-				}
-				);
-			}
-
-			for (std::thread& t : thr) {
-				t.join();
-			}
-		}
+		int step,
+		bool analyzes = true) {
+
+		runRules(rulesBeforeOutput, allPlayers, param, step, analyzes);
 	}
 
 	/**
@@ -86,37 +70,39 @@ public:
 	void runRulesAfterOutput(
 		const AllPlayer& allPlayers,
 		const spd::param::Parameter& param,
-		int step) const {
-
-		int core = param.getCore();
-		std::vector<std::thread> thr(core);
-
-		// 順番に処理
-		for (auto& rule : rulesAfterOutput) {
-
-			// 1コアが担当するプレイヤ数
-			int playerNum = allPlayers.size();
-			int breadth = playerNum / core;
-
-			for (int i = 0, size = thr.size(); i < size; ++i) {
-				thr[i] = std::thread(
-						[&, i]{
-
-					int from = breadth * i;
-					int to = (i + 1 < core) ? breadth * (i + 1) : playerNum;
-					for (int id = from; id < to; ++id) {
-						rule->runRule(allPlayers[id], allPlayers, param, step);
-					}
-				}
-				);
-			}
-
-			for (std::thread& t : thr) {
-				t.join();
-			}
-		}
+		int step) {
+
+		runRules(rulesAfterOutput, allPlayers, param, step, true);
 	}
 
+	/**
+	 * まとめた近傍を破棄する
+	 *
+	 * 空間構造が作り直された場合に呼び、次の実行時にまとめ直す
+	 */
+	void resetNeighborTables();
+
+	/**
+	 * 分岐元のルールがまとめた近傍を、このルールでも使う
+	 *
+	 * 分岐した空間は分岐元と同じ構造なので、近傍の表は作り直さずに配列を共有する
+	 * @param[in] base 分岐元のルール
+	 */
+	void shareNeighborTables(const SpdRule& base);
+
+	/**
+	 * 分岐元のルールが持つ状態を引き継ぐ
+	 *
+	 * 分岐先のルールは異なり得るので、同じ種類のルールを前処理・後処理の順に現れる順で対応させる
+	 * @param[in] base 分岐元のルール
+	 * @param[in] allPlayers 分岐先のプレイヤ
+	 * @param[in] param 分岐先のパラメタ
+	 */
+	void takeOverState(
+		const SpdRule& base,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param);
+
 	/**
 	 * 前処理ルールを追加
 	 */
@@ -147,6 +133,21 @@ public:
 		return rulesAfterOutput;
 	}
 
+	/**
+	 * 前処理ルールの先頭をまとめて実行するクラスを設定
+	 * @param[in] pipeline まとめて実行するクラス(ルールごとに実行する場合は nullptr)
+	 * @throw std::invalid_argument 前処理ルールの先頭が、まとめて実行するルールと異なる場合
+	 */
+	void setPipeline(const std::shared_ptr<StepPipeline>& pipeline);
+
+	/**
+	 * 前処理ルールの先頭をまとめて実行するクラスの取得
+	 * @return まとめて実行するクラス(設定されていない場合は nullptr)
+	 */
+	const std::shared_ptr<StepPipeline>& getPipeline() const {
+		return pipeline;
+	}
+
 	/**
 	 * ルール名の出力
 	 */
@@ -176,6 +177,87 @@ private:
 	 * 後処理ルール
 	 */
 	std::vector<std::shared_ptr<Rule>> rulesAfterOutput;
+
+	/**
+	 * 前処理ルールの先頭をまとめて実行するクラス
+	 * @note 設定されていない場合は nullptr
+	 */
+	std::shared_ptr<StepPipeline> pipeline;
+
+	/**
+	 * 近傍の種類ごとの、全プレイヤの近傍の表
+	 */
+	NeighborTable neighborTables[NeighborhoodType::TYPE_NUM];
+
+	/**
+	 * 近傍の表をまとめたかどうか
+	 */
+	bool neighborTablesBuilt = false;
+
+	/**
+	 * 近傍の種類ごとの、非同期更新の色分け
+	 */
+	GraphColoring colorings[NeighborhoodType::TYPE_NUM];
+
+	/**
+	 * ルールの実行で共有する常駐ワーカ
+	 * @note コア数が変わった場合のみ作り直す
+	 */
+	std::shared_ptr<WorkerPool> workers;
+
+	/**
+	 * いずれかのルールが近傍の表を使うかどうか
+	 * @param[in] type 近傍の種類
+	 * @return 使うかどうか
+	 */
+	bool usesNeighborTable(NeighborhoodType type) const;
+
+	/**
+	 * 非同期更新で、色ごとにルールを実行
+	 *
+	 * 色の順番はステップごとの乱数列で並べ替え、同じ色のプレイヤはワーカに分けて実行する
+	 * @param[in, out] rule ルール
+	 * @param[in] type 非同期更新で読む近傍の種類
+	 * @param[in] context 解決済みの情報
+	 * @param[in] workers 共有のワーカ
+	 */
+	void runAsynchronous(
+		Rule& rule,
+		NeighborhoodType type,
+		const RuleContext& context,
+		const WorkerPool& workers);
+
+	/**
+	 * ルールが記録した空間構造の編集を反映し、まとめた近傍をまとめ直す
+	 *
+	 * 近傍は編集の影響を受けたプレイヤだけを作り直し、近傍の表とルールがまとめた近傍は
+	 * そのプレイヤの行だけをまとめ直す。色分けは、そのプレイヤの近傍に同じ色がいる場合だけ塗り直す
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 */
+	void applyTopologyEdits(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param);
+
+	/**
+	 * ルールを順番に、コアごとのプレイヤの範囲に対して実行
+	 *
+	 * 空間全体を扱うルールは、ワーカを渡して一度だけ実行
+	 * 前処理ルールの先頭は、まとめて実行できる場合はまとめて実行
+	 * 非同期更新の場合、対応するルールは色ごとに実行
+	 * ルールが空間構造を編集した場合、次のルールの前に反映
+	 * @param[in] rules ルール
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @param[in] step 実行ステップ
+	 * @param[in] analyzes 解析ルールも実行するかどうか
+	 */
+	void runRules(
+		const std::vector<std::shared_ptr<Rule>>& rules,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step,
+		bool analyzes);
 };
 
 } /* namespace core */
@@ -0,0 +1,69 @@
+/**
+ * StepPipeline.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef STEPPIPELINE_HPP_
+#define STEPPIPELINE_HPP_
+
+#include <memory>
+#include <vector>
+
+#include "Rule.hpp"
+#include "RuleContext.hpp"
+#include "WorkerPool.hpp"
+#include "../core/NeighborhoodType.hpp"
+
+namespace spd {
+namespace rule {
+
+/**
+ * 前処理ルールの先頭の組み合わせを、まとめて実行するクラス
+ *
+ * @par
+ * 組み込みの組み合わせに特殊化した実行は、ルールごとの実行の代わりに、
+ * 前処理ルールの先頭 getRuleNum() 個を一度に実行する。<br>
+ * 条件に合わない場合は何もせず false を返し、SpdRule はルールごとに実行する。
+ */
+class StepPipeline {
+public:
+
+	/**
+	 * デストラクタ
+	 */
+	virtual ~StepPipeline(){};
+
+	/**
+	 * まとめて実行する、前処理ルールの先頭の個数
+	 * @return ルールの個数
+	 */
+	virtual int getRuleNum() const = 0;
+
+	/**
+	 * 前処理ルールの先頭が、まとめて実行するルールと同じかどうか
+	 * @param[in] rules 前処理ルール
+	 * @return 同じインスタンスが同じ順に並んでいる場合 true
+	 */
+	virtual bool covers(const std::vector<std::shared_ptr<Rule>>& rules) const = 0;
+
+	/**
+	 * まとめて実行するために使う近傍の表
+	 * @param[in] type 近傍の種類
+	 * @return 近傍の表を使うかどうか
+	 */
+	virtual bool usesNeighborTable(NeighborhoodType type) const = 0;
+
+	/**
+	 * 前処理ルールの先頭をまとめて実行する
+	 * @param[in] context 解決済みの情報
+	 * @param[in] workers 共有のワーカ
+	 * @return 実行した場合 true (条件に合わず何もしなかった場合 false)
+	 */
+	virtual bool run(const RuleContext& context, const WorkerPool& workers) = 0;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* STEPPIPELINE_HPP_ */
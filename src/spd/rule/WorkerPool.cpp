@@ -0,0 +1,155 @@
+/**
+ * WorkerPool.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "WorkerPool.hpp"
+
+#include <algorithm>
+
+namespace spd {
+namespace rule {
+
+/*
+ * コンストラクタ
+ *
+ * 先頭のワーカは呼び出したスレッドが担当するので、残りの分だけ起動する
+ */
+WorkerPool::WorkerPool(int core) : core(std::max(1, core)) {
+
+	threads.reserve(this->core - 1);
+	for (int worker = 1; worker < this->core; ++worker) {
+		threads.emplace_back(&WorkerPool::loop, this, worker);
+	}
+}
+
+/*
+ * デストラクタ
+ */
+WorkerPool::~WorkerPool() {
+
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		stopping = true;
+	}
+	started.notify_all();
+
+	for (std::thread& t : threads) {
+		t.join();
+	}
+}
+
+/*
+ * 範囲 [0, num) をワーカに分けて実行し、全員の終了を待つ
+ *
+ * 例外は全員の終了を待ってから投げ直す(実行内容が参照する変数を、実行中に破棄しないため)
+ */
+void WorkerPool::dispatch(int num, const std::function<void(int, int, int)>& function) const {
+
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+
+		// 入れ子の呼び出しや常駐スレッドがない場合は、このスレッドで順に処理
+		if (running || threads.empty()) {
+			lock.unlock();
+			for (int worker = 0; worker < core; ++worker) {
+				runPart(worker, num, function);
+			}
+			return;
+		}
+
+		running = true;
+		task = &function;
+		taskNum = num;
+		remaining = threads.size();
+		error = nullptr;
+		++generation;
+	}
+	started.notify_all();
+
+	std::exception_ptr callerError;
+	try {
+		runPart(0, num, function);
+	} catch (...) {
+		callerError = std::current_exception();
+	}
+
+	std::exception_ptr workerError;
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		finished.wait(lock, [this]{ return remaining == 0; });
+		task = nullptr;
+		running = false;
+		workerError = error;
+		error = nullptr;
+	}
+
+	if (callerError != nullptr) {
+		std::rethrow_exception(callerError);
+	}
+	if (workerError != nullptr) {
+		std::rethrow_exception(workerError);
+	}
+}
+
+/*
+ * 指定したワーカの担当範囲を実行する
+ */
+void WorkerPool::runPart(int worker, int num, const std::function<void(int, int, int)>& function) const {
+
+	// 1コアが担当する数
+	int breadth = num / core;
+
+	int from = breadth * worker;
+	int to = (worker + 1 < core) ? breadth * (worker + 1) : num;
+
+	function(worker, from, to);
+}
+
+/*
+ * 常駐スレッドの処理
+ */
+void WorkerPool::loop(int worker) {
+
+	unsigned long seen = 0;
+
+	while (true) {
+
+		const std::function<void(int, int, int)>* function;
+		int num;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			started.wait(lock, [&]{ return stopping || generation != seen; });
+			if (stopping) {
+				return;
+			}
+			seen = generation;
+			function = task;
+			num = taskNum;
+		}
+
+		std::exception_ptr workerError;
+		try {
+			runPart(worker, num, *function);
+		} catch (...) {
+			workerError = std::current_exception();
+		}
+
+		bool last;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			if (workerError != nullptr && error == nullptr) {
+				error = workerError;
+			}
+			last = (--remaining == 0);
+		}
+		if (last) {
+			finished.notify_one();
+		}
+	}
+}
+
+} /* namespace rule */
+} /* namespace spd */
@@ -0,0 +1,155 @@
+/**
+ * WorkerPool.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef WORKERPOOL_HPP_
+#define WORKERPOOL_HPP_
+
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace spd {
+namespace rule {
+
+/**
+ * ルールの実行で共有する、コア数分の常駐ワーカ
+ *
+ * @par
+ * ワーカのスレッドは作成時に一度だけ起動し、破棄するまで待機と実行を繰り返す。<br>
+ * 範囲 [0, num) をコア数で等分し、先頭の範囲は呼び出したスレッドが、残りは常駐スレッドが処理して、
+ * 全員の終了を待つ。<br>
+ * 分け方は、これまでの各ルールの分け方(最後のコアが余りを担当)と同じ。
+ * @note 実行中の処理から run を呼んだ場合(入れ子)は、呼び出したスレッドで全範囲を順に処理する
+ */
+class WorkerPool {
+public:
+
+	/**
+	 * コンストラクタ
+	 * @note コア数から1引いた数のスレッドを起動する
+	 * @param[in] core コア数
+	 */
+	explicit WorkerPool(int core);
+
+	/**
+	 * デストラクタ
+	 * @note 常駐スレッドを終了させ、終了を待つ
+	 */
+	~WorkerPool();
+
+	WorkerPool(const WorkerPool&) = delete;
+	WorkerPool& operator=(const WorkerPool&) = delete;
+
+	/**
+	 * コア数を取得
+	 * @return コア数
+	 */
+	int getCore() const {
+		return core;
+	};
+
+	/**
+	 * 範囲 [0, num) をワーカに分けて実行し、全員の終了を待つ
+	 * @param[in] num 範囲の大きさ
+	 * @param[in] function 実行内容 (int worker, int from, int to) -> void
+	 * @throw 実行内容が投げた例外(全員の終了後に、最初の一つを投げ直す)
+	 */
+	template <class Function>
+	void run(int num, Function function) const {
+		dispatch(num, std::function<void(int, int, int)>(std::ref(function)));
+	};
+
+private:
+
+	/**
+	 * コア数
+	 */
+	int core;
+
+	/**
+	 * 常駐スレッド(ワーカ 1 から core - 1)
+	 */
+	std::vector<std::thread> threads;
+
+	/**
+	 * 実行中の内容と範囲を守る
+	 */
+	mutable std::mutex mutex;
+
+	/**
+	 * 新しい実行、または終了を常駐スレッドに知らせる
+	 */
+	mutable std::condition_variable started;
+
+	/**
+	 * 常駐スレッドがすべて終えたことを呼び出し元に知らせる
+	 */
+	mutable std::condition_variable finished;
+
+	/**
+	 * 実行内容
+	 */
+	mutable const std::function<void(int, int, int)>* task = nullptr;
+
+	/**
+	 * 実行する範囲の大きさ
+	 */
+	mutable int taskNum = 0;
+
+	/**
+	 * 実行の世代(常駐スレッドが新しい実行を見分ける)
+	 */
+	mutable unsigned long generation = 0;
+
+	/**
+	 * 実行を終えていない常駐スレッドの数
+	 */
+	mutable int remaining = 0;
+
+	/**
+	 * 実行中かどうか(入れ子の呼び出しを見分ける)
+	 */
+	mutable bool running = false;
+
+	/**
+	 * 実行内容が投げた最初の例外
+	 */
+	mutable std::exception_ptr error;
+
+	/**
+	 * 常駐スレッドを終了させるかどうか
+	 */
+	bool stopping = false;
+
+	/**
+	 * 範囲 [0, num) をワーカに分けて実行し、全員の終了を待つ
+	 * @param[in] num 範囲の大きさ
+	 * @param[in] function 実行内容
+	 */
+	void dispatch(int num, const std::function<void(int, int, int)>& function) const;
+
+	/**
+	 * 指定したワーカの担当範囲を実行する
+	 * @param[in] worker ワーカ番号
+	 * @param[in] num 範囲の大きさ
+	 * @param[in] function 実行内容
+	 */
+	void runPart(int worker, int num, const std::function<void(int, int, int)>& function) const;
+
+	/**
+	 * 常駐スレッドの処理(実行を待ち、担当範囲を実行する)
+	 * @param[in] worker ワーカ番号
+	 */
+	void loop(int worker);
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* WORKERPOOL_HPP_ */
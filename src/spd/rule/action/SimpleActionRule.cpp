@@ -9,7 +9,7 @@
 #include "SimpleActionRule.hpp"
 
 #include <stdexcept>
-#include <random>
+#include <vector>
 
 #include "../../core/Player.hpp"
 #include "../../core/Strategy.hpp"
@@ -17,6 +17,9 @@
 #include "../../param/NeighborhoodParameter.hpp"
 #include "../../param/RandomParameter.hpp"
 #include "../../topology/Topology.hpp"
+#include "../NeighborTable.hpp"
+#include "../DegreeDispatch.hpp"
+#include "../../topology/BoxCounter.hpp"
 
 namespace spd {
 namespace rule {
@@ -28,6 +31,68 @@ void SimpleActionRule::initialize(
 	return;
 }
 
+/*
+ * 箱型近傍を集計できる空間構造の場合、前の行動がDであるプレイヤを集計する
+ *
+ * 集計できれば、近傍半径によらず1プレイヤあたり定数時間でDの数が求まる。
+ */
+void SimpleActionRule::prepare(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step) {
+
+	auto& neighborParam = param.getNeighborhoodParameter();
+	countedRadius = neighborParam->getNeiborhoodRadius(NeighborhoodType::ACTION);
+
+	// 集計クラスはプレイヤ数が変わった場合のみ作り直す
+	int playerNum = allPlayers.size();
+	if (boxPlayerNum != playerNum) {
+		boxCounter = neighborParam->getTopology()->createBoxCounter(playerNum);
+		boxPlayerNum = playerNum;
+	}
+
+	dCounter = (boxCounter != nullptr && boxCounter->isApplicable(countedRadius)) ? boxCounter : nullptr;
+	if (dCounter != nullptr) {
+		// Dなら1
+		dField.assign(playerNum, 0);
+		for (auto& player : allPlayers) {
+			if (player->getPreAction() == Action::ACTION_D) {
+				dField.at(player->getId()) = 1;
+			} else if (player->getPreAction() == Action::ACTION_UN) {
+				// 未定義の行動があった場合終了
+				throw std::runtime_error("The neighbor's action is undefined.");
+			}
+		}
+		dCounter->build(dField);
+	}
+
+	// 調整表の作成
+	// 近傍を保持していないプレイヤは、runRule と同じく近傍を求めて数える
+	for (auto& player : allPlayers) {
+		int dMax = 0;
+		if (dCounter != nullptr) {
+			dMax = dCounter->boxSize(countedRadius) - 1;
+		} else {
+			auto neighbors = player->getNeighbors(NeighborhoodType::ACTION);
+			if (neighbors == nullptr) {
+				neighbors = neighborParam->getTopology()->getNeighbors(
+						allPlayers, player->getId(), countedRadius);
+			}
+			for (int r = 1, rMax = neighbors->size(); r < rMax; ++r) {
+				dMax += neighbors->at(r)->size();
+			}
+		}
+
+		int length = player->getStrategy()->getLength();
+		if ((dMax + 1) != length) {
+			auto key = std::make_pair(dMax, length);
+			if (lengthTables.find(key) == lengthTables.end()) {
+				lengthTables.insert(std::make_pair(key, StrategyLengthTable(dMax, length)));
+			}
+		}
+	}
+}
+
 /*
  * 行動更新
  *
@@ -40,28 +105,134 @@ void SimpleActionRule::runRule(
 		const spd::param::Parameter& param,
 		int step) {
 
-	// 近傍の設定
-	auto phase = NeighborhoodType::ACTION;
-	auto neighbors = player->getNeighbors(phase);
-	if (neighbors == nullptr) {
-		neighbors = std::move(param.getNeighborhoodParameter()->getTopology()->getNeighbors(
-				allPlayers,
-				player->getId(),
-				param.getNeighborhoodParameter()->getNeiborhoodRadius(phase)));
-	}
-
 	int dMax = 0;
-	int playersDNum = countDNum(player, neighbors, &dMax);
+	int playersDNum = 0;
+
+	if (dCounter != nullptr) {
+		// 集計済みの箱から自分を除く
+		dMax = dCounter->boxSize(countedRadius) - 1;
+		playersDNum = dCounter->countBox(player->getId(), countedRadius)
+				- dCounter->countBox(player->getId(), 0);
+	} else {
+		// 近傍の設定
+		auto phase = NeighborhoodType::ACTION;
+		auto neighbors = player->getNeighbors(phase);
+		if (neighbors == nullptr) {
+			neighbors = std::move(param.getNeighborhoodParameter()->getTopology()->getNeighbors(
+					allPlayers,
+					player->getId(),
+					param.getNeighborhoodParameter()->getNeiborhoodRadius(phase)));
+		}
+
+		playersDNum = countDNum(player, neighbors, &dMax);
+	}
 
 	// dの最大値+1 と、戦略の長さが異なる場合は調整
-	if ((dMax + 1) != player->getStrategy()->getLength()) {
-		playersDNum = adjustToStrategyLength(playersDNum, dMax, player->getStrategy(), param);
+	int length = player->getStrategy()->getLength();
+	if ((dMax + 1) != length) {
+		// プレイヤとステップごとの乱数列なので、スレッド数によらず同じ結果になる
+		playersDNum = adjustToStrategyLength(playersDNum, dMax, length,
+				param.getRandomParameter()->getStream(
+						step, player->getId(), spd::param::RandomPurpose::ACTION_ADJUST));
 	}
 
 	// 行動を設定
 	player->setAction(player->getStrategy()->actionAt(playersDNum));
 }
 
+/*
+ * プレイヤ位置座標の範囲に行動更新を行う
+ */
+void SimpleActionRule::runRange(int begin, int end, const RuleContext& context) {
+
+	auto table = context.neighborTables[NeighborhoodType::ACTION];
+	if ((dCounter != nullptr) || (table == nullptr)) {
+		Rule::runRange(begin, end, context);
+		return;
+	}
+
+	// 近傍数で特殊化したカーネル
+	dispatchDegree(table->getUniformCount(), *this, begin, end, context, *table);
+}
+
+/*
+ * 非同期更新で、指定したプレイヤの行動更新を行う
+ */
+void SimpleActionRule::runAsynchronous(const int* ids, int num, const RuleContext& context) {
+
+	auto table = context.neighborTables[NeighborhoodType::ACTION];
+	auto& allPlayers = context.allPlayers;
+	for (int index = 0; index < num; ++index) {
+		int id = ids[index];
+		auto& player = allPlayers[id];
+
+		// 自分は含まない
+		int dMax = table->getCount(id);
+		int playersDNum = 0;
+		for (const int* it = table->begin(id), *last = table->end(id); it != last; ++it) {
+			// 先に更新された近傍は、更新後の行動
+			auto neighborAction = allPlayers[*it]->getAction();
+
+			// Dの数をカウント
+			if (neighborAction == Action::ACTION_D) {
+				++playersDNum;
+			} else if (neighborAction == Action::ACTION_UN) {
+				// 未定義の行動があった場合終了
+				throw std::runtime_error("The neighbor's action is undefined.");
+			}
+		}
+
+		// dの最大値+1 と、戦略の長さが異なる場合は調整
+		int length = player->getStrategy()->getLength();
+		if ((dMax + 1) != length) {
+			playersDNum = adjustToStrategyLength(playersDNum, dMax, length,
+					context.getStream(id, spd::param::RandomPurpose::ACTION_ADJUST));
+		}
+
+		// 行動を設定
+		player->setAction(player->getStrategy()->actionAt(playersDNum));
+	}
+}
+
+/*
+ * 近傍数を固定して、プレイヤ位置座標の範囲に行動更新を行う
+ */
+template <int DEGREE>
+void SimpleActionRule::runDegree(int begin, int end, const RuleContext& context,
+		const NeighborTable& table) {
+
+	auto& allPlayers = context.allPlayers;
+	for (int id = begin; id < end; ++id) {
+		auto& player = allPlayers[id];
+
+		// 自分は含まない
+		int dMax = (DEGREE > 0) ? DEGREE : table.getCount(id);
+		const int* neighbors = table.begin(id);
+		int playersDNum = 0;
+		for (int k = 0; k < dMax; ++k) {
+			auto neighborAction = allPlayers[neighbors[k]]->getPreAction();
+
+			// Dの数をカウント
+			if (neighborAction == Action::ACTION_D) {
+				++playersDNum;
+			} else if (neighborAction == Action::ACTION_UN) {
+				// 未定義の行動があった場合終了
+				throw std::runtime_error("The neighbor's action is undefined.");
+			}
+		}
+
+		// dの最大値+1 と、戦略の長さが異なる場合は調整
+		int length = player->getStrategy()->getLength();
+		if ((dMax + 1) != length) {
+			playersDNum = adjustToStrategyLength(playersDNum, dMax, length,
+					context.getStream(id, spd::param::RandomPurpose::ACTION_ADJUST));
+		}
+
+		// 行動を設定
+		player->setAction(player->getStrategy()->actionAt(playersDNum));
+	}
+}
+
 /*
  * Dの数
  */
@@ -108,25 +279,11 @@ inline int SimpleActionRule::countDNum(
 inline int SimpleActionRule::adjustToStrategyLength(
 		int dNum,
 		int dMax,
-		const std::shared_ptr<spd::core::Strategy>& playerStrategy,
-		const spd::param::Parameter& param) {
-
-	double normalRandom;
-
-	auto engine = param.getRandomParameter()->getEngine();
-
-	// 正規乱数の生成
-	// 中央値(dNum + 0.5), 標準偏差(0.25) とする
-	// 二項分布の0未満、dNum+1以上ならば、やりなおす。
-	std::normal_distribution<double> normalDistribution (0.5 + dNum, 0.25);
-	do {
-		normalRandom = normalDistribution(engine);
-		param.getRandomParameter()->addGenerated(1);
-	} while ((normalRandom < dNum) || (normalRandom >= dNum + 1));
-
-	int result = static_cast<int>(normalRandom * playerStrategy->getLength() / (dMax + 1));
+		int length,
+		spd::param::PhiloxEngine engine) {
 
-	return result;
+	// 組み合わせはすべて prepare で作成済み
+	return lengthTables.at(std::make_pair(dMax, length)).sample(dNum, engine());
 }
 
 
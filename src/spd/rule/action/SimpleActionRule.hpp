@@ -8,12 +8,20 @@
 #ifndef SIMPLEACTIONRULE_H_
 #define SIMPLEACTIONRULE_H_
 
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
 #include "../Rule.hpp"
+#include "StrategyLengthTable.hpp"
 
 namespace spd {
 namespace core {
 	class Strategy;
 }
+namespace topology {
+	class BoxCounter;
+}
 namespace rule {
 
 /**
@@ -54,6 +62,70 @@ public:
 		const spd::param::Parameter& param,
 		int step);
 
+	/**
+	 * プレイヤ位置座標の範囲に行動更新を行う
+	 * @par
+	 * 集計しない場合は、行動更新近傍の表から前の行動がDである近傍を数える。
+	 * 表が無い場合や集計済みの場合は、プレイヤごとに runRule を呼ぶ。
+	 * @param[in] begin 開始プレイヤ位置座標
+	 * @param[in] end 終了プレイヤ位置座標(これを含まない)
+	 * @param[in] context 解決済みの情報
+	 */
+	void runRange(int begin, int end, const RuleContext& context);
+
+	/**
+	 * 近傍数を固定して、プレイヤ位置座標の範囲に行動更新を行う
+	 * @note dispatchDegree から呼ばれる
+	 * @param[in] begin 開始プレイヤ位置座標
+	 * @param[in] end 終了プレイヤ位置座標(これを含まない)
+	 * @param[in] context 解決済みの情報
+	 * @param[in] table 近傍の表
+	 * @tparam DEGREE 全プレイヤで共通の近傍数(0 の場合はプレイヤごとに読む)
+	 */
+	template <int DEGREE>
+	void runDegree(int begin, int end, const RuleContext& context, const NeighborTable& table);
+
+	/**
+	 * 非同期更新では行動更新近傍の現在の行動を読む
+	 * @return 行動更新近傍
+	 */
+	NeighborhoodType getAsynchronousNeighborhood() const {
+		return NeighborhoodType::ACTION;
+	};
+
+	/**
+	 * 非同期更新で、指定したプレイヤの行動更新を行う
+	 * @par
+	 * 行動更新近傍の表から、現在の行動がDである近傍を数える。
+	 * @param[in] ids プレイヤ位置座標の先頭
+	 * @param[in] num プレイヤ数
+	 * @param[in] context 解決済みの情報
+	 */
+	void runAsynchronous(const int* ids, int num, const RuleContext& context);
+
+	/**
+	 * 行動更新近傍の表を使う
+	 * @param[in] type 近傍の種類
+	 * @return 行動更新近傍の場合 true
+	 */
+	bool usesNeighborTable(NeighborhoodType type) const {
+		return type == NeighborhoodType::ACTION;
+	};
+
+	/**
+	 * 箱型近傍を集計できる空間構造の場合、前の行動がDであるプレイヤを集計する
+	 * @par
+	 * あわせて、近傍プレイヤ数と戦略の長さが異なるプレイヤのために、調整表を作成する
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @param[in] step 実行ステップ
+	 * @throw std::runtime_error 前の行動が未定義のプレイヤがいる場合
+	 */
+	void prepare(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step);
+
 	/**
 	 * ルール情報の文字出力
 	 * @return "SimpleActionUpdate"
@@ -79,18 +151,53 @@ private:
 	/**
 	 * Dの数をプレイヤの戦略の長さに調整する
 	 * @par
-	 * 調整はその値+0.5 を中心とした、二項分布(正規乱数による近似)に従う
+	 * 調整はその値+0.5 を中心とした、二項分布(正規乱数による近似)に従う。<br>
+	 * 分布は StrategyLengthTable で表にしたものを使い、1回の一様乱数で決める。
 	 *
 	 * @param[in] dNum Dの数
 	 * @param[in] dMax 近傍プレイヤ数
-	 * @param[in] playerStrategy プレイヤの戦略
-	 * @param[in] param パラメタ
+	 * @param[in] length 戦略の長さ
+	 * @param[in] engine プレイヤとステップごとの乱数列
+	 * @throw std::out_of_range prepare で調整表を作成していない組み合わせの場合
 	 */
 	int adjustToStrategyLength(
 			int dNum,
 			int dMax,
-			const std::shared_ptr<spd::core::Strategy>& playerStrategy,
-			const spd::param::Parameter& param);
+			int length,
+			spd::param::PhiloxEngine engine);
+
+	/**
+	 * 前の行動がDであるプレイヤの箱型近傍の集計
+	 * @note 箱型近傍を集計できない場合は nullptr
+	 */
+	std::shared_ptr<spd::topology::BoxCounter> dCounter;
+
+	/**
+	 * 作成済みの箱型近傍の集計クラス(作成できない構造では nullptr)
+	 * @note ステップごとに作り直さず、内容だけ集計し直す
+	 */
+	std::shared_ptr<spd::topology::BoxCounter> boxCounter;
+
+	/**
+	 * 集計クラスを作成したプレイヤ数
+	 */
+	int boxPlayerNum = -1;
+
+	/**
+	 * 前の行動がDなら1とした値(集計の入力、ステップごとに使い回す)
+	 */
+	std::vector<int> dField;
+
+	/**
+	 * 集計した近傍半径
+	 */
+	int countedRadius = 0;
+
+	/**
+	 * (近傍プレイヤ数, 戦略の長さ) ごとの、戦略の長さへの調整表
+	 * @note prepare で作成し、runRule では参照のみ行う
+	 */
+	std::map<std::pair<int, int>, StrategyLengthTable> lengthTables;
 
 };
 
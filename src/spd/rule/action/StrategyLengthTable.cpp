@@ -0,0 +1,83 @@
+/**
+ * StrategyLengthTable.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "StrategyLengthTable.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace spd {
+namespace rule {
+
+namespace {
+
+/**
+ * 正規分布の中心
+ */
+constexpr double MEAN = 0.5;
+
+/**
+ * 正規分布の標準偏差
+ */
+constexpr double DEVIATION = 0.25;
+
+/**
+ * Dの数からの差 u における、正規分布の累積分布関数
+ * @param[in] u Dの数からの差
+ * @return 累積確率
+ */
+double cumulative(double u) {
+	return 0.5 * std::erfc(-(u - MEAN) / (DEVIATION * std::sqrt(2.0)));
+}
+
+}
+
+/*
+ * 表を作成する
+ * @param[in] dMax 近傍プレイヤ数
+ * @param[in] strategyLength 戦略の長さ
+ */
+StrategyLengthTable::StrategyLengthTable(int dMax, int strategyLength) {
+
+	int width = dMax + 1;
+	offsets.reserve(width);
+	tables.reserve(width);
+	probabilities.reserve(width);
+
+	for (int dNum = 0; dNum <= dMax; ++dNum) {
+
+		// x * strategyLength / width の範囲 [dNum * strategyLength / width, (dNum + 1) * strategyLength / width)
+		int first = static_cast<long long>(dNum) * strategyLength / width;
+		int last = static_cast<int>(std::ceil(
+				static_cast<double>(dNum + 1) * strategyLength / width)) - 1;
+		last = std::max(first, last);
+
+		std::vector<double> weights;
+		weights.reserve(last - first + 1);
+		for (int k = first; k <= last; ++k) {
+			// 戦略の位置 k となる x の範囲を、[dNum, dNum + 1) に切り詰める
+			double lower = std::max(static_cast<double>(k) * width / strategyLength, static_cast<double>(dNum));
+			double upper = std::min(static_cast<double>(k + 1) * width / strategyLength, dNum + 1.0);
+			weights.push_back(std::max(0.0, cumulative(upper - dNum) - cumulative(lower - dNum)));
+		}
+
+		offsets.push_back(first);
+		tables.push_back(spd::core::AliasTable(weights));
+
+		double sum = 0.0;
+		for (double weight : weights) {
+			sum += weight;
+		}
+		for (double& weight : weights) {
+			weight /= sum;
+		}
+		probabilities.push_back(weights);
+	}
+}
+
+} /* namespace rule */
+} /* namespace spd */
@@ -0,0 +1,82 @@
+/**
+ * StrategyLengthTable.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef STRATEGYLENGTHTABLE_HPP_
+#define STRATEGYLENGTHTABLE_HPP_
+
+#include <cstdint>
+#include <vector>
+
+#include "../../core/AliasTable.hpp"
+
+namespace spd {
+namespace rule {
+
+/**
+ * Dの数を、長さの異なる戦略の位置へ対応させる表を表すクラス
+ *
+ * @par
+ * Dの数 dNum に対し、x を平均 dNum + 0.5、標準偏差 0.25 の正規分布を
+ * [dNum, dNum + 1) に切断した分布に従う乱数とし、
+ * 戦略の位置を floor(x * strategyLength / (dMax + 1)) とする。<br>
+ * 戦略の位置 k の確率は、x が [k * (dMax + 1) / strategyLength, (k + 1) * (dMax + 1) / strategyLength)
+ * と [dNum, dNum + 1) の共通部分に入る確率であり、正規分布の累積分布関数の差から求める。<br>
+ * Dの数ごとにこの離散分布のエイリアス表を作成しておき、1回の一様乱数で標本化する。
+ */
+class StrategyLengthTable {
+public:
+
+	/**
+	 * 表を作成する
+	 * @param[in] dMax 近傍プレイヤ数
+	 * @param[in] strategyLength 戦略の長さ
+	 */
+	StrategyLengthTable(int dMax, int strategyLength);
+
+	/**
+	 * Dの数に対応する戦略の位置を標本化する
+	 * @param[in] dNum Dの数
+	 * @param[in] random 64bit の一様乱数
+	 * @return 戦略の位置
+	 */
+	int sample(int dNum, std::uint64_t random) const {
+		return offsets[dNum] + tables[dNum].sample(random);
+	};
+
+	/**
+	 * Dの数が戦略の位置に対応する確率
+	 * @param[in] dNum Dの数
+	 * @param[in] position 戦略の位置
+	 * @return 確率
+	 */
+	double getProbability(int dNum, int position) const {
+		int index = position - offsets[dNum];
+		auto& weights = probabilities[dNum];
+		return ((index < 0) || (index >= static_cast<int>(weights.size()))) ? 0.0 : weights[index];
+	};
+
+private:
+
+	/**
+	 * Dの数ごとの、取り得る最小の戦略の位置
+	 */
+	std::vector<int> offsets;
+
+	/**
+	 * Dの数ごとの、最小の位置からの差のエイリアス表
+	 */
+	std::vector<spd::core::AliasTable> tables;
+
+	/**
+	 * Dの数ごとの、最小の位置からの差の確率(標本化には使わない)
+	 */
+	std::vector<std::vector<double>> probabilities;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* STRATEGYLENGTHTABLE_HPP_ */
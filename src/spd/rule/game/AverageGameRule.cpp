@@ -34,16 +34,6 @@ void AverageGameRule::runRule(
 		const spd::param::Parameter& param,
 		int step) {
 
-	// 近傍の設定
-	auto phase = NeighborhoodType::GAME;
-	auto neighbors = player->getNeighbors(phase);
-	if (neighbors == nullptr) {
-		neighbors = std::move(param.getNeighborhoodParameter()->getTopology()->getNeighbors(
-				allPlayers,
-				player->getId(),
-				param.getNeighborhoodParameter()->getNeiborhoodRadius(phase)));
-	}
-
 	double payoffSum = 0.0;
 
 	int neighborsCount = 0;
@@ -56,6 +46,29 @@ void AverageGameRule::runRule(
 	if (!param.getRuntimeParameter()->isSelfInteraction()) {
 		startRadius++;
 	}
+
+	// 集計済みなら、近傍半径ごとの行動の数で対戦
+	if (isCounted()) {
+		for (int r = startRadius, rMax = getCountedRadius(); r <= rMax; ++r) {
+			payoffSum += sumRingPayoff(player->getId(), r, payoffRow);
+			neighborsCount += ringSize(r);
+		}
+
+		// 利得を加える
+		player->addScore(payoffSum / neighborsCount);
+		return;
+	}
+
+	// 近傍の設定
+	auto phase = NeighborhoodType::GAME;
+	auto neighbors = player->getNeighbors(phase);
+	if (neighbors == nullptr) {
+		neighbors = std::move(param.getNeighborhoodParameter()->getTopology()->getNeighbors(
+				allPlayers,
+				player->getId(),
+				param.getNeighborhoodParameter()->getNeiborhoodRadius(phase)));
+	}
+
 	// 近傍対戦
 	for (int r = startRadius, rMax = neighbors->size(); r < rMax; ++r) {
 		for (auto& opponentWP : *(neighbors->at(r))) {
@@ -8,7 +8,7 @@
 #ifndef AVERAGEGAMERULE_H_
 #define AVERAGEGAMERULE_H_
 
-#include "../Rule.hpp"
+#include "RingCountingGameRule.hpp"
 
 namespace spd {
 namespace rule {
@@ -17,7 +17,7 @@ namespace rule {
  * 平均利得を扱う対戦ルールを表すクラス
  *
  */
-class AverageGameRule: public spd::rule::Rule {
+class AverageGameRule: public spd::rule::RingCountingGameRule {
 public:
 
 	/**
@@ -0,0 +1,35 @@
+/**
+ * FarFieldReport.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "FarFieldReport.hpp"
+
+#include <cmath>
+
+namespace spd {
+namespace rule {
+
+/*
+ * 適用状況と誤差を出力に回す
+ *
+ * 許容誤差と誤差は10億分率に丸める
+ */
+std::map<std::string, int> FarFieldReport::propOutput(
+		const spd::core::AllPlayer& allPlayers,
+		int propPos) {
+
+	return std::map<std::string, int> {
+		{"applied", applied ? 1 : 0},
+		{"block_num", blockNum},
+		{"ring_num", ringNum},
+		{"tolerance_ppb", static_cast<int>(std::lround(tolerance * 1e9))},
+		{"measured_step", measuredStep},
+		{"max_error_ppb", measured ? static_cast<int>(std::lround(error * 1e9)) : -1}
+	};
+}
+
+} /* namespace rule */
+} /* namespace spd */
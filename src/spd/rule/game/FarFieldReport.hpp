@@ -0,0 +1,135 @@
+/**
+ * FarFieldReport.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef FARFIELDREPORT_HPP_
+#define FARFIELDREPORT_HPP_
+
+#include <map>
+#include <string>
+
+#include "../../core/OriginalType.hpp"
+#include "../../core/PropertyCounting.hpp"
+
+namespace spd {
+namespace rule {
+
+/**
+ * 遠方近似の適用状況と計測した誤差を、プロパティの特別な数え上げとして出力するクラス
+ *
+ * @par
+ * 誤差は1シミュレーションにつき、遠方近似を初めて使ったステップで1回だけ計測する。<br>
+ * 出力は整数なので、許容誤差と誤差は10億分率(ppb)で出力する。
+ */
+class FarFieldReport : public spd::core::PropertyCounting {
+public:
+
+	/**
+	 * 記録を破棄する
+	 */
+	void reset() {
+		applied = false;
+		blockNum = 0;
+		ringNum = 0;
+		tolerance = 0.0;
+		measured = false;
+		measuredStep = -1;
+		error = 0.0;
+	};
+
+	/**
+	 * 遠方近似の適用状況を記録する
+	 * @param[in] isApplied 遠方近似を使ったかどうか(畳み込みの方が速い場合は使わない)
+	 * @param[in] blocks まとめたブロックの数
+	 * @param[in] rings まとめる前のリングの数
+	 * @param[in] tol 許容誤差
+	 */
+	void update(bool isApplied, int blocks, int rings, double tol) {
+		applied = isApplied;
+		blockNum = blocks;
+		ringNum = rings;
+		tolerance = tol;
+	};
+
+	/**
+	 * 最後に記録した許容誤差
+	 * @return 許容誤差
+	 */
+	double getTolerance() const {
+		return tolerance;
+	};
+
+	/**
+	 * 誤差を計測済みかどうか
+	 * @return 計測済みの場合 true
+	 */
+	bool isMeasured() const {
+		return measured;
+	};
+
+	/**
+	 * 計測した誤差を記録する
+	 * @param[in] step 計測したステップ
+	 * @param[in] measuredError 割引された対戦数の総和に対する、差の最大値
+	 */
+	void setError(int step, double measuredError) {
+		measured = true;
+		measuredStep = step;
+		error = measuredError;
+	};
+
+	/**
+	 * 適用状況と誤差を出力に回す
+	 * @note プレイヤは走査しない
+	 * @param[in] allPlayers すべてのプレイヤ
+	 * @param[in] propPos プレイヤの持つプロパティの中で、対象とするプロパティの位置
+	 * @return 項目の名前と値(未計測の誤差は -1)
+	 */
+	std::map<std::string, int> propOutput(
+			const spd::core::AllPlayer& allPlayers,
+			int propPos);
+
+private:
+
+	/**
+	 * 直近のステップで遠方近似を使ったかどうか
+	 */
+	bool applied = false;
+
+	/**
+	 * まとめたブロックの数
+	 */
+	int blockNum = 0;
+
+	/**
+	 * まとめる前のリングの数
+	 */
+	int ringNum = 0;
+
+	/**
+	 * 許容誤差
+	 */
+	double tolerance = 0.0;
+
+	/**
+	 * 誤差を計測済みかどうか
+	 */
+	bool measured = false;
+
+	/**
+	 * 誤差を計測したステップ
+	 */
+	int measuredStep = -1;
+
+	/**
+	 * 計測した誤差
+	 */
+	double error = 0.0;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* FARFIELDREPORT_HPP_ */
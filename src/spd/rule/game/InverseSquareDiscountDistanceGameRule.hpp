@@ -8,7 +8,7 @@
 #ifndef InverseSquareDiscountDistance_H_
 #define InverseSquareDiscountDistance_H_
 
-#include "../Rule.hpp"
+#include "RingCountingGameRule.hpp"
 
 namespace spd {
 namespace rule {
@@ -17,21 +17,9 @@ namespace rule {
  * 距離の二乗の比例する割引率（獲得利得が逆二乗）を扱う対戦ルールを表すクラス
  *
  */
-class InverseSquareDiscountDistance: public spd::rule::Rule {
+class InverseSquareDiscountDistance: public spd::rule::RingCountingGameRule {
 public:
 
-	/**
-	 * プレイヤの初期化ルール
-	 * @note なにもしない
-	 * @param[in, out] player 対象プレイヤ
-	 * @param[in] allPlayers 全てのプレイヤ
-	 * @param[in] param パラメタ
-	 */
-	void initialize(
-			const std::shared_ptr<Player>& player,
-			const AllPlayer& allPlayers,
-			const spd::param::Parameter& param);
-
 	/**
 	 * 距離の二乗に比例する割引率（獲得利得が逆二乗）の対戦を行う
 	 *
@@ -53,6 +41,27 @@ public:
 	std::string toString() const {
 		return "InverseSquareDiscountGame";
 	}
+
+protected:
+
+	/**
+	 * 近傍半径ごとの割引率
+	 * @note 距離の二乗に比例して割り引く
+	 * @param[in] radius 近傍半径
+	 * @param[in] maxRadius 対戦する最大の近傍半径
+	 * @return 割引率
+	 */
+	double discountRatio(int radius, int maxRadius) const {
+		return 1.0 / ((radius + static_cast<double>(1.0)) * (radius + static_cast<double>(1.0)));
+	}
+
+	/**
+	 * 割引のある対戦ルールかどうか
+	 * @return 割引があるので true
+	 */
+	bool isDiscounted() const {
+		return true;
+	}
 };
 
 } /* namespace rule */
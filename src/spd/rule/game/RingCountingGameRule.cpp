@@ -0,0 +1,370 @@
+/**
+ * RingCountingGameRule.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "RingCountingGameRule.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include "../../core/Player.hpp"
+#include "../../core/Property.hpp"
+#include "../../param/Parameter.hpp"
+#include "../../param/NeighborhoodParameter.hpp"
+#include "../../param/RuntimeParameter.hpp"
+
+#include "../../topology/Topology.hpp"
+#include "../../topology/BoxCounter.hpp"
+#include "../../topology/FftConvolver.hpp"
+
+#include "FarFieldReport.hpp"
+
+namespace spd {
+namespace rule {
+
+/*
+ * 割引があり遠方近似の許容誤差が設定された場合、遠方近似の報告をプロパティに設定する
+ *
+ * 先頭プレイヤの時に記録を破棄する
+ */
+void RingCountingGameRule::initialize(
+		const std::shared_ptr<Player>& player,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param) {
+
+	if (!isDiscounted() || param.getRuntimeParameter()->getFarFieldTolerance() <= 0) {
+		return;
+	}
+
+	if (farFieldReport == nullptr) {
+		farFieldReport = std::make_shared<FarFieldReport>();
+	}
+	if (player->getId() == 0) {
+		farFieldReport->reset();
+	}
+
+	try {
+		player->getProperty(FAR_FIELD_PROP_NAME).setValue(0);
+	} catch (std::invalid_argument& e) {
+		if (player->getId() == 0) {
+			player->addProperty(spd::core::Property(FAR_FIELD_PROP_NAME, 0,
+					spd::core::Property::OutputType::SPECIAL, farFieldReport));
+		} else {
+			player->addProperty(spd::core::Property(FAR_FIELD_PROP_NAME, 0,
+					spd::core::Property::OutputType::NOT));
+		}
+	}
+}
+
+/*
+ * 分岐元の遠方近似の報告を引き継ぐ
+ */
+void RingCountingGameRule::takeOverState(
+		const Rule& base,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param) {
+
+	auto& baseReport = static_cast<const RingCountingGameRule&>(base).farFieldReport;
+	if ((farFieldReport != nullptr) && (baseReport != nullptr) &&
+			(baseReport->getTolerance() == param.getRuntimeParameter()->getFarFieldTolerance())) {
+		*farFieldReport = *baseReport;
+	}
+}
+
+/*
+ * 箱型近傍を集計できる空間構造の場合、行動がDであるプレイヤを集計する
+ */
+void RingCountingGameRule::prepare(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step) {
+
+	auto& neighborParam = param.getNeighborhoodParameter();
+	countedRadius = neighborParam->getNeiborhoodRadius(NeighborhoodType::GAME);
+	convolvedD.clear();
+	farField = false;
+
+	// 集計クラスはプレイヤ数が変わった場合のみ作り直す
+	int playerNum = allPlayers.size();
+	if (boxPlayerNum != playerNum) {
+		boxCounter = neighborParam->getTopology()->createBoxCounter(playerNum);
+		boxPlayerNum = playerNum;
+	}
+
+	dCounter = (boxCounter != nullptr && boxCounter->isApplicable(countedRadius)) ? boxCounter : nullptr;
+	if (dCounter == nullptr) {
+		return;
+	}
+
+	// Dなら1
+	dField.assign(playerNum, 0);
+	for (auto& player : allPlayers) {
+		if (player->getAction() == Action::ACTION_D) {
+			dField.at(player->getId()) = 1;
+		} else if (player->getAction() == Action::ACTION_UN) {
+			// 未定義の行動があった場合終了
+			throw std::runtime_error("The neighbor's action is undefined.");
+		}
+	}
+	dCounter->build(dField);
+
+	// 割引がなければ、リングごとに数える
+	if (!isDiscounted()) {
+		return;
+	}
+
+	int startRadius = 0;
+	// 自己対戦がないなら、半径1から
+	if (!param.getRuntimeParameter()->isSelfInteraction()) {
+		startRadius++;
+	}
+
+	// 許容誤差があれば遠方近似(ブロックの数で数えても畳み込みより遅い場合は使わない)
+	double tolerance = param.getRuntimeParameter()->getFarFieldTolerance();
+	if (tolerance > 0) {
+		prepareFarField(countedRadius, startRadius, tolerance);
+		farField = !isConvolutionFaster(farFieldBlocks.size(), dCounter->getSide());
+
+		if (farFieldReport != nullptr) {
+			farFieldReport->update(farField, farFieldBlocks.size(),
+					countedRadius - startRadius + 1, tolerance);
+
+			// 誤差はシミュレーションごとに1回だけ計測する
+			if (farField && !farFieldReport->isMeasured()) {
+				farFieldReport->setError(step, measureFarFieldError(playerNum));
+			}
+		}
+
+		if (farField) {
+			return;
+		}
+	}
+
+	// 近傍半径が大きい場合は畳み込む
+	if (isConvolutionFaster(countedRadius, dCounter->getSide())) {
+		prepareConvolver(countedRadius, startRadius);
+		convolver->convolve(dField, convolvedD);
+	}
+}
+
+/*
+ * 畳み込みを使うかどうか判定する
+ * @param[in] radius 近傍半径
+ * @param[in] side 辺の長さ
+ */
+bool RingCountingGameRule::isConvolutionFaster(int radius, int side) {
+	return radius >= BREAK_EVEN_RATIO * std::log2(std::max(side, 2));
+}
+
+/*
+ * 割引率のカーネルを作成し、畳み込みの準備をする
+ * @param[in] radius 近傍半径
+ * @param[in] startRadius 対戦を始める近傍半径
+ */
+void RingCountingGameRule::prepareConvolver(int radius, int startRadius) {
+
+	int side = dCounter->getSide();
+	int dimension = dCounter->getDimension();
+
+	std::size_t playerNum = 1;
+	for (int d = 0; d < dimension; ++d) {
+		playerNum *= side;
+	}
+
+	// 空間の大きさが変わった場合は作りなおす
+	if (convolver == nullptr || convolver->size() != playerNum) {
+		convolver = std::make_shared<spd::topology::FftConvolver>(side, dimension);
+		kernelRadius = -1;
+	}
+
+	// カーネルが同じなら、変換済みのものを使う
+	if (kernelRadius == radius && kernelStartRadius == startRadius) {
+		return;
+	}
+
+	// 箱の各相対位置に、その位置の近傍半径の割引率を置く
+	// 辺の長さより箱が大きい場合は、回り込んだ位置に重複して加算する
+	std::vector<double> kernel(convolver->size(), 0.0);
+	kernelSum = 0.0;
+
+	int width = 2 * radius + 1;
+	long long offsetNum = dCounter->boxSize(radius);
+	for (long long offsetIndex = 0; offsetIndex < offsetNum; ++offsetIndex) {
+
+		long long rest = offsetIndex;
+		std::size_t index = 0;
+		std::size_t stride = 1;
+		int distance = 0;
+		for (int d = 0; d < dimension; ++d) {
+			int offset = static_cast<int>(rest % width) - radius;
+			rest /= width;
+			distance = std::max(distance, std::abs(offset));
+			index += ((offset % side + side) % side) * stride;
+			stride *= side;
+		}
+
+		if (distance < startRadius) {
+			continue;
+		}
+
+		double ratio = discountRatio(distance, radius);
+		kernel[index] += ratio;
+		kernelSum += ratio;
+	}
+
+	convolver->setKernel(kernel);
+	kernelRadius = radius;
+	kernelStartRadius = startRadius;
+}
+
+/*
+ * 許容誤差に収まるようにリングをまとめ、遠方近似の準備をする
+ * @param[in] radius 近傍半径
+ * @param[in] startRadius 対戦を始める近傍半径
+ * @param[in] tolerance 許容誤差
+ */
+void RingCountingGameRule::prepareFarField(int radius, int startRadius, double tolerance) {
+
+	// 同じ条件なら作成済みのものを使う
+	if (farFieldRadius == radius && farFieldStartRadius == startRadius
+			&& farFieldTolerance == tolerance) {
+		return;
+	}
+
+	farFieldBlocks.clear();
+	farFieldWeightSum = 0.0;
+
+	for (int from = startRadius; from <= radius; ) {
+
+		// 一つ先のリングまで広げても収まる間、ブロックを広げる
+		int to = from;
+		double ratio = discountRatio(from, radius);
+		while (to < radius) {
+
+			// [from, to + 1] をまとめた場合の平均の割引率
+			double weightSum = 0.0;
+			long long sizeSum = 0;
+			for (int r = from; r <= to + 1; ++r) {
+				weightSum += ringSize(r) * discountRatio(r, radius);
+				sizeSum += ringSize(r);
+			}
+			double average = weightSum / sizeSum;
+
+			// Dの配置によらない誤差の上限は、平均からの偏差の総和の半分
+			double deviation = 0.0;
+			for (int r = from; r <= to + 1; ++r) {
+				deviation += ringSize(r) * std::abs(discountRatio(r, radius) - average);
+			}
+			if (deviation / 2 > tolerance * weightSum) {
+				break;
+			}
+
+			++to;
+			ratio = average;
+		}
+
+		farFieldBlocks.push_back({from, to, ratio});
+		for (int r = from; r <= to; ++r) {
+			farFieldWeightSum += ringSize(r) * discountRatio(r, radius);
+		}
+		from = to + 1;
+	}
+
+	farFieldRadius = radius;
+	farFieldStartRadius = startRadius;
+	farFieldTolerance = tolerance;
+}
+
+/*
+ * 遠方近似と厳密な割引率で数えた、割引されたDの数の差を計測する
+ * @param[in] playerNum プレイヤ数
+ */
+double RingCountingGameRule::measureFarFieldError(int playerNum) const {
+
+	if (farFieldWeightSum <= 0) {
+		return 0.0;
+	}
+
+	double maxError = 0.0;
+	int interval = std::max(1, playerNum / FAR_FIELD_SAMPLE_NUM);
+
+	for (int target = 0; target < playerNum; target += interval) {
+
+		// 厳密な割引率
+		double exact = 0.0;
+		for (int r = farFieldBlocks.front().from; r <= countedRadius; ++r) {
+			exact += dCounter->countRing(target, r) * discountRatio(r, countedRadius);
+		}
+
+		// 遠方近似
+		double approximate = 0.0;
+		for (auto& block : farFieldBlocks) {
+			long long dNum = dCounter->countBox(target, block.to);
+			if (block.from > 0) {
+				dNum -= dCounter->countBox(target, block.from - 1);
+			}
+			approximate += dNum * block.ratio;
+		}
+
+		maxError = std::max(maxError, std::abs(approximate - exact) / farFieldWeightSum);
+	}
+
+	return maxError;
+}
+
+/*
+ * 遠方近似で、近傍全体との割引された対戦の利得の和を求める
+ * @param[in] target 対象プレイヤの空間位置
+ * @param[in] payoffRow 対象プレイヤの利得行
+ */
+double RingCountingGameRule::sumFarFieldPayoff(int target, const double* payoffRow) const {
+
+	double payoffSum = 0.0;
+
+	for (auto& block : farFieldBlocks) {
+
+		// ブロック内のDの数
+		long long dNum = dCounter->countBox(target, block.to);
+		long long size = dCounter->boxSize(block.to);
+		if (block.from > 0) {
+			dNum -= dCounter->countBox(target, block.from - 1);
+			size -= dCounter->boxSize(block.from - 1);
+		}
+
+		payoffSum += (payoffRow[static_cast<int>(Action::ACTION_C)] * (size - dNum)
+				+ payoffRow[static_cast<int>(Action::ACTION_D)] * dNum) * block.ratio;
+	}
+
+	return payoffSum;
+}
+
+/*
+ * 指定した近傍半径のリングに含まれるプレイヤ数
+ * @param[in] radius 近傍半径
+ */
+long long RingCountingGameRule::ringSize(int radius) const {
+	return dCounter->ringSize(radius);
+}
+
+/*
+ * 指定した近傍半径のリングにいるプレイヤとの対戦の利得の和を求める
+ * @param[in] target 対象プレイヤの空間位置
+ * @param[in] radius 近傍半径
+ * @param[in] payoffRow 対象プレイヤの利得行
+ */
+double RingCountingGameRule::sumRingPayoff(int target, int radius, const double* payoffRow) const {
+
+	long long dNum = dCounter->countRing(target, radius);
+	long long cNum = dCounter->ringSize(radius) - dNum;
+
+	return payoffRow[static_cast<int>(Action::ACTION_C)] * cNum
+			+ payoffRow[static_cast<int>(Action::ACTION_D)] * dNum;
+}
+
+} /* namespace rule */
+} /* namespace spd */
@@ -0,0 +1,342 @@
+/**
+ * RingCountingGameRule.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef RINGCOUNTINGGAMERULE_HPP_
+#define RINGCOUNTINGGAMERULE_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "../Rule.hpp"
+#include "../../core/Action.hpp"
+
+namespace spd {
+namespace topology {
+	class BoxCounter;
+	class FftConvolver;
+}
+namespace rule {
+	class FarFieldReport;
+
+/**
+ * 近傍半径ごとの行動の数から利得を求められる対戦ルールを表す抽象クラス
+ *
+ * @par
+ * 箱型近傍を集計できる空間構造では、ステップごとに行動がDであるプレイヤを集計し、
+ * 近傍半径ごとのC, Dの数から利得を求める。<br>
+ * これにより、近傍半径によらず1プレイヤあたり定数時間(半径ごとには定数時間)で対戦できる。<br>
+ * 割引のある対戦ルールでは、近傍半径が損益分岐点以上になると、
+ * 割引率のカーネルとDの分布を高速フーリエ変換で畳み込み、全プレイヤの割引加算を一度に求める。<br>
+ * 遠方近似の許容誤差が設定された場合は、割引率の変化が小さい遠方のリングをまとめたブロックごとに、
+ * 平均の割引率でDの数を数える。近傍のリングは、まとめると誤差が大きいため、そのまま数える。<br>
+ * ただし、ブロックの数が畳み込みの損益分岐点以上になる場合は、畳み込みの方が速く誤差もないため、
+ * 遠方近似は使わない。
+ * @par
+ * 遠方近似の適用状況と計測した誤差は、プロパティの特別な数え上げとして出力する。
+ */
+class RingCountingGameRule: public spd::rule::Rule {
+public:
+
+	/**
+	 * デストラクタ
+	 */
+	virtual ~RingCountingGameRule(){};
+
+	/**
+	 * 割引があり遠方近似の許容誤差が設定された場合、遠方近似の報告をプロパティに設定する
+	 * @note 出力は先頭プレイヤのプロパティだけを見るので、数え上げは先頭プレイヤにだけ設定する
+	 * @param[in, out] player 対象プレイヤ
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 */
+	void initialize(
+			const std::shared_ptr<Player>& player,
+			const AllPlayer& allPlayers,
+			const spd::param::Parameter& param);
+
+	/**
+	 * 分岐元の遠方近似の報告を引き継ぐ
+	 * @note 許容誤差が変わる場合は、分岐先で計測し直すので引き継がない
+	 * @param[in] base 分岐元のルール
+	 * @param[in] allPlayers 分岐先のプレイヤ
+	 * @param[in] param 分岐先のパラメタ
+	 */
+	void takeOverState(
+		const Rule& base,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param);
+
+	/**
+	 * 箱型近傍を集計できる空間構造の場合、行動がDであるプレイヤを集計する
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @param[in] step 実行ステップ
+	 * @throw std::runtime_error 行動が未定義のプレイヤがいる場合
+	 */
+	void prepare(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step);
+
+	/**
+	 * 近傍半径ごとの対戦の重み
+	 * @param[in] radius 近傍半径
+	 * @param[in] maxRadius 対戦する最大の近傍半径
+	 * @return 重み(割引率)
+	 */
+	double getRingWeight(int radius, int maxRadius) const {
+		return discountRatio(radius, maxRadius);
+	}
+
+	/**
+	 * 集計済みかどうか
+	 * @return 集計結果を使って対戦できるかどうか
+	 */
+	bool isCounted() const {
+		return dCounter != nullptr;
+	}
+
+protected:
+
+	/**
+	 * 畳み込み済みかどうか
+	 * @return 畳み込みの結果を使って対戦できるかどうか
+	 */
+	bool isConvolved() const {
+		return !convolvedD.empty();
+	}
+
+	/**
+	 * 遠方近似を行うかどうか
+	 * @return 遠方近似の結果を使って対戦するかどうか
+	 */
+	bool isFarField() const {
+		return farField;
+	}
+
+	/**
+	 * 集計した近傍半径
+	 * @return 近傍半径
+	 */
+	int getCountedRadius() const {
+		return countedRadius;
+	}
+
+	/**
+	 * 指定した近傍半径のリングに含まれるプレイヤ数(重複を含む)
+	 * @param[in] radius 近傍半径
+	 * @return プレイヤ数
+	 */
+	long long ringSize(int radius) const;
+
+	/**
+	 * 指定した近傍半径のリングにいるプレイヤとの対戦の利得の和を求める
+	 * @param[in] target 対象プレイヤの空間位置
+	 * @param[in] radius 近傍半径
+	 * @param[in] payoffRow 対象プレイヤの利得行
+	 * @return 利得の和
+	 */
+	double sumRingPayoff(int target, int radius, const double* payoffRow) const;
+
+	/**
+	 * 畳み込みの結果から、近傍全体との割引された対戦の利得の和を求める
+	 * @param[in] target 対象プレイヤの空間位置
+	 * @param[in] payoffRow 対象プレイヤの利得行
+	 * @return 利得の和
+	 */
+	double sumConvolvedPayoff(int target, const double* payoffRow) const {
+		double dSum = convolvedD[target];
+		return payoffRow[static_cast<int>(Action::ACTION_C)] * (kernelSum - dSum)
+				+ payoffRow[static_cast<int>(Action::ACTION_D)] * dSum;
+	}
+
+	/**
+	 * 遠方近似で、近傍全体との割引された対戦の利得の和を求める
+	 * @param[in] target 対象プレイヤの空間位置
+	 * @param[in] payoffRow 対象プレイヤの利得行
+	 * @return 利得の和
+	 */
+	double sumFarFieldPayoff(int target, const double* payoffRow) const;
+
+	/**
+	 * 近傍半径ごとの割引率
+	 * @param[in] radius 近傍半径
+	 * @param[in] maxRadius 対戦する最大の近傍半径
+	 * @return 割引率
+	 * @retval 1 割引のない場合
+	 */
+	virtual double discountRatio(int radius, int maxRadius) const {
+		return 1.0;
+	}
+
+	/**
+	 * 割引のある対戦ルールかどうか
+	 * @note 割引のある対戦ルールのみ、畳み込みを行う
+	 * @return 割引のある場合 true
+	 */
+	virtual bool isDiscounted() const {
+		return false;
+	}
+
+private:
+
+	/**
+	 * 遠方近似で、まとめて数えるリングの範囲
+	 */
+	struct FarFieldBlock {
+		/** 開始の近傍半径(含む) */
+		int from;
+		/** 終了の近傍半径(含む) */
+		int to;
+		/** ブロック内の平均の割引率 */
+		double ratio;
+	};
+
+	/**
+	 * 遠方近似の報告のプロパティ名
+	 */
+	const std::string FAR_FIELD_PROP_NAME = "FarField";
+
+	/**
+	 * 遠方近似の誤差を計測するプレイヤ数
+	 */
+	static const int FAR_FIELD_SAMPLE_NUM = 1000;
+
+	/**
+	 * 畳み込みに切り替える近傍半径の損益分岐点
+	 * @note 1プレイヤあたりの計算量は、半径ごとの集計では近傍半径に比例し、
+	 * 畳み込みでは辺の長さの対数に比例するため、辺の長さの対数に対する比で判定する<br>
+	 * 100x100, 200x200 のムーア近傍で計測し、近傍半径8から12の間で逆転したことから決めた
+	 */
+	static constexpr double BREAK_EVEN_RATIO = 1.2;
+
+	/**
+	 * 畳み込みを使うかどうか判定する
+	 * @param[in] radius 近傍半径
+	 * @param[in] side 辺の長さ
+	 * @return 畳み込みの方が速い場合 true
+	 */
+	static bool isConvolutionFaster(int radius, int side);
+
+	/**
+	 * 割引率のカーネルを作成し、畳み込みの準備をする
+	 * @param[in] radius 近傍半径
+	 * @param[in] startRadius 対戦を始める近傍半径
+	 */
+	void prepareConvolver(int radius, int startRadius);
+
+	/**
+	 * 許容誤差に収まるようにリングをまとめ、遠方近似の準備をする
+	 * @par
+	 * ブロック内のDの配置によらない誤差の上限が、ブロックの割引された対戦数の
+	 * 許容誤差倍以下となる範囲で、リングをまとめる。
+	 * @param[in] radius 近傍半径
+	 * @param[in] startRadius 対戦を始める近傍半径
+	 * @param[in] tolerance 許容誤差
+	 */
+	void prepareFarField(int radius, int startRadius, double tolerance);
+
+	/**
+	 * 遠方近似と厳密な割引率で数えた、割引されたDの数の差を計測する
+	 * @note 全プレイヤから等間隔に最大 FAR_FIELD_SAMPLE_NUM 人を選んで計測する
+	 * @param[in] playerNum プレイヤ数
+	 * @return 割引された対戦数の総和に対する、差の最大値
+	 */
+	double measureFarFieldError(int playerNum) const;
+
+	/**
+	 * 行動がDであるプレイヤの箱型近傍の集計
+	 * @note 箱型近傍を集計できない場合は nullptr
+	 */
+	std::shared_ptr<spd::topology::BoxCounter> dCounter;
+
+	/**
+	 * 作成済みの箱型近傍の集計クラス(作成できない構造では nullptr)
+	 * @note ステップごとに作り直さず、内容だけ集計し直す
+	 */
+	std::shared_ptr<spd::topology::BoxCounter> boxCounter;
+
+	/**
+	 * 集計クラスを作成したプレイヤ数
+	 */
+	int boxPlayerNum = -1;
+
+	/**
+	 * 行動がDなら1とした値(集計と畳み込みの入力、ステップごとに使い回す)
+	 */
+	std::vector<int> dField;
+
+	/**
+	 * 集計した近傍半径
+	 */
+	int countedRadius = 0;
+
+	/**
+	 * 割引率のカーネルを設定した畳み込み
+	 */
+	std::shared_ptr<spd::topology::FftConvolver> convolver;
+
+	/**
+	 * カーネルを作成した近傍半径
+	 */
+	int kernelRadius = -1;
+
+	/**
+	 * カーネルを作成した、対戦を始める近傍半径
+	 */
+	int kernelStartRadius = -1;
+
+	/**
+	 * カーネルの重みの総和(近傍がすべてCの場合の割引された対戦数)
+	 */
+	double kernelSum = 0.0;
+
+	/**
+	 * 各プレイヤの、割引されたDの数
+	 * @note 畳み込まない場合は空
+	 */
+	std::vector<double> convolvedD;
+
+	/**
+	 * このステップで遠方近似を行うかどうか
+	 */
+	bool farField = false;
+
+	/**
+	 * 遠方近似でまとめたリングの範囲
+	 */
+	std::vector<FarFieldBlock> farFieldBlocks;
+
+	/**
+	 * 遠方近似する近傍全体の割引された対戦数
+	 */
+	double farFieldWeightSum = 0.0;
+
+	/**
+	 * 遠方近似の範囲を作成した近傍半径
+	 */
+	int farFieldRadius = -1;
+
+	/**
+	 * 遠方近似の範囲を作成した、対戦を始める近傍半径
+	 */
+	int farFieldStartRadius = -1;
+
+	/**
+	 * 遠方近似の範囲を作成した許容誤差
+	 */
+	double farFieldTolerance = 0.0;
+
+	/**
+	 * 遠方近似の適用状況と計測した誤差
+	 */
+	std::shared_ptr<FarFieldReport> farFieldReport;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* RINGCOUNTINGGAMERULE_HPP_ */
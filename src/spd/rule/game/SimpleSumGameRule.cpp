@@ -14,6 +14,8 @@
 #include "../../param/RuntimeParameter.hpp"
 
 #include "../../topology/Topology.hpp"
+#include "../NeighborTable.hpp"
+#include "../DegreeDispatch.hpp"
 
 namespace spd {
 namespace rule {
@@ -34,16 +36,6 @@ void SimpleSumGameRule::runRule(
 		const spd::param::Parameter& param,
 		int step) {
 
-	// 近傍の設定
-	auto phase = NeighborhoodType::GAME;
-	auto neighbors = player->getNeighbors(phase);
-	if (neighbors == nullptr) {
-		neighbors = std::move(param.getNeighborhoodParameter()->getTopology()->getNeighbors(
-				allPlayers,
-				player->getId(),
-				param.getNeighborhoodParameter()->getNeiborhoodRadius(phase)));
-	}
-
 	double payoffSum = 0.0;
 
 	// 自身の利得行を取得
@@ -54,6 +46,28 @@ void SimpleSumGameRule::runRule(
 	if (!param.getRuntimeParameter()->isSelfInteraction()) {
 		startRadius++;
 	}
+
+	// 集計済みなら、近傍半径ごとの行動の数で対戦
+	if (isCounted()) {
+		for (int r = startRadius, rMax = getCountedRadius(); r <= rMax; ++r) {
+			payoffSum += sumRingPayoff(player->getId(), r, payoffRow);
+		}
+
+		// 利得を加える
+		player->addScore(payoffSum);
+		return;
+	}
+
+	// 近傍の設定
+	auto phase = NeighborhoodType::GAME;
+	auto neighbors = player->getNeighbors(phase);
+	if (neighbors == nullptr) {
+		neighbors = std::move(param.getNeighborhoodParameter()->getTopology()->getNeighbors(
+				allPlayers,
+				player->getId(),
+				param.getNeighborhoodParameter()->getNeiborhoodRadius(phase)));
+	}
+
 	// 近傍対戦
 	for (int r = startRadius, rMax = neighbors->size(); r < rMax; ++r) {
 		for (auto& opponentWP : *(neighbors->at(r))) {
@@ -73,6 +87,53 @@ void SimpleSumGameRule::runRule(
 	player->addScore(payoffSum);
 }
 
+/*
+ * プレイヤ位置座標の範囲に総和対戦を行う
+ */
+void SimpleSumGameRule::runRange(int begin, int end, const RuleContext& context) {
+
+	auto table = context.neighborTables[NeighborhoodType::GAME];
+	if (isCounted() || (table == nullptr)) {
+		Rule::runRange(begin, end, context);
+		return;
+	}
+
+	// 近傍数で特殊化したカーネル
+	dispatchDegree(table->getUniformCount(), *this, begin, end, context, *table);
+}
+
+/*
+ * 近傍数を固定して、プレイヤ位置座標の範囲に総和対戦を行う
+ */
+template <int DEGREE>
+void SimpleSumGameRule::runDegree(int begin, int end, const RuleContext& context,
+		const NeighborTable& table) {
+
+	auto& allPlayers = context.allPlayers;
+	for (int id = begin; id < end; ++id) {
+		auto& player = allPlayers[id];
+
+		// 自身の利得行
+		const double* payoffRow = context.payoffMatrix[static_cast<int>(player->getAction())];
+
+		double payoffSum = 0.0;
+
+		// 自己対戦(近傍半径0は自身)
+		if (context.selfInteraction) {
+			payoffSum += payoffRow[static_cast<int>(player->getAction())];
+		}
+
+		// 近傍対戦
+		int count = (DEGREE > 0) ? DEGREE : table.getCount(id);
+		const int* neighbors = table.begin(id);
+		for (int k = 0; k < count; ++k) {
+			payoffSum += payoffRow[static_cast<int>(allPlayers[neighbors[k]]->getAction())];
+		}
+
+		// 利得を加える
+		player->addScore(payoffSum);
+	}
+}
 
 } /* namespace rule */
 } /* namespace spd */
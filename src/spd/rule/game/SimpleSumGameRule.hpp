@@ -8,7 +8,7 @@
 #ifndef SIMPLESUMGAMERULE_H_
 #define SIMPLESUMGAMERULE_H_
 
-#include "../Rule.hpp"
+#include "RingCountingGameRule.hpp"
 
 namespace spd {
 namespace rule {
@@ -18,7 +18,7 @@ namespace rule {
  *
  * 対戦は純粋な総和で行う
  */
-class SimpleSumGameRule: public spd::rule::Rule {
+class SimpleSumGameRule: public spd::rule::RingCountingGameRule {
 public:
 
 	/**
@@ -49,6 +49,38 @@ public:
 			const spd::param::Parameter& param,
 			int step);
 
+	/**
+	 * プレイヤ位置座標の範囲に総和対戦を行う
+	 * @par
+	 * 集計しない場合は、対戦近傍の表と解決済みの利得行列で対戦する。
+	 * 表が無い場合や集計済みの場合は、プレイヤごとに runRule を呼ぶ。
+	 * @param[in] begin 開始プレイヤ位置座標
+	 * @param[in] end 終了プレイヤ位置座標(これを含まない)
+	 * @param[in] context 解決済みの情報
+	 */
+	void runRange(int begin, int end, const RuleContext& context);
+
+	/**
+	 * 近傍数を固定して、プレイヤ位置座標の範囲に総和対戦を行う
+	 * @note dispatchDegree から呼ばれる
+	 * @param[in] begin 開始プレイヤ位置座標
+	 * @param[in] end 終了プレイヤ位置座標(これを含まない)
+	 * @param[in] context 解決済みの情報
+	 * @param[in] table 近傍の表
+	 * @tparam DEGREE 全プレイヤで共通の近傍数(0 の場合はプレイヤごとに読む)
+	 */
+	template <int DEGREE>
+	void runDegree(int begin, int end, const RuleContext& context, const NeighborTable& table);
+
+	/**
+	 * 対戦近傍の表を使う
+	 * @param[in] type 近傍の種類
+	 * @return 対戦近傍の場合 true
+	 */
+	bool usesNeighborTable(NeighborhoodType type) const {
+		return type == NeighborhoodType::GAME;
+	};
+
 	/**
 	 * ルール情報の文字出力
 	 * @return "SimpleSumGame";
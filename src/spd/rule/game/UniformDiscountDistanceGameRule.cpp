@@ -18,13 +18,6 @@
 namespace spd {
 namespace rule {
 
-void UniformDiscountDistance::initialize(
-		const std::shared_ptr<Player>& player,
-		const AllPlayer& allPlayers,
-		const spd::param::Parameter& param) {
-	return;
-}
-
 /*
  * 均一な距離割引の対戦を行う
  */
@@ -34,16 +27,6 @@ void UniformDiscountDistance::runRule(
 		const spd::param::Parameter& param,
 		int step) {
 
-	// 近傍の設定
-	auto phase = NeighborhoodType::GAME;
-	auto neighbors = player->getNeighbors(phase);
-	if (neighbors == nullptr) {
-		neighbors = std::move(param.getNeighborhoodParameter()->getTopology()->getNeighbors(
-				allPlayers,
-				player->getId(),
-				param.getNeighborhoodParameter()->getNeiborhoodRadius(phase)));
-	}
-
 	double payoffSum = 0.0;
 
 	// 自身の利得行を取得
@@ -54,11 +37,47 @@ void UniformDiscountDistance::runRule(
 	if (!param.getRuntimeParameter()->isSelfInteraction()) {
 		startRadius++;
 	}
+
+	// 遠方近似なら、まとめたリングごとに対戦
+	if (isFarField()) {
+		player->addScore(sumFarFieldPayoff(player->getId(), payoffRow));
+		return;
+	}
+
+	// 畳み込み済みなら、その結果で対戦
+	if (isConvolved()) {
+		player->addScore(sumConvolvedPayoff(player->getId(), payoffRow));
+		return;
+	}
+
+	// 集計済みなら、近傍半径ごとの行動の数で対戦
+	if (isCounted()) {
+		for (int r = startRadius, rMax = getCountedRadius(); r <= rMax; ++r) {
+
+			// 割引加算
+			payoffSum += sumRingPayoff(player->getId(), r, payoffRow) * discountRatio(r, rMax);
+		}
+
+		// 利得を加える
+		player->addScore(payoffSum);
+		return;
+	}
+
+	// 近傍の設定
+	auto phase = NeighborhoodType::GAME;
+	auto neighbors = player->getNeighbors(phase);
+	if (neighbors == nullptr) {
+		neighbors = std::move(param.getNeighborhoodParameter()->getTopology()->getNeighbors(
+				allPlayers,
+				player->getId(),
+				param.getNeighborhoodParameter()->getNeiborhoodRadius(phase)));
+	}
+
 	// 近傍対戦
 	for (int r = startRadius, rMax = neighbors->size(); r < rMax; ++r) {
 
 		// 割引率
-		double discoutRatio = (-r/(rMax -1 + static_cast<double>(1.0)) + 1.0);
+		double discoutRatio = discountRatio(r, rMax - 1);
 
 		for (auto& opponentWP : *(neighbors->at(r))) {
 
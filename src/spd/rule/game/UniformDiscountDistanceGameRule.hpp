@@ -8,7 +8,7 @@
 #ifndef UniformDiscountDistance_H_
 #define UniformDiscountDistance_H_
 
-#include "../Rule.hpp"
+#include "RingCountingGameRule.hpp"
 
 namespace spd {
 namespace rule {
@@ -17,21 +17,9 @@ namespace rule {
  * 均一な距離割引を扱う対戦ルールを表すクラス
  *
  */
-class UniformDiscountDistance: public spd::rule::Rule {
+class UniformDiscountDistance: public spd::rule::RingCountingGameRule {
 public:
 
-	/**
-	 * プレイヤの初期化ルール
-	 * @note なにもしない
-	 * @param[in, out] player 対象プレイヤ
-	 * @param[in] allPlayers 全てのプレイヤ
-	 * @param[in] param パラメタ
-	 */
-	void initialize(
-			const std::shared_ptr<Player>& player,
-			const AllPlayer& allPlayers,
-			const spd::param::Parameter& param);
-
 	/**
 	 * 均一な距離割引の対戦を行う
 	 *
@@ -53,6 +41,27 @@ public:
 	std::string toString() const {
 		return "UniformDiscountGame";
 	}
+
+protected:
+
+	/**
+	 * 近傍半径ごとの割引率
+	 * @note 近傍半径に比例して一様に割り引く
+	 * @param[in] radius 近傍半径
+	 * @param[in] maxRadius 対戦する最大の近傍半径
+	 * @return 割引率
+	 */
+	double discountRatio(int radius, int maxRadius) const {
+		return (-radius/(maxRadius + static_cast<double>(1.0)) + 1.0);
+	}
+
+	/**
+	 * 割引のある対戦ルールかどうか
+	 * @return 割引があるので true
+	 */
+	bool isDiscounted() const {
+		return true;
+	}
 };
 
 } /* namespace rule */
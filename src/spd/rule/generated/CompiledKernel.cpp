@@ -0,0 +1,177 @@
+/**
+ * CompiledKernel.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "CompiledKernel.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+#include <dlfcn.h>
+#include <unistd.h>
+
+#include <boost/filesystem.hpp>
+
+#include "RuleSource.hpp"
+
+namespace spd {
+namespace rule {
+
+namespace {
+
+/*
+ * 環境変数を取得(無いか空なら既定値)
+ */
+std::string environment(const char* name, const std::string& defaultValue) {
+
+	const char* value = std::getenv(name);
+	return (value != nullptr && *value != '\0') ? std::string(value) : defaultValue;
+}
+
+/*
+ * シェルに渡すために、単一引用符で囲む
+ */
+std::string quote(const std::string& text) {
+
+	std::string quoted = "'";
+	for (char c : text) {
+		if (c == '\'') {
+			quoted += "'\\''";
+		} else {
+			quoted += c;
+		}
+	}
+	return quoted + "'";
+}
+
+/*
+ * 64ビットの FNV-1a ハッシュを16進で求める
+ */
+std::string hashOf(const std::string& text) {
+
+	std::uint64_t value = 14695981039346656037ULL;
+	for (unsigned char c : text) {
+		value ^= c;
+		value *= 1099511628211ULL;
+	}
+
+	char hex[17];
+	std::snprintf(hex, sizeof(hex), "%016llx", static_cast<unsigned long long>(value));
+	return hex;
+}
+
+/*
+ * ファイルの内容を読む(読めなければ空)
+ */
+std::string readFile(const std::string& fileName) {
+
+	std::ifstream file(fileName);
+	std::ostringstream text;
+	text << file.rdbuf();
+	return text.str();
+}
+
+/*
+ * 同じプロセス内で読み込んだカーネル
+ */
+std::mutex loadedMutex;
+std::map<std::string, std::weak_ptr<CompiledKernel>> loaded;
+
+} /* namespace */
+
+/*
+ * ルールのカーネルを取得する
+ *
+ * コンパイルは一時ファイルに出力してから名前を変えるので、
+ * 同じキャッシュを使う複数のプロセスが同時にコンパイルしても、壊れたものを読まない。
+ */
+std::shared_ptr<CompiledKernel> CompiledKernel::load(const RuleSource& source) {
+
+	namespace fs = boost::filesystem;
+
+	std::string code = source.toCpp();
+	std::string compiler = environment("SPD_KERNEL_CXX", "c++");
+	std::string flags = environment("SPD_KERNEL_CXXFLAGS", "-std=c++11 -O3");
+	std::string hash = hashOf(std::to_string(SPD_KERNEL_ABI_VERSION) + "\n"
+			+ compiler + "\n" + flags + "\n" + code);
+
+	std::lock_guard<std::mutex> lock(loadedMutex);
+	auto found = loaded.find(hash);
+	if (found != loaded.end()) {
+		if (auto kernel = found->second.lock()) {
+			return kernel;
+		}
+	}
+
+	std::string home = environment("HOME", "");
+	fs::path cacheDir(environment("SPD_KERNEL_CACHE",
+			home.empty() ? std::string("/tmp/spd_kernels") : home + "/.cache/spd_kernels"));
+	boost::system::error_code ec;
+	fs::create_directories(cacheDir, ec);
+	if (!fs::is_directory(cacheDir)) {
+		throw std::runtime_error("Could not create a kernel cache directory " + cacheDir.string() + ".");
+	}
+
+	fs::path library = cacheDir / (hash + ".so");
+	if (!fs::exists(library)) {
+
+		fs::path sourceFile = cacheDir / (hash + ".cpp");
+		fs::path logFile = cacheDir / (hash + ".log");
+		fs::path temporary = cacheDir / (hash + ".so." + std::to_string(::getpid()));
+		{
+			std::ofstream out(sourceFile.string());
+			out << code;
+			if (!out) {
+				throw std::runtime_error("Could not write a kernel source " + sourceFile.string() + ".");
+			}
+		}
+
+		std::string command = compiler + " " + flags + " -fPIC -shared -o " + quote(temporary.string())
+				+ " " + quote(sourceFile.string()) + " > " + quote(logFile.string()) + " 2>&1";
+		if (std::system(command.c_str()) != 0 || !fs::exists(temporary)) {
+			fs::remove(temporary, ec);
+			throw std::runtime_error("Could not compile a rule " + source.getName() + ":\n"
+					+ command + "\n" + readFile(logFile.string()));
+		}
+		fs::rename(temporary, library);
+	}
+
+	void* handle = ::dlopen(library.string().c_str(), RTLD_NOW | RTLD_LOCAL);
+	if (handle == nullptr) {
+		throw std::runtime_error("Could not load a kernel " + library.string() + ": " + ::dlerror());
+	}
+
+	// 版と引数の大きさが違うものは使わない
+	auto abi = reinterpret_cast<int (*)()>(::dlsym(handle, "spd_kernel_abi"));
+	auto argsSize = reinterpret_cast<unsigned long (*)()>(::dlsym(handle, "spd_kernel_args_size"));
+	auto function = reinterpret_cast<void (*)(const SpdKernelArgs*)>(::dlsym(handle, "spd_kernel_run"));
+	if (abi == nullptr || argsSize == nullptr || function == nullptr ||
+			abi() != SPD_KERNEL_ABI_VERSION || argsSize() != sizeof(SpdKernelArgs)) {
+		::dlclose(handle);
+		throw std::runtime_error("A kernel " + library.string() + " does not match this simulator."
+				" Remove it from the cache and run again.");
+	}
+
+	std::shared_ptr<CompiledKernel> kernel(new CompiledKernel(handle, function, hash));
+	loaded[hash] = kernel;
+	return kernel;
+}
+
+/*
+ * デストラクタ
+ */
+CompiledKernel::~CompiledKernel() {
+	::dlclose(handle);
+}
+
+} /* namespace rule */
+} /* namespace spd */
@@ -0,0 +1,99 @@
+/**
+ * CompiledKernel.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef COMPILEDKERNEL_HPP_
+#define COMPILEDKERNEL_HPP_
+
+#include <memory>
+#include <string>
+
+#include "KernelAbi.hpp"
+
+namespace spd {
+namespace rule {
+
+class RuleSource;
+
+/**
+ * ルールの記述から生成したカーネルを、コンパイルして読み込んだもの
+ *
+ * @par
+ * 生成したソースを、手元のコンパイラで共有ライブラリにし、dlopen で読み込む。<br>
+ * 共有ライブラリは、ソースとコンパイルのコマンドのハッシュを名前としてキャッシュし、
+ * 同じルールは再開時や次の実行でもコンパイルし直さない。同じプロセス内では読み込んだものを共有する。
+ * @par
+ * 環境変数で次を変えられる。
+ * - SPD_KERNEL_CXX: コンパイラ(省略時 c++)
+ * - SPD_KERNEL_CXXFLAGS: コンパイルのオプション(省略時 -std=c++11 -O3)
+ * - SPD_KERNEL_CACHE: キャッシュのディレクトリ(省略時 $HOME/.cache/spd_kernels、HOME が無ければ /tmp/spd_kernels)
+ */
+class CompiledKernel {
+public:
+
+	/**
+	 * ルールのカーネルを取得する(キャッシュに無ければコンパイルする)
+	 * @param[in] source ルール
+	 * @return 読み込んだカーネル
+	 * @throw std::runtime_error コンパイルや読み込みに失敗した場合(コンパイラの出力を含む)
+	 */
+	static std::shared_ptr<CompiledKernel> load(const RuleSource& source);
+
+	/**
+	 * デストラクタ
+	 * @note 共有ライブラリを閉じる
+	 */
+	~CompiledKernel();
+
+	CompiledKernel(const CompiledKernel&) = delete;
+	CompiledKernel& operator=(const CompiledKernel&) = delete;
+
+	/**
+	 * カーネルを実行する
+	 * @param[in] args 引数
+	 */
+	void run(const SpdKernelArgs& args) const {
+		function(&args);
+	};
+
+	/**
+	 * キャッシュの名前に使ったハッシュ
+	 * @return 16進のハッシュ
+	 */
+	const std::string& getHash() const {
+		return hash;
+	};
+
+private:
+
+	/**
+	 * コンストラクタ
+	 * @param[in] handle 共有ライブラリ
+	 * @param[in] function カーネルの関数
+	 * @param[in] hash ハッシュ
+	 */
+	CompiledKernel(void* handle, void (*function)(const SpdKernelArgs*), const std::string& hash) :
+		handle(handle), function(function), hash(hash) {};
+
+	/**
+	 * dlopen で開いた共有ライブラリ
+	 */
+	void* handle;
+
+	/**
+	 * カーネルの関数
+	 */
+	void (*function)(const SpdKernelArgs*);
+
+	/**
+	 * ハッシュ
+	 */
+	std::string hash;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* COMPILEDKERNEL_HPP_ */
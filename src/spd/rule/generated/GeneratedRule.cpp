@@ -0,0 +1,337 @@
+/**
+ * GeneratedRule.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "GeneratedRule.hpp"
+
+#include <random>
+#include <stdexcept>
+
+#include "CompiledKernel.hpp"
+#include "KernelAbi.hpp"
+
+#include "../../core/Player.hpp"
+#include "../../core/Strategy.hpp"
+#include "../../core/StrategyPool.hpp"
+#include "../../param/Parameter.hpp"
+#include "../../param/NeighborhoodParameter.hpp"
+#include "../../param/RandomParameter.hpp"
+#include "../../param/RuntimeParameter.hpp"
+#include "../../topology/Topology.hpp"
+
+namespace spd {
+namespace rule {
+
+namespace {
+
+/*
+ * 行動を 0 (C), 1 (D) にする
+ */
+signed char toDigit(Action action) {
+
+	if (action == Action::ACTION_UN) {
+		// 未定義の行動があった場合終了
+		throw std::runtime_error("The neighbor's action is undefined.");
+	}
+	return (action == Action::ACTION_D) ? 1 : 0;
+}
+
+} /* namespace */
+
+/*
+ * ルールの記述を読み、カーネルを読み込む
+ */
+GeneratedRule::GeneratedRule(const std::string& fileName) :
+		source(RuleSource::load(fileName)),
+		kernel(CompiledKernel::load(source)) {
+
+	switch (source.getKind()) {
+		case RuleSource::Kind::GAME:
+			type = NeighborhoodType::GAME;
+			break;
+		case RuleSource::Kind::ACTION:
+			type = NeighborhoodType::ACTION;
+			break;
+		case RuleSource::Kind::STRATEGY:
+		default:
+			type = NeighborhoodType::STRATEGY;
+			break;
+	}
+}
+
+/*
+ * 構造が作り直されている可能性があるため、まとめた近傍を破棄する
+ */
+void GeneratedRule::initialize(
+		const std::shared_ptr<Player>& player,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param) {
+
+	if (player->getId() == 0) {
+		offsets.clear();
+	}
+}
+
+/*
+ * 1プレイヤ分だけカーネルを実行する
+ */
+void GeneratedRule::runRule(
+		const std::shared_ptr<Player>& player,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step) {
+
+	const NeighborTable* const tables[NeighborhoodType::TYPE_NUM] = {};
+	RuleContext context(allPlayers, param, step, tables);
+	runRange(player->getId(), player->getId() + 1, context);
+}
+
+/*
+ * 近傍をまとめ、カーネルが読むプレイヤの状態を配列に写す
+ *
+ * 対戦は現在の行動、行動更新は前の行動と戦略、戦略のまねは前の利得を読む
+ */
+void GeneratedRule::prepare(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step) {
+
+	// 戦略更新周期でなければ、戦略はまねない
+	active = (source.getKind() != RuleSource::Kind::STRATEGY) ||
+			(step % param.getRuntimeParameter()->getStrategyUpdateCycle() == 0);
+	if (!active) {
+		return;
+	}
+
+	if (offsets.size() != allPlayers.size() + 1) {
+		buildNeighbors(allPlayers, param);
+	}
+
+	int playerNum = allPlayers.size();
+	switch (source.getKind()) {
+		case RuleSource::Kind::GAME:
+			actions.resize(playerNum);
+			for (auto& player : allPlayers) {
+				actions[player->getId()] = toDigit(player->getAction());
+			}
+			outScores.resize(playerNum);
+			break;
+
+		case RuleSource::Kind::ACTION: {
+			actions.resize(playerNum);
+			for (auto& player : allPlayers) {
+				actions[player->getId()] = toDigit(player->getPreAction());
+			}
+
+			// 戦略ごとに、Dの数ごとの行動を並べる
+			auto& pool = param.getStrategyPool();
+			std::vector<int> strategyOffsets(pool->getIdLimit(), -1);
+			decisions.clear();
+			for (int strategyId = 0, idLimit = pool->getIdLimit(); strategyId < idLimit; ++strategyId) {
+				auto& strategy = pool->at(strategyId);
+				if (strategy == nullptr) {
+					continue;
+				}
+				strategyOffsets[strategyId] = decisions.size();
+				for (int dNum = 0, length = strategy->getLength(); dNum < length; ++dNum) {
+					decisions.push_back(toDigit(strategy->actionAt(dNum)));
+				}
+			}
+
+			decisionOffsets.resize(playerNum);
+			decisionLengths.resize(playerNum);
+			for (auto& player : allPlayers) {
+				auto& strategy = player->getStrategy();
+				decisionOffsets[player->getId()] = strategyOffsets.at(strategy->getId());
+				decisionLengths[player->getId()] = strategy->getLength();
+			}
+			outActions.resize(playerNum);
+			break;
+		}
+
+		case RuleSource::Kind::STRATEGY:
+			scores.resize(playerNum);
+			for (auto& player : allPlayers) {
+				scores[player->getId()] = player->getPreScore();
+			}
+			outSources.resize(playerNum);
+			break;
+	}
+
+	if (source.usesRandom()) {
+		uniforms.resize(2 * playerNum);
+	}
+}
+
+/*
+ * プレイヤ位置座標の範囲にカーネルを実行し、結果をプレイヤに戻す
+ *
+ * 乱数はプレイヤとステップごとの乱数列から取り、配列に置いてから渡す
+ */
+void GeneratedRule::runRange(int begin, int end, const RuleContext& context) {
+
+	if (!active || begin >= end) {
+		return;
+	}
+
+	if (source.usesRandom()) {
+		std::uniform_real_distribution<double> uniform(0.0, 1.0);
+		for (int id = begin; id < end; ++id) {
+			auto engine = context.getStream(id, spd::param::RandomPurpose::GENERATED_RULE);
+			uniforms[2 * id] = uniform(engine);
+			uniforms[2 * id + 1] = uniform(engine);
+		}
+	}
+
+	SpdKernelArgs args = {};
+	args.begin = begin;
+	args.end = end;
+	args.offsets = offsets.data();
+	args.ids = ids.data();
+	args.radii = radii.data();
+	args.maxRadius = maxRadius;
+	args.selfInteraction = context.selfInteraction ? 1 : 0;
+	for (int own = 0; own < 2; ++own) {
+		for (int opponent = 0; opponent < 2; ++opponent) {
+			args.payoff[own * 2 + opponent] = context.payoffMatrix[own][opponent];
+		}
+	}
+	args.actions = actions.data();
+	args.decisions = decisions.data();
+	args.decisionOffsets = decisionOffsets.data();
+	args.decisionLengths = decisionLengths.data();
+	args.scores = scores.data();
+	args.uniforms = uniforms.data();
+	args.outScores = outScores.data();
+	args.outActions = outActions.data();
+	args.outSources = outSources.data();
+
+	kernel->run(args);
+
+	auto& allPlayers = context.allPlayers;
+	switch (source.getKind()) {
+		case RuleSource::Kind::GAME:
+			for (int id = begin; id < end; ++id) {
+				allPlayers[id]->addScore(outScores[id]);
+			}
+			break;
+		case RuleSource::Kind::ACTION:
+			for (int id = begin; id < end; ++id) {
+				allPlayers[id]->setAction(outActions[id] ? Action::ACTION_D : Action::ACTION_C);
+			}
+			break;
+		case RuleSource::Kind::STRATEGY:
+			for (int id = begin; id < end; ++id) {
+				auto& player = allPlayers[id];
+				if (outSources[id] >= 0) {
+					player->setStrategy(allPlayers[outSources[id]]->getPreStrategy());
+				}
+
+				// 利得を0にする
+				player->setScore(0.0);
+			}
+			break;
+	}
+}
+
+/*
+ * 近傍が変わったプレイヤの分だけ、近傍をまとめ直す
+ *
+ * 変わらない行は前の配列からまとめて写し、開始位置をずらすだけにする。
+ */
+void GeneratedRule::repairNeighborTables(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		const std::vector<int>& repaired) {
+
+	int playerNum = allPlayers.size();
+	if ((playerNum == 0) || (offsets.size() != static_cast<std::size_t>(playerNum + 1)) ||
+			(allPlayers[0]->getNeighbors(type) == nullptr)) {
+		// まとめていないか、プレイヤ数が変わったか、近傍を空間構造から求めた場合は次の準備処理でまとめる
+		offsets.clear();
+		return;
+	}
+
+	std::vector<int> patchedOffsets(1, 0);
+	std::vector<int> patchedIds;
+	std::vector<int> patchedRadii;
+	patchedOffsets.reserve(playerNum + 1);
+	patchedIds.reserve(ids.size());
+	patchedRadii.reserve(radii.size());
+
+	// [copied, until) の行を前の配列から写す
+	int copied = 0;
+	auto copyRows = [&](int until) {
+		int shift = static_cast<int>(patchedIds.size()) - offsets[copied];
+		patchedIds.insert(patchedIds.end(), ids.begin() + offsets[copied], ids.begin() + offsets[until]);
+		patchedRadii.insert(patchedRadii.end(), radii.begin() + offsets[copied], radii.begin() + offsets[until]);
+		for (int id = copied; id < until; ++id) {
+			patchedOffsets.push_back(offsets[id + 1] + shift);
+		}
+	};
+
+	for (int id : repaired) {
+		copyRows(id);
+		appendNeighbors(allPlayers, param, id, patchedIds, patchedRadii);
+		patchedOffsets.push_back(patchedIds.size());
+		copied = id + 1;
+	}
+	copyRows(playerNum);
+
+	offsets.swap(patchedOffsets);
+	ids.swap(patchedIds);
+	radii.swap(patchedRadii);
+}
+
+/*
+ * 近傍を近傍半径つきの配列にまとめる
+ */
+void GeneratedRule::buildNeighbors(const AllPlayer& allPlayers, const spd::param::Parameter& param) {
+
+	maxRadius = param.getNeighborhoodParameter()->getNeiborhoodRadius(type);
+
+	offsets.assign(1, 0);
+	ids.clear();
+	radii.clear();
+	for (int id = 0, playerNum = allPlayers.size(); id < playerNum; ++id) {
+		appendNeighbors(allPlayers, param, id, ids, radii);
+		offsets.push_back(ids.size());
+	}
+}
+
+/*
+ * プレイヤの近傍を、近傍半径とともに走査順に追加する
+ *
+ * 近傍を保持していないプレイヤは、空間構造から求める
+ */
+void GeneratedRule::appendNeighbors(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int id,
+		std::vector<int>& neighborIds,
+		std::vector<int>& neighborRadii) const {
+
+	auto neighbors = allPlayers[id]->getNeighbors(type);
+	if (neighbors == nullptr) {
+		neighbors = param.getNeighborhoodParameter()->getTopology()->getNeighbors(allPlayers, id, maxRadius);
+	}
+
+	// 自身は含めないので1から
+	for (int r = 1, rMax = neighbors->size(); r < rMax; ++r) {
+		for (auto& neighborWP : *(neighbors->at(r))) {
+			auto neighbor = neighborWP.lock();
+			if (neighbor == nullptr) {
+				// 近傍がいない場合終了
+				throw std::runtime_error("Could not find a neighbor of a player.");
+			}
+			neighborIds.push_back(neighbor->getId());
+			neighborRadii.push_back(r);
+		}
+	}
+}
+
+} /* namespace rule */
+} /* namespace spd */
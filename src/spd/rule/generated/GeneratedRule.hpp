@@ -0,0 +1,232 @@
+/**
+ * GeneratedRule.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef GENERATEDRULE_HPP_
+#define GENERATEDRULE_HPP_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../Rule.hpp"
+#include "RuleSource.hpp"
+
+namespace spd {
+namespace rule {
+
+class CompiledKernel;
+
+/**
+ * ルールの記述言語で書かれたルールを、コンパイルしたカーネルで実行するルール
+ *
+ * @par
+ * 作成時に記述を読み、カーネルを生成してコンパイルし、読み込む(キャッシュがあればそれを使う)。<br>
+ * 近傍は近傍半径つきの配列にまとめて構造が変わるまで使い回し、プレイヤの状態は
+ * 準備処理で配列に写す。runRange はプレイヤの範囲ごとにカーネルを呼び、結果をプレイヤに戻す。
+ * @par
+ * ルールの記述は RuleSource を参照。
+ * 乱数はプレイヤとステップごとの乱数列から取るので、結果はコア数によらない。
+ */
+class GeneratedRule: public spd::rule::Rule {
+public:
+
+	/**
+	 * ルールの記述を読み、カーネルを読み込む
+	 * @param[in] fileName ルールの記述のファイル名
+	 * @throw std::invalid_argument 記述に誤りがある場合
+	 * @throw std::runtime_error コンパイルや読み込みに失敗した場合
+	 */
+	explicit GeneratedRule(const std::string& fileName);
+
+	/**
+	 * プレイヤの初期化ルール
+	 * @note 構造が作り直されている可能性があるため、まとめた近傍を破棄する
+	 * @param[in, out] player 対象プレイヤ
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 */
+	void initialize(
+			const std::shared_ptr<Player>& player,
+			const AllPlayer& allPlayers,
+			const spd::param::Parameter& param);
+
+	/**
+	 * 1プレイヤ分だけカーネルを実行する
+	 * @note 準備処理の後に呼ばれる必要がある
+	 * @param[in, out] player 対象プレイヤ
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @param[in] step 実行ステップ
+	 */
+	void runRule(
+			const std::shared_ptr<Player>& player,
+			const AllPlayer& allPlayers,
+			const spd::param::Parameter& param,
+			int step);
+
+	/**
+	 * プレイヤ位置座標の範囲にカーネルを実行し、結果をプレイヤに戻す
+	 * @param[in] begin 開始プレイヤ位置座標
+	 * @param[in] end 終了プレイヤ位置座標(これを含まない)
+	 * @param[in] context 解決済みの情報
+	 */
+	void runRange(int begin, int end, const RuleContext& context);
+
+	/**
+	 * 近傍をまとめ、カーネルが読むプレイヤの状態を配列に写す
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @param[in] step 実行ステップ
+	 * @throw std::runtime_error 行動が未定義のプレイヤがいる場合
+	 */
+	void prepare(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step);
+
+	/**
+	 * まとめた近傍を破棄する
+	 */
+	void resetNeighborTables() {
+		offsets.clear();
+	};
+
+	/**
+	 * 近傍が変わったプレイヤの分だけ、近傍をまとめ直す
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @param[in] repaired 近傍が変わったプレイヤ位置座標(昇順)
+	 * @throw std::runtime_error 近傍のプレイヤが存在しない場合
+	 */
+	void repairNeighborTables(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		const std::vector<int>& repaired);
+
+	/**
+	 * ルール情報の文字出力
+	 * @return "Generated(ファイル名)"
+	 */
+	std::string toString() const {
+		return "Generated(" + source.getName() + ")";
+	}
+
+private:
+
+	/**
+	 * ルールの記述
+	 */
+	RuleSource source;
+
+	/**
+	 * 読み込んだカーネル
+	 */
+	std::shared_ptr<CompiledKernel> kernel;
+
+	/**
+	 * 近傍の種類
+	 */
+	NeighborhoodType type;
+
+	/**
+	 * このステップで実行するかどうか(戦略更新周期でないステップは実行しない)
+	 */
+	bool active = false;
+
+	/**
+	 * 最大の近傍半径
+	 */
+	int maxRadius = 0;
+
+	/**
+	 * プレイヤ位置座標ごとの、近傍配列の開始位置(まとめていない場合は空)
+	 */
+	std::vector<int> offsets;
+
+	/**
+	 * 近傍のプレイヤ位置座標
+	 */
+	std::vector<int> ids;
+
+	/**
+	 * 近傍ごとの近傍半径
+	 */
+	std::vector<int> radii;
+
+	/**
+	 * プレイヤの行動(対戦は現在の行動、行動更新は前の行動)
+	 */
+	std::vector<signed char> actions;
+
+	/**
+	 * 全戦略の、Dの数ごとの行動
+	 */
+	std::vector<signed char> decisions;
+
+	/**
+	 * プレイヤの戦略の、decisions での開始位置
+	 */
+	std::vector<int> decisionOffsets;
+
+	/**
+	 * プレイヤの戦略の長さ
+	 */
+	std::vector<int> decisionLengths;
+
+	/**
+	 * プレイヤの前の利得
+	 */
+	std::vector<double> scores;
+
+	/**
+	 * プレイヤごとの一様乱数
+	 */
+	std::vector<double> uniforms;
+
+	/**
+	 * カーネルの結果(利得)
+	 */
+	std::vector<double> outScores;
+
+	/**
+	 * カーネルの結果(行動)
+	 */
+	std::vector<signed char> outActions;
+
+	/**
+	 * カーネルの結果(まねるプレイヤ)
+	 */
+	std::vector<int> outSources;
+
+	/**
+	 * 近傍を近傍半径つきの配列にまとめる
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @throw std::runtime_error 近傍のプレイヤが存在しない場合
+	 */
+	void buildNeighbors(const AllPlayer& allPlayers, const spd::param::Parameter& param);
+
+	/**
+	 * プレイヤの近傍を、近傍半径とともに走査順に追加する
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @param[in] id プレイヤ位置座標
+	 * @param[in, out] neighborIds 近傍のプレイヤ位置座標
+	 * @param[in, out] neighborRadii 近傍ごとの近傍半径
+	 * @throw std::runtime_error 近傍のプレイヤが存在しない場合
+	 */
+	void appendNeighbors(
+			const AllPlayer& allPlayers,
+			const spd::param::Parameter& param,
+			int id,
+			std::vector<int>& neighborIds,
+			std::vector<int>& neighborRadii) const;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* GENERATEDRULE_HPP_ */
@@ -0,0 +1,74 @@
+/**
+ * KernelAbi.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef KERNELABI_HPP_
+#define KERNELABI_HPP_
+
+/**
+ * 生成したカーネルに渡す引数の定義
+ *
+ * @par
+ * 生成するソースは本体のヘッダを参照しないので、同じ定義を文字列としても埋め込む。<br>
+ * 定義を変えた場合は SPD_KERNEL_ABI_VERSION を上げ、キャッシュしたカーネルを作り直させる。
+ * @note 定義にはカンマを使わない(文字列化のため)
+ */
+#define SPD_KERNEL_ARGS_DEFINITION \
+struct SpdKernelArgs { \
+	int begin; \
+	int end; \
+	const int* offsets; \
+	const int* ids; \
+	const int* radii; \
+	int maxRadius; \
+	int selfInteraction; \
+	double payoff[4]; \
+	const signed char* actions; \
+	const signed char* decisions; \
+	const int* decisionOffsets; \
+	const int* decisionLengths; \
+	const double* scores; \
+	const double* uniforms; \
+	double* outScores; \
+	signed char* outActions; \
+	int* outSources; \
+};
+
+/**
+ * 引数の定義の版
+ */
+#define SPD_KERNEL_ABI_VERSION 1
+
+#define SPD_KERNEL_STRINGIFY_(...) #__VA_ARGS__
+#define SPD_KERNEL_STRINGIFY(...) SPD_KERNEL_STRINGIFY_(__VA_ARGS__)
+
+namespace spd {
+namespace rule {
+
+/**
+ * 生成したカーネルに渡す引数
+ *
+ * @par
+ * 配列はすべてプレイヤ位置座標で引き、カーネルは [begin, end) のプレイヤだけを書き換える。
+ * - offsets, ids, radii: 近傍(CSR形式、自身は含めない)と、各近傍の近傍半径
+ * - payoff: 利得行列(自身の行動 * 2 + 相手の行動)
+ * - actions: 行動(C は 0, D は 1)
+ * - decisions, decisionOffsets, decisionLengths: 全戦略の、Dの数ごとの行動を並べたものと、
+ *   各プレイヤの戦略の開始位置と長さ(行動ルールのみ)
+ * - scores: 前の利得(戦略ルールのみ)
+ * - uniforms: プレイヤごとに2つの [0, 1) の一様乱数
+ * - outScores, outActions, outSources: 加える利得、次の行動、戦略をまねるプレイヤ(まねない場合は -1)
+ */
+SPD_KERNEL_ARGS_DEFINITION
+
+/**
+ * 生成するソースに埋め込む、引数の定義
+ */
+constexpr const char* KERNEL_ARGS_SOURCE = SPD_KERNEL_STRINGIFY(SPD_KERNEL_ARGS_DEFINITION);
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* KERNELABI_HPP_ */
@@ -0,0 +1,383 @@
+/**
+ * RuleSource.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "RuleSource.hpp"
+
+#include <cctype>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+#include "KernelAbi.hpp"
+
+namespace spd {
+namespace rule {
+
+namespace {
+
+/*
+ * 式で使える関数
+ */
+const std::set<std::string> FUNCTIONS {
+	"exp", "log", "sqrt", "pow", "abs", "min", "max", "floor", "ceil"
+};
+
+/*
+ * 式で使える演算子(長いものから調べる)
+ */
+const char* const OPERATORS[] {
+	"<=", ">=", "==", "!=", "&&", "||",
+	"+", "-", "*", "/", "<", ">", "!", "?", ":", "(", ")", ","
+};
+
+/*
+ * 前後の空白を除く
+ */
+std::string trim(const std::string& text) {
+
+	auto first = text.find_first_not_of(" \t\r");
+	if (first == std::string::npos) {
+		return "";
+	}
+	auto last = text.find_last_not_of(" \t\r");
+	return text.substr(first, last - first + 1);
+}
+
+/*
+ * 種類ごとの、定義できる名前と使える変数
+ */
+std::map<std::string, std::set<std::string>> definableNames(RuleSource::Kind kind) {
+
+	switch (kind) {
+		case RuleSource::Kind::GAME:
+			return {
+				{"pair", {"a", "b", "p", "r", "R", "n"}},
+				{"score", {"sum", "n"}}
+			};
+		case RuleSource::Kind::ACTION:
+			return {
+				{"defect", {"d", "n", "s", "u"}}
+			};
+		case RuleSource::Kind::STRATEGY:
+		default:
+			return {
+				{"adopt", {"si", "sj", "n"}}
+			};
+	}
+}
+
+/*
+ * 式で使う関数の定義(同じ名前の大域関数より先に見つかるよう、名前空間に置く)
+ */
+const char* const EXPRESSION_PRELUDE =
+		"#include <cmath>\n"
+		"namespace spd_expr {\n"
+		"using std::exp; using std::log; using std::sqrt; using std::pow;\n"
+		"using std::floor; using std::ceil;\n"
+		"inline double abs(double x) { return std::fabs(x); }\n"
+		"inline double min(double x, double y) { return std::fmin(x, y); }\n"
+		"inline double max(double x, double y) { return std::fmax(x, y); }\n";
+
+} /* namespace */
+
+/*
+ * ファイルからルールを読む
+ */
+RuleSource RuleSource::load(const std::string& fileName) {
+
+	std::ifstream file(fileName);
+	if (!file) {
+		throw std::invalid_argument("Could not read a rule file " + fileName + ".");
+	}
+
+	std::ostringstream text;
+	text << file.rdbuf();
+	return parse(text.str(), fileName);
+}
+
+/*
+ * 文字列からルールを読む
+ *
+ * 式は種類が決まってから確かめるので、kind は式より後に書いてもよい
+ */
+RuleSource RuleSource::parse(const std::string& text, const std::string& name) {
+
+	RuleSource source;
+	source.name = name;
+
+	std::map<std::string, std::pair<std::string, int>> values;
+	std::istringstream lines(text);
+	std::string line;
+	for (int lineNum = 1; std::getline(lines, line); ++lineNum) {
+
+		line = trim(line.substr(0, line.find('#')));
+		if (line.empty()) {
+			continue;
+		}
+
+		auto equal = line.find('=');
+		std::string where = name + ":" + std::to_string(lineNum);
+		if (equal == std::string::npos) {
+			throw std::invalid_argument(where + ": expected NAME = VALUE.");
+		}
+		std::string key = trim(line.substr(0, equal));
+		std::string value = trim(line.substr(equal + 1));
+		if (key.empty() || value.empty()) {
+			throw std::invalid_argument(where + ": expected NAME = VALUE.");
+		}
+		if (!values.insert(std::make_pair(key, std::make_pair(value, lineNum))).second) {
+			throw std::invalid_argument(where + ": " + key + " is defined twice.");
+		}
+	}
+
+	// 種類
+	auto kindValue = values.find("kind");
+	if (kindValue == values.end()) {
+		throw std::invalid_argument(name + ": kind is not defined (game, action or strategy).");
+	}
+	const std::string& kindName = kindValue->second.first;
+	if (kindName == "game") {
+		source.kind = Kind::GAME;
+	} else if (kindName == "action") {
+		source.kind = Kind::ACTION;
+	} else if (kindName == "strategy") {
+		source.kind = Kind::STRATEGY;
+	} else {
+		throw std::invalid_argument(name + ":" + std::to_string(kindValue->second.second)
+				+ ": unknown kind " + kindName + " (game, action or strategy).");
+	}
+	values.erase(kindValue);
+
+	// 式
+	auto names = definableNames(source.kind);
+	for (auto& value : values) {
+		std::string where = name + ":" + std::to_string(value.second.second);
+		auto definable = names.find(value.first);
+		if (definable == names.end()) {
+			throw std::invalid_argument(where + ": " + value.first
+					+ " cannot be defined for kind " + kindName + ".");
+		}
+		auto used = validate(value.second.first, definable->second, where);
+		source.usedVariables.insert(used.begin(), used.end());
+		source.definitions[value.first] = value.second.first;
+	}
+
+	// 必須の式と、省略時の式
+	const char* required = (source.kind == Kind::GAME) ? "pair"
+			: (source.kind == Kind::ACTION) ? "defect" : "adopt";
+	if (source.definitions.find(required) == source.definitions.end()) {
+		throw std::invalid_argument(name + ": " + required + " is not defined.");
+	}
+	if (source.kind == Kind::GAME) {
+		source.definitions.insert(std::make_pair("score", "sum"));
+	}
+
+	return source;
+}
+
+/*
+ * 式を字句に分けて確かめる
+ *
+ * 関数名の直後は必ず '(' とし、変数名は関数として呼べない
+ */
+std::set<std::string> RuleSource::validate(
+		const std::string& expression,
+		const std::set<std::string>& variables,
+		const std::string& where) {
+
+	std::set<std::string> used;
+	int depth = 0;
+	bool expectsParenthesis = false;
+
+	for (std::size_t pos = 0; pos < expression.size(); ) {
+		char c = expression[pos];
+
+		if (std::isspace(static_cast<unsigned char>(c))) {
+			++pos;
+			continue;
+		}
+
+		if (expectsParenthesis && c != '(') {
+			throw std::invalid_argument(where + ": a function must be followed by '('.");
+		}
+		expectsParenthesis = false;
+
+		// 数値
+		if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+			std::size_t end = pos;
+			while (end < expression.size() &&
+					(std::isdigit(static_cast<unsigned char>(expression[end])) || expression[end] == '.')) {
+				++end;
+			}
+			if (end < expression.size() && (expression[end] == 'e' || expression[end] == 'E')) {
+				std::size_t exponent = end + 1;
+				if (exponent < expression.size() && (expression[exponent] == '+' || expression[exponent] == '-')) {
+					++exponent;
+				}
+				if (exponent < expression.size() && std::isdigit(static_cast<unsigned char>(expression[exponent]))) {
+					end = exponent;
+					while (end < expression.size() && std::isdigit(static_cast<unsigned char>(expression[end]))) {
+						++end;
+					}
+				}
+			}
+			std::string number = expression.substr(pos, end - pos);
+			if (number.find('.') != number.rfind('.') || number == ".") {
+				throw std::invalid_argument(where + ": malformed number " + number + ".");
+			}
+			pos = end;
+			continue;
+		}
+
+		// 変数と関数
+		if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+			std::size_t end = pos;
+			while (end < expression.size() &&
+					(std::isalnum(static_cast<unsigned char>(expression[end])) || expression[end] == '_')) {
+				++end;
+			}
+			std::string identifier = expression.substr(pos, end - pos);
+			if (variables.count(identifier) > 0) {
+				used.insert(identifier);
+			} else if (FUNCTIONS.count(identifier) > 0) {
+				expectsParenthesis = true;
+			} else {
+				std::string allowed;
+				for (auto& variable : variables) {
+					allowed += " " + variable;
+				}
+				throw std::invalid_argument(where + ": unknown name " + identifier
+						+ " (variables:" + allowed + ").");
+			}
+			pos = end;
+			continue;
+		}
+
+		// 演算子
+		bool matched = false;
+		for (const char* op : OPERATORS) {
+			std::string symbol(op);
+			if (expression.compare(pos, symbol.size(), symbol) == 0) {
+				if (symbol == "(") {
+					++depth;
+				} else if (symbol == ")" && --depth < 0) {
+					throw std::invalid_argument(where + ": unbalanced ')'.");
+				}
+				pos += symbol.size();
+				matched = true;
+				break;
+			}
+		}
+		if (!matched) {
+			throw std::invalid_argument(where + ": unexpected character '" + std::string(1, c) + "'.");
+		}
+	}
+
+	if (expectsParenthesis) {
+		throw std::invalid_argument(where + ": a function must be followed by '('.");
+	}
+	if (depth != 0) {
+		throw std::invalid_argument(where + ": unbalanced '('.");
+	}
+	return used;
+}
+
+/*
+ * 乱数を使うかどうか
+ *
+ * 戦略のまねは、まねる近傍を選ぶために常に使う
+ */
+bool RuleSource::usesRandom() const {
+	return (kind == Kind::STRATEGY) || (usedVariables.count("u") > 0);
+}
+
+/*
+ * カーネルの C++ ソースに変換する
+ *
+ * 変数はすべて double とし、式は名前空間 spd_expr の関数の中に置く
+ */
+std::string RuleSource::toCpp() const {
+
+	std::ostringstream source;
+	source << "// generated from " << name << "\n"
+			<< EXPRESSION_PRELUDE;
+
+	switch (kind) {
+		case Kind::GAME:
+			source << "inline double pair(double a, double b, double p, double r, double R, double n) {\n"
+					<< "\treturn (" << definitions.at("pair") << ");\n}\n"
+					<< "inline double score(double sum, double n) {\n"
+					<< "\treturn (" << definitions.at("score") << ");\n}\n";
+			break;
+		case Kind::ACTION:
+			source << "inline double defect(double d, double n, double s, double u) {\n"
+					<< "\treturn (" << definitions.at("defect") << ");\n}\n";
+			break;
+		case Kind::STRATEGY:
+			source << "inline double adopt(double si, double sj, double n) {\n"
+					<< "\treturn (" << definitions.at("adopt") << ");\n}\n";
+			break;
+	}
+
+	source << "}\n"
+			<< KERNEL_ARGS_SOURCE << "\n"
+			<< "extern \"C\" int spd_kernel_abi() { return " << SPD_KERNEL_ABI_VERSION << "; }\n"
+			<< "extern \"C\" unsigned long spd_kernel_args_size() { return sizeof(SpdKernelArgs); }\n"
+			<< "extern \"C\" void spd_kernel_run(const SpdKernelArgs* args) {\n"
+			<< "\tfor (int i = args->begin; i < args->end; ++i) {\n"
+			<< "\t\tconst int from = args->offsets[i];\n"
+			<< "\t\tconst int to = args->offsets[i + 1];\n";
+
+	switch (kind) {
+		case Kind::GAME:
+			source << "\t\tconst int a = args->actions[i];\n"
+					<< "\t\tconst double n = (to - from) + (args->selfInteraction ? 1 : 0);\n"
+					<< "\t\tconst double R = args->maxRadius;\n"
+					<< "\t\tdouble sum = 0.0;\n"
+					<< "\t\tif (args->selfInteraction) {\n"
+					<< "\t\t\tsum += spd_expr::pair(a, a, args->payoff[a * 2 + a], 0, R, n);\n"
+					<< "\t\t}\n"
+					<< "\t\tfor (int k = from; k < to; ++k) {\n"
+					<< "\t\t\tconst int b = args->actions[args->ids[k]];\n"
+					<< "\t\t\tsum += spd_expr::pair(a, b, args->payoff[a * 2 + b], args->radii[k], R, n);\n"
+					<< "\t\t}\n"
+					<< "\t\targs->outScores[i] = spd_expr::score(sum, n);\n";
+			break;
+		case Kind::ACTION:
+			source << "\t\tint d = 0;\n"
+					<< "\t\tfor (int k = from; k < to; ++k) {\n"
+					<< "\t\t\td += args->actions[args->ids[k]];\n"
+					<< "\t\t}\n"
+					<< "\t\tconst int n = to - from;\n"
+					<< "\t\tconst int length = args->decisionLengths[i];\n"
+					<< "\t\tconst int position = (length == n + 1) ? d : (n == 0) ? 0\n"
+					<< "\t\t\t\t: static_cast<int>(d * (length - 1.0) / n + 0.5);\n"
+					<< "\t\tconst int s = args->decisions[args->decisionOffsets[i] + position];\n"
+					<< "\t\targs->outActions[i] = (spd_expr::defect(d, n, s, args->uniforms[2 * i]) != 0) ? 1 : 0;\n";
+			break;
+		case Kind::STRATEGY:
+			source << "\t\targs->outSources[i] = -1;\n"
+					<< "\t\tif (to == from) {\n"
+					<< "\t\t\tcontinue;\n"
+					<< "\t\t}\n"
+					<< "\t\tint k = from + static_cast<int>(args->uniforms[2 * i] * (to - from));\n"
+					<< "\t\tif (k >= to) {\n"
+					<< "\t\t\tk = to - 1;\n"
+					<< "\t\t}\n"
+					<< "\t\tconst int j = args->ids[k];\n"
+					<< "\t\tif (args->uniforms[2 * i + 1] < spd_expr::adopt(args->scores[i], args->scores[j], to - from)) {\n"
+					<< "\t\t\targs->outSources[i] = j;\n"
+					<< "\t\t}\n";
+			break;
+	}
+
+	source << "\t}\n}\n";
+	return source.str();
+}
+
+} /* namespace rule */
+} /* namespace spd */
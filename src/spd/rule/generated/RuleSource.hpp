@@ -0,0 +1,133 @@
+/**
+ * RuleSource.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef RULESOURCE_HPP_
+#define RULESOURCE_HPP_
+
+#include <map>
+#include <set>
+#include <string>
+
+namespace spd {
+namespace rule {
+
+/**
+ * ルールの記述言語で書かれたルールを読み、カーネルの C++ ソースに変換するクラス
+ *
+ * @par
+ * 記述は1行に1つの「名前 = 値」で、# から行末まではコメントとする。<br>
+ * kind でルールの種類を選び、種類ごとに決まった名前の式を定義する。
+ * - kind = game: 近傍との対戦。pair (必須) は1対戦の利得、score (省略時 sum) は加える利得
+ *   - pair で使える変数: a, b (自身と相手の行動、C は 0, D は 1), p (利得行列の値),
+ *     r (相手の近傍半径、自己対戦は 0), R (最大の近傍半径), n (対戦数)
+ *   - score で使える変数: sum (pair の総和), n (対戦数)
+ * - kind = action: 行動更新。defect (必須) が 0 以外なら次の行動を D とする
+ *   - 使える変数: d (前の行動が D の近傍数), n (近傍数), s (戦略が選ぶ行動、
+ *     近傍数と戦略の長さが異なる場合は d を比例させて丸めた位置の行動), u ([0, 1) の一様乱数)
+ * - kind = strategy: 戦略のまね。一様に選んだ近傍1人の戦略を、確率 adopt (必須) でまねる
+ *   - 使える変数: si, sj (自身と近傍の前の利得), n (近傍数)
+ * @par
+ * 式には数値、変数、+ - * / の四則演算、比較、&& || !、条件演算子 ?:、括弧と、
+ * 関数 exp, log, sqrt, pow, abs, min, max, floor, ceil だけを使える。
+ * それ以外の字句は変換前に拒否するので、生成するソースに任意のコードは入らない。
+ */
+class RuleSource {
+public:
+
+	/**
+	 * ルールの種類
+	 */
+	enum class Kind {
+		GAME, /**< 近傍との対戦 */
+		ACTION, /**< 行動更新 */
+		STRATEGY, /**< 戦略のまね */
+	};
+
+	/**
+	 * ファイルからルールを読む
+	 * @param[in] fileName ファイル名
+	 * @return 読んだルール
+	 * @throw std::invalid_argument ファイルを読めない場合や、記述に誤りがある場合
+	 */
+	static RuleSource load(const std::string& fileName);
+
+	/**
+	 * 文字列からルールを読む
+	 * @param[in] text 記述
+	 * @param[in] name エラー表示に使う名前
+	 * @return 読んだルール
+	 * @throw std::invalid_argument 記述に誤りがある場合
+	 */
+	static RuleSource parse(const std::string& text, const std::string& name);
+
+	/**
+	 * ルールの種類
+	 * @return 種類
+	 */
+	Kind getKind() const {
+		return kind;
+	};
+
+	/**
+	 * 名前(ファイル名)
+	 * @return 名前
+	 */
+	const std::string& getName() const {
+		return name;
+	};
+
+	/**
+	 * 乱数を使うかどうか
+	 * @return 一様乱数を使う場合 true
+	 */
+	bool usesRandom() const;
+
+	/**
+	 * カーネルの C++ ソースに変換する
+	 * @return ソース
+	 */
+	std::string toCpp() const;
+
+private:
+
+	/**
+	 * 種類
+	 */
+	Kind kind = Kind::GAME;
+
+	/**
+	 * 名前
+	 */
+	std::string name;
+
+	/**
+	 * 定義した式
+	 */
+	std::map<std::string, std::string> definitions;
+
+	/**
+	 * 式で使った変数
+	 */
+	std::set<std::string> usedVariables;
+
+	/**
+	 * 式を字句に分けて確かめる
+	 * @param[in] expression 式
+	 * @param[in] variables 使える変数
+	 * @param[in] where エラー表示に使う位置
+	 * @return 使った変数
+	 * @throw std::invalid_argument 使えない字句がある場合や、括弧が対応しない場合
+	 */
+	static std::set<std::string> validate(
+			const std::string& expression,
+			const std::set<std::string>& variables,
+			const std::string& where);
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* RULESOURCE_HPP_ */
@@ -8,7 +8,6 @@
 
 #include <stdexcept>
 #include <vector>
-#include <thread>
 
 #include "../../core/Player.hpp"
 #include "../../core/Strategy.hpp"
@@ -18,6 +17,7 @@
 #include "countingRule/PropCount.hpp"
 
 #include "MembraneDetectRule.hpp"
+#include "FrontierPropagation.hpp"
 
 namespace spd {
 namespace rule {
@@ -35,165 +35,122 @@ void AffectedPlayerRule::initialize(
 		const spd::param::Parameter& param) {
 
 	initProp(player);
+
+	// 構造が変わり得るので、まとめた近傍を破棄
+	classification.clear();
 }
 
 /*
- * 影響検知
- * @param[in, out] player 対象プレイヤ
- * @param[in] allPlayers 全てのプレイヤ
- * @param[in] param パラメタ
- * @param[in] step 実行ステップ
+ * 分岐元の影響の検知結果を引き継ぐ
+ *
+ * 膜検知の結果は、分岐先の膜検知ルールが引き継ぐ
  */
-void AffectedPlayerRule::runRule(
-		const std::shared_ptr<Player>& frontPlayer,
+void AffectedPlayerRule::takeOverState(
+		const Rule& base,
 		const AllPlayer& allPlayers,
-		const spd::param::Parameter& param,
-		int step) {
-
-	NeighborhoodType neiType = NeighborhoodType::GAME;
-
-
-	bool notStable;
-
-	// 初のプレイヤの時だけ
-	if (frontPlayer->getId() != 0) {
-		return;
-	}
-
-	// 初期化
-	for (auto& player : allPlayers) {
-		initProp(player);
-	}
+		const spd::param::Parameter& param) {
 
-	auto filter = filtering(allPlayers, param);
+	auto& baseRule = static_cast<const AffectedPlayerRule&>(base);
+	memGroups = baseRule.memGroups;
+	affects = baseRule.affects;
+	nextAffects = baseRule.nextAffects;
+}
 
-	int core = param.getCore();
+/*
+ * 影響検知
+ *
+ * 同じステップで膜検知ルールが検知していれば、その接触の種類と膜グループを使う。
+ * プロパティは最後にまとめて設定し、途中の状態はプレイヤ位置座標の配列で持つ。
+ * @param[in] context 解決済みの情報
+ * @param[in] workers 共有のワーカ
+ */
+void AffectedPlayerRule::runGlobal(const RuleContext& context, const WorkerPool& workers) {
 
-	// 1コアが担当するプレイヤ数
+	auto& allPlayers = context.allPlayers;
 	int playerNum = allPlayers.size();
-	int breadth = playerNum / core;
-
-	std::vector<std::thread> thr(core);
-	for (int i = 0, size = thr.size(); i < size; ++i) {
-		thr[i] = std::thread(
-				[&, i]{
 
-			int from = breadth * i;
-			int to = (i + 1 < core) ? breadth * (i + 1) : playerNum;
-
-			for (int id = from; id < to; ++id) {
-				directAffect(allPlayers[id], neiType, filter);
-			}
+	const ContactClassification* contact = &classification;
+	const std::vector<int>* groups = &memGroups;
+	if ((membraneRule != nullptr) && (membraneRule->getAnalyzedStep() == context.step)) {
+		contact = &(membraneRule->getClassification());
+		groups = &(membraneRule->getGroups());
+	} else {
+		classification.classify(allPlayers, context.param, workers);
+		memGroups.resize(playerNum);
+		for (int id = 0; id < playerNum; ++id) {
+			memGroups[id] = allPlayers[id]->getProperty("MemGroup").getValueAs<int>();
 		}
-		);
-	}
-	for (std::thread& t : thr) {
-		t.join();
 	}
 
-	// 検知開始
-	std::vector<bool> changes(core);
-	do {
-
-		// 調べる(1ステップ)
-		for (int i = 0, size = thr.size(); i < size; ++i) {
-			thr[i] = std::thread(
-					[&, i]{
-
-				int from = breadth * i;
-				int to = (i + 1 < core) ? breadth * (i + 1) : playerNum;
+	affects.resize(playerNum);
+	nextAffects.resize(playerNum);
 
-				for (int id = from; id < to; ++id) {
-					spreadAffect(allPlayers[id], neiType);
-				}
-			}
-			);
-		}
-		for (std::thread& t : thr) {
-			t.join();
+	std::vector<int> frontier;
+	for (int id = 0; id < playerNum; ++id) {
+		directAffect(id, *contact, *groups);
+		if (affects[id] == static_cast<int>(Affect::BLANK)) {
+			frontier.push_back(id);
 		}
+	}
 
-		// アップデート
-		for (int i = 0, size = thr.size(); i < size; ++i) {
-			thr[i] = std::thread(
-					[&, i]{
-				bool result = false;
-
-				int from = breadth * i;
-				int to = (i + 1 < core) ? breadth * (i + 1) : playerNum;
-
-				for (int id = from; id < to; ++id) {
-					result = changesStatus(allPlayers[id]) || result;
-				}
-				changes[i] = result;
-			}
-			);
-		}
-		notStable = false;
-		for (int i = 0, size = thr.size(); i < size; ++i) {
-			thr[i].join();
-			notStable = changes[i] || notStable;
+	// 検知開始
+	propagateFrontier(frontier, contact->getReaderTable(), workers,
+			[&](int id) { return affects[id] == static_cast<int>(Affect::BLANK); },
+			[&](int id) { return spreadAffect(id, *contact); },
+			[&](int id) { changesStatus(id); });
+
+	// プロパティへ設定
+	workers.run(playerNum,
+			[&](int worker, int from, int to) {
+		for (int id = from; id < to; ++id) {
+			allPlayers[id]->getProperty(PROP_NAMES[0]).setValue(affects[id]);
+			allPlayers[id]->getProperty(PROP_NAMES[1]).setValue(nextAffects[id]);
 		}
-	} while (notStable);
-
+	});
 }
 
 /*
  * 直接な影響
  */
-void AffectedPlayerRule::directAffect(const std::shared_ptr<Player> player,
-			NeighborhoodType type,
-			std::vector<bool>& filter) {
+void AffectedPlayerRule::directAffect(int id,
+			const ContactClassification& contact,
+			const std::vector<int>& groups) {
 
-	auto playerStrategyId = player->getStrategy()->getId();
-	auto playerAction = player->getAction();
+	auto& strategies = contact.getStrategies();
+	auto& actions = contact.getActions();
+	int playerStrategyId = strategies[id];
+	int playerAction = actions[id];
 
 	// フィルタリング
 	// 逆の行動
 	int oppsiteActInt = 0;
-	if (spd::core::converter::actionToChar(playerAction) != 'D') {
+	if (playerAction != static_cast<int>(Action::ACTION_D)) {
 		oppsiteActInt = 1;
 	}
 	// 膜の影響を受けることはあり得ないプレイヤは飛ばす
-	if (!(filter.at(2 * playerStrategyId + oppsiteActInt))) {
+	if (!(contact.getFilter().at(2 * playerStrategyId + oppsiteActInt))) {
 		// 現在と未来を設定
-		int iGroup = static_cast<int>(Affect::IGNORE);
-		player->getProperty(PROP_NAMES[0]).setValue(iGroup);
-		player->getProperty(PROP_NAMES[1]).setValue(iGroup);
+		affects[id] = static_cast<int>(Affect::IGNORE);
+		nextAffects[id] = static_cast<int>(Affect::IGNORE);
 		return;
 	}
 
-	auto& neighbors = player->getNeighbors(type);
-
-	bool hasEnemy = false;
+	// 行動も戦略も違う
+	bool hasEnemy = (contact.getContacts()[id] &
+			ContactClassification::DIFFERENT_STRATEGY_DIFFERENT_ACTION) != 0;
 	bool hasMembrane = false;
 
-	// 自分は考えない
-	for (int r = 1, rMax = neighbors->size(); r < rMax; ++r) {
-
-		// 同じ近傍距離のプレイヤ
-		auto nNeighbors = neighbors->at(r);
-
-		for (auto& opponentWP : *(nNeighbors)) {
-			auto opponent = opponentWP.lock();
-			if (opponent == nullptr) {
-				// 近傍がいない場合終了
-				throw std::runtime_error("Could not find a neighbor of a player (mem detect rule - grouping).");
-			}
-
-			if (playerAction != opponent->getAction()) {
-				if (playerStrategyId != opponent->getStrategy()->getId()) {
-					// 行動も戦略も違う
-					hasEnemy = true;
-				} else {
-					auto propertyVal = static_cast<MembraneDetectRule::Group>(
-							opponent->getProperty("MemGroup").getValueAs<int>());
-
-					if (propertyVal == MembraneDetectRule::Group::COMBINE ||
-							propertyVal == MembraneDetectRule::Group::BOTH_SIDE) {
-						// 行動だけ違う
-						hasMembrane = true;
-					}
+	if (!hasEnemy) {
+		auto& neighborTable = contact.getNeighborTable();
+		for (const int* it = neighborTable.begin(id), *last = neighborTable.end(id); it != last; ++it) {
+			// 行動だけ違う
+			if ((playerAction != actions[*it]) && (playerStrategyId == strategies[*it])) {
+				auto propertyVal = static_cast<MembraneDetectRule::Group>(groups[*it]);
+
+				if (propertyVal == MembraneDetectRule::Group::COMBINE ||
+						propertyVal == MembraneDetectRule::Group::BOTH_SIDE) {
+					hasMembrane = true;
+					break;
 				}
 			}
 		}
@@ -206,62 +163,45 @@ void AffectedPlayerRule::directAffect(const std::shared_ptr<Player> player,
 	}
 
 	// 現在と未来を設定
-	int iGroup = static_cast<int>(group);
-	player->getProperty(PROP_NAMES[0]).setValue(iGroup);
-	player->getProperty(PROP_NAMES[1]).setValue(iGroup);
+	affects[id] = static_cast<int>(group);
+	nextAffects[id] = static_cast<int>(group);
 }
 
 /*
  * 影響が広がる
- * @param player プレイヤ
- * @param type 考える膜のタイプ
+ * @param id プレイヤ位置座標
+ * @param contact 接触の種類
  */
-void AffectedPlayerRule::spreadAffect(const std::shared_ptr<Player> player,
-		NeighborhoodType type) {
-
-	auto thisGroup = static_cast<Affect>(player->getProperty(PROP_NAMES[0]).getValueAs<int>());
+bool AffectedPlayerRule::spreadAffect(int id, const ContactClassification& contact) {
 
 	// 空き以外なら終わり
-	if (thisGroup != Affect::BLANK) {
-		return;
+	if (affects[id] != static_cast<int>(Affect::BLANK)) {
+		return false;
 	}
 
-	// 近傍
-	auto& neighbors = player->getNeighbors(type);
-
 	// 行動と戦略
-	auto playerStrategyId = player->getStrategy()->getId();
-	auto playerAction = player->getAction();
+	auto& strategies = contact.getStrategies();
+	auto& actions = contact.getActions();
+	int playerStrategyId = strategies[id];
+	int playerAction = actions[id];
 
 	bool hasEnemy = false;
 	bool hasMembrane = false;
 
-	// 自分は考えない
-	for (int r = 1, rMax = neighbors->size(); r < rMax; ++r) {
-
-		// 同じ近傍距離のプレイヤ
-		auto nNeighbors = neighbors->at(r);
+	auto& neighborTable = contact.getNeighborTable();
+	for (const int* it = neighborTable.begin(id), *last = neighborTable.end(id); it != last; ++it) {
 
-		for (auto& opponentWP : *(nNeighbors)) {
-			auto opponent = opponentWP.lock();
-			if (opponent == nullptr) {
-				// 近傍がいない場合終了
-				throw std::runtime_error("Could not find a neighbor of a player (mem detect rule - zero).");
-			}
-
-			// 戦略と行動が同じでなければ飛ばす
-			if ((playerStrategyId != opponent->getStrategy()->getId()) ||
-					(playerAction != opponent->getAction())) {
-				continue;
-			}
+		// 戦略と行動が同じでなければ飛ばす
+		if ((playerStrategyId != strategies[*it]) || (playerAction != actions[*it])) {
+			continue;
+		}
 
-			auto opponentPVal = static_cast<Affect>(
-					opponent->getProperty(PROP_NAMES[0]).getValueAs<int>());
-			if (Affect::ENEMY == opponentPVal) {
-				hasEnemy = true;
-			} else if (Affect::MEMBRANE == opponentPVal) {
-				hasMembrane = true;
-			}
+		auto opponentPVal = static_cast<Affect>(affects[*it]);
+		if (Affect::ENEMY == opponentPVal) {
+			hasEnemy = true;
+			break;
+		} else if (Affect::MEMBRANE == opponentPVal) {
+			hasMembrane = true;
 		}
 	}
 
@@ -272,31 +212,27 @@ void AffectedPlayerRule::spreadAffect(const std::shared_ptr<Player> player,
 		group = Affect::MEMBRANE;
 	}
 
-	int iGroup = static_cast<int>(group);
-	player->getProperty(PROP_NAMES[1]).setValue(iGroup);
+	nextAffects[id] = static_cast<int>(group);
+	return group != Affect::BLANK;
 }
 
 /**
  * next を current に更新する
  *
  * その際状態が変われば、true, 変わらなければ false とする
- * @param player プレイヤ
+ * @param id プレイヤ位置座標
  * @return 状態が変わったかどうか
  * @retval true 状態が変わった
  * @retval false 状態が変わらない
  */
-bool AffectedPlayerRule::changesStatus(const std::shared_ptr<Player> player) {
-
-	if (player->getProperty(PROP_NAMES[0]).getValueAs<int>() ==
-			player->getProperty(PROP_NAMES[1]).getValueAs<int>()) {
+bool AffectedPlayerRule::changesStatus(int id) {
 
+	if (affects[id] == nextAffects[id]) {
 		return false;
 	}
 	// 未来を現在へコピーする
 	// group id
-	player->getProperty(PROP_NAMES[0]).setValue(
-			player->getProperty(PROP_NAMES[1]).getValueAs<int>());
-
+	affects[id] = nextAffects[id];
 
 	return true;
 }
@@ -347,85 +283,5 @@ void AffectedPlayerRule::initProp(const std::shared_ptr<Player>& player) {
 	}
 }
 
-/*
- * 現在の状態をみて膜になるのかどうかのフィルタを作る
- * @param[in] allPlayers 全てのプレイヤ
- * @param[in] param パラメタ
- */
-std::vector<bool> AffectedPlayerRule::filtering(
-		const AllPlayer& allPlayers, const spd::param::Parameter& param) {
-
-	auto strategies = param.getStrategyList();
-	// それが膜になり得るかどうかのフィルタ
-	std::vector<bool> filter(strategies.size() * 2, false);
-
-	// どれぐらいの strategy x action が存在するのか
-	int potential = 0;
-	//存在するかどうかの可能性
-
-	for (int i = 0, size = strategies.size(); i < size; ++i) {
-		std::string shortStrategy = (strategies[i].first)->getShortStrategy();
-
-		// C が含まれている
-		if (shortStrategy.find("C") != std::string::npos) {
-			potential++;
-		}
-
-		// D が含まれている
-		if (shortStrategy.find("D") != std::string::npos) {
-			potential++;
-		}
-	}
-
-	// 現実にどれぐらいあるのか
-	std::vector<bool> existence(strategies.size() * 2, false);
-	for (auto& p : allPlayers) {
-		// C = 0; D = 1
-		int actionInt = spd::core::converter::actionToChar(p->getAction()) - 'C';
-		if (!(existence[2 * (p->getStrategy()->getId()) + actionInt])) {
-			existence[2 * (p->getStrategy()->getId()) + actionInt] = true;
-			potential--;
-		}
-		// 全パターンでたら抜ける
-		if (potential == 0) {
-			break;
-		}
-	}
-
-	int probabilityC = 0;
-	int probabilityD = 0;
-
-	for (int i = 0, size = strategies.size(); i < size; ++i) {
-		// C, D 両方あるか
-		if (existence[2 * i] && existence[2 * i + 1]) {
-			filter[2 * i] = true;
-			filter[2 * i + 1] = true;
-		}
-		// どのぐらい、それぞれがそんざいするか
-		if (existence[2 * i]) {
-			probabilityC++;
-		}
-		if (existence[2 * i + 1]) {
-			probabilityD++;
-		}
-	}
-
-	for (int i = 0, size = strategies.size(); i < size; ++i) {
-
-		// 他にCがいないなら、その戦略のCは膜にならない
-		if (probabilityC < 2) {
-			filter[2 * i] = false;
-		}
-
-		if (probabilityD < 2) {
-			filter[2 * i + 1] = false;
-		}
-	}
-
-	return filter;
-}
-
-
-
 } /* namespace rule */
 } /* namespace spd */
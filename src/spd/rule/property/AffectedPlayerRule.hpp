@@ -7,18 +7,27 @@
 #ifndef AFFECTEDPLAYERRULE_HPP_
 #define AFFECTEDPLAYERRULE_HPP_
 
-#include "../Rule.hpp"
+#include <memory>
+#include <vector>
+
+#include "../GlobalRule.hpp"
 #include "../../core/NeighborhoodType.hpp"
+#include "ContactClassification.hpp"
 
 namespace spd {
 namespace rule {
 
+class MembraneDetectRule;
+
 /**
  * 膜の影響を受けているプレイヤを検知するルールを表すクラス
  *
  * 膜検知ルールを実行した後でないとエラーが発生
+ *
+ * 膜検知ルールを渡した場合、同じステップでそのルールが検知していれば、
+ * 接触の種類と膜グループはそのルールの結果を使う。
  */
-class AffectedPlayerRule : public spd::rule::Rule {
+class AffectedPlayerRule : public spd::rule::GlobalRule {
 public:
 
 	/**
@@ -31,6 +40,20 @@ public:
 		IGNORE, /**< 考えないでよいプレイヤ */
 	};
 
+	/**
+	 * コンストラクタ
+	 *
+	 * 膜グループはプロパティから読み、接触の種類は自身で求める
+	 */
+	AffectedPlayerRule() = default;
+
+	/**
+	 * コンストラクタ
+	 * @param[in] membraneRule 先に実行する膜検知ルール
+	 */
+	explicit AffectedPlayerRule(const std::shared_ptr<const MembraneDetectRule>& membraneRule)
+		: membraneRule(membraneRule) {};
+
 	/**
 	 * プロパティを設定する
 	 * @param[in, out] player 対象プレイヤ
@@ -44,17 +67,42 @@ public:
 
 	/**
 	 * 影響検知
-	 * @param[in, out] player 対象プレイヤ
+	 * @param[in] context 解決済みの情報
+	 * @param[in] workers 共有のワーカ
+	 */
+	void runGlobal(const RuleContext& context, const WorkerPool& workers);
+
+
+	/**
+	 * 空間構造が編集された場合に、まとめた近傍を破棄する
+	 */
+	void resetNeighborTables() {
+		classification.clear();
+	};
+
+	/**
+	 * 空間構造が編集された場合に、近傍が変わったプレイヤの分だけ近傍をまとめ直す
 	 * @param[in] allPlayers 全てのプレイヤ
 	 * @param[in] param パラメタ
-	 * @param[in] step 実行ステップ
+	 * @param[in] repaired 近傍が変わったプレイヤ位置座標(昇順)
 	 */
-	void runRule(
-			const std::shared_ptr<Player>& player,
-			const AllPlayer& allPlayers,
-			const spd::param::Parameter& param,
-			int step);
+	void repairNeighborTables(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		const std::vector<int>& repaired) {
+		classification.repair(allPlayers, repaired);
+	};
 
+	/**
+	 * 分岐元の影響の検知結果を引き継ぐ
+	 * @param[in] base 分岐元のルール
+	 * @param[in] allPlayers 分岐先のプレイヤ
+	 * @param[in] param 分岐先のパラメタ
+	 */
+	void takeOverState(
+		const Rule& base,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param);
 
 	/**
 	 * ルール情報の文字出力
@@ -64,6 +112,14 @@ public:
 		return "Affected";
 	}
 
+	/**
+	 * 出力だけが結果を読む解析ルール
+	 * @return true
+	 */
+	bool isAnalysis() const {
+		return true;
+	};
+
 private:
 
 	/**
@@ -89,39 +145,57 @@ private:
 
 	/**
 	 * 直接的な影響を調べる
-	 * @param player プレイヤ
-	 * @param type 考える膜のタイプ
-	 * @param filter 膜になり得るかどうかのフィルタ
+	 * @param id プレイヤ位置座標
+	 * @param contact 接触の種類
+	 * @param groups プレイヤ位置座標ごとの膜グループ
 	 */
-	void directAffect(const std::shared_ptr<Player> player,
-				NeighborhoodType type,
-				std::vector<bool>& filter);
+	void directAffect(int id,
+			const ContactClassification& contact,
+			const std::vector<int>& groups);
+
 	/**
 	 * 影響が広がる
-	 * @param player プレイヤ
-	 * @param type 考える膜のタイプ
+	 * @param id プレイヤ位置座標
+	 * @param contact 接触の種類
+	 * @return 次の状態が現在と異なるかどうか
 	 */
-	void spreadAffect(const std::shared_ptr<Player> player,
-			NeighborhoodType type);
+	bool spreadAffect(int id, const ContactClassification& contact);
 
 	/**
 	 * next を current に更新する
 	 *
 	 * その際状態が変われば、true, 変わらなければ false とする
-	 * @param player プレイヤ
+	 * @param id プレイヤ位置座標
 	 * @return 状態が変わったかどうか
 	 * @retval true 状態が変わった
 	 * @retval false 状態が変わらない
 	 */
-	bool changesStatus(const std::shared_ptr<Player> player);
+	bool changesStatus(int id);
 
 	/**
-	 * 現在の状態をみて膜になるのかどうかのフィルタを作る
-	 * @param[in] allPlayers 全てのプレイヤ
-	 * @param[in] param パラメタ
+	 * 先に実行する膜検知ルール(無ければ nullptr)
 	 */
-	std::vector<bool> filtering(const AllPlayer& allPlayers, const spd::param::Parameter& param);
+	std::shared_ptr<const MembraneDetectRule> membraneRule;
 
+	/**
+	 * 膜検知ルールの結果を使えない場合の、接触の種類
+	 */
+	ContactClassification classification;
+
+	/**
+	 * 膜検知ルールの結果を使えない場合の、プロパティから読んだ膜グループ
+	 */
+	std::vector<int> memGroups;
+
+	/**
+	 * プレイヤ位置座標ごとの影響状態 (PROP_NAMES[0])
+	 */
+	std::vector<int> affects;
+
+	/**
+	 * プレイヤ位置座標ごとの次の影響状態 (PROP_NAMES[1])
+	 */
+	std::vector<int> nextAffects;
 
 };
 
@@ -0,0 +1,184 @@
+/**
+ * ContactClassification.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "ContactClassification.hpp"
+
+#include <stdexcept>
+#include <string>
+
+#include "../../core/Player.hpp"
+#include "../../core/Converter.hpp"
+#include "../../core/Strategy.hpp"
+#include "../../core/StrategyPool.hpp"
+#include "../../core/NeighborhoodType.hpp"
+#include "../../param/Parameter.hpp"
+
+namespace spd {
+namespace rule {
+
+constexpr unsigned ContactClassification::SAME_STRATEGY_SAME_ACTION;
+constexpr unsigned ContactClassification::SAME_STRATEGY_DIFFERENT_ACTION;
+constexpr unsigned ContactClassification::DIFFERENT_STRATEGY_SAME_ACTION;
+constexpr unsigned ContactClassification::DIFFERENT_STRATEGY_DIFFERENT_ACTION;
+
+/*
+ * 現在の戦略と行動から、接触の種類とフィルタを求める
+ * @param[in] allPlayers 全てのプレイヤ
+ * @param[in] param パラメタ
+ * @param[in] workers 共有のワーカ
+ */
+void ContactClassification::classify(const spd::core::AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		const WorkerPool& workers) {
+
+	if (!neighborTable.isBuilt()) {
+		if (!neighborTable.build(allPlayers, NeighborhoodType::GAME)) {
+			throw std::runtime_error("Could not find neighbors of a player (contact classification).");
+		}
+		readerTable = neighborTable.reverse();
+	}
+
+	filtering(allPlayers, param);
+
+	int playerNum = allPlayers.size();
+	strategies.resize(playerNum);
+	actions.resize(playerNum);
+	contacts.resize(playerNum);
+	for (int id = 0; id < playerNum; ++id) {
+		strategies[id] = allPlayers[id]->getStrategy()->getId();
+		actions[id] = static_cast<int>(allPlayers[id]->getAction());
+	}
+
+	workers.run(playerNum,
+			[&](int worker, int from, int to) {
+		for (int id = from; id < to; ++id) {
+			classifyContact(id);
+		}
+	});
+}
+
+/*
+ * まとめた近傍を破棄する
+ */
+void ContactClassification::clear() {
+
+	neighborTable.clear();
+	readerTable.clear();
+}
+
+/*
+ * 近傍が変わったプレイヤの分だけ対戦近傍をまとめ直す
+ *
+ * 逆向きの表は数えて詰め直すだけなので、近傍の探索はしない。
+ */
+void ContactClassification::repair(const spd::core::AllPlayer& allPlayers,
+		const std::vector<int>& repaired) {
+
+	if (neighborTable.patch(allPlayers, NeighborhoodType::GAME, repaired)) {
+		readerTable = neighborTable.reverse();
+	} else {
+		readerTable.clear();
+	}
+}
+
+/*
+ * 近傍の戦略IDと行動を、接触の種類のビットへまとめる
+ *
+ * (異戦略か * 2 + 異行動か) ビット目を立てる。
+ */
+void ContactClassification::classifyContact(int id) {
+
+	int playerStrategyId = strategies[id];
+	int playerAction = actions[id];
+
+	unsigned contact = 0;
+	for (const int* it = neighborTable.begin(id), *last = neighborTable.end(id); it != last; ++it) {
+		contact |= 1u << (2 * (strategies[*it] != playerStrategyId) + (actions[*it] != playerAction));
+	}
+	contacts[id] = contact;
+}
+
+/*
+ * 現在の状態をみて膜になるのかどうかのフィルタを作る
+ * @param[in] allPlayers 全てのプレイヤ
+ * @param[in] param パラメタ
+ */
+void ContactClassification::filtering(const spd::core::AllPlayer& allPlayers,
+		const spd::param::Parameter& param) {
+
+	// 戦略ID ごとに引く(破棄された ID は存在しない戦略として扱う)
+	auto& pool = param.getStrategyPool();
+	int idLimit = pool->getIdLimit();
+	// それが膜になり得るかどうかのフィルタ
+	filter.assign(idLimit * 2, false);
+
+	// どれぐらいの strategy x action が存在するのか
+	int potential = 0;
+	//存在するかどうかの可能性
+
+	for (auto& strategy : pool->getActiveStrategies()) {
+		const std::string& shortStrategy = strategy->getShortStrategy();
+
+		// C が含まれている
+		if (shortStrategy.find("C") != std::string::npos) {
+			potential++;
+		}
+
+		// D が含まれている
+		if (shortStrategy.find("D") != std::string::npos) {
+			potential++;
+		}
+	}
+
+	// 現実にどれぐらいあるのか
+	std::vector<bool> existence(idLimit * 2, false);
+	for (auto& p : allPlayers) {
+		// C = 0; D = 1
+		int actionInt = spd::core::converter::actionToChar(p->getAction()) - 'C';
+		if (!(existence[2 * (p->getStrategy()->getId()) + actionInt])) {
+			existence[2 * (p->getStrategy()->getId()) + actionInt] = true;
+			potential--;
+		}
+		// 全パターンでたら抜ける
+		if (potential == 0) {
+			break;
+		}
+	}
+
+	int probabilityC = 0;
+	int probabilityD = 0;
+
+	for (int i = 0; i < idLimit; ++i) {
+		// C, D 両方あるか
+		if (existence[2 * i] && existence[2 * i + 1]) {
+			filter[2 * i] = true;
+			filter[2 * i + 1] = true;
+		}
+		// どのぐらい、それぞれがそんざいするか
+		if (existence[2 * i]) {
+			probabilityC++;
+		}
+		if (existence[2 * i + 1]) {
+			probabilityD++;
+		}
+	}
+
+	for (int i = 0; i < idLimit; ++i) {
+
+		// 他にCがいないなら、その戦略のCは膜にならない
+		if (probabilityC < 2) {
+			filter[2 * i] = false;
+		}
+
+		if (probabilityD < 2) {
+			filter[2 * i + 1] = false;
+		}
+	}
+}
+
+} /* namespace rule */
+} /* namespace spd */
@@ -0,0 +1,172 @@
+/**
+ * ContactClassification.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef CONTACTCLASSIFICATION_HPP_
+#define CONTACTCLASSIFICATION_HPP_
+
+#include <vector>
+
+#include "../../core/OriginalType.hpp"
+#include "../NeighborTable.hpp"
+#include "../WorkerPool.hpp"
+
+namespace spd {
+namespace param {
+	class Parameter;
+}
+namespace rule {
+
+/**
+ * 対戦近傍との接触の種類を、プレイヤ位置座標の配列で表すクラス
+ *
+ * @par
+ * 膜検知と影響検知で共通の分類(近傍の戦略と行動が自身と同じか)を、1ステップに1度だけ行う。<br>
+ * 対戦近傍の表は構造が変わらない限り使い回すため、ルールの初期化時に clear する。
+ */
+class ContactClassification {
+public:
+
+	/**
+	 * 同戦略同行動の近傍と接触
+	 */
+	static constexpr unsigned SAME_STRATEGY_SAME_ACTION = 1u;
+
+	/**
+	 * 同戦略異行動の近傍と接触
+	 */
+	static constexpr unsigned SAME_STRATEGY_DIFFERENT_ACTION = 2u;
+
+	/**
+	 * 異戦略同行動の近傍と接触
+	 */
+	static constexpr unsigned DIFFERENT_STRATEGY_SAME_ACTION = 4u;
+
+	/**
+	 * 異戦略異行動の近傍と接触
+	 */
+	static constexpr unsigned DIFFERENT_STRATEGY_DIFFERENT_ACTION = 8u;
+
+	/**
+	 * 現在の戦略と行動から、接触の種類と膜になり得るかどうかのフィルタを求める
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @param[in] workers 共有のワーカ
+	 * @throw std::runtime_error 対戦近傍を保持していないプレイヤがいる場合
+	 */
+	void classify(const spd::core::AllPlayer& allPlayers, const spd::param::Parameter& param,
+			const WorkerPool& workers);
+
+	/**
+	 * まとめた近傍を破棄する
+	 */
+	void clear();
+
+	/**
+	 * 近傍が変わったプレイヤの分だけ対戦近傍をまとめ直し、逆向きの表を作り直す
+	 * @note まとめていない場合はなにもしない(次の分類でまとめる)
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] repaired 近傍が変わったプレイヤ位置座標(昇順)
+	 */
+	void repair(const spd::core::AllPlayer& allPlayers, const std::vector<int>& repaired);
+
+	/**
+	 * 対戦近傍の表を取得
+	 * @return 対戦近傍の表
+	 */
+	const NeighborTable& getNeighborTable() const {
+		return neighborTable;
+	};
+
+	/**
+	 * 各プレイヤを対戦近傍に持つプレイヤの表を取得
+	 * @return 逆向きの表
+	 */
+	const NeighborTable& getReaderTable() const {
+		return readerTable;
+	};
+
+	/**
+	 * プレイヤ位置座標ごとの戦略IDを取得
+	 * @return 戦略ID
+	 */
+	const std::vector<int>& getStrategies() const {
+		return strategies;
+	};
+
+	/**
+	 * プレイヤ位置座標ごとの行動を取得
+	 * @return 行動(Action を int にしたもの)
+	 */
+	const std::vector<int>& getActions() const {
+		return actions;
+	};
+
+	/**
+	 * プレイヤ位置座標ごとの接触の種類を取得
+	 * @return 接触の種類のビットの和
+	 */
+	const std::vector<unsigned>& getContacts() const {
+		return contacts;
+	};
+
+	/**
+	 * 膜になり得るかどうかのフィルタを取得
+	 * @return 2 * 戦略ID + 行動(C = 0, D = 1) ごとのフィルタ
+	 */
+	const std::vector<bool>& getFilter() const {
+		return filter;
+	};
+
+private:
+
+	/**
+	 * 現在の状態をみて膜になるのかどうかのフィルタを作る
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 */
+	void filtering(const spd::core::AllPlayer& allPlayers, const spd::param::Parameter& param);
+
+	/**
+	 * 近傍の戦略IDと行動を、分岐なしに接触の種類のビットへまとめる
+	 * @param[in] id プレイヤ位置座標
+	 */
+	void classifyContact(int id);
+
+	/**
+	 * 対戦近傍の表
+	 */
+	NeighborTable neighborTable;
+
+	/**
+	 * 各プレイヤを対戦近傍に持つプレイヤの表
+	 */
+	NeighborTable readerTable;
+
+	/**
+	 * プレイヤ位置座標ごとの戦略ID
+	 */
+	std::vector<int> strategies;
+
+	/**
+	 * プレイヤ位置座標ごとの行動
+	 */
+	std::vector<int> actions;
+
+	/**
+	 * プレイヤ位置座標ごとの接触の種類
+	 */
+	std::vector<unsigned> contacts;
+
+	/**
+	 * 膜になり得るかどうかのフィルタ
+	 */
+	std::vector<bool> filter;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* CONTACTCLASSIFICATION_HPP_ */
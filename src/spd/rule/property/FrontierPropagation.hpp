@@ -0,0 +1,102 @@
+/**
+ * FrontierPropagation.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef FRONTIERPROPAGATION_HPP_
+#define FRONTIERPROPAGATION_HPP_
+
+#include <vector>
+
+#include "../NeighborTable.hpp"
+#include "../WorkerPool.hpp"
+
+namespace spd {
+namespace rule {
+
+/**
+ * 状態の変わったプレイヤの周りだけを調べて、全プレイヤ同時の更新を収束まで繰り返す
+ *
+ * @par
+ * 全プレイヤを前の状態から同時に更新するのは全体の繰り返しと同じだが、
+ * 次に調べるのは前の更新で状態が変わったプレイヤと、それを近傍に持つプレイヤに限る。
+ * 調べないプレイヤは入力(自身と近傍の状態)が前回と同じなので、次の状態も変わらない。
+ * @param[in] frontier 最初に調べるプレイヤ位置座標
+ * @param[in] readerTable 各プレイヤを近傍に持つプレイヤの表
+ * @param[in] workers 共有のワーカ
+ * @param[in] spreads 状態が変わり得るかどうか (int id) -> bool
+ * @param[in] evaluate 次の状態を求め、現在と異なるかを返す (int id) -> bool
+ *                     自身の次の状態のみ書き込むこと(コアに分けて呼ぶ)
+ * @param[in] update 次の状態を現在へ写す (int id) -> void
+ */
+template <class Spreads, class Evaluate, class Update>
+void propagateFrontier(
+		std::vector<int> frontier,
+		const NeighborTable& readerTable,
+		const WorkerPool& workers,
+		Spreads spreads,
+		Evaluate evaluate,
+		Update update) {
+
+	// この数以上のプレイヤを調べる時は、コアに分ける
+	constexpr int PARALLEL_FRONTIER = 4096;
+
+	// 次に調べるプレイヤに加えた回
+	std::vector<int> visited(readerTable.getPlayerNum(), -1);
+	std::vector<std::vector<int>> changed(workers.getCore());
+
+	for (int round = 0; !frontier.empty(); ++round) {
+
+		// 調べる(1ステップ)
+		int frontierNum = frontier.size();
+		for (auto& ids : changed) {
+			ids.clear();
+		}
+		if (frontierNum < PARALLEL_FRONTIER) {
+			for (int id : frontier) {
+				if (evaluate(id)) {
+					changed[0].push_back(id);
+				}
+			}
+		} else {
+			workers.run(frontierNum,
+					[&](int worker, int from, int to) {
+				for (int index = from; index < to; ++index) {
+					if (evaluate(frontier[index])) {
+						changed[worker].push_back(frontier[index]);
+					}
+				}
+			});
+		}
+
+		// アップデート
+		for (auto& ids : changed) {
+			for (int id : ids) {
+				update(id);
+			}
+		}
+
+		// 次に調べるプレイヤ
+		frontier.clear();
+		auto visit = [&](int id) {
+			if ((visited[id] != round) && spreads(id)) {
+				visited[id] = round;
+				frontier.push_back(id);
+			}
+		};
+		for (auto& ids : changed) {
+			for (int id : ids) {
+				visit(id);
+				for (const int* it = readerTable.begin(id), *last = readerTable.end(id); it != last; ++it) {
+					visit(*it);
+				}
+			}
+		}
+	}
+}
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* FRONTIERPROPAGATION_HPP_ */
@@ -10,7 +10,6 @@
 #include <algorithm>
 #include <stdexcept>
 #include <vector>
-#include <thread>
 
 #include "../../core/Player.hpp"
 #include "../../core/Strategy.hpp"
@@ -18,6 +17,7 @@
 #include "../../param/InitParameter.hpp"
 
 #include "countingRule/PropCount.hpp"
+#include "FrontierPropagation.hpp"
 
 namespace spd {
 namespace rule {
@@ -32,275 +32,105 @@ void MembraneDetectRule::initialize(
 
 	// 初期化
 	initProp(player);
+
+	// 構造が変わり得るので、まとめた近傍を破棄
+	classification.clear();
+	analyzedStep = -1;
 }
 
 
 /*
- * 検知
+ * 分岐元の膜の検知結果を引き継ぐ
+ *
+ * 近傍の表は分岐先でまとめ直す
  */
-void MembraneDetectRule::runRule(
-		const std::shared_ptr<Player>& frontPlayer,
+void MembraneDetectRule::takeOverState(
+		const Rule& base,
 		const AllPlayer& allPlayers,
-		const spd::param::Parameter& param,
-		int step) {
-
-	NeighborhoodType neiType = NeighborhoodType::GAME;
-
-
-	bool notStable;
-
-	// 初のプレイヤの時だけ
-	if (frontPlayer->getId() != 0) {
-		return;
-	}
-
-	// 初期化
-	for (auto& player : allPlayers) {
-		initProp(player);
-	}
+		const spd::param::Parameter& param) {
+
+	auto& baseRule = static_cast<const MembraneDetectRule&>(base);
+	analyzedStep = baseRule.analyzedStep;
+	groups = baseRule.groups;
+	nextGroups = baseRule.nextGroups;
+	moves = baseRule.moves;
+	nextMoves = baseRule.nextMoves;
+}
 
-	auto filter = filtering(allPlayers, param);
+/*
+ * 検知
+ *
+ * プロパティは最後にまとめて設定し、途中の状態はプレイヤ位置座標の配列で持つ。
+ */
+void MembraneDetectRule::runGlobal(const RuleContext& context, const WorkerPool& workers) {
 
-	int core = param.getCore();
+	auto& allPlayers = context.allPlayers;
+	classification.classify(allPlayers, context.param, workers);
 
-	// 1コアが担当するプレイヤ数
 	int playerNum = allPlayers.size();
-	int breadth = playerNum / core;
-
-	std::vector<std::thread> thr(core);
-
-	for (int i = 0, size = thr.size(); i < size; ++i) {
-		thr[i] = std::thread(
-				[&, i]{
 
-			int from = breadth * i;
-			int to = (i + 1 < core) ? breadth * (i + 1) : playerNum;
+	groups.resize(playerNum);
+	nextGroups.resize(playerNum);
+	moves.assign(playerNum, INIT_VALS[2]);
+	nextMoves.assign(playerNum, INIT_VALS[3]);
 
-			for (int id = from; id < to; ++id) {
-				grouping(allPlayers[id], neiType, filter);
-			}
+	std::vector<int> frontier;
+	for (int id = 0; id < playerNum; ++id) {
+		grouping(id);
+		if (spreads(groups[id])) {
+			frontier.push_back(id);
 		}
-		);
-	}
-	for (std::thread& t : thr) {
-		t.join();
 	}
 
 	// 検知開始
-	std::vector<bool> changes(core);
-	do {
-
-		// 調べる(1ステップ)
-		for (int i = 0, size = thr.size(); i < size; ++i) {
-			thr[i] = std::thread(
-					[&, i]{
-
-				int from = breadth * i;
-				int to = (i + 1 < core) ? breadth * (i + 1) : playerNum;
-
-				for (int id = from; id < to; ++id) {
-					spreadMembraneDetect(allPlayers[id], neiType);
-				}
-			}
-			);
-		}
-		for (std::thread& t : thr) {
-			t.join();
-		}
-
-		// アップデート
-		for (int i = 0, size = thr.size(); i < size; ++i) {
-			thr[i] = std::thread(
-					[&, i]{
-				bool result = false;
-
-				int from = breadth * i;
-				int to = (i + 1 < core) ? breadth * (i + 1) : playerNum;
-
-				for (int id = from; id < to; ++id) {
-					result = changesStatus(allPlayers[id]) || result;
-				}
-				changes[i] = result;
-			}
-			);
-		}
-		notStable = false;
-		for (int i = 0, size = thr.size(); i < size; ++i) {
-			thr[i].join();
-			notStable = changes[i] || notStable;
-		}
-	} while (notStable);
+	propagateFrontier(frontier, classification.getReaderTable(), workers,
+			[&](int id) { return spreads(groups[id]); },
+			[&](int id) { return spreadMembraneDetect(id); },
+			[&](int id) { changesStatus(id); });
 
 	// 最終処理
-	for (int i = 0, size = thr.size(); i < size; ++i) {
-		thr[i] = std::thread(
-				[&, i]{
-
-			int from = breadth * i;
-			int to = (i + 1 < core) ? breadth * (i + 1) : playerNum;
-
-			for (int id = from; id < to; ++id) {
-				postHandling(allPlayers[id], neiType);
-			}
-		}
-		);
-	}
-	for (std::thread& t : thr) {
-		t.join();
+	// (異なるプレイヤが同じ相手を上書きし得るので、一つずつ)
+	for (int id = 0; id < playerNum; ++id) {
+		postHandling(id);
 	}
 	// 最終結果を合算
-	for (int i = 0, size = thr.size(); i < size; ++i) {
-		thr[i] = std::thread(
-				[&, i]{
-			bool result = false;
-
-			int from = breadth * i;
-			int to = (i + 1 < core) ? breadth * (i + 1) : playerNum;
-
-			for (int id = from; id < to; ++id) {
-				changesStatus(allPlayers[id]) || result;
-			}
-		}
-		);
-	}
-	for (int i = 0, size = thr.size(); i < size; ++i) {
-		thr[i].join();
+	for (int id = 0; id < playerNum; ++id) {
+		changesStatus(id);
 	}
 
-}
-
-std::vector<bool> MembraneDetectRule::filtering(const AllPlayer& allPlayers, const spd::param::Parameter& param){
-
-	auto strategies = param.getStrategyList();
-	// それが膜になり得るかどうかのフィルタ
-	std::vector<bool> filter(strategies.size() * 2, false);
-
-	// どれぐらいの strategy x action が存在するのか
-	int potential = 0;
-	//存在するかどうかの可能性
-
-	for (int i = 0, size = strategies.size(); i < size; ++i) {
-		std::string shortStrategy = (strategies[i].first)->getShortStrategy();
-
-		// C が含まれている
-		if (shortStrategy.find("C") != std::string::npos) {
-			potential++;
+	// プロパティへ設定
+	workers.run(playerNum,
+			[&](int worker, int from, int to) {
+		for (int id = from; id < to; ++id) {
+			auto& player = allPlayers[id];
+			player->getProperty(PROP_NAMES[0]).setValue(groups[id]);
+			player->getProperty(PROP_NAMES[1]).setValue(nextGroups[id]);
+			player->getProperty(PROP_NAMES[2]).setValue(moves[id]);
+			player->getProperty(PROP_NAMES[3]).setValue(nextMoves[id]);
 		}
+	});
 
-		// D が含まれている
-		if (shortStrategy.find("D") != std::string::npos) {
-			potential++;
-		}
-	}
-
-	// 現実にどれぐらいあるのか
-	std::vector<bool> existence(strategies.size() * 2, false);
-	for (auto& p : allPlayers) {
-		// C = 0; D = 1
-		int actionInt = spd::core::converter::actionToChar(p->getAction()) - 'C';
-		if (!(existence[2 * (p->getStrategy()->getId()) + actionInt])) {
-			existence[2 * (p->getStrategy()->getId()) + actionInt] = true;
-			potential--;
-		}
-		// 全パターンでたら抜ける
-		if (potential == 0) {
-			break;
-		}
-	}
-
-	int probabilityC = 0;
-	int probabilityD = 0;
-
-	for (int i = 0, size = strategies.size(); i < size; ++i) {
-		// C, D 両方あるか
-		if (existence[2 * i] && existence[2 * i + 1]) {
-			filter[2 * i] = true;
-			filter[2 * i + 1] = true;
-		}
-		// どのぐらい、それぞれがそんざいするか
-		if (existence[2 * i]) {
-			probabilityC++;
-		}
-		if (existence[2 * i + 1]) {
-			probabilityD++;
-		}
-	}
-
-	for (int i = 0, size = strategies.size(); i < size; ++i) {
-
-		// 他にCがいないなら、その戦略のCは膜にならない
-		if (probabilityC < 2) {
-			filter[2 * i] = false;
-		}
-
-		if (probabilityD < 2) {
-			filter[2 * i + 1] = false;
-		}
-	}
-
-	return filter;
+	analyzedStep = context.step;
 }
 
 /*
  * 初期のグループ分け
  */
-void MembraneDetectRule::grouping(const std::shared_ptr<Player> player,
-			NeighborhoodType type,
-			std::vector<bool>& filter) {
-
-	auto playerStrategyId = player->getStrategy()->getId();
-	auto playerAction = player->getAction();
+void MembraneDetectRule::grouping(int id) {
 
-	auto& neighbors = player->getNeighbors(type);
+	unsigned contact = classification.getContacts()[id];
 
 	// same strategy, same action
-	bool ss = false;
+	bool ss = (contact & ContactClassification::SAME_STRATEGY_SAME_ACTION) != 0;
 
 	// same strategy, different action
-	bool sd = false;
+	bool sd = (contact & ContactClassification::SAME_STRATEGY_DIFFERENT_ACTION) != 0;
 
 	// different strategy, same action
-	bool ds = false;
+	bool ds = (contact & ContactClassification::DIFFERENT_STRATEGY_SAME_ACTION) != 0;
 
 	// different strategy, different action
-	bool dd = false;
-
-
-
-	// 自分は考えない
-	for (int r = 1, rMax = neighbors->size(); r < rMax; ++r) {
-
-		// 同じ近傍距離のプレイヤ
-		auto nNeighbors = neighbors->at(r);
-
-		for (auto& opponentWP : *(nNeighbors)) {
-			auto opponent = opponentWP.lock();
-			if (opponent == nullptr) {
-				// 近傍がいない場合終了
-				throw std::runtime_error("Could not find a neighbor of a player (mem detect rule - grouping).");
-			}
-
-			if (playerStrategyId == opponent->getStrategy()->getId()) {
-				// same strategy
-				if (playerAction == opponent->getAction()) {
-					// same action
-					ss = true;
-				} else {
-					sd = true;
-				}
-
-			} else {
-				// different strategy
-				if (playerAction == opponent->getAction()) {
-					// same action
-					ds = true;
-				} else {
-					dd = true;
-				}
-			}
-		}
-	}
-
+	bool dd = (contact & ContactClassification::DIFFERENT_STRATEGY_DIFFERENT_ACTION) != 0;
 
 	// 場合分け
 	Group group = Group::DIRECT;
@@ -323,50 +153,40 @@ void MembraneDetectRule::grouping(const std::shared_ptr<Player> player,
 
 	// フィルタリング
 	int actionInt = 0;
-	if (spd::core::converter::actionToChar(playerAction) == 'D') {
+	if (classification.getActions()[id] == static_cast<int>(Action::ACTION_D)) {
 		actionInt = 1;
 	}
 	// Direct でなく、膜になり得ないプレイヤは飛ばす
-	if (!(filter.at(2 * playerStrategyId + actionInt)) && (group != Group::DIRECT)) {
+	int playerStrategyId = classification.getStrategies()[id];
+	if (!(classification.getFilter().at(2 * playerStrategyId + actionInt)) && (group != Group::DIRECT)) {
 		group = Group::IGNORE;
 	}
 
 	// 現在と未来を設定
-	int iGroup = static_cast<int>(group);
-	player->getProperty(PROP_NAMES[0]).setValue(iGroup);
-	player->getProperty(PROP_NAMES[1]).setValue(iGroup);
+	groups[id] = static_cast<int>(group);
+	nextGroups[id] = static_cast<int>(group);
 }
 
-/**
+/*
  * 膜判定が広がる
- * @param player プレイヤ
- * @param type 考える膜のタイプ
+ * @param id プレイヤ位置座標
  */
-void MembraneDetectRule::spreadMembraneDetect(const std::shared_ptr<Player> player,
-		NeighborhoodType type) {
+bool MembraneDetectRule::spreadMembraneDetect(int id) {
 
 	// グループ番号
-	auto thisGroup = static_cast<Group>(player->getProperty(PROP_NAMES[0]).getValueAs<int>());
+	auto thisGroup = static_cast<Group>(groups[id]);
 
-	if ((thisGroup != Group::BLANK) &&
-			(thisGroup != Group::INNER) &&
-			(thisGroup != Group::OUTER)) {
-		return;
-	}
-	auto& neighbors = player->getNeighbors(type);
 	switch (thisGroup) {
 		case Group::BLANK:
-
-			blankGroupBehavior(player, neighbors);
-			break;
+			return blankGroupBehavior(id);
 
 		case Group::INNER:
 		case Group::OUTER:
-			inOutGroupBehavior(player, neighbors);
-			break;
+			return inOutGroupBehavior(id);
+
 		default:
 			// それ以外のグループがくるけど無視
-			break;
+			return false;
 	}
 }
 
@@ -374,11 +194,9 @@ void MembraneDetectRule::spreadMembraneDetect(const std::shared_ptr<Player> play
 /*
  * Blankグループの動き
  * 同戦略同行動とのみ接続
- * @param player プレイヤ
- * @param neighbors 近傍
+ * @param id プレイヤ位置座標
  */
-void MembraneDetectRule::blankGroupBehavior(const std::shared_ptr<Player> player,
-		Neighbors& neighbors) {
+bool MembraneDetectRule::blankGroupBehavior(int id) {
 
 
 	// 移動ポイント
@@ -389,30 +207,18 @@ void MembraneDetectRule::blankGroupBehavior(const std::shared_ptr<Player> player
 	bool hasOuterGroup = false;
 
 
-	// 自分は考えない
-	for (int r = 1, rMax = neighbors->size(); r < rMax; ++r) {
-
-		// 同じ近傍距離のプレイヤ
-		auto nNeighbors = neighbors->at(r);
+	auto& neighborTable = classification.getNeighborTable();
+	for (const int* it = neighborTable.begin(id), *last = neighborTable.end(id); it != last; ++it) {
 
-		for (auto& opponentWP : *(nNeighbors)) {
-			auto opponent = opponentWP.lock();
-			if (opponent == nullptr) {
-				// 近傍がいない場合終了
-				throw std::runtime_error("Could not find a neighbor of a player (mem detect rule - zero).");
-			}
+		auto oppGroup = static_cast<Group>(groups[*it]);
 
-			auto oppGroup = static_cast<Group>(
-					opponent->getProperty(PROP_NAMES[0]).getValueAs<int>());
-
-			if ((oppGroup == Group::INNER) || (oppGroup == Group::OUTER)) {
-				// 小さいmove point へ
-				minMove = std::min(opponent->getProperty(PROP_NAMES[2]).getValueAs<int>(), minMove);
-				if (oppGroup == Group::INNER) {
-					hasInnerGroup = true;
-				} else {
-					hasOuterGroup = true;
-				}
+		if ((oppGroup == Group::INNER) || (oppGroup == Group::OUTER)) {
+			// 小さいmove point へ
+			minMove = std::min(moves[*it], minMove);
+			if (oppGroup == Group::INNER) {
+				hasInnerGroup = true;
+			} else {
+				hasOuterGroup = true;
 			}
 		}
 	}
@@ -422,34 +228,35 @@ void MembraneDetectRule::blankGroupBehavior(const std::shared_ptr<Player> player
 
 	if (hasInnerGroup && hasOuterGroup) {
 		// inner, outerがくっついた -> combine になる
-		player->getProperty(PROP_NAMES[1]).setValue(
-				static_cast<int>(Group::COMBINE));
-		player->getProperty(PROP_NAMES[3]).setValue(minMove);
+		nextGroups[id] = static_cast<int>(Group::COMBINE);
+		nextMoves[id] = minMove;
+		return true;
 
 	} else if (hasInnerGroup || hasOuterGroup){
 		// それぞれが広がる
 		auto groupVal = (hasInnerGroup) ? Group::INNER : Group::OUTER;
 
-		player->getProperty(PROP_NAMES[1]).setValue(static_cast<int>(groupVal));
-		player->getProperty(PROP_NAMES[3]).setValue(minMove);
+		nextGroups[id] = static_cast<int>(groupVal);
+		nextMoves[id] = minMove;
+		return true;
 	}
+	return false;
 }
 
 /*
  * InnerグループとOuterグループの動き
- * @param player プレイヤ
- * @param neighbors 近傍
+ * @param id プレイヤ位置座標
  */
-void MembraneDetectRule::inOutGroupBehavior(const std::shared_ptr<Player> player,
-		Neighbors& neighbors) {
+bool MembraneDetectRule::inOutGroupBehavior(int id) {
 
 	// 自分の戦略と行動
-	auto playerStrategyId = player->getStrategy()->getId();
-	auto playerAction = player->getAction();
+	auto& strategies = classification.getStrategies();
+	auto& actions = classification.getActions();
+	int playerStrategyId = strategies[id];
+	int playerAction = actions[id];
 
 	// グループ番号
-	auto thisGroup = static_cast<Group>(
-			player->getProperty(PROP_NAMES[0]).getValueAs<int>());
+	auto thisGroup = static_cast<Group>(groups[id]);
 
 	// 対のグループ番号
 	auto oppositeGroup = (thisGroup != Group::INNER) ? Group::INNER : Group::OUTER;
@@ -459,67 +266,52 @@ void MembraneDetectRule::inOutGroupBehavior(const std::shared_ptr<Player> player
 	// 移動ポイント
 	int minMove = INT_MAX;
 
-	// 自分は考えない
-	for (int r = 1, rMax = neighbors->size(); r < rMax; ++r) {
-		// 同じ近傍距離のプレイヤ
-		auto nNeighbors = neighbors->at(r);
-		for (auto& opponentWP : *(nNeighbors)) {
-			auto opponent = opponentWP.lock();
-			if (opponent == nullptr) {
-				// 近傍がいない場合終了
-				throw std::runtime_error("Could not find a neighbor of a player (mem detect rule - one,two).");
-			}
+	auto& neighborTable = classification.getNeighborTable();
+	for (const int* it = neighborTable.begin(id), *last = neighborTable.end(id); it != last; ++it) {
 
-			// 同戦略同行動からのみ派生
-			if ((playerStrategyId == opponent->getStrategy()->getId()) &&
-					(playerAction == opponent->getAction())) {
+		// 同戦略同行動からのみ派生
+		if ((playerStrategyId == strategies[*it]) && (playerAction == actions[*it])) {
 
-				auto opponentGroup = static_cast<Group>(
-						opponent->getProperty(PROP_NAMES[0]).getValueAs<int>());
-				auto opponentMovePoint = opponent->getProperty(PROP_NAMES[2]).getValueAs<int>();
+			auto opponentGroup = static_cast<Group>(groups[*it]);
+			int opponentMovePoint = moves[*it];
 
-				// Combineグループの場合は、移動ポイントが必要
-				if ((opponentGroup == Group::COMBINE) && (opponentMovePoint > 0)) {
-					// 終わりでよい
-					player->getProperty(PROP_NAMES[1]).setValue(static_cast<int>(Group::COMBINE));
-					player->getProperty(PROP_NAMES[3]).setValue(opponentMovePoint - 1);
-					return;
+			// Combineグループの場合は、移動ポイントが必要
+			if ((opponentGroup == Group::COMBINE) && (opponentMovePoint > 0)) {
+				// 終わりでよい
+				nextGroups[id] = static_cast<int>(Group::COMBINE);
+				nextMoves[id] = opponentMovePoint - 1;
+				return true;
 
-				} else if (opponentGroup == oppositeGroup) {
-					// 相手側グループの場合、現在のポイントと比較
-					minMove = std::min(minMove, player->getProperty(PROP_NAMES[2]).getValueAs<int>());
-					becomesMembrane = true;
+			} else if (opponentGroup == oppositeGroup) {
+				// 相手側グループの場合、現在のポイントと比較
+				minMove = std::min(minMove, moves[id]);
+				becomesMembrane = true;
 
-				}
 			}
 		}
 	}
 
 	if (becomesMembrane) {
-		player->getProperty(PROP_NAMES[1]).setValue(static_cast<int>(Group::COMBINE));
-		player->getProperty(PROP_NAMES[3]).setValue(minMove);
+		nextGroups[id] = static_cast<int>(Group::COMBINE);
+		nextMoves[id] = minMove;
 	}
-
+	return becomesMembrane;
 }
 
 
 /*
  * コピー
  */
-bool MembraneDetectRule::changesStatus(const std::shared_ptr<Player> player) {
-
-	if (player->getProperty(PROP_NAMES[0]).getValueAs<int>() ==
-			player->getProperty(PROP_NAMES[1]).getValueAs<int>()) {
+bool MembraneDetectRule::changesStatus(int id) {
 
+	if (groups[id] == nextGroups[id]) {
 		return false;
 	}
 	// 未来を現在へコピーする
 	// group id
-	player->getProperty(PROP_NAMES[0]).setValue(
-			player->getProperty(PROP_NAMES[1]).getValueAs<int>());
+	groups[id] = nextGroups[id];
 	// move point
-	player->getProperty(PROP_NAMES[2]).setValue(
-			player->getProperty(PROP_NAMES[3]).getValueAs<int>());
+	moves[id] = nextMoves[id];
 
 	return true;
 }
@@ -529,41 +321,26 @@ bool MembraneDetectRule::changesStatus(const std::shared_ptr<Player> player) {
  *
  * 膜で無いものについて上書きで、消していく
  */
-void MembraneDetectRule::postHandling(const std::shared_ptr<Player> player,
-		NeighborhoodType type) {
-
-	auto& neighbors = player->getNeighbors(type);
+void MembraneDetectRule::postHandling(int id) {
 
 	// Direct Player でなければ飛ばす
-	if (static_cast<Group>(player->getProperty(PROP_NAMES[0]).getValueAs<int>())
-			!= Group::DIRECT) {
+	if (static_cast<Group>(groups[id]) != Group::DIRECT) {
 		return;
 	}
 
 	// 自分の戦略と行動
-	auto playerStrategyId = player->getStrategy()->getId();
-	auto playerAction = player->getAction();
-
-	// 自分は考えない
-	for (int r = 1, rMax = neighbors->size(); r < rMax; ++r) {
-		// 同じ近傍距離のプレイヤ
-		auto nNeighbors = neighbors->at(r);
-
-		for (auto& opponentWP : *(nNeighbors)) {
-			auto opponent = opponentWP.lock();
-			if (opponent == nullptr) {
-				// 近傍がいない場合終了
-				throw std::runtime_error("Could not find a neighbor of a player (mem detect rule - zero).");
-			}
-
-			// 同じ戦略で、異なる行動のプレイヤならば、膜でなくす
-			if ((playerStrategyId == opponent->getStrategy()->getId()) &&
-					(playerAction != opponent->getAction())) {
-
-				opponent->getProperty(PROP_NAMES[1]).setValue(
-						static_cast<int>(Group::IGNORE));
-				return;
-			}
+	auto& strategies = classification.getStrategies();
+	auto& actions = classification.getActions();
+	int playerStrategyId = strategies[id];
+	int playerAction = actions[id];
+
+	auto& neighborTable = classification.getNeighborTable();
+	for (const int* it = neighborTable.begin(id), *last = neighborTable.end(id); it != last; ++it) {
+
+		// 同じ戦略で、異なる行動のプレイヤならば、膜でなくす
+		if ((playerStrategyId == strategies[*it]) && (playerAction != actions[*it])) {
+			nextGroups[*it] = static_cast<int>(Group::IGNORE);
+			return;
 		}
 	}
 }
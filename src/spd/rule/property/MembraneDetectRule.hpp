@@ -7,8 +7,9 @@
 #ifndef MEMBRANEDETECTRULE_HPP_
 #define MEMBRANEDETECTRULE_HPP_
 
-#include "../Rule.hpp"
+#include "../GlobalRule.hpp"
 #include "../../core/NeighborhoodType.hpp"
+#include "ContactClassification.hpp"
 
 namespace spd {
 namespace rule {
@@ -17,7 +18,7 @@ namespace rule {
  * 膜の検知ルールを表すクラス
  *
  */
-class MembraneDetectRule : public spd::rule::Rule {
+class MembraneDetectRule : public spd::rule::GlobalRule {
 
 public:
 	/**
@@ -46,17 +47,42 @@ public:
 
 	/**
 	 * 膜を検知する
-	 * @param[in, out] player 対象プレイヤ
+	 * @param[in] context 解決済みの情報
+	 * @param[in] workers 共有のワーカ
+	 */
+	void runGlobal(const RuleContext& context, const WorkerPool& workers);
+
+
+	/**
+	 * 空間構造が編集された場合に、まとめた近傍を破棄する
+	 */
+	void resetNeighborTables() {
+		classification.clear();
+	};
+
+	/**
+	 * 空間構造が編集された場合に、近傍が変わったプレイヤの分だけ近傍をまとめ直す
 	 * @param[in] allPlayers 全てのプレイヤ
 	 * @param[in] param パラメタ
-	 * @param[in] step 実行ステップ
+	 * @param[in] repaired 近傍が変わったプレイヤ位置座標(昇順)
 	 */
-	void runRule(
-			const std::shared_ptr<Player>& player,
-			const AllPlayer& allPlayers,
-			const spd::param::Parameter& param,
-			int step);
+	void repairNeighborTables(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		const std::vector<int>& repaired) {
+		classification.repair(allPlayers, repaired);
+	};
 
+	/**
+	 * 分岐元の膜の検知結果を引き継ぐ
+	 * @param[in] base 分岐元のルール
+	 * @param[in] allPlayers 分岐先のプレイヤ
+	 * @param[in] param 分岐先のパラメタ
+	 */
+	void takeOverState(
+		const Rule& base,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param);
 
 	/**
 	 * ルール情報の文字出力
@@ -66,6 +92,38 @@ public:
 		return "MemDetect";
 	}
 
+	/**
+	 * 出力だけが結果を読む解析ルール
+	 * @return true
+	 */
+	bool isAnalysis() const {
+		return true;
+	};
+
+	/**
+	 * 最後に膜を検知したステップを取得
+	 * @return ステップ(初期化後に未検知なら -1)
+	 */
+	int getAnalyzedStep() const {
+		return analyzedStep;
+	};
+
+	/**
+	 * 最後に検知した接触の種類を取得
+	 * @return 接触の種類
+	 */
+	const ContactClassification& getClassification() const {
+		return classification;
+	};
+
+	/**
+	 * 最後に検知した膜グループを取得
+	 * @return プレイヤ位置座標ごとの膜グループ
+	 */
+	const std::vector<int>& getGroups() const {
+		return groups;
+	};
+
 private:
 
 	/**
@@ -102,70 +160,93 @@ private:
 	 * INNER -> 同戦略同行動 + 同戦略"異"行動 と接続しているプレイヤ
 	 * OUTER -> 同戦略同行動 + "異"戦略同行動 + ["異"行動"異"戦略] と接しているプレイヤ
 	 * BOTH_SIDE -> 同戦略"異"行動 + "異"戦略同行動 + [同戦略同行動 | "異"戦略"異"行動] と接しているプレイヤ
-	 * @param player プレイヤ
-	 * @param type 考える膜のタイプ
-	 * @param filter 膜になり得るかどうかのフィルタ
+	 * @param id プレイヤ位置座標
 	 */
-	void grouping(const std::shared_ptr<Player> player,
-			NeighborhoodType type,
-			std::vector<bool>& filter);
+	void grouping(int id);
 
 	/**
 	 * 膜判定が広がる
-	 * @param player プレイヤ
-	 * @param type 考える膜のタイプ
+	 * @param id プレイヤ位置座標
+	 * @return 次の状態が現在と異なるかどうか
 	 */
-	void spreadMembraneDetect(const std::shared_ptr<Player> player,
-			NeighborhoodType type);
+	bool spreadMembraneDetect(int id);
 
 	/**
 	 * next を current に更新する
 	 *
 	 * その際状態が変われば、true, 変わらなければ false とする
-	 * @param player プレイヤ
+	 * @param id プレイヤ位置座標
 	 * @return 状態が変わったかどうか
 	 * @retval true 状態が変わった
 	 * @retval false 状態が変わらない
 	 */
-	bool changesStatus(const std::shared_ptr<Player> player);
+	bool changesStatus(int id);
 
 	/**
 	 * 事後処理
 	 *
 	 * 膜で無いものについて上書きで、消していく
-	 * @param player プレイヤ
-	 * @param type 考える膜のタイプ
+	 * @param id プレイヤ位置座標
 	 */
-	void postHandling(const std::shared_ptr<Player> player,
-			NeighborhoodType type);
+	void postHandling(int id);
 
 	/**
 	 * 空グループに分類されたプレイヤの動き
 	 * inner と outer がくっついたら、combine となる。
 	 * このcombineは、innerとouterへ広がる
 	 *
-	 * @param player プレイヤ
-	 * @param neighbors 近傍
+	 * @param id プレイヤ位置座標
+	 * @return 次の状態を設定したかどうか
 	 */
-	void blankGroupBehavior(const std::shared_ptr<Player> player,
-			Neighbors& neighbors);
+	bool blankGroupBehavior(int id);
 
 	/**
 	 * InnerグループとOuterグループの動き
-	 * @param player プレイヤ
-	 * @param neighbors 近傍
+	 * @param id プレイヤ位置座標
+	 * @return 次の状態を設定したかどうか
 	 */
-	void inOutGroupBehavior(const std::shared_ptr<Player> player,
-			Neighbors& neighbors);
+	bool inOutGroupBehavior(int id);
 
+	/**
+	 * 膜判定が広がり得るグループかどうか
+	 * @param group グループ番号
+	 * @return 広がり得るかどうか
+	 */
+	static bool spreads(int group) {
+		return (group == static_cast<int>(Group::BLANK)) ||
+				(group == static_cast<int>(Group::INNER)) ||
+				(group == static_cast<int>(Group::OUTER));
+	};
 
 	/**
-	 * 現在の状態をみて膜になるのかどうかのフィルタを作る
-	 * @param[in] allPlayers 全てのプレイヤ
-	 * @param[in] param パラメタ
+	 * 対戦近傍との接触の種類
+	 */
+	ContactClassification classification;
+
+	/**
+	 * 最後に膜を検知したステップ(未検知なら -1)
 	 */
-	std::vector<bool> filtering(const AllPlayer& allPlayers, const spd::param::Parameter& param);
+	int analyzedStep = -1;
 
+	/**
+	 * プレイヤ位置座標ごとの膜グループ (PROP_NAMES[0])
+	 */
+	std::vector<int> groups;
+
+	/**
+	 * プレイヤ位置座標ごとの次の膜グループ (PROP_NAMES[1])
+	 */
+	std::vector<int> nextGroups;
+
+	/**
+	 * プレイヤ位置座標ごとの移動ポイント (PROP_NAMES[2])
+	 */
+	std::vector<int> moves;
+
+	/**
+	 * プレイヤ位置座標ごとの次の移動ポイント (PROP_NAMES[3])
+	 */
+	std::vector<int> nextMoves;
 
 };
 
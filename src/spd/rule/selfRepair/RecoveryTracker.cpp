@@ -0,0 +1,154 @@
+/**
+ * RecoveryTracker.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "RecoveryTracker.hpp"
+
+#include <algorithm>
+
+#include "../../core/Player.hpp"
+#include "../../core/Strategy.hpp"
+#include "../../topology/Topology.hpp"
+
+namespace spd {
+namespace rule {
+
+/*
+ * 記録と統計を破棄する
+ */
+void RecoveryTracker::reset() {
+
+	region.clear();
+	recovering = false;
+	advancing = false;
+	damagedStep = 0;
+	damageNum = 0;
+	dirtyNum = 0;
+	recoveredNum = 0;
+	totalRecoveryTime = 0;
+	lastRecoveryTime = -1;
+	maxRecoveryTime = -1;
+}
+
+/*
+ * 損傷を与える直前のプレイヤの状態を記録する
+ *
+ * 回復中でなければ、このステップから回復までを数える
+ */
+void RecoveryTracker::watch(const spd::core::AllPlayer& allPlayers, const std::vector<int>& ids, int step) {
+
+	if (!recovering) {
+		recovering = true;
+		damagedStep = step;
+		damageNum = 0;
+	}
+	++damageNum;
+
+	for (int id : ids) {
+		record(allPlayers, id);
+	}
+}
+
+/*
+ * 記録したプレイヤの状態を調べ、汚れたプレイヤから記録を広げるか、回復を記録する
+ *
+ * 影響半径以内を加えるのは、初めて汚れたときの一度だけでよい。
+ * 損傷を与えなかった場合の盤面があれば、記録した状態の代わりにそれと比べる。
+ */
+void RecoveryTracker::update(const spd::core::AllPlayer& allPlayers,
+		spd::topology::Topology& topology,
+		int radius,
+		int step,
+		const spd::core::AllPlayer* baseline) {
+
+	if (!recovering) {
+		return;
+	}
+
+	advancing = (baseline != nullptr);
+	dirtyNum = 0;
+	std::vector<int> expanding;
+	for (auto& entry : region) {
+		auto& player = allPlayers[entry.first];
+		auto& snapshot = entry.second;
+		if (advancing) {
+			auto& undamaged = (*baseline)[entry.first];
+			if ((player->getStrategy()->getId() == undamaged->getStrategy()->getId()) &&
+					(player->getAction() == undamaged->getAction())) {
+				continue;
+			}
+		} else if ((player->getStrategy()->getId() == snapshot.strategyId) &&
+				(player->getAction() == snapshot.action)) {
+			continue;
+		}
+
+		++dirtyNum;
+		if (!snapshot.expanded) {
+			snapshot.expanded = true;
+			expanding.push_back(entry.first);
+		}
+	}
+
+	// すべて戻れば回復
+	if (dirtyNum == 0) {
+		lastRecoveryTime = step - damagedStep;
+		maxRecoveryTime = std::max(maxRecoveryTime, lastRecoveryTime);
+		totalRecoveryTime += lastRecoveryTime;
+		++recoveredNum;
+
+		region.clear();
+		recovering = false;
+		damageNum = 0;
+		return;
+	}
+
+	// 次のステップで変わり得るプレイヤを、変わる前の状態で記録する
+	for (int id : expanding) {
+		auto neighbors = topology.getNeighbors(allPlayers, id, radius);
+		for (auto& ring : *neighbors) {
+			for (auto& neighbor : *ring) {
+				record(allPlayers, neighbor.lock()->getId());
+			}
+		}
+	}
+}
+
+/*
+ * 回復の統計を出力に回す
+ *
+ * 回復していない場合の回復までのステップ数は -1 とする
+ */
+std::map<std::string, int> RecoveryTracker::propOutput(
+		const spd::core::AllPlayer& allPlayers,
+		int propPos) {
+
+	return std::map<std::string, int> {
+		{"damage_num", damageNum},
+		{"dirty_num", recovering ? dirtyNum : 0},
+		{"region_size", static_cast<int>(region.size())},
+		{"advancing_baseline", advancing ? 1 : 0},
+		{"recovered_num", recoveredNum},
+		{"last_recovery_time", lastRecoveryTime},
+		{"max_recovery_time", maxRecoveryTime},
+		{"mean_recovery_time", (recoveredNum > 0) ?
+				static_cast<int>(totalRecoveryTime / recoveredNum) : -1}
+	};
+}
+
+/*
+ * 現在の状態を記録する
+ *
+ * すでに記録している場合は、最初の記録のままとする
+ */
+void RecoveryTracker::record(const spd::core::AllPlayer& allPlayers, int id) {
+
+	auto& player = allPlayers[id];
+	region.insert(std::make_pair(id,
+			Snapshot{player->getStrategy()->getId(), player->getAction(), false}));
+}
+
+} /* namespace rule */
+} /* namespace spd */
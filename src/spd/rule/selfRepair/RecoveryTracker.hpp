@@ -0,0 +1,199 @@
+/**
+ * RecoveryTracker.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef RECOVERYTRACKER_HPP_
+#define RECOVERYTRACKER_HPP_
+
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "../../core/Action.hpp"
+#include "../../core/OriginalType.hpp"
+#include "../../core/PropertyCounting.hpp"
+
+namespace spd {
+namespace topology {
+	class Topology;
+}
+namespace rule {
+
+/**
+ * 損傷を受けた領域を追跡し、回復までのステップ数を数えるクラス
+ *
+ * @par
+ * 損傷の影響が及び得るプレイヤを領域として記録し、基準と異なる状態(戦略IDと行動)のプレイヤを
+ * 汚れたプレイヤとする。汚れたプレイヤが初めて現れたら、そのプレイヤから影響半径以内のプレイヤを
+ * 領域に加える。<br>
+ * 1ステップで状態の変化が伝わるのは影響半径以内なので、領域の外のプレイヤは基準と同じであり、
+ * 毎ステップ調べるのは領域のプレイヤだけでよい。<br>
+ * 領域のプレイヤがすべて基準と同じ状態に戻ったステップで回復とし、領域を破棄する。
+ * @par
+ * 基準には、損傷を与えなかった場合の盤面(影の盤面)を渡せば、それと比べる(進む基準)。
+ * 渡さない場合は、損傷の直前に記録した状態と比べる。
+ * その場合、盤面が損傷と関係なく変わり続けると回復しないので、固定点に落ち着いた状態からの回復にのみ使える。
+ * @par
+ * 回復までのステップ数の統計は、プロパティの特別な数え上げとして出力する(プレイヤは走査しない)。
+ */
+class RecoveryTracker : public spd::core::PropertyCounting {
+public:
+
+	/**
+	 * 記録と統計を破棄する
+	 */
+	void reset();
+
+	/**
+	 * 損傷を与える直前のプレイヤの状態を記録する
+	 * @note すでに記録しているプレイヤは、最初の記録のままとする
+	 * @param[in] allPlayers すべてのプレイヤ
+	 * @param[in] ids 損傷を与えるプレイヤ位置座標
+	 * @param[in] step 実行ステップ
+	 */
+	void watch(const spd::core::AllPlayer& allPlayers, const std::vector<int>& ids, int step);
+
+	/**
+	 * 記録したプレイヤの状態を調べ、汚れたプレイヤから記録を広げるか、回復を記録する
+	 * @param[in] allPlayers すべてのプレイヤ
+	 * @param[in] topology 空間構造
+	 * @param[in] radius 1ステップで状態の変化が伝わる影響半径
+	 * @param[in] step 実行ステップ
+	 * @param[in] baseline 損傷を与えなかった場合の盤面(nullptr の場合は、損傷の直前に記録した状態と比べる)
+	 */
+	void update(const spd::core::AllPlayer& allPlayers,
+			spd::topology::Topology& topology,
+			int radius,
+			int step,
+			const spd::core::AllPlayer* baseline);
+
+	/**
+	 * 回復の統計を出力に回す
+	 * @note プレイヤは走査しない
+	 * @param[in] allPlayers すべてのプレイヤ
+	 * @param[in] propPos プレイヤの持つプロパティの中で、対象とするプロパティの位置
+	 * @return 統計の名前と値
+	 */
+	std::map<std::string, int> propOutput(
+			const spd::core::AllPlayer& allPlayers,
+			int propPos);
+
+	/**
+	 * 回復中かどうか
+	 * @return 回復中かどうか
+	 */
+	bool isRecovering() const {
+		return recovering;
+	};
+
+	/**
+	 * 記録しているプレイヤ数
+	 * @return 記録しているプレイヤ数
+	 */
+	int getRegionSize() const {
+		return region.size();
+	};
+
+	/**
+	 * 回復した回数
+	 * @return 回復した回数
+	 */
+	int getRecoveredNum() const {
+		return recoveredNum;
+	};
+
+	/**
+	 * 最後に回復したときの、回復までのステップ数
+	 * @return ステップ数(まだ回復していない場合は -1)
+	 */
+	int getLastRecoveryTime() const {
+		return lastRecoveryTime;
+	};
+
+private:
+
+	/**
+	 * 損傷前の状態
+	 */
+	struct Snapshot {
+		/**
+		 * 戦略ID
+		 */
+		int strategyId;
+
+		/**
+		 * 行動
+		 */
+		Action action;
+
+		/**
+		 * 影響半径以内を記録に加えたかどうか
+		 */
+		bool expanded;
+	};
+
+	/**
+	 * 現在の状態を記録する
+	 * @param[in] allPlayers すべてのプレイヤ
+	 * @param[in] id プレイヤ位置座標
+	 */
+	void record(const spd::core::AllPlayer& allPlayers, int id);
+
+	/**
+	 * プレイヤ位置座標ごとの、損傷前の状態
+	 */
+	std::unordered_map<int, Snapshot> region;
+
+	/**
+	 * 回復中かどうか
+	 */
+	bool recovering = false;
+
+	/**
+	 * 最後に調べたときに、損傷を与えなかった場合の盤面と比べたかどうか
+	 */
+	bool advancing = false;
+
+	/**
+	 * 回復中の損傷を最初に与えたステップ
+	 */
+	int damagedStep = 0;
+
+	/**
+	 * 回復中に与えた損傷の回数
+	 */
+	int damageNum = 0;
+
+	/**
+	 * 最後に調べたときの、汚れたプレイヤ数
+	 */
+	int dirtyNum = 0;
+
+	/**
+	 * 回復した回数
+	 */
+	int recoveredNum = 0;
+
+	/**
+	 * 回復までのステップ数の合計
+	 */
+	long long totalRecoveryTime = 0;
+
+	/**
+	 * 最後に回復したときの、回復までのステップ数
+	 */
+	int lastRecoveryTime = -1;
+
+	/**
+	 * 回復までの最大のステップ数
+	 */
+	int maxRecoveryTime = -1;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* RECOVERYTRACKER_HPP_ */
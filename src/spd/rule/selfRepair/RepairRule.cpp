@@ -6,8 +6,276 @@
  */
 #include "RepairRule.hpp"
 
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+#include "../../core/Player.hpp"
+#include "../../core/Property.hpp"
+#include "../../core/Space.hpp"
+#include "../../param/Parameter.hpp"
+#include "../../param/GenerateSpdRule.hpp"
+#include "../../param/InitParameter.hpp"
+#include "../../param/NeighborhoodParameter.hpp"
+#include "../../param/RuntimeParameter.hpp"
+#include "../../topology/Topology.hpp"
+#include "../SpdRule.hpp"
+
 namespace spd {
-namespace topology {
+namespace rule {
+
+using spd::param::DamageType;
+
+/*
+ * プロパティを設定し、先頭プレイヤの時に記録と統計、影の盤面を破棄する
+ *
+ * 出力は先頭プレイヤのプロパティだけを見るので、数え上げは先頭プレイヤにだけ設定する
+ */
+void RepairRule::initialize(
+			const std::shared_ptr<Player>& player,
+			const AllPlayer& allPlayers,
+			const spd::param::Parameter& param) {
+
+	if (player->getId() == 0) {
+		tracker->reset();
+		shadowPlayers.clear();
+	}
+
+	try {
+		player->getProperty(PROP_NAME).setValue(0);
+	} catch (std::invalid_argument& e) {
+		if (player->getId() == 0) {
+			player->addProperty(spd::core::Property(PROP_NAME, 0,
+					spd::core::Property::OutputType::SPECIAL, tracker));
+		} else {
+			player->addProperty(spd::core::Property(PROP_NAME, 0,
+					spd::core::Property::OutputType::NOT));
+		}
+	}
+}
+
+/*
+ * 分岐元の回復の追跡と統計、影の盤面を引き継ぐ
+ *
+ * 数え上げはプロパティが参照しているので、置き換えずに中身を写す
+ */
+void RepairRule::takeOverState(
+		const Rule& base,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param) {
+
+	auto& baseRule = static_cast<const RepairRule&>(base);
+	*tracker = *(baseRule.tracker);
+
+	shadowPlayers.clear();
+	if (!baseRule.shadowPlayers.empty()) {
+		startShadow(baseRule.shadowPlayers, param);
+	}
+}
+
+/*
+ * 損傷の間隔ごとのステップで損傷を与え、損傷を受けた領域を追跡する
+ *
+ * 影の盤面は、前のステップのこのルールの直後から、このステップのこのルールの直前まで進めてから比べる。
+ * 損傷を与えるプレイヤの状態は、与える前に記録する
+ */
+void RepairRule::runGlobal(const RuleContext& context, const WorkerPool& workers) {
+
+	auto& runtimeParam = context.param.getRuntimeParameter();
+	auto& neighborParam = context.param.getNeighborhoodParameter();
+	auto& allPlayers = context.allPlayers;
+
+	if (!shadowPlayers.empty()) {
+		shadowRule->runRulesBeforeOutput(shadowPlayers, context.param, context.step - 1, false);
+		shadowRule->runRulesAfterOutput(shadowPlayers, context.param, context.step);
+	}
+
+	if ((runtimeParam->getDamageType() != DamageType::NONE) &&
+			(context.step % runtimeParam->getDamageInterval() == 0)) {
+
+		auto damaged = chooseDamaged(context);
+		if (!tracker->isRecovering()) {
+			startShadow(allPlayers, context.param);
+		}
+		tracker->watch(allPlayers, damaged, context.step);
+
+		if (runtimeParam->getDamageType() == DamageType::SWAP) {
+			for (int i = 0, size = damaged.size(); i + 1 < size; i += 2) {
+				auto& one = allPlayers[damaged[i]];
+				auto& other = allPlayers[damaged[i + 1]];
+				auto strategy = one->getStrategy();
+				auto action = one->getAction();
+				one->setStrategy(other->getStrategy());
+				one->setPreStrategy(other->getStrategy());
+				one->setAction(other->getAction());
+				one->setPreAction(other->getAction());
+				other->setStrategy(strategy);
+				other->setPreStrategy(strategy);
+				other->setAction(action);
+				other->setPreAction(action);
+			}
+		} else {
+			for (int id : damaged) {
+				auto& player = allPlayers[id];
+				auto flipped = (player->getAction() == Action::ACTION_C) ?
+						Action::ACTION_D : Action::ACTION_C;
+				player->setAction(flipped);
+				player->setPreAction(flipped);
+			}
+		}
+	}
+
+	int radius = 0;
+	for (int type = 0; type < NeighborhoodType::TYPE_NUM; ++type) {
+		radius += std::max(0, neighborParam->getNeiborhoodRadius(static_cast<NeighborhoodType>(type)));
+	}
+	tracker->update(allPlayers, *(neighborParam->getTopology()), radius, context.step,
+			shadowPlayers.empty() ? nullptr : &shadowPlayers);
+
+	// 回復したら影の盤面は使わない
+	if (!tracker->isRecovering()) {
+		shadowPlayers.clear();
+	}
+}
+
+/*
+ * 影の盤面を進めるルールを作る
+ *
+ * このルールが後処理にある場合、影の盤面は
+ * (後処理のこのルールより後 + 前処理)を前のステップで、(後処理のこのルールより前)を今のステップで実行する。
+ * 前処理にある場合は、(前処理のこのルールより後)を前のステップで、(後処理 + 前処理のこのルールより前)を
+ * 今のステップで実行する。
+ */
+std::shared_ptr<SpdRule> RepairRule::createShadowRule(const SpdRule& spdRule) {
+
+	// 状態を持つので、同じ名前から作り直す
+	spd::param::GenerateSpdRule generator;
+	auto generated = generator.generate(spdRule.getName());
+	auto& before = generated->getRulesBeforeOutput();
+	auto& after = generated->getRulesAfterOutput();
+
+	auto isRepair = [](const std::shared_ptr<Rule>& rule) {
+		return dynamic_cast<RepairRule*>(rule.get()) != nullptr;
+	};
+	auto editsShared = [](const std::shared_ptr<Rule>& rule) {
+		return rule->editsSharedState();
+	};
+	if (std::any_of(before.begin(), before.end(), editsShared) ||
+			std::any_of(after.begin(), after.end(), editsShared)) {
+		return nullptr;
+	}
+
+	auto shadow = std::make_shared<SpdRule>(generated->getName());
+	auto addBefore = [&](std::vector<std::shared_ptr<Rule>>::const_iterator from,
+			std::vector<std::shared_ptr<Rule>>::const_iterator to) {
+		for (; from != to; ++from) {
+			if (!isRepair(*from)) {
+				shadow->addRuleBeforeOutput(*from);
+			}
+		}
+	};
+	auto addAfter = [&](std::vector<std::shared_ptr<Rule>>::const_iterator from,
+			std::vector<std::shared_ptr<Rule>>::const_iterator to) {
+		for (; from != to; ++from) {
+			if (!isRepair(*from)) {
+				shadow->addRuleAfterOutput(*from);
+			}
+		}
+	};
+
+	auto position = std::find_if(after.begin(), after.end(), isRepair);
+	if (position != after.end()) {
+		addBefore(position + 1, after.end());
+		addBefore(before.begin(), before.end());
+		addAfter(after.begin(), position);
+	} else {
+		position = std::find_if(before.begin(), before.end(), isRepair);
+		addBefore(position + ((position != before.end()) ? 1 : 0), before.end());
+		addAfter(after.begin(), after.end());
+		addAfter(before.begin(), position);
+	}
+	return shadow;
+}
+
+/*
+ * 盤面を複製し、影の盤面とする
+ *
+ * 影の盤面のルールは初期化してからプロパティの値を写し、実行中のルールがまとめた近傍の表を共有する
+ */
+void RepairRule::startShadow(const AllPlayer& source, const spd::param::Parameter& param) {
+
+	auto& spdRule = param.getInitialParameter()->getSpdRule();
+	if (!shadowRuleCreated) {
+		shadowRule = createShadowRule(*spdRule);
+		shadowRuleCreated = true;
+	}
+	if (shadowRule == nullptr) {
+		return;
+	}
+
+	shadowPlayers = spd::core::Space::clonePlayers(source);
+	shadowRule->init(shadowPlayers, param);
+	spd::core::Space::copyProperties(source, shadowPlayers);
+	shadowRule->resetNeighborTables();
+	shadowRule->shareNeighborTables(*spdRule);
+}
+
+/*
+ * 損傷を与えるプレイヤを選ぶ
+ *
+ * 反転では同じプレイヤを二度反転しないよう、重複を除く
+ */
+std::vector<int> RepairRule::chooseDamaged(const RuleContext& context) {
+
+	auto& runtimeParam = context.param.getRuntimeParameter();
+	auto& allPlayers = context.allPlayers;
+	int playerNum = allPlayers.size();
+	int size = runtimeParam->getDamageSize();
+
+	auto engine = context.getStream(0, spd::param::RandomPurpose::DAMAGE);
+	std::uniform_int_distribution<int> uniform(0, playerNum - 1);
+
+	std::vector<int> damaged;
+	switch (runtimeParam->getDamageType()) {
+		case DamageType::SITES:
+			for (int i = 0; i < size; ++i) {
+				damaged.push_back(uniform(engine));
+			}
+			std::sort(damaged.begin(), damaged.end());
+			damaged.erase(std::unique(damaged.begin(), damaged.end()), damaged.end());
+			break;
+
+		case DamageType::DISC: {
+			auto& topology = context.param.getNeighborhoodParameter()->getTopology();
+			auto neighbors = topology->getNeighbors(allPlayers, uniform(engine), size);
+			for (auto& ring : *neighbors) {
+				for (auto& neighbor : *ring) {
+					damaged.push_back(neighbor.lock()->getId());
+				}
+			}
+			// 回り込んで重複する場合
+			std::sort(damaged.begin(), damaged.end());
+			damaged.erase(std::unique(damaged.begin(), damaged.end()), damaged.end());
+			break;
+		}
+
+		case DamageType::SWAP:
+			for (int i = 0; (i < size) && (playerNum > 1); ++i) {
+				int one = uniform(engine);
+				int other = uniform(engine);
+				while (other == one) {
+					other = uniform(engine);
+				}
+				damaged.push_back(one);
+				damaged.push_back(other);
+			}
+			break;
+
+		default:
+			break;
+	}
+	return damaged;
+}
 
-} /* namespace topology */
+} /* namespace rule */
 } /* namespace spd */
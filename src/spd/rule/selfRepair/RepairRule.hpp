@@ -7,32 +7,138 @@
 #ifndef REPAIRRULE_HPP_
 #define REPAIRRULE_HPP_
 
-#include "../Rule.hpp"
+#include <memory>
+#include <vector>
+
+#include "../GlobalRule.hpp"
+#include "RecoveryTracker.hpp"
 
 namespace spd {
 namespace rule {
 
+class SpdRule;
+
 /**
  * 自己修復のルールを表すクラス
+ *
+ * @par
+ * 損傷の間隔ごとのステップで、戦略更新の後に損傷を与える。損傷の種類は
+ * 一様に選んだプレイヤの行動の反転(sites)、一様に選んだ中心から近傍半径以内の行動の反転(disc)、
+ * 一様に選んだ2プレイヤの戦略と行動の入れ替え(swap)である。<br>
+ * 反転と入れ替えは、前の状態にも反映し、次のステップの更新が損傷後の状態を読むようにする。
+ * @par
+ * 損傷の影響は RecoveryTracker で、損傷が広がった領域だけを調べて追跡する。
+ * 影響半径は、行動更新・対戦・戦略更新の近傍半径の和とする。<br>
+ * 回復中は、損傷の直前に複製した盤面(影の盤面)を、このルール以外の同じルールで進め、
+ * 損傷を与えなかった場合の盤面として追跡の基準にする。乱数はステップとプレイヤごとの乱数列なので、
+ * 影の盤面は損傷がなければ実際の盤面と同じに進み、変わり続ける盤面でも回復を判定できる。<br>
+ * 回復までのステップ数の統計は、プロパティ "Repair" として出力する。
+ * @note 影の盤面は盤面全体を進めるので、回復中は1ステップの計算がおよそ2倍になる
+ * (ルールは領域だけを更新できない)。共有するものを書き換えるルール(張り替えや突然変異)がある場合は
+ * 影の盤面を作らず、損傷の直前の状態を基準にするので、固定点からの回復にのみ使える
+ * @note 乱数はステップごとの乱数列を使うので、コア数によらず同じ結果となる
  */
-class RepairRule : public spd::rule::Rule {
+class RepairRule : public spd::rule::GlobalRule {
 public:
 
+	/**
+	 * コンストラクタ
+	 */
+	RepairRule() : tracker(std::make_shared<RecoveryTracker>()) {};
+
+	/**
+	 * プロパティを設定し、先頭プレイヤの時に記録と統計、影の盤面を破棄する
+	 * @param[in, out] player 対象プレイヤ
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 */
 	void initialize(
 				const std::shared_ptr<Player>& player,
 				const AllPlayer& allPlayers,
 				const spd::param::Parameter& param);
 
-	void runRule(
-			const std::shared_ptr<Player>& player,
-			const AllPlayer& allPlayers,
-			const spd::param::Parameter& param,
-			int step);
+	/**
+	 * 損傷の間隔ごとのステップで損傷を与え、損傷を受けた領域を追跡する
+	 * @param[in] context 解決済みの情報
+	 * @param[in] workers 共有のワーカ
+	 */
+	void runGlobal(const RuleContext& context, const WorkerPool& workers);
 
+	/**
+	 * 分岐元の回復の追跡と統計、影の盤面を引き継ぐ
+	 * @note 影の盤面は分岐先のルールで進める
+	 * @param[in] base 分岐元のルール
+	 * @param[in] allPlayers 分岐先のプレイヤ
+	 * @param[in] param 分岐先のパラメタ
+	 */
+	void takeOverState(
+		const Rule& base,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param);
+
+	/**
+	 * 回復の追跡を取得
+	 * @return 回復の追跡
+	 */
+	const std::shared_ptr<RecoveryTracker>& getTracker() const {
+		return tracker;
+	};
 
 	std::string toString() const {
 		return "selfRepair";
 	}
+
+private:
+
+	/**
+	 * プロパティ名
+	 */
+	const std::string PROP_NAME = "Repair";
+
+	/**
+	 * 損傷を与えるプレイヤを選ぶ
+	 * @note 入れ替えの場合は、入れ替える2プレイヤを順に並べる
+	 * @param[in] context 解決済みの情報
+	 * @return プレイヤ位置座標
+	 */
+	std::vector<int> chooseDamaged(const RuleContext& context);
+
+	/**
+	 * 影の盤面を進めるルールを作る
+	 *
+	 * 実行中のルールを同じ名前から作り直し、このルールの直後から次にこのルールに至るまでのルールを、
+	 * 前のステップで実行するものと今のステップで実行するものに分けて並べる
+	 * @param[in] spdRule 実行中のルール
+	 * @return 影の盤面を進めるルール(共有するものを書き換えるルールがある場合は nullptr)
+	 */
+	static std::shared_ptr<SpdRule> createShadowRule(const SpdRule& spdRule);
+
+	/**
+	 * 盤面を複製し、影の盤面とする
+	 * @param[in] source 複製する盤面
+	 * @param[in] param パラメタ
+	 */
+	void startShadow(const AllPlayer& source, const spd::param::Parameter& param);
+
+	/**
+	 * 回復の追跡(プロパティの数え上げも兼ねる)
+	 */
+	std::shared_ptr<RecoveryTracker> tracker;
+
+	/**
+	 * 影の盤面を進めるルールを作ったかどうか
+	 */
+	bool shadowRuleCreated = false;
+
+	/**
+	 * 影の盤面を進めるルール(作れない場合は nullptr)
+	 */
+	std::shared_ptr<SpdRule> shadowRule;
+
+	/**
+	 * 影の盤面(回復中でない場合は空)
+	 */
+	AllPlayer shadowPlayers;
 };
 
 } /* namespace rule */
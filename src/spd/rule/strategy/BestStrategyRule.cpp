@@ -7,9 +7,11 @@
 
 #include "BestStrategyRule.hpp"
 
+#include <limits>
 #include <stdexcept>
 
 #include "../../core/Strategy.hpp"
+#include "../../core/StrategyPool.hpp"
 #include "../../core/Player.hpp"
 
 #include "../../param/Parameter.hpp"
@@ -17,6 +19,7 @@
 #include "../../param/NeighborhoodParameter.hpp"
 
 #include "../../topology/Topology.hpp"
+#include "../../topology/SlidingMaximum.hpp"
 
 namespace spd {
 namespace rule {
@@ -25,7 +28,63 @@ void BestStrategyRule::initialize(
 		const std::shared_ptr<Player>& player,
 		const AllPlayer& allPlayers,
 		const spd::param::Parameter& param) {
-	return;
+
+	neighborTable.clear();
+}
+
+/*
+ * 箱型近傍の空間構造の場合、戦略ごとに近傍の最大利得を求める
+ *
+ * 戦略ごとに、その戦略のプレイヤの前の利得(他の戦略は負の無限大)を並べ、箱の最大値をとる。
+ */
+void BestStrategyRule::prepare(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step) {
+
+	strategyMaxScores.clear();
+
+	// 戦略更新周期でなければ、何もしない
+	if (step % param.getRuntimeParameter()->getStrategyUpdateCycle() != 0) {
+		return;
+	}
+
+	auto& neighborParam = param.getNeighborhoodParameter();
+	int radius = neighborParam->getNeiborhoodRadius(NeighborhoodType::STRATEGY);
+
+	auto& pool = param.getStrategyPool();
+	auto slidingMax = neighborParam->getTopology()->createSlidingMaximum(allPlayers.size());
+	if (slidingMax == nullptr || !slidingMax->isApplicable(radius) ||
+			(pool->getActiveNum() > SLIDING_MAX_STRATEGY_NUM)) {
+
+		// 近傍を配列にまとめられれば、前の利得と戦略IDを写す
+		if (neighborTable.isBuilt() || neighborTable.build(allPlayers, NeighborhoodType::STRATEGY)) {
+			preScores.resize(allPlayers.size());
+			preStrategies.resize(allPlayers.size());
+			for (auto& player : allPlayers) {
+				preScores[player->getId()] = player->getPreScore();
+				preStrategies[player->getId()] = player->getPreStrategy()->getId();
+			}
+		}
+		return;
+	}
+
+	int strategyNum = pool->getIdLimit();
+	strategyMaxScores.resize(strategyNum);
+
+	std::vector<double> scores(allPlayers.size());
+	for (int strategyId = 0; strategyId < strategyNum; ++strategyId) {
+		if (pool->at(strategyId) == nullptr) {
+			// 破棄された ID
+			strategyMaxScores[strategyId].assign(allPlayers.size(), -std::numeric_limits<double>::infinity());
+			continue;
+		}
+		for (auto& player : allPlayers) {
+			scores[player->getId()] = (player->getPreStrategy()->getId() == strategyId) ?
+					player->getPreScore() : -std::numeric_limits<double>::infinity();
+		}
+		slidingMax->compute(scores, radius, strategyMaxScores[strategyId]);
+	}
 }
 
 /*
@@ -42,6 +101,36 @@ void BestStrategyRule::runRule(
 		return;
 	}
 
+	int maxStrategyId = -1;
+	if (!strategyMaxScores.empty()) {
+		maxStrategyId = findBestStrategy(player);
+	} else if (neighborTable.isBuilt()) {
+		int id = player->getId();
+		maxStrategyId = argMax.find(neighborTable.begin(id), neighborTable.getCount(id),
+				preScores.data(), preStrategies.data(),
+				player->getPreScore(), player->getPreStrategy()->getId());
+	}
+	if (maxStrategyId < 0) {
+		maxStrategyId = scanBestStrategy(player, allPlayers, param);
+	}
+
+	// 最大の戦略を設定
+	player->setStrategy(param.getStrategyPool()->at(maxStrategyId));
+
+	// 利得を0にする
+	player->setScore(0.0);
+}
+
+/*
+ * 近傍を走査して、最大利得の戦略を求める
+ *
+ * 利得が同じ場合は自身の戦略を維持し、そうでなければ走査順で先の近傍の戦略とする。
+ */
+int BestStrategyRule::scanBestStrategy(
+		const std::shared_ptr<Player>& player,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param) const {
+
 	// 近傍の設定
 	auto phase = NeighborhoodType::STRATEGY;
 	auto neighbors = player->getNeighbors(phase);
@@ -80,13 +169,46 @@ void BestStrategyRule::runRule(
 		}
 	}
 
-	// 最大の戦略を設定
-	player->setStrategy(param.getStrategyList().at(maxStrategyId).first);
-
-	// 利得を0にする
-	player->setScore(0.0);
+	return maxStrategyId;
 }
 
+/*
+ * 戦略ごとの近傍の最大利得から、最大利得の戦略を求める
+ *
+ * 走査による更新と同じく、最大利得に自身の戦略が含まれれば自身の戦略を維持する。
+ * 自身の戦略以外で最大利得の戦略が1つなら、その戦略とする。
+ * 複数ある場合は走査順で決まるため、求めない。
+ */
+int BestStrategyRule::findBestStrategy(const std::shared_ptr<Player>& player) const {
+
+	int id = player->getId();
+	int ownStrategyId = player->getPreStrategy()->getId();
+
+	double maxScore = -std::numeric_limits<double>::infinity();
+	for (auto& maxScores : strategyMaxScores) {
+		if (maxScore < maxScores[id]) {
+			maxScore = maxScores[id];
+		}
+	}
+
+	// 自身の戦略が最大利得なら維持
+	if (strategyMaxScores[ownStrategyId][id] == maxScore) {
+		return ownStrategyId;
+	}
+
+	int maxStrategyId = -1;
+	for (int strategyId = 0, size = strategyMaxScores.size(); strategyId < size; ++strategyId) {
+		if (strategyMaxScores[strategyId][id] == maxScore) {
+			if (maxStrategyId >= 0) {
+				// 複数の戦略が並ぶ場合
+				return -1;
+			}
+			maxStrategyId = strategyId;
+		}
+	}
+
+	return maxStrategyId;
+}
 
 } /* namespace rule */
 } /* namespace spd */
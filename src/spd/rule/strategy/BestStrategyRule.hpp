@@ -8,9 +8,16 @@
 #ifndef BESTSTRATEGYRULE_H_
 #define BESTSTRATEGYRULE_H_
 
+#include <memory>
+#include <vector>
 #include "../Rule.hpp"
+#include "../NeighborTable.hpp"
+#include "NeighborArgMax.hpp"
 
 namespace spd {
+namespace topology {
+	class SlidingMaximum;
+}
 namespace rule {
 
 /**
@@ -23,7 +30,7 @@ public:
 
 	/**
 	 * プレイヤの初期化ルール
-	 * @note なにもしない
+	 * @note 構造が作り直されている可能性があるため、まとめた近傍を破棄する
 	 * @param[in, out] player 対象プレイヤ
 	 * @param[in] allPlayers 全てのプレイヤ
 	 * @param[in] param パラメタ
@@ -49,6 +56,41 @@ public:
 		const spd::param::Parameter& param,
 		int step);
 
+	/**
+	 * 箱型近傍の空間構造の場合、戦略ごとに近傍の最大利得を求める
+	 * @par
+	 * 戦略ごとの最大利得が分かれば、ほとんどのプレイヤは近傍を走査せずに更新後の戦略が決まる。<br>
+	 * それ以外の構造で近傍を保持している場合は、近傍をプレイヤ位置座標の連続した配列にまとめ、
+	 * 前の利得と戦略IDを配列に写す。
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @param[in] step 実行ステップ
+	 */
+	void prepare(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		int step);
+
+	/**
+	 * 空間構造が編集された場合に、まとめた近傍を破棄する
+	 */
+	void resetNeighborTables() {
+		neighborTable.clear();
+	};
+
+	/**
+	 * 空間構造が編集された場合に、近傍が変わったプレイヤの分だけ近傍をまとめ直す
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @param[in] repaired 近傍が変わったプレイヤ位置座標(昇順)
+	 */
+	void repairNeighborTables(
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param,
+		const std::vector<int>& repaired) {
+		neighborTable.patch(allPlayers, NeighborhoodType::STRATEGY, repaired);
+	};
+
 	/**
 	 * ルール情報の文字出力
 	 * @return "BestStrategyUpdate"
@@ -56,6 +98,61 @@ public:
 	std::string toString() const {
 		return "BestStrategyUpdate";
 	}
+
+private:
+
+	/**
+	 * 近傍を走査して、最大利得の戦略を求める
+	 * @param[in] player 対象プレイヤ
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @return 最大利得の戦略ID
+	 * @throw std::runtime_error 近傍が見つからない場合
+	 */
+	int scanBestStrategy(
+		const std::shared_ptr<Player>& player,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param) const;
+
+	/**
+	 * 戦略ごとの近傍の最大利得から、最大利得の戦略を求める
+	 * @param[in] player 対象プレイヤ
+	 * @return 最大利得の戦略ID
+	 * @retval -1 自身以外の複数の戦略が最大利得で並び、近傍の走査順で決まる場合
+	 */
+	int findBestStrategy(const std::shared_ptr<Player>& player) const;
+
+	/**
+	 * 戦略ごとに箱型近傍の最大値を求める、使われている戦略数の上限
+	 * @note 突然変異で戦略が増えた場合は、近傍の表から求める方が速い
+	 */
+	static const int SLIDING_MAX_STRATEGY_NUM = 8;
+
+	/**
+	 * 戦略ごとの、箱型近傍における最大利得(戦略ID, プレイヤ位置座標の順)
+	 * @note 箱型近傍の最大値を求められない場合は空
+	 */
+	std::vector<std::vector<double>> strategyMaxScores;
+
+	/**
+	 * 近傍から最大利得の戦略を求める計算方法
+	 */
+	NeighborArgMax argMax;
+
+	/**
+	 * 戦略更新近傍をまとめた表
+	 */
+	NeighborTable neighborTable;
+
+	/**
+	 * プレイヤ位置座標ごとの前の利得
+	 */
+	std::vector<double> preScores;
+
+	/**
+	 * プレイヤ位置座標ごとの前の戦略ID
+	 */
+	std::vector<int> preStrategies;
 };
 
 } /* namespace rule */
@@ -0,0 +1,64 @@
+/**
+ * MutationRule.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "MutationRule.hpp"
+
+#include <random>
+#include <vector>
+
+#include "../../core/Player.hpp"
+#include "../../core/Strategy.hpp"
+#include "../../core/StrategyPool.hpp"
+#include "../../param/Parameter.hpp"
+#include "../../param/RuntimeParameter.hpp"
+
+namespace spd {
+namespace rule {
+
+/*
+ * 使われなくなった戦略を破棄し、戦略更新周期のステップでは突然変異させる
+ *
+ * 突然変異するかどうかと位置の抽選は並列に行い、戦略の登録はプレイヤ順に行う
+ */
+void MutationRule::runGlobal(const RuleContext& context, const WorkerPool& workers) {
+
+	auto& runtimeParam = context.param.getRuntimeParameter();
+	auto& pool = context.param.getStrategyPool();
+	pool->retireUnused();
+
+	double mutationRate = runtimeParam->getMutationRate();
+	if ((mutationRate <= 0) || (context.step % runtimeParam->getStrategyUpdateCycle() != 0)) {
+		return;
+	}
+
+	// 反転させる位置(突然変異しない場合は -1)
+	auto& allPlayers = context.allPlayers;
+	std::vector<int> positions(allPlayers.size(), -1);
+	workers.run(allPlayers.size(), [&](int, int begin, int end) {
+		for (int id = begin; id < end; ++id) {
+			auto engine = context.getStream(id, spd::param::RandomPurpose::MUTATION);
+			if (std::uniform_real_distribution<double>(0.0, 1.0)(engine) < mutationRate) {
+				int length = allPlayers[id]->getStrategy()->getLength();
+				positions[id] = std::uniform_int_distribution<int>(0, length - 1)(engine);
+			}
+		}
+	});
+
+	for (int id = 0, playerNum = allPlayers.size(); id < playerNum; ++id) {
+		if (positions[id] < 0) {
+			continue;
+		}
+		auto& player = allPlayers[id];
+		std::vector<Action> longStrategy = player->getStrategy()->getLongStrategy();
+		longStrategy[positions[id]] = (longStrategy[positions[id]] == Action::ACTION_C) ?
+				Action::ACTION_D : Action::ACTION_C;
+		player->setStrategy(pool->intern(longStrategy));
+	}
+}
+
+} /* namespace rule */
+} /* namespace spd */
@@ -0,0 +1,67 @@
+/**
+ * MutationRule.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef MUTATIONRULE_HPP_
+#define MUTATIONRULE_HPP_
+
+#include "../GlobalRule.hpp"
+
+namespace spd {
+namespace rule {
+
+/**
+ * 戦略の突然変異を表すクラス
+ *
+ * @par
+ * 戦略更新の後に、各プレイヤは突然変異率の確率で、戦略の一様に選んだ1か所の行動を反転させる。<br>
+ * 作られた戦略は StrategyPool で同じ略記の戦略とまとめ、
+ * どのプレイヤからも参照されなくなった戦略は次の実行時に破棄する。<br>
+ * 乱数はプレイヤとステップごとの乱数列を使うので、コア数によらず同じ結果となる。
+ */
+class MutationRule : public spd::rule::GlobalRule {
+public:
+
+	/**
+	 * プレイヤの初期化ルール
+	 * @note なにもしない
+	 * @param[in, out] player 対象プレイヤ
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 */
+	void initialize(
+			const std::shared_ptr<Player>& player,
+			const AllPlayer& allPlayers,
+			const spd::param::Parameter& param) {
+	};
+
+	/**
+	 * 使われなくなった戦略を破棄し、戦略更新周期のステップでは突然変異させる
+	 * @param[in] context 解決済みの情報
+	 * @param[in] workers 共有のワーカ
+	 */
+	void runGlobal(const RuleContext& context, const WorkerPool& workers);
+
+	/**
+	 * 共有する戦略プールに戦略を登録し、破棄するので、書き換える
+	 * @return true
+	 */
+	bool editsSharedState() const {
+		return true;
+	};
+
+	/**
+	 * ルール情報の文字出力
+	 * @return "Mutation"
+	 */
+	std::string toString() const {
+		return "Mutation";
+	}
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* MUTATIONRULE_HPP_ */
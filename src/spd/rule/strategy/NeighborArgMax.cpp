@@ -0,0 +1,259 @@
+/**
+ * NeighborArgMax.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "NeighborArgMax.hpp"
+
+#include <limits>
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SPD_NEIGHBORARGMAX_X86
+#include <immintrin.h>
+#endif
+
+namespace spd {
+namespace rule {
+
+namespace {
+
+/**
+ * レーンごとの途中結果
+ */
+struct LaneState {
+	/** 最大利得 */
+	double best;
+	/** 最大利得の戦略ID */
+	int strategy;
+	/** 最大利得が最初に現れた位置 */
+	long long order;
+	/** 最大利得に自身の戦略が含まれるか */
+	bool own;
+};
+
+/**
+ * レーンの途中結果をまとめる
+ * @param[in] lanes レーンの途中結果
+ * @param[in] laneNum レーン数
+ * @param[in] ownScore 自身の前の利得
+ * @param[in] ownStrategy 自身の前の戦略ID
+ * @return 最大利得の戦略ID
+ */
+int reduceLanes(const LaneState* lanes, int laneNum, double ownScore, int ownStrategy) {
+
+	double maxScore = ownScore;
+	for (int i = 0; i < laneNum; ++i) {
+		if (maxScore < lanes[i].best) {
+			maxScore = lanes[i].best;
+		}
+	}
+
+	// 自身が最大利得なら維持
+	if (ownScore == maxScore) {
+		return ownStrategy;
+	}
+
+	int maxStrategyId = ownStrategy;
+	long long firstOrder = std::numeric_limits<long long>::max();
+	for (int i = 0; i < laneNum; ++i) {
+		if (lanes[i].best != maxScore) {
+			continue;
+		}
+		if (lanes[i].own) {
+			// 利得が同じなら、戦略を維持する
+			return ownStrategy;
+		}
+		if (lanes[i].order < firstOrder) {
+			firstOrder = lanes[i].order;
+			maxStrategyId = lanes[i].strategy;
+		}
+	}
+	return maxStrategyId;
+}
+
+/**
+ * 残りの要素を、1要素ずつのレーンとして加える
+ * @param[in] from 開始位置
+ * @param[in] count 近傍数
+ * @param[in] ids 近傍のプレイヤ位置座標
+ * @param[in] scores 前の利得
+ * @param[in] strategies 前の戦略ID
+ * @param[in] ownStrategy 自身の前の戦略ID
+ * @param[in, out] lanes レーンの途中結果
+ * @param[in, out] laneNum レーン数
+ */
+void addRemainder(int from, int count, const int* ids, const double* scores, const int* strategies,
+		int ownStrategy, LaneState* lanes, int& laneNum) {
+
+	for (int i = from; i < count; ++i) {
+		int strategy = strategies[ids[i]];
+		lanes[laneNum++] = {scores[ids[i]], strategy, i, strategy == ownStrategy};
+	}
+}
+
+/**
+ * スカラーで最大利得の戦略を求める
+ */
+int scalarKernel(const int* ids, int count, const double* scores, const int* strategies,
+		double ownScore, int ownStrategy) {
+
+	double maxScore = ownScore;
+	int maxStrategyId = ownStrategy;
+
+	for (int i = 0; i < count; ++i) {
+		double score = scores[ids[i]];
+		int strategy = strategies[ids[i]];
+		if (maxScore < score) {
+			maxStrategyId = strategy;
+			maxScore = score;
+		} else if ((maxScore == score) && (strategy == ownStrategy)) {
+			maxStrategyId = strategy;
+		}
+	}
+	return maxStrategyId;
+}
+
+#ifdef SPD_NEIGHBORARGMAX_X86
+
+/**
+ * AVX2 で最大利得の戦略を求める(4レーン)
+ */
+__attribute__((target("avx2")))
+int avx2Kernel(const int* ids, int count, const double* scores, const int* strategies,
+		double ownScore, int ownStrategy) {
+
+	constexpr int WIDTH = 4;
+	LaneState lanes[2 * WIDTH];
+	int laneNum = 0;
+	int vectorEnd = count - count % WIDTH;
+
+	if (vectorEnd > 0) {
+		__m256d best = _mm256_set1_pd(-std::numeric_limits<double>::infinity());
+		__m256i strategy = _mm256_setzero_si256();
+		__m256i order = _mm256_setzero_si256();
+		__m256i own = _mm256_setzero_si256();
+		const __m256i ownVec = _mm256_set1_epi64x(ownStrategy);
+		const __m256i step = _mm256_set1_epi64x(WIDTH);
+		__m256i current = _mm256_set_epi64x(3, 2, 1, 0);
+		// 全要素を読み込むマスク(マスクなしの gather は未初期化の警告が出るため)
+		const __m256d allScores = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+		const __m128i allStrategies = _mm_set1_epi32(-1);
+
+		for (int i = 0; i < vectorEnd; i += WIDTH) {
+			__m128i index = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ids + i));
+			__m256d score = _mm256_mask_i32gather_pd(_mm256_setzero_pd(), scores, index, allScores, 8);
+			__m256i st = _mm256_cvtepi32_epi64(
+					_mm_mask_i32gather_epi32(_mm_setzero_si128(), strategies, index, allStrategies, 4));
+
+			__m256i gt = _mm256_castpd_si256(_mm256_cmp_pd(score, best, _CMP_GT_OQ));
+			__m256i eq = _mm256_castpd_si256(_mm256_cmp_pd(score, best, _CMP_EQ_OQ));
+			__m256i isOwn = _mm256_cmpeq_epi64(st, ownVec);
+
+			best = _mm256_blendv_pd(best, score, _mm256_castsi256_pd(gt));
+			strategy = _mm256_blendv_epi8(strategy, st, gt);
+			order = _mm256_blendv_epi8(order, current, gt);
+			own = _mm256_blendv_epi8(_mm256_or_si256(own, _mm256_and_si256(eq, isOwn)), isOwn, gt);
+
+			current = _mm256_add_epi64(current, step);
+		}
+
+		double bestArray[WIDTH];
+		long long strategyArray[WIDTH];
+		long long orderArray[WIDTH];
+		long long ownArray[WIDTH];
+		_mm256_storeu_pd(bestArray, best);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(strategyArray), strategy);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(orderArray), order);
+		_mm256_storeu_si256(reinterpret_cast<__m256i*>(ownArray), own);
+		for (int lane = 0; lane < WIDTH; ++lane) {
+			lanes[laneNum++] = {bestArray[lane], static_cast<int>(strategyArray[lane]),
+					orderArray[lane], ownArray[lane] != 0};
+		}
+	}
+
+	addRemainder(vectorEnd, count, ids, scores, strategies, ownStrategy, lanes, laneNum);
+	return reduceLanes(lanes, laneNum, ownScore, ownStrategy);
+}
+
+/**
+ * AVX-512 で最大利得の戦略を求める(8レーン)
+ */
+__attribute__((target("avx512f,avx2")))
+int avx512Kernel(const int* ids, int count, const double* scores, const int* strategies,
+		double ownScore, int ownStrategy) {
+
+	constexpr int WIDTH = 8;
+	LaneState lanes[2 * WIDTH];
+	int laneNum = 0;
+	int vectorEnd = count - count % WIDTH;
+
+	if (vectorEnd > 0) {
+		__m512d best = _mm512_set1_pd(-std::numeric_limits<double>::infinity());
+		__m512i strategy = _mm512_setzero_si512();
+		__m512i order = _mm512_setzero_si512();
+		__mmask8 own = 0;
+		const __m512i ownVec = _mm512_set1_epi64(ownStrategy);
+		const __m512i step = _mm512_set1_epi64(WIDTH);
+		__m512i current = _mm512_set_epi64(7, 6, 5, 4, 3, 2, 1, 0);
+		// 全要素を読み込むマスク(マスクなしの gather は未初期化の警告が出るため)
+		const __m256i allStrategies = _mm256_set1_epi32(-1);
+
+		for (int i = 0; i < vectorEnd; i += WIDTH) {
+			__m256i index = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ids + i));
+			__m512d score = _mm512_mask_i32gather_pd(_mm512_setzero_pd(), 0xFF, index, scores, 8);
+			__m512i st = _mm512_maskz_cvtepi32_epi64(0xFF,
+					_mm256_mask_i32gather_epi32(_mm256_setzero_si256(), strategies, index, allStrategies, 4));
+
+			__mmask8 gt = _mm512_cmp_pd_mask(score, best, _CMP_GT_OQ);
+			__mmask8 eq = _mm512_cmp_pd_mask(score, best, _CMP_EQ_OQ);
+			__mmask8 isOwn = _mm512_cmpeq_epi64_mask(st, ownVec);
+
+			best = _mm512_mask_blend_pd(gt, best, score);
+			strategy = _mm512_mask_blend_epi64(gt, strategy, st);
+			order = _mm512_mask_blend_epi64(gt, order, current);
+			own = (gt & isOwn) | (~gt & (own | (eq & isOwn)));
+
+			current = _mm512_add_epi64(current, step);
+		}
+
+		double bestArray[WIDTH];
+		long long strategyArray[WIDTH];
+		long long orderArray[WIDTH];
+		_mm512_storeu_pd(bestArray, best);
+		_mm512_storeu_si512(strategyArray, strategy);
+		_mm512_storeu_si512(orderArray, order);
+		for (int lane = 0; lane < WIDTH; ++lane) {
+			lanes[laneNum++] = {bestArray[lane], static_cast<int>(strategyArray[lane]),
+					orderArray[lane], ((own >> lane) & 1) != 0};
+		}
+	}
+
+	addRemainder(vectorEnd, count, ids, scores, strategies, ownStrategy, lanes, laneNum);
+	return reduceLanes(lanes, laneNum, ownScore, ownStrategy);
+}
+
+#endif
+
+}
+
+/*
+ * CPU が対応する命令セットから、計算方法を選ぶ
+ */
+NeighborArgMax::NeighborArgMax() : kernel(scalarKernel), instructionSet("scalar") {
+
+#ifdef SPD_NEIGHBORARGMAX_X86
+	__builtin_cpu_init();
+	if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx2")) {
+		kernel = avx512Kernel;
+		instructionSet = "avx512";
+	} else if (__builtin_cpu_supports("avx2")) {
+		kernel = avx2Kernel;
+		instructionSet = "avx2";
+	}
+#endif
+}
+
+} /* namespace rule */
+} /* namespace spd */
@@ -0,0 +1,78 @@
+/**
+ * NeighborArgMax.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef NEIGHBORARGMAX_HPP_
+#define NEIGHBORARGMAX_HPP_
+
+#include <string>
+
+namespace spd {
+namespace rule {
+
+/**
+ * 連続した近傍のプレイヤ位置座標の配列から、最大利得の戦略を求めるクラス
+ *
+ * @par
+ * 利得と戦略IDはプレイヤ位置座標ごとの配列とし、近傍の位置座標で間接参照(gather)する。<br>
+ * ベクトル演算では、レーンごとに最大利得・その戦略ID・最初に現れた位置・自身の戦略が最大利得に含まれるか
+ * を分岐なしに(blend で)更新し、最後にレーンをまとめる。<br>
+ * 実行時に CPU を調べ、AVX-512, AVX2, スカラーの順に使用可能なものを選ぶ。
+ * @note 結果は BestStrategyRule の走査と同じく、利得が同じなら自身の戦略を維持し、
+ * そうでなければ配列で先に現れた近傍の戦略とする
+ */
+class NeighborArgMax {
+public:
+
+	/**
+	 * CPU が対応する命令セットから、計算方法を選ぶ
+	 */
+	NeighborArgMax();
+
+	/**
+	 * 最大利得の戦略を求める
+	 * @param[in] ids 近傍のプレイヤ位置座標(走査順)
+	 * @param[in] count 近傍数
+	 * @param[in] scores プレイヤ位置座標ごとの前の利得
+	 * @param[in] strategies プレイヤ位置座標ごとの前の戦略ID
+	 * @param[in] ownScore 自身の前の利得
+	 * @param[in] ownStrategy 自身の前の戦略ID
+	 * @return 最大利得の戦略ID
+	 */
+	int find(const int* ids, int count, const double* scores, const int* strategies,
+			double ownScore, int ownStrategy) const {
+		return kernel(ids, count, scores, strategies, ownScore, ownStrategy);
+	};
+
+	/**
+	 * 選んだ命令セット名を取得
+	 * @return "avx512", "avx2", "scalar" のいずれか
+	 */
+	const std::string& getInstructionSet() const {
+		return instructionSet;
+	};
+
+private:
+
+	/**
+	 * 計算方法の型
+	 */
+	typedef int (*Kernel)(const int*, int, const double*, const int*, double, int);
+
+	/**
+	 * 計算方法
+	 */
+	Kernel kernel;
+
+	/**
+	 * 命令セット名
+	 */
+	std::string instructionSet;
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* NEIGHBORARGMAX_HPP_ */
@@ -0,0 +1,102 @@
+/**
+ * RewireRule.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "RewireRule.hpp"
+
+#include <random>
+#include <stdexcept>
+
+#include "../../core/Player.hpp"
+#include "../../param/Parameter.hpp"
+#include "../../param/NeighborhoodParameter.hpp"
+#include "../../param/RuntimeParameter.hpp"
+#include "../../topology/Topology.hpp"
+
+namespace spd {
+namespace rule {
+
+/*
+ * プレイヤの初期化ルール
+ *
+ * 空間構造が接続を編集できるかを、先頭プレイヤの時だけ調べる
+ */
+void RewireRule::initialize(
+		const std::shared_ptr<Player>& player,
+		const AllPlayer& allPlayers,
+		const spd::param::Parameter& param) {
+
+	if ((player->getId() == 0) && (param.getRuntimeParameter()->getRewireRate() > 0) &&
+			!param.getNeighborhoodParameter()->getTopology()->isEditable()) {
+		throw std::invalid_argument("Could not rewire links on this topology. "
+				"The rewire component needs a network topology.");
+	}
+}
+
+/*
+ * 戦略更新周期のステップで、接続の張り替えを記録する
+ *
+ * 接続はルールの区切りまで変わらないので、各ワーカは編集前の接続を読む
+ */
+void RewireRule::runGlobal(const RuleContext& context, const WorkerPool& workers) {
+
+	auto& runtimeParam = context.param.getRuntimeParameter();
+	double rewireRate = runtimeParam->getRewireRate();
+	if ((rewireRate <= 0) || (context.step % runtimeParam->getStrategyUpdateCycle() != 0)) {
+		return;
+	}
+
+	auto& editor = context.param.getNeighborhoodParameter()->getTopology()->getEditor();
+	editor.reserve(workers.getCore());
+
+	auto& allPlayers = context.allPlayers;
+	workers.run(allPlayers.size(), [&](int worker, int begin, int end) {
+		for (int id = begin; id < end; ++id) {
+			auto& player = allPlayers[id];
+			auto links = player->getLinkedPlayers();
+			if ((player->getAction() != Action::ACTION_C) || (links == nullptr) || links->empty()) {
+				continue;
+			}
+
+			auto engine = context.getStream(id, spd::param::RandomPurpose::REWIRE);
+			if (std::uniform_real_distribution<double>(0.0, 1.0)(engine) >= rewireRate) {
+				continue;
+			}
+
+			// Dの接続相手
+			int linkNum = links->size();
+			auto defector = links->at(std::uniform_int_distribution<int>(0, linkNum - 1)(engine)).lock();
+			auto defectorLinks = defector->getLinkedPlayers();
+			if ((defector->getAction() != Action::ACTION_D) || (defectorLinks == nullptr)) {
+				continue;
+			}
+
+			// 相手の接続先から、新しい接続先を選ぶ
+			int defectorLinkNum = defectorLinks->size();
+			int next = defectorLinks->at(
+					std::uniform_int_distribution<int>(0, defectorLinkNum - 1)(engine)).lock()->getId();
+			if (next == id) {
+				continue;
+			}
+			bool linked = false;
+			for (auto& link : *links) {
+				if (link.lock()->getId() == next) {
+					linked = true;
+					break;
+				}
+			}
+			if (linked) {
+				continue;
+			}
+
+			editor.removeLink(worker, id, defector->getId());
+			editor.addLink(worker, id, next);
+		}
+	});
+}
+
+} /* namespace rule */
+} /* namespace spd */
@@ -0,0 +1,70 @@
+/**
+ * RewireRule.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef REWIRERULE_HPP_
+#define REWIRERULE_HPP_
+
+#include "../GlobalRule.hpp"
+
+namespace spd {
+namespace rule {
+
+/**
+ * 接続の張り替え(戦略と空間構造の共進化)を表すクラス
+ *
+ * @par
+ * 戦略更新の後に、現在の行動がCの各プレイヤは張り替え率の確率で、一様に選んだ接続相手を調べる。<br>
+ * 相手の行動がDであれば、その相手との接続を切り、相手の接続先から一様に選んだプレイヤへ接続する
+ * (選んだプレイヤが自身かすでに接続している場合は張り替えない)。
+ * @par
+ * 抽選は並列に行い、編集は TopologyEditor のワーカごとのバッファに記録する。
+ * 編集はルールの区切りでまとめて反映し、影響を受けたプレイヤの近傍だけを作り直す。<br>
+ * 乱数はプレイヤとステップごとの乱数列を使うので、コア数によらず同じ結果となる。
+ * @note 接続を編集できる空間構造(ネットワーク)でのみ使える
+ */
+class RewireRule : public spd::rule::GlobalRule {
+public:
+
+	/**
+	 * プレイヤの初期化ルール
+	 * @param[in, out] player 対象プレイヤ
+	 * @param[in] allPlayers 全てのプレイヤ
+	 * @param[in] param パラメタ
+	 * @throw std::invalid_argument 張り替える設定で、接続を編集できない空間構造の場合
+	 */
+	void initialize(
+			const std::shared_ptr<Player>& player,
+			const AllPlayer& allPlayers,
+			const spd::param::Parameter& param);
+
+	/**
+	 * 戦略更新周期のステップで、接続の張り替えを記録する
+	 * @param[in] context 解決済みの情報
+	 * @param[in] workers 共有のワーカ
+	 */
+	void runGlobal(const RuleContext& context, const WorkerPool& workers);
+
+	/**
+	 * 共有する空間構造の編集を記録するので、書き換える
+	 * @return true
+	 */
+	bool editsSharedState() const {
+		return true;
+	};
+
+	/**
+	 * ルール情報の文字出力
+	 * @return "Rewire"
+	 */
+	std::string toString() const {
+		return "Rewire";
+	}
+};
+
+} /* namespace rule */
+} /* namespace spd */
+#endif /* REWIRERULE_HPP_ */
@@ -0,0 +1,223 @@
+/**
+ * BoxCounter.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "BoxCounter.hpp"
+
+#include <stdexcept>
+#include <string>
+
+namespace spd {
+namespace topology {
+
+/*
+ * コンストラクタ
+ * @param[in] side 辺の長さ
+ * @param[in] dimension 次元数
+ */
+BoxCounter::BoxCounter(int side, int dimension) : side(side), dimension(dimension) {
+
+	if (side < 1 || dimension < 1 || dimension > 3) {
+		throw std::invalid_argument("Could not count boxes on a lattice of side "
+				+ std::to_string(side) + " and dimension " + std::to_string(dimension) + ".");
+	}
+
+	std::size_t tableSize = 1;
+	for (int d = 0; d < dimension; ++d) {
+		tableSize *= side + 1;
+	}
+	table.assign(tableSize, 0);
+}
+
+/*
+ * 累積和テーブルを作成する
+ * @param[in] values 各プレイヤ位置座標の値
+ */
+void BoxCounter::build(const std::vector<int>& values) {
+
+	std::size_t playerNum = 1;
+	for (int d = 0; d < dimension; ++d) {
+		playerNum *= side;
+	}
+	if (values.size() != playerNum) {
+		throw std::invalid_argument("The number of values differs from the number of players.");
+	}
+
+	int width = side + 1;
+
+	// 値を (1, 1, ...) からの位置に配置する
+	// 0 の面は累積和の境界として 0 のまま
+	for (std::size_t i = 0; i < playerNum; ++i) {
+		std::size_t rest = i;
+		std::size_t index = 0;
+		std::size_t stride = 1;
+		for (int d = 0; d < dimension; ++d) {
+			index += (rest % side + 1) * stride;
+			rest /= side;
+			stride *= width;
+		}
+		table[index] = values[i];
+	}
+
+	// 次元ごとに累積和をとる
+	std::size_t stride = 1;
+	for (int d = 0; d < dimension; ++d) {
+		for (std::size_t i = 0, size = table.size(); i < size; ++i) {
+			if ((i / stride) % width != 0) {
+				table[i] += table[i - stride];
+			}
+		}
+		stride *= width;
+	}
+}
+
+/*
+ * 指定したプレイヤを中心とした箱の合計を求める
+ *
+ * 次元数ごとに特殊化した集計を呼ぶ
+ * @param[in] target 中心となるプレイヤ位置座標
+ * @param[in] radius 近傍半径
+ */
+long long BoxCounter::countBox(int target, int radius) const {
+
+	switch (dimension) {
+		case 1:
+			return countBoxIn<1>(target, radius);
+		case 2:
+			return countBoxIn<2>(target, radius);
+		default:
+			return countBoxIn<3>(target, radius);
+	}
+}
+
+/*
+ * 次元数を固定して、指定したプレイヤを中心とした箱の合計を求める
+ *
+ * 各次元の分割した区間の組み合わせごとに、直方体を数える
+ * @param[in] target 中心となるプレイヤ位置座標
+ * @param[in] radius 近傍半径
+ */
+template <int DIMENSION>
+inline long long BoxCounter::countBoxIn(int target, int radius) const {
+
+	// 次元ごとに分割した区間
+	Segment segments[DIMENSION][3];
+	int segmentNum[3] = {1, 1, 1};
+
+	int rest = target;
+	for (int d = 0; d < DIMENSION; ++d) {
+		int center = rest % side;
+		rest /= side;
+		segmentNum[d] = split(center - radius, 2 * radius + 1, segments[d]);
+	}
+
+	long long result = 0;
+	int from[DIMENSION];
+	int to[DIMENSION];
+	int index[3] = {0, 0, 0};
+
+	// 分割した区間の組み合わせごとに直方体を数える
+	while (true) {
+		long long weight = 1;
+		for (int d = 0; d < DIMENSION; ++d) {
+			const Segment& segment = segments[d][index[d]];
+			weight *= segment.weight;
+			from[d] = segment.from;
+			to[d] = segment.to;
+		}
+		result += weight * countRectIn<DIMENSION>(from, to);
+
+		// 次の組み合わせ
+		int d = 0;
+		while (d < DIMENSION && ++index[d] == segmentNum[d]) {
+			index[d] = 0;
+			++d;
+		}
+		if (d == DIMENSION) {
+			break;
+		}
+	}
+
+	return result;
+}
+
+/*
+ * 箱に含まれるプレイヤ数
+ * @param[in] radius 近傍半径
+ */
+long long BoxCounter::boxSize(int radius) const {
+
+	long long result = 1;
+	for (int d = 0; d < dimension; ++d) {
+		result *= 2 * radius + 1;
+	}
+	return result;
+}
+
+/*
+ * 回り込みのある区間を、回り込まない区間に分割する
+ * @param[in] start 区間の開始位置
+ * @param[in] length 区間の長さ
+ * @param[out] segments 分割した区間
+ */
+int BoxCounter::split(int start, int length, Segment* segments) const {
+
+	int num = 0;
+
+	// 一周以上する分は、全体を重複して数える
+	int round = length / side;
+	if (round > 0) {
+		segments[num++] = {0, side, round};
+	}
+
+	// 残りの区間
+	int remain = length % side;
+	if (remain > 0) {
+		int from = ((start % side) + side) % side;
+		if (from + remain <= side) {
+			segments[num++] = {from, from + remain, 1};
+		} else {
+			segments[num++] = {from, side, 1};
+			segments[num++] = {0, from + remain - side, 1};
+		}
+	}
+
+	return num;
+}
+
+/*
+ * 次元数を固定して、回り込まない直方体の合計を求める
+ * @param[in] from 各次元の開始位置(含む)
+ * @param[in] to 各次元の終了位置(含まない)
+ */
+template <int DIMENSION>
+inline long long BoxCounter::countRectIn(const int* from, const int* to) const {
+
+	long long result = 0;
+	int width = side + 1;
+
+	// 包除原理で頂点の累積和を足し引きする
+	for (int corner = 0; corner < (1 << DIMENSION); ++corner) {
+		std::size_t index = 0;
+		std::size_t stride = 1;
+		int sign = 1;
+		for (int d = 0; d < DIMENSION; ++d) {
+			if (corner & (1 << d)) {
+				index += from[d] * stride;
+				sign = -sign;
+			} else {
+				index += to[d] * stride;
+			}
+			stride *= width;
+		}
+		result += sign * table[index];
+	}
+
+	return result;
+}
+
+} /* namespace topology */
+} /* namespace spd */
@@ -0,0 +1,171 @@
+/**
+ * BoxCounter.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef BOXCOUNTER_HPP_
+#define BOXCOUNTER_HPP_
+
+#include <vector>
+
+namespace spd {
+namespace topology {
+
+/**
+ * トーラス上の立方格子における箱型近傍の集計を表すクラス
+ *
+ * @par
+ * 各プレイヤの値(行動がDなら1など)から累積和テーブル(Summed Area Table)を作成し、
+ * 近傍半径によらず、1プレイヤあたり定数時間で箱型近傍内の合計を求める。<br>
+ * 半径ごとの(リング状の)近傍の合計は、箱の差として求める。<br>
+ * 集計は次元数をコンパイル時定数として特殊化したものを使う。
+ * @note 辺の長さより箱が大きい場合は、Moore::getNeighbors と同様に、回り込んだ分も重複して数える
+ */
+class BoxCounter {
+public:
+
+	/**
+	 * コンストラクタ
+	 * @param[in] side 辺の長さ
+	 * @param[in] dimension 次元数(2: 平面, 3: 立方体)
+	 * @throw std::invalid_argument 辺の長さが1未満の場合や、次元数が1から3でない場合
+	 */
+	BoxCounter(int side, int dimension);
+
+	/**
+	 * 累積和テーブルを作成する
+	 * @note プレイヤ位置座標は x が最も速く変化する順(x + y * side + z * side * side)とする
+	 * @param[in] values 各プレイヤ位置座標の値
+	 * @throw std::invalid_argument 値の数がプレイヤ数と異なる場合
+	 */
+	void build(const std::vector<int>& values);
+
+	/**
+	 * 指定したプレイヤを中心とした、一辺 2 * radius + 1 の箱の合計を求める
+	 * @param[in] target 中心となるプレイヤ位置座標
+	 * @param[in] radius 近傍半径
+	 * @return 箱の合計
+	 */
+	long long countBox(int target, int radius) const;
+
+	/**
+	 * 指定したプレイヤからちょうど近傍半径の距離にある、リング状の近傍の合計を求める
+	 * @param[in] target 中心となるプレイヤ位置座標
+	 * @param[in] radius 近傍半径
+	 * @return リングの合計
+	 * @retval 近傍半径が0の場合は、自身の値
+	 */
+	long long countRing(int target, int radius) const {
+		if (radius == 0) {
+			return countBox(target, 0);
+		}
+		return countBox(target, radius) - countBox(target, radius - 1);
+	};
+
+	/**
+	 * 一辺 2 * radius + 1 の箱に含まれるプレイヤ数(重複を含む)
+	 * @param[in] radius 近傍半径
+	 * @return 箱のプレイヤ数
+	 */
+	long long boxSize(int radius) const;
+
+	/**
+	 * 近傍半径のリングに含まれるプレイヤ数(重複を含む)
+	 * @param[in] radius 近傍半径
+	 * @return リングのプレイヤ数
+	 */
+	long long ringSize(int radius) const {
+		if (radius == 0) {
+			return 1;
+		}
+		return boxSize(radius) - boxSize(radius - 1);
+	};
+
+	/**
+	 * 集計結果が、プレイヤに設定された近傍と一致する近傍半径かどうか
+	 * @note 半径1の近傍は接続近傍(重複なし)のコピーなので、辺の長さが3未満では一致しない
+	 * @param[in] radius 近傍半径
+	 * @return 集計が使用可能かどうか
+	 */
+	bool isApplicable(int radius) const {
+		return (radius >= 0) && (radius != 1 || side >= 3);
+	};
+
+	/**
+	 * 辺の長さを取得
+	 * @return 辺の長さ
+	 */
+	int getSide() const {
+		return side;
+	};
+
+	/**
+	 * 次元数を取得
+	 * @return 次元数
+	 */
+	int getDimension() const {
+		return dimension;
+	};
+
+private:
+
+	/**
+	 * 回り込みを考慮した区間の一部
+	 */
+	struct Segment {
+		/** 開始位置(含む) */
+		int from;
+		/** 終了位置(含まない) */
+		int to;
+		/** 重複数 */
+		int weight;
+	};
+
+	/**
+	 * 回り込みのある区間を、回り込まない区間に分割する
+	 * @param[in] start 区間の開始位置
+	 * @param[in] length 区間の長さ
+	 * @param[out] segments 分割した区間(最大3つ)
+	 * @return 分割した区間の数
+	 */
+	int split(int start, int length, Segment* segments) const;
+
+	/**
+	 * 次元数を固定して、指定したプレイヤを中心とした箱の合計を求める
+	 * @param[in] target 中心となるプレイヤ位置座標
+	 * @param[in] radius 近傍半径
+	 * @return 箱の合計
+	 */
+	template <int DIMENSION>
+	long long countBoxIn(int target, int radius) const;
+
+	/**
+	 * 次元数を固定して、回り込まない直方体の合計を求める
+	 * @param[in] from 各次元の開始位置(含む)
+	 * @param[in] to 各次元の終了位置(含まない)
+	 * @return 直方体の合計
+	 */
+	template <int DIMENSION>
+	long long countRectIn(const int* from, const int* to) const;
+
+	/**
+	 * 辺の長さ
+	 */
+	int side;
+
+	/**
+	 * 次元数
+	 */
+	int dimension;
+
+	/**
+	 * 累積和テーブル(各次元 side + 1)
+	 */
+	std::vector<long long> table;
+};
+
+} /* namespace topology */
+} /* namespace spd */
+#endif /* BOXCOUNTER_HPP_ */
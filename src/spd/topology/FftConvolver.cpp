@@ -0,0 +1,225 @@
+/**
+ * FftConvolver.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "FftConvolver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace spd {
+namespace topology {
+
+namespace {
+
+/** 円周率 */
+const double PI = std::acos(-1.0);
+
+}
+
+/*
+ * コンストラクタ
+ * @param[in] side 辺の長さ
+ * @param[in] dimension 次元数
+ */
+FftConvolver::FftConvolver(int side, int dimension) : side(side), dimension(dimension),
+		playerNum(1), paddedLength(0) {
+
+	if (side < 1 || dimension < 1 || dimension > 3) {
+		throw std::invalid_argument("Could not convolve on a lattice of side "
+				+ std::to_string(side) + " and dimension " + std::to_string(dimension) + ".");
+	}
+
+	for (int d = 0; d < dimension; ++d) {
+		playerNum *= side;
+	}
+
+	// 2のべき乗なら、そのまま高速フーリエ変換できる
+	std::size_t n = side;
+	if ((n & (n - 1)) == 0) {
+		return;
+	}
+
+	// Bluestein の変換の準備
+	// 2 * side - 1 以上の2のべき乗で巡回畳み込みを行う
+	paddedLength = 1;
+	while (paddedLength < 2 * n - 1) {
+		paddedLength <<= 1;
+	}
+
+	chirp.resize(n);
+	for (std::size_t k = 0; k < n; ++k) {
+		// k^2 は 2 * side を法として計算し、桁落ちを防ぐ
+		std::size_t k2 = (k * k) % (2 * n);
+		chirp[k] = std::polar(1.0, -PI * k2 / n);
+	}
+
+	chirpSpectrum.assign(paddedLength, 0);
+	chirpSpectrum[0] = std::conj(chirp[0]);
+	for (std::size_t k = 1; k < n; ++k) {
+		chirpSpectrum[k] = std::conj(chirp[k]);
+		chirpSpectrum[paddedLength - k] = std::conj(chirp[k]);
+	}
+	radix2(chirpSpectrum, false);
+}
+
+/*
+ * 畳み込むカーネルを設定する
+ * @param[in] kernel 各相対位置の重み
+ */
+void FftConvolver::setKernel(const std::vector<double>& kernel) {
+
+	if (kernel.size() != playerNum) {
+		throw std::invalid_argument("The size of the kernel differs from the number of players.");
+	}
+
+	kernelSpectrum.assign(kernel.begin(), kernel.end());
+	transform(kernelSpectrum, false);
+}
+
+/*
+ * 設定したカーネルで畳み込む
+ * @param[in] values 各プレイヤ位置座標の値
+ * @param[out] result 各プレイヤ位置座標の重み付き合計
+ */
+void FftConvolver::convolve(const std::vector<int>& values, std::vector<double>& result) const {
+
+	if (values.size() != playerNum) {
+		throw std::invalid_argument("The number of values differs from the number of players.");
+	}
+
+	std::vector<std::complex<double>> data(values.begin(), values.end());
+	transform(data, false);
+
+	// 周波数領域での積
+	for (std::size_t i = 0; i < playerNum; ++i) {
+		data[i] *= kernelSpectrum[i];
+	}
+
+	transform(data, true);
+
+	result.resize(playerNum);
+	for (std::size_t i = 0; i < playerNum; ++i) {
+		result[i] = data[i].real() / playerNum;
+	}
+}
+
+/*
+ * 全次元に対して離散フーリエ変換を行う
+ * @param[in, out] data 変換するデータ
+ * @param[in] inverse 逆変換かどうか
+ */
+void FftConvolver::transform(std::vector<std::complex<double>>& data, bool inverse) const {
+
+	std::vector<std::complex<double>> line(side);
+	std::vector<std::complex<double>> work(paddedLength);
+
+	std::size_t stride = 1;
+	for (int d = 0; d < dimension; ++d) {
+
+		// この次元の座標が0である位置から、一列ずつ変換する
+		for (std::size_t base = 0; base < playerNum; ++base) {
+			if ((base / stride) % side != 0) {
+				continue;
+			}
+
+			for (int k = 0; k < side; ++k) {
+				line[k] = data[base + k * stride];
+			}
+			transformLine(line, inverse, work);
+			for (int k = 0; k < side; ++k) {
+				data[base + k * stride] = line[k];
+			}
+		}
+		stride *= side;
+	}
+}
+
+/*
+ * 長さ side の一次元離散フーリエ変換を行う
+ * @param[in, out] line 変換する列
+ * @param[in] inverse 逆変換かどうか
+ * @param[in, out] work 作業領域
+ */
+void FftConvolver::transformLine(std::vector<std::complex<double>>& line, bool inverse,
+		std::vector<std::complex<double>>& work) const {
+
+	if (paddedLength == 0) {
+		radix2(line, inverse);
+		return;
+	}
+
+	// 逆変換は共役をとって順変換する
+	if (inverse) {
+		for (auto& value : line) {
+			value = std::conj(value);
+		}
+	}
+
+	// Bluestein: X_k = c_k * Σ_j (x_j c_j) conj(c_{k-j})
+	std::fill(work.begin(), work.end(), 0);
+	for (int k = 0; k < side; ++k) {
+		work[k] = line[k] * chirp[k];
+	}
+	radix2(work, false);
+	for (std::size_t k = 0; k < paddedLength; ++k) {
+		work[k] *= chirpSpectrum[k];
+	}
+	radix2(work, true);
+	for (int k = 0; k < side; ++k) {
+		line[k] = work[k] * chirp[k] / static_cast<double>(paddedLength);
+	}
+
+	if (inverse) {
+		for (auto& value : line) {
+			value = std::conj(value);
+		}
+	}
+}
+
+/*
+ * 2のべき乗長の高速フーリエ変換を行う
+ * @param[in, out] data 変換するデータ
+ * @param[in] inverse 逆変換かどうか(正規化はしない)
+ */
+void FftConvolver::radix2(std::vector<std::complex<double>>& data, bool inverse) {
+
+	std::size_t n = data.size();
+
+	// ビット反転の並べ替え
+	for (std::size_t i = 1, j = 0; i < n; ++i) {
+		std::size_t bit = n >> 1;
+		for (; j & bit; bit >>= 1) {
+			j ^= bit;
+		}
+		j ^= bit;
+		if (i < j) {
+			std::swap(data[i], data[j]);
+		}
+	}
+
+	// バタフライ演算
+	for (std::size_t length = 2; length <= n; length <<= 1) {
+		double angle = 2 * PI / length * (inverse ? 1 : -1);
+		std::complex<double> unit = std::polar(1.0, angle);
+		for (std::size_t i = 0; i < n; i += length) {
+			std::complex<double> w(1.0);
+			for (std::size_t k = 0; k < length / 2; ++k) {
+				std::complex<double> u = data[i + k];
+				std::complex<double> v = data[i + k + length / 2] * w;
+				data[i + k] = u + v;
+				data[i + k + length / 2] = u - v;
+				w *= unit;
+			}
+		}
+	}
+}
+
+} /* namespace topology */
+} /* namespace spd */
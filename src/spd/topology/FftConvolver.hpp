@@ -0,0 +1,124 @@
+/**
+ * FftConvolver.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef FFTCONVOLVER_HPP_
+#define FFTCONVOLVER_HPP_
+
+#include <complex>
+#include <vector>
+
+namespace spd {
+namespace topology {
+
+/**
+ * トーラス上の立方格子における巡回畳み込みを、高速フーリエ変換で行うクラス
+ *
+ * @par
+ * 近傍半径ごとの重み(割引率)を並べたカーネルと、プレイヤの値(行動がDなら1など)を畳み込み、
+ * 全プレイヤの重み付き合計を O(N log N) で求める。<br>
+ * 辺の長さが2のべき乗でない場合は、Bluestein のアルゴリズムで任意長の離散フーリエ変換を行う。
+ * @note プレイヤ位置座標は x が最も速く変化する順(x + y * side + z * side * side)とする
+ */
+class FftConvolver {
+public:
+
+	/**
+	 * コンストラクタ
+	 * @param[in] side 辺の長さ
+	 * @param[in] dimension 次元数(2: 平面, 3: 立方体)
+	 * @throw std::invalid_argument 辺の長さが1未満の場合や、次元数が1から3でない場合
+	 */
+	FftConvolver(int side, int dimension);
+
+	/**
+	 * 畳み込むカーネルを設定する
+	 * @note カーネルは原点をプレイヤ位置座標 0 とし、負の相対位置は回り込ませて配置する
+	 * @param[in] kernel 各相対位置の重み
+	 * @throw std::invalid_argument 重みの数がプレイヤ数と異なる場合
+	 */
+	void setKernel(const std::vector<double>& kernel);
+
+	/**
+	 * 設定したカーネルで畳み込む
+	 * @param[in] values 各プレイヤ位置座標の値
+	 * @param[out] result 各プレイヤ位置座標の重み付き合計
+	 * @throw std::invalid_argument 値の数がプレイヤ数と異なる場合
+	 */
+	void convolve(const std::vector<int>& values, std::vector<double>& result) const;
+
+	/**
+	 * プレイヤ数
+	 * @return 辺の長さの次元数乗
+	 */
+	std::size_t size() const {
+		return playerNum;
+	}
+
+private:
+
+	/**
+	 * 全次元に対して離散フーリエ変換を行う
+	 * @param[in, out] data 変換するデータ
+	 * @param[in] inverse 逆変換かどうか
+	 */
+	void transform(std::vector<std::complex<double>>& data, bool inverse) const;
+
+	/**
+	 * 長さ side の一次元離散フーリエ変換を行う
+	 * @param[in, out] line 変換する列
+	 * @param[in] inverse 逆変換かどうか
+	 * @param[in, out] work 作業領域
+	 */
+	void transformLine(std::vector<std::complex<double>>& line, bool inverse,
+			std::vector<std::complex<double>>& work) const;
+
+	/**
+	 * 2のべき乗長の高速フーリエ変換を行う
+	 * @param[in, out] data 変換するデータ
+	 * @param[in] inverse 逆変換かどうか(正規化はしない)
+	 */
+	static void radix2(std::vector<std::complex<double>>& data, bool inverse);
+
+	/**
+	 * 辺の長さ
+	 */
+	int side;
+
+	/**
+	 * 次元数
+	 */
+	int dimension;
+
+	/**
+	 * プレイヤ数
+	 */
+	std::size_t playerNum;
+
+	/**
+	 * Bluestein の変換で使う2のべき乗長(辺の長さが2のべき乗なら0)
+	 */
+	std::size_t paddedLength;
+
+	/**
+	 * Bluestein の変換で使うチャープ exp(-πi k^2 / side)
+	 */
+	std::vector<std::complex<double>> chirp;
+
+	/**
+	 * チャープの共役を並べて変換したもの
+	 */
+	std::vector<std::complex<double>> chirpSpectrum;
+
+	/**
+	 * 変換済みのカーネル
+	 */
+	std::vector<std::complex<double>> kernelSpectrum;
+};
+
+} /* namespace topology */
+} /* namespace spd */
+#endif /* FFTCONVOLVER_HPP_ */
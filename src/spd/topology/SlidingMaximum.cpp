@@ -0,0 +1,126 @@
+/**
+ * SlidingMaximum.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "SlidingMaximum.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace spd {
+namespace topology {
+
+/*
+ * コンストラクタ
+ * @param[in] side 辺の長さ
+ * @param[in] dimension 次元数
+ */
+SlidingMaximum::SlidingMaximum(int side, int dimension) : side(side), dimension(dimension) {
+
+	if (side < 1 || dimension < 1 || dimension > 3) {
+		throw std::invalid_argument("Could not find box maximums on a lattice of side "
+				+ std::to_string(side) + " and dimension " + std::to_string(dimension) + ".");
+	}
+}
+
+/*
+ * 各プレイヤを中心とした箱の最大値を求める
+ * @param[in] values 各プレイヤ位置座標の値
+ * @param[in] radius 近傍半径
+ * @param[out] result 各プレイヤ位置座標の箱の最大値
+ */
+void SlidingMaximum::compute(
+		const std::vector<double>& values,
+		int radius,
+		std::vector<double>& result) const {
+
+	std::size_t playerNum = 1;
+	for (int d = 0; d < dimension; ++d) {
+		playerNum *= side;
+	}
+	if (values.size() != playerNum) {
+		throw std::invalid_argument("The number of values differs from the number of players.");
+	}
+
+	result = values;
+
+	std::vector<double> line(side);
+	std::vector<double> forward;
+	std::vector<double> backward;
+
+	// 次元ごとに窓の最大値をとる
+	std::size_t stride = 1;
+	for (int d = 0; d < dimension; ++d) {
+		for (std::size_t start = 0; start < playerNum; ++start) {
+			// 各列の先頭(この次元の座標が0)のみ
+			if ((start / stride) % side != 0) {
+				continue;
+			}
+			for (int i = 0; i < side; ++i) {
+				line[i] = result[start + i * stride];
+			}
+			slideLine(line, radius, forward, backward);
+			for (int i = 0; i < side; ++i) {
+				result[start + i * stride] = line[i];
+			}
+		}
+		stride *= side;
+	}
+}
+
+/*
+ * 一次元の窓の最大値を求める
+ * @param[in, out] line 値の列
+ * @param[in] radius 近傍半径
+ * @param[in, out] forward 作業領域
+ * @param[in, out] backward 作業領域
+ */
+void SlidingMaximum::slideLine(std::vector<double>& line, int radius,
+		std::vector<double>& forward, std::vector<double>& backward) const {
+
+	int width = 2 * radius + 1;
+
+	// 窓が一周以上する場合は、列全体の最大値
+	if (width >= side) {
+		double maxValue = *std::max_element(line.begin(), line.end());
+		std::fill(line.begin(), line.end(), maxValue);
+		return;
+	}
+
+	// 回り込みを展開した列 (位置 -radius から side + radius - 1)
+	int length = side + 2 * radius;
+	forward.resize(length);
+	backward.resize(length);
+
+	// ブロック内の前方からの累積最大値
+	for (int j = 0; j < length; ++j) {
+		double value = line[(j - radius + side) % side];
+		if (j % width == 0) {
+			forward[j] = value;
+		} else {
+			forward[j] = std::max(forward[j - 1], value);
+		}
+	}
+
+	// ブロック内の後方からの累積最大値
+	for (int j = length - 1; j >= 0; --j) {
+		double value = line[(j - radius + side) % side];
+		if (j == length - 1 || (j + 1) % width == 0) {
+			backward[j] = value;
+		} else {
+			backward[j] = std::max(backward[j + 1], value);
+		}
+	}
+
+	// 窓 [i, i + width) は高々2ブロックにまたがる
+	for (int i = 0; i < side; ++i) {
+		line[i] = std::max(backward[i], forward[i + width - 1]);
+	}
+}
+
+} /* namespace topology */
+} /* namespace spd */
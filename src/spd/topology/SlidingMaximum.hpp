@@ -0,0 +1,81 @@
+/**
+ * SlidingMaximum.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef SLIDINGMAXIMUM_HPP_
+#define SLIDINGMAXIMUM_HPP_
+
+#include <vector>
+
+namespace spd {
+namespace topology {
+
+/**
+ * トーラス上の立方格子における箱型近傍の最大値を表すクラス
+ *
+ * @par
+ * 箱の最大値は次元ごとに分解できるため、各次元について
+ * 幅 2 * radius + 1 の窓の最大値を van Herk / Gil-Werman の方法で求める。<br>
+ * 窓を幅ごとのブロックに分け、ブロック内の前方・後方からの累積最大値を持つことで、
+ * 近傍半径によらず1プレイヤ・1次元あたり定数回の比較で最大値が求まる。
+ * @note プレイヤ位置座標は x が最も速く変化する順(x + y * side + z * side * side)とする
+ */
+class SlidingMaximum {
+public:
+
+	/**
+	 * コンストラクタ
+	 * @param[in] side 辺の長さ
+	 * @param[in] dimension 次元数(2: 平面, 3: 立方体)
+	 * @throw std::invalid_argument 辺の長さが1未満の場合や、次元数が1から3でない場合
+	 */
+	SlidingMaximum(int side, int dimension);
+
+	/**
+	 * 各プレイヤを中心とした、一辺 2 * radius + 1 の箱の最大値を求める
+	 * @param[in] values 各プレイヤ位置座標の値
+	 * @param[in] radius 近傍半径
+	 * @param[out] result 各プレイヤ位置座標の箱の最大値
+	 * @throw std::invalid_argument 値の数がプレイヤ数と異なる場合
+	 */
+	void compute(const std::vector<double>& values, int radius, std::vector<double>& result) const;
+
+	/**
+	 * 最大値が、プレイヤに設定された近傍の最大値と一致する近傍半径かどうか
+	 * @note 半径1の近傍は接続近傍(重複なし)のコピーなので、辺の長さが3未満では一致しない
+	 * @param[in] radius 近傍半径
+	 * @return 最大値が使用可能かどうか
+	 */
+	bool isApplicable(int radius) const {
+		return (radius >= 0) && (radius != 1 || side >= 3);
+	};
+
+private:
+
+	/**
+	 * 一次元の窓の最大値を求める
+	 * @param[in, out] line 値の列(長さ side)、窓の最大値で上書きする
+	 * @param[in] radius 近傍半径
+	 * @param[in, out] forward 作業領域
+	 * @param[in, out] backward 作業領域
+	 */
+	void slideLine(std::vector<double>& line, int radius,
+			std::vector<double>& forward, std::vector<double>& backward) const;
+
+	/**
+	 * 辺の長さ
+	 */
+	int side;
+
+	/**
+	 * 次元数
+	 */
+	int dimension;
+};
+
+} /* namespace topology */
+} /* namespace spd */
+#endif /* SLIDINGMAXIMUM_HPP_ */
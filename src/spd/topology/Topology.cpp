@@ -5,9 +5,11 @@
  * @author katsumata
  */
 
+#include <algorithm>
 #include <iostream>
 #include <stdexcept>
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include "Topology.hpp"
@@ -127,5 +129,117 @@ void Topology::copyConnectors(NeighborhoodType destType, const spd::core::AllPla
 	}
 }
 
+/*
+ * 記録した編集を反映し、影響を受けたプレイヤの近傍だけを作り直す
+ *
+ * 編集前と編集後の接続で、接続が変わるプレイヤからの距離をそれぞれ求め、近い方を使う。
+ * @param[in] players すべてのプレイヤ
+ * @param[in] param パラメタ
+ */
+std::vector<int> Topology::applyEdits(
+		const spd::core::AllPlayer& players,
+		const spd::param::Parameter& param) {
+
+	auto& neiParam = param.getNeighborhoodParameter();
+
+	// 編集の影響が及ぶ最大の近傍半径
+	int maxRadius = 0;
+	for (int type = 0; type < NeighborhoodType::TYPE_NUM; ++type) {
+		maxRadius = std::max(maxRadius,
+				neiParam->getNeiborhoodRadius(static_cast<NeighborhoodType>(type)));
+	}
+
+	auto touched = editor.findTouched(players);
+	auto distances = findWithin(players, touched, maxRadius - 1);
+	editor.apply(players);
+	for (auto& entry : findWithin(players, touched, maxRadius - 1)) {
+		auto found = distances.find(entry.first);
+		if ((found == distances.end()) || (found->second > entry.second)) {
+			distances[entry.first] = entry.second;
+		}
+	}
+
+	std::vector<int> repaired;
+	for (auto& entry : distances) {
+		auto& player = players[entry.first];
+
+		// 近傍半径ごとに作り直した近傍
+		std::vector<std::pair<int, spd::core::Neighbors>> rebuilt;
+		bool changed = false;
+		for (int type = 0; type < NeighborhoodType::TYPE_NUM; ++type) {
+			auto neighborType = static_cast<NeighborhoodType>(type);
+			int radius = neiParam->getNeiborhoodRadius(neighborType);
+			auto& neighbors = player->getNeighbors(neighborType);
+			if ((radius < 1) || (entry.second > radius - 1) || (neighbors == nullptr)) {
+				continue;
+			}
+			changed = true;
+
+			// 接続近傍を共有している場合は、接続の編集がそのまま反映されている
+			if ((radius == 1) && (neighbors->size() > 1) &&
+					(neighbors->at(1) == player->getLinkedPlayers())) {
+				continue;
+			}
+
+			auto found = std::find_if(rebuilt.begin(), rebuilt.end(),
+					[radius](const std::pair<int, spd::core::Neighbors>& r) {
+				return r.first == radius;
+			});
+			if (found == rebuilt.end()) {
+				rebuilt.push_back(std::make_pair(radius, getNeighbors(players, entry.first, radius)));
+				found = rebuilt.end() - 1;
+			}
+			neighbors = found->second;
+		}
+
+		if (changed) {
+			repaired.push_back(entry.first);
+		}
+	}
+
+	std::sort(repaired.begin(), repaired.end());
+	return repaired;
+}
+
+/*
+ * 指定したプレイヤから、接続をたどって指定した距離以内のプレイヤを求める
+ *
+ * 起点すべてから同時に幅優先で探索する。
+ * @param[in] players すべてのプレイヤ
+ * @param[in] sources 起点のプレイヤ位置座標
+ * @param[in] depth 距離
+ */
+std::unordered_map<int, int> Topology::findWithin(
+		const spd::core::AllPlayer& players,
+		const std::vector<int>& sources,
+		int depth) {
+
+	std::unordered_map<int, int> distances;
+	std::vector<int> frontier;
+	for (int source : sources) {
+		if (distances.insert(std::make_pair(source, 0)).second) {
+			frontier.push_back(source);
+		}
+	}
+
+	for (int d = 1; (d <= depth) && !frontier.empty(); ++d) {
+		std::vector<int> next;
+		for (int id : frontier) {
+			auto links = players[id]->getLinkedPlayers();
+			if (links == nullptr) {
+				continue;
+			}
+			for (auto& link : *links) {
+				int linkId = link.lock()->getId();
+				if (distances.insert(std::make_pair(linkId, d)).second) {
+					next.push_back(linkId);
+				}
+			}
+		}
+		frontier.swap(next);
+	}
+	return distances;
+}
+
 } /* namespace topology */
 } /* namespace spd */
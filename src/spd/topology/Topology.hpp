@@ -8,9 +8,14 @@
 #ifndef TOPOLOGY_H_
 #define TOPOLOGY_H_
 
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
 #include "../IToString.hpp"
 #include "../core/OriginalType.hpp"
 #include "../core/NeighborhoodType.hpp"
+#include "TopologyEditor.hpp"
 
 namespace spd {
 namespace core {
@@ -25,6 +30,9 @@ class OutputVisitor;
 }
 namespace topology {
 
+class BoxCounter;
+class SlidingMaximum;
+
 /**
  * 空間構造を表すクラス
  */
@@ -113,8 +121,103 @@ public:
 	 */
 	virtual void setProp(std::vector<std::string>  properties) = 0;
 
+	/**
+	 * 箱型近傍を定数時間で集計するクラスを作成する
+	 * @note 近傍が箱型でない構造では集計できないため、nullptr を返す
+	 * @param[in] playerNum 全プレイヤ数
+	 * @return 箱型近傍の集計クラス
+	 * @retval nullptr 集計できない構造の場合
+	 */
+	virtual std::shared_ptr<BoxCounter> createBoxCounter(int playerNum) const {
+		return nullptr;
+	};
+
+	/**
+	 * 箱型近傍の最大値を求めるクラスを作成する
+	 * @note 近傍が箱型でない構造では求められないため、nullptr を返す
+	 * @param[in] playerNum 全プレイヤ数
+	 * @return 箱型近傍の最大値クラス
+	 * @retval nullptr 求められない構造の場合
+	 */
+	virtual std::shared_ptr<SlidingMaximum> createSlidingMaximum(int playerNum) const {
+		return nullptr;
+	};
+
+	/**
+	 * 2プレイヤ間の近傍半径(何番目の近傍か)を、近傍を作成せずに求める
+	 * @note 座標から求められない構造では -1 を返すので、getNeighbors を用いる
+	 * @param[in] from 一方のプレイヤ位置座標
+	 * @param[in] to もう一方のプレイヤ位置座標
+	 * @return 近傍半径
+	 * @retval -1 座標から求められない構造の場合
+	 */
+	virtual int getDistance(int from, int to) const {
+		return -1;
+	};
+
+	/**
+	 * 近傍半径以内のプレイヤが同じ色にならないよう、座標から色を塗る
+	 * @note 座標から塗れない構造では空を返すので、近傍から貪欲に塗る
+	 * @param[in] radius 近傍半径
+	 * @return プレイヤ位置座標ごとの色
+	 * @retval 空 座標から塗れない構造の場合
+	 */
+	virtual std::vector<int> colorPlayers(int radius) const {
+		return std::vector<int>();
+	};
+
+	/**
+	 * 実行中に接続を編集できる構造かどうか
+	 * @note 座標から近傍を求める構造(格子など)は編集できないので false を返す
+	 * @return 編集できるかどうか
+	 */
+	virtual bool isEditable() const {
+		return false;
+	};
+
+	/**
+	 * 空間構造の編集を記録するクラスを取得する
+	 * @return 編集の記録
+	 */
+	TopologyEditor& getEditor() {
+		return editor;
+	};
+
+	/**
+	 * 記録した編集を反映し、影響を受けたプレイヤの近傍だけを作り直す
+	 *
+	 * @par
+	 * 近傍半径 r の近傍は、接続が変わったプレイヤから r - 1 以内
+	 * (編集前と編集後の接続のいずれか)のプレイヤだけが変わるので、そのプレイヤだけを探索し直す。<br>
+	 * 同じ近傍半径の近傍タイプは、作り直した近傍を共有する。
+	 * @note 近傍を保持していないプレイヤは、実行時に探索するので作り直さない
+	 * @param[in] players すべてのプレイヤ
+	 * @param[in] param パラメタ
+	 * @return 近傍が変わり得るプレイヤ位置座標(昇順、接続近傍を共有していて作り直さなかったプレイヤも含む)
+	 */
+	std::vector<int> applyEdits(
+			const spd::core::AllPlayer& players,
+			const spd::param::Parameter& param);
+
 private:
 
+	/**
+	 * 空間構造の編集の記録
+	 */
+	TopologyEditor editor;
+
+	/**
+	 * 指定したプレイヤから、接続をたどって指定した距離以内のプレイヤを求める
+	 * @param[in] players すべてのプレイヤ
+	 * @param[in] sources 起点のプレイヤ位置座標
+	 * @param[in] depth 距離
+	 * @return プレイヤ位置座標ごとの、起点からの距離
+	 */
+	static std::unordered_map<int, int> findWithin(
+			const spd::core::AllPlayer& players,
+			const std::vector<int>& sources,
+			int depth);
+
 	/**
 	 * プレイヤの近傍をコピーする
 	 * @param[in] sourceType コピー元近傍タイプ
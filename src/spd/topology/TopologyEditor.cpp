@@ -0,0 +1,125 @@
+/**
+ * TopologyEditor.cpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#include "TopologyEditor.hpp"
+
+#include <algorithm>
+
+#include "../core/Player.hpp"
+
+namespace spd {
+namespace topology {
+
+/*
+ * ワーカ数分のバッファを用意する
+ * @param[in] workerNum ワーカ数
+ */
+void TopologyEditor::reserve(int workerNum) {
+
+	if (static_cast<int>(buffers.size()) < workerNum) {
+		buffers.resize(workerNum);
+	}
+}
+
+/*
+ * 反映していない編集があるかどうか
+ */
+bool TopologyEditor::hasEdits() const {
+
+	for (auto& buffer : buffers) {
+		if (!buffer.empty()) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * 編集で接続が変わるプレイヤを求める
+ * @param[in] players すべてのプレイヤ
+ */
+std::vector<int> TopologyEditor::findTouched(const spd::core::AllPlayer& players) const {
+
+	std::vector<int> touched;
+	for (auto& buffer : buffers) {
+		for (auto& edit : buffer) {
+			touched.push_back(edit.from);
+			touched.push_back(edit.to);
+
+			// 切り離すプレイヤの接続先
+			auto links = players[edit.from]->getLinkedPlayers();
+			if ((edit.type == EditType::ISOLATE) && (links != nullptr)) {
+				for (auto& link : *links) {
+					touched.push_back(link.lock()->getId());
+				}
+			}
+		}
+	}
+
+	std::sort(touched.begin(), touched.end());
+	touched.erase(std::unique(touched.begin(), touched.end()), touched.end());
+	return touched;
+}
+
+/*
+ * 記録した編集を、ワーカ順にプレイヤの接続へ反映し、バッファを空にする
+ *
+ * すでにある接続の追加や、無い接続の削除は何もしない。
+ * @param[in] players すべてのプレイヤ
+ */
+void TopologyEditor::apply(const spd::core::AllPlayer& players) {
+
+	for (auto& buffer : buffers) {
+		for (auto& edit : buffer) {
+			auto& from = players[edit.from];
+			auto& to = players[edit.to];
+
+			switch (edit.type) {
+				case EditType::ADD_LINK:
+					from->linkTo(to);
+					to->linkTo(from);
+					break;
+
+				case EditType::REMOVE_LINK:
+					if (from->getLinkedPlayers() != nullptr) {
+						from->deleteLinkTo(to);
+					}
+					if (to->getLinkedPlayers() != nullptr) {
+						to->deleteLinkTo(from);
+					}
+					break;
+
+				case EditType::ISOLATE:
+					if (from->getLinkedPlayers() != nullptr) {
+						// 相手側の接続を消してから、自身の接続を空にする
+						for (auto& link : *(from->getLinkedPlayers())) {
+							auto opponent = link.lock();
+							if (opponent->getLinkedPlayers() != nullptr) {
+								opponent->deleteLinkTo(from);
+							}
+						}
+						from->clearLink();
+					}
+					break;
+			}
+		}
+		buffer.clear();
+	}
+}
+
+/*
+ * 記録した編集を破棄する
+ */
+void TopologyEditor::clear() {
+
+	for (auto& buffer : buffers) {
+		buffer.clear();
+	}
+}
+
+} /* namespace topology */
+} /* namespace spd */
@@ -0,0 +1,123 @@
+/**
+ * TopologyEditor.hpp
+ *
+ * @date 2026/10/19
+ * @author katsumata
+ */
+
+#ifndef TOPOLOGYEDITOR_HPP_
+#define TOPOLOGYEDITOR_HPP_
+
+#include <vector>
+
+#include "../core/OriginalType.hpp"
+
+namespace spd {
+namespace topology {
+
+/**
+ * 実行中の空間構造の編集(接続の追加と削除、プレイヤの切り離し)を記録するクラス
+ *
+ * @par
+ * 編集はワーカごとのバッファに記録するので、ルールは並列に記録できる。<br>
+ * 記録した編集は、ルールの区切りで Topology::applyEdits がワーカ順にまとめて反映する。
+ * ワーカはプレイヤ位置座標の小さい順に範囲を担当するので、反映順はコア数によらず同じになる。
+ * @par
+ * 接続は双方向に追加・削除する。
+ * プレイヤ数は変えられないので、プレイヤの削除はすべての接続の切り離しで、
+ * 追加は切り離したプレイヤへの接続の追加で表す。
+ */
+class TopologyEditor {
+public:
+
+	/**
+	 * ワーカ数分のバッファを用意する
+	 * @note 記録済みの編集は残す
+	 * @param[in] workerNum ワーカ数
+	 */
+	void reserve(int workerNum);
+
+	/**
+	 * 2プレイヤ間の接続の追加を記録する
+	 * @param[in] worker 記録するワーカ
+	 * @param[in] from 一方のプレイヤ位置座標
+	 * @param[in] to もう一方のプレイヤ位置座標
+	 */
+	void addLink(int worker, int from, int to) {
+		buffers[worker].push_back(Edit{EditType::ADD_LINK, from, to});
+	};
+
+	/**
+	 * 2プレイヤ間の接続の削除を記録する
+	 * @param[in] worker 記録するワーカ
+	 * @param[in] from 一方のプレイヤ位置座標
+	 * @param[in] to もう一方のプレイヤ位置座標
+	 */
+	void removeLink(int worker, int from, int to) {
+		buffers[worker].push_back(Edit{EditType::REMOVE_LINK, from, to});
+	};
+
+	/**
+	 * プレイヤのすべての接続の切り離しを記録する
+	 * @param[in] worker 記録するワーカ
+	 * @param[in] id プレイヤ位置座標
+	 */
+	void isolate(int worker, int id) {
+		buffers[worker].push_back(Edit{EditType::ISOLATE, id, id});
+	};
+
+	/**
+	 * 反映していない編集があるかどうか
+	 * @return 編集があるかどうか
+	 */
+	bool hasEdits() const;
+
+	/**
+	 * 編集で接続が変わるプレイヤを求める
+	 * @note 反映前に呼ぶ(切り離すプレイヤは、その時点の接続先も含む)
+	 * @param[in] players すべてのプレイヤ
+	 * @return 重複のないプレイヤ位置座標
+	 */
+	std::vector<int> findTouched(const spd::core::AllPlayer& players) const;
+
+	/**
+	 * 記録した編集を、ワーカ順にプレイヤの接続へ反映し、バッファを空にする
+	 * @note 接続リストは作り直さないので、接続近傍として共有している近傍にもそのまま反映される
+	 * @param[in] players すべてのプレイヤ
+	 */
+	void apply(const spd::core::AllPlayer& players);
+
+	/**
+	 * 記録した編集を破棄する
+	 */
+	void clear();
+
+private:
+
+	/**
+	 * 編集の種類
+	 */
+	enum class EditType {
+		ADD_LINK, /**< 接続の追加 */
+		REMOVE_LINK, /**< 接続の削除 */
+		ISOLATE, /**< すべての接続の切り離し */
+	};
+
+	/**
+	 * 1つの編集
+	 */
+	struct Edit {
+		EditType type;
+		int from;
+		int to;
+	};
+
+	/**
+	 * ワーカごとの編集のバッファ
+	 */
+	std::vector<std::vector<Edit>> buffers;
+};
+
+} /* namespace topology */
+} /* namespace spd */
+#endif /* TOPOLOGYEDITOR_HPP_ */
@@ -6,6 +6,7 @@
  */
 #include "Cube.hpp"
 
+#include <algorithm>
 #include <cmath> // 三乗根(cbrt)
 #include <stdexcept>
 
@@ -239,6 +240,27 @@ void Cube::setNeighborsOf(
 
 
 
+/*
+ * 近傍半径以内のプレイヤが同じ色にならないよう、座標から色を塗る
+ * @param[in] radius 近傍半径
+ */
+std::vector<int> Cube::colorPlayers(int radius) const {
+
+	int period = radius + 1;
+	if ((sideNum <= 0) || (radius < 0) || (sideNum % period != 0)) {
+		return std::vector<int>();
+	}
+
+	std::vector<int> colors(plateNum * sideNum);
+	for (int i = 0, size = colors.size(); i < size; ++i) {
+		int z = i / plateNum;
+		int y = (i - z * plateNum) / sideNum;
+		int x = (i - z * plateNum) % sideNum;
+		colors[i] = (x % period) + ((y % period) + (z % period) * period) * period;
+	}
+	return colors;
+}
+
 /**
  * 空間構図構造名の出力
  * @return 空間構図構造名(Moore)
@@ -104,6 +104,49 @@ public:
 	 */
 	void setProp(std::vector<std::string> properties);
 
+	/**
+	 * 近傍タイプに応じた箱型近傍の集計クラスを作成する
+	 * @note 状態ファイルから読み込んだ場合は辺の長さが設定されないので、プレイヤ数から求める
+	 * @param[in] playerNum 全プレイヤ数
+	 * @return 箱型近傍の集計クラス
+	 * @retval nullptr 近傍タイプが箱型でない場合
+	 */
+	std::shared_ptr<BoxCounter> createBoxCounter(int playerNum) const {
+		return cubeNeighbor->createBoxCounter(calcSideNum(playerNum));
+	};
+
+	/**
+	 * 近傍タイプに従って、箱型近傍の最大値を求めるクラスを作成する
+	 * @note 状態ファイルから読み込んだ場合は辺の長さが設定されないので、プレイヤ数から求める
+	 * @param[in] playerNum 全プレイヤ数
+	 * @return 箱型近傍の最大値クラス
+	 * @retval nullptr 求められない近傍タイプの場合
+	 */
+	std::shared_ptr<SlidingMaximum> createSlidingMaximum(int playerNum) const {
+		return cubeNeighbor->createSlidingMaximum(calcSideNum(playerNum));
+	};
+
+	/**
+	 * 2プレイヤ間の近傍半径を、近傍タイプに従って求める
+	 * @param[in] from 一方のプレイヤ位置座標
+	 * @param[in] to もう一方のプレイヤ位置座標
+	 * @return 近傍半径
+	 * @retval -1 座標から求められない近傍タイプの場合
+	 */
+	int getDistance(int from, int to) const {
+		return cubeNeighbor->getDistance(sideNum, from, to);
+	};
+
+	/**
+	 * 近傍半径以内のプレイヤが同じ色にならないよう、座標から色を塗る
+	 * @par
+	 * 各軸を近傍半径 + 1 ごとに繰り返す色とする。
+	 * @param[in] radius 近傍半径
+	 * @return プレイヤ位置座標ごとの色
+	 * @retval 空 辺の長さが 近傍半径 + 1 で割り切れない場合
+	 */
+	std::vector<int> colorPlayers(int radius) const;
+
 	/**
 	 * 対象プレイヤに対する、x, y, zの相対値から該当するプレイヤ位置座標を取得する
 	 * @param[in] i ベースのプレイヤ位置座標
@@ -155,6 +198,15 @@ private:
 	 */
 	int sideNum;
 
+	/**
+	 * プレイヤ数から一辺のプレイヤ数を求める
+	 * @param[in] playerNum 全プレイヤ数
+	 * @return 一辺のプレイヤ数
+	 */
+	static int calcSideNum(int playerNum) {
+		return static_cast<int>(std::lround(std::cbrt(playerNum)));
+	};
+
 	/**
 	 * すべてのプレイヤに指定近傍タイプのプレイヤを設定する
 	 *
@@ -7,6 +7,8 @@
 #ifndef CUBENEIGHBORTYPE_HPP_
 #define CUBENEIGHBORTYPE_HPP_
 
+#include <memory>
+
 #include "../../core/OriginalType.hpp"
 #include "../../IToString.hpp"
 
@@ -16,6 +18,8 @@ class Player;
 }
 namespace topology {
 class Cube;
+class BoxCounter;
+class SlidingMaximum;
 namespace cube {
 
 
@@ -68,6 +72,40 @@ public:
 			spd::core::Neighbors& result,
 			const spd::topology::Cube& cube) const = 0;
 
+	/**
+	 * 箱型近傍を集計するクラスを作成する
+	 * @note 近傍が箱型でない場合は集計できないため、nullptr を返す
+	 * @param[in] sideNum 一辺のプレイヤ数
+	 * @return 箱型近傍の集計クラス
+	 * @retval nullptr 集計できない近傍タイプの場合
+	 */
+	virtual std::shared_ptr<spd::topology::BoxCounter> createBoxCounter(int sideNum) const {
+		return nullptr;
+	};
+
+	/**
+	 * 箱型近傍の最大値を求めるクラスを作成する
+	 * @note 近傍が箱型でない場合は求められないため、nullptr を返す
+	 * @param[in] sideNum 一辺のプレイヤ数
+	 * @return 箱型近傍の最大値クラス
+	 * @retval nullptr 求められない近傍タイプの場合
+	 */
+	virtual std::shared_ptr<spd::topology::SlidingMaximum> createSlidingMaximum(int sideNum) const {
+		return nullptr;
+	};
+
+	/**
+	 * 2プレイヤ間の近傍半径を、近傍を作成せずに求める
+	 * @param[in] sideNum 一辺のプレイヤ数
+	 * @param[in] from 一方のプレイヤ位置座標
+	 * @param[in] to もう一方のプレイヤ位置座標
+	 * @return 近傍半径
+	 * @retval -1 座標から求められない近傍タイプの場合
+	 */
+	virtual int getDistance(int sideNum, int from, int to) const {
+		return -1;
+	};
+
 };
 
 } /* namespace cube */
@@ -6,9 +6,12 @@
  */
 #include "MooreCube.hpp"
 
+#include <algorithm>
 #include <cmath>
 
 #include "Cube.hpp"
+#include "../BoxCounter.hpp"
+#include "../SlidingMaximum.hpp"
 
 #include "../../core/OriginalType.hpp"
 #include "../../core/Player.hpp"
@@ -79,6 +82,44 @@ void MooreCube::getNeighbors(
 
 
 
+/*
+ * 三次元の箱型近傍を集計するクラスを作成する
+ * @param[in] sideNum 一辺のプレイヤ数
+ * @return 箱型近傍の集計クラス
+ */
+std::shared_ptr<spd::topology::BoxCounter> MooreCube::createBoxCounter(int sideNum) const {
+	return std::make_shared<spd::topology::BoxCounter>(sideNum, 3);
+}
+
+/*
+ * 三次元の箱型近傍の最大値を求めるクラスを作成する
+ * @param[in] sideNum 一辺のプレイヤ数
+ * @return 箱型近傍の最大値クラス
+ */
+std::shared_ptr<spd::topology::SlidingMaximum> MooreCube::createSlidingMaximum(int sideNum) const {
+	return std::make_shared<spd::topology::SlidingMaximum>(sideNum, 3);
+}
+
+/*
+ * 2プレイヤ間の近傍半径を求める
+ * @param[in] sideNum 一辺のプレイヤ数
+ * @param[in] from 一方のプレイヤ位置座標
+ * @param[in] to もう一方のプレイヤ位置座標
+ */
+int MooreCube::getDistance(int sideNum, int from, int to) const {
+
+	int result = 0;
+	for (int d = 0; d < 3; ++d) {
+		int diff = std::abs(from % sideNum - to % sideNum);
+		// 回り込んだ方が近い場合
+		diff = std::min(diff, sideNum - diff);
+		result = std::max(result, diff);
+		from /= sideNum;
+		to /= sideNum;
+	}
+	return result;
+}
+
 } /* namespace cube */
 } /* namespace topology */
 } /* namespace spd */
@@ -59,6 +59,29 @@ public:
 			spd::core::Neighbors& result,
 			const spd::topology::Cube& cube) const;
 
+	/**
+	 * 三次元の箱型近傍を集計するクラスを作成する
+	 * @param[in] sideNum 一辺のプレイヤ数
+	 * @return 箱型近傍の集計クラス
+	 */
+	std::shared_ptr<spd::topology::BoxCounter> createBoxCounter(int sideNum) const;
+
+	/**
+	 * 三次元の箱型近傍の最大値を求めるクラスを作成する
+	 * @param[in] sideNum 一辺のプレイヤ数
+	 * @return 箱型近傍の最大値クラス
+	 */
+	std::shared_ptr<spd::topology::SlidingMaximum> createSlidingMaximum(int sideNum) const;
+
+	/**
+	 * 2プレイヤ間の近傍半径を、回り込みを考慮したチェビシェフ距離として求める
+	 * @param[in] sideNum 一辺のプレイヤ数
+	 * @param[in] from 一方のプレイヤ位置座標
+	 * @param[in] to もう一方のプレイヤ位置座標
+	 * @return 近傍半径
+	 */
+	int getDistance(int sideNum, int from, int to) const;
+
 	/**
 	 * クラス情報の文字出力
 	 * @return クラス情報
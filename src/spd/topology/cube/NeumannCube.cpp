@@ -6,6 +6,9 @@
  */
 #include "NeumannCube.hpp"
 
+#include <algorithm>
+#include <cstdlib>
+
 #include "Cube.hpp"
 
 #include "../../core/OriginalType.hpp"
@@ -75,6 +78,26 @@ void NeumannCube::getNeighbors(
 }
 
 
+/*
+ * 2プレイヤ間の近傍半径を求める
+ * @param[in] sideNum 一辺のプレイヤ数
+ * @param[in] from 一方のプレイヤ位置座標
+ * @param[in] to もう一方のプレイヤ位置座標
+ */
+int NeumannCube::getDistance(int sideNum, int from, int to) const {
+
+	int result = 0;
+	for (int d = 0; d < 3; ++d) {
+		int diff = std::abs(from % sideNum - to % sideNum);
+		// 回り込んだ方が近い場合
+		diff = std::min(diff, sideNum - diff);
+		result = result + diff;
+		from /= sideNum;
+		to /= sideNum;
+	}
+	return result;
+}
+
 } /* namespace cube */
 } /* namespace topology */
 } /* namespace spd */
@@ -67,6 +67,15 @@ public:
 			spd::core::Neighbors& result,
 			const spd::topology::Cube& cube) const;
 
+	/**
+	 * 2プレイヤ間の近傍半径を、回り込みを考慮したマンハッタン距離として求める
+	 * @param[in] sideNum 一辺のプレイヤ数
+	 * @param[in] from 一方のプレイヤ位置座標
+	 * @param[in] to もう一方のプレイヤ位置座標
+	 * @return 近傍半径
+	 */
+	int getDistance(int sideNum, int from, int to) const;
+
 	/**
 	 * クラス情報の文字出力
 	 * @return クラス情報
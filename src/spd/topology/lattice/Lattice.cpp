@@ -28,5 +28,25 @@ void Lattice::accept(spd::output::OutputVisitor& visitor, spd::core::Space& spac
 	visitor.output(*this, space);
 }
 
+/*
+ * 近傍半径以内のプレイヤが同じ色にならないよう、座標から色を塗る
+ * @param[in] radius 近傍半径
+ */
+std::vector<int> Lattice::colorPlayers(int radius) const {
+
+	int period = radius + 1;
+	if ((side <= 0) || (radius < 0) || (side % period != 0)) {
+		return std::vector<int>();
+	}
+
+	std::vector<int> colors(side * side);
+	for (int i = 0, size = colors.size(); i < size; ++i) {
+		int x = i % side;
+		int y = i / side;
+		colors[i] = (x % period) + (y % period) * period;
+	}
+	return colors;
+}
+
 } /* namespace topology */
 } /* namespace spd */
@@ -58,6 +58,17 @@ public:
 		return centerIndex;
 	};
 
+	/**
+	 * 近傍半径以内のプレイヤが同じ色にならないよう、座標から色を塗る
+	 * @par
+	 * 各軸を近傍半径 + 1 ごとに繰り返す色とする。<br>
+	 * 近傍半径以内なら各軸の差も近傍半径以内なので、異なる色になる。
+	 * @param[in] radius 近傍半径
+	 * @return プレイヤ位置座標ごとの色
+	 * @retval 空 辺の長さが 近傍半径 + 1 で割り切れない場合(回り込みで同じ色が隣接する)
+	 */
+	std::vector<int> colorPlayers(int radius) const;
+
 
 protected:
 	/**
@@ -6,7 +6,10 @@
  */
 
 #include "Moore.hpp"
+#include "../BoxCounter.hpp"
+#include "../SlidingMaximum.hpp"
 
+#include <algorithm>
 #include <cmath> // sqrt と absのため
 #include <iostream>
 #include <string>
@@ -266,6 +269,41 @@ std::string Moore::toString() const {
 	return "Moore";
 }
 
+/*
+ * 二次元の箱型近傍を集計するクラスを作成する
+ * @param[in] playerNum 全プレイヤ数
+ * @return 箱型近傍の集計クラス
+ */
+std::shared_ptr<BoxCounter> Moore::createBoxCounter(int playerNum) const {
+	return std::make_shared<BoxCounter>(static_cast<int>(std::sqrt(playerNum)), 2);
+}
+
+/*
+ * 二次元の箱型近傍の最大値を求めるクラスを作成する
+ * @param[in] playerNum 全プレイヤ数
+ * @return 箱型近傍の最大値クラス
+ */
+std::shared_ptr<SlidingMaximum> Moore::createSlidingMaximum(int playerNum) const {
+	return std::make_shared<SlidingMaximum>(static_cast<int>(std::sqrt(playerNum)), 2);
+}
+
+/*
+ * 2プレイヤ間の近傍半径を求める
+ * @param[in] from 一方のプレイヤ位置座標
+ * @param[in] to もう一方のプレイヤ位置座標
+ */
+int Moore::getDistance(int from, int to) const {
+
+	int dx = std::abs(from % side - to % side);
+	int dy = std::abs(from / side - to / side);
+
+	// 回り込んだ方が近い場合
+	dx = std::min(dx, side - dx);
+	dy = std::min(dy, side - dy);
+
+	return std::max(dx, dy);
+}
+
 } /* namespace topology */
 } /* namespace spd */
 
@@ -82,6 +82,30 @@ public:
 		return;
 	};
 
+	/**
+	 * 二次元の箱型近傍を集計するクラスを作成する
+	 * @note 状態ファイルから読み込んだ場合は辺の長さが設定されないので、プレイヤ数から求める
+	 * @param[in] playerNum 全プレイヤ数
+	 * @return 箱型近傍の集計クラス
+	 */
+	std::shared_ptr<BoxCounter> createBoxCounter(int playerNum) const;
+
+	/**
+	 * 二次元の箱型近傍の最大値を求めるクラスを作成する
+	 * @note 状態ファイルから読み込んだ場合は辺の長さが設定されないので、プレイヤ数から求める
+	 * @param[in] playerNum 全プレイヤ数
+	 * @return 箱型近傍の最大値クラス
+	 */
+	std::shared_ptr<SlidingMaximum> createSlidingMaximum(int playerNum) const;
+
+	/**
+	 * 2プレイヤ間の近傍半径を、回り込みを考慮したチェビシェフ距離として求める
+	 * @param[in] from 一方のプレイヤ位置座標
+	 * @param[in] to もう一方のプレイヤ位置座標
+	 * @return 近傍半径
+	 */
+	int getDistance(int from, int to) const;
+
 	/**
 	 * 空間構図構造名の出力
 	 * @return 空間構図構造名(Moore)
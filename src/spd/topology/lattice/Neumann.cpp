@@ -7,6 +7,7 @@
 
 #include "Neumann.hpp"
 
+#include <algorithm>
 #include <cmath> // sqrt と absのため
 #include <iostream>
 #include <string>
@@ -261,5 +262,22 @@ std::string Neumann::toString() const {
 }
 
 
+/*
+ * 2プレイヤ間の近傍半径を求める
+ * @param[in] from 一方のプレイヤ位置座標
+ * @param[in] to もう一方のプレイヤ位置座標
+ */
+int Neumann::getDistance(int from, int to) const {
+
+	int dx = std::abs(from % side - to % side);
+	int dy = std::abs(from / side - to / side);
+
+	// 回り込んだ方が近い場合
+	dx = std::min(dx, side - dx);
+	dy = std::min(dy, side - dy);
+
+	return dx + dy;
+}
+
 } /* namespace topology */
 } /* namespace spd */
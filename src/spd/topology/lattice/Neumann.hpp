@@ -82,6 +82,14 @@ public:
 		return;
 	};
 
+	/**
+	 * 2プレイヤ間の近傍半径を、回り込みを考慮したマンハッタン距離として求める
+	 * @param[in] from 一方のプレイヤ位置座標
+	 * @param[in] to もう一方のプレイヤ位置座標
+	 * @return 近傍半径
+	 */
+	int getDistance(int from, int to) const;
+
 	/**
 	 * 空間構図構造名の出力
 	 * @return 空間構図構造名(Neumann)
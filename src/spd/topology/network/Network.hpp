@@ -76,6 +76,14 @@ public:
 		return playerNum / 2;
 	};
 
+	/**
+	 * 近傍を接続からたどって求めるので、実行中に接続を編集できる
+	 * @return true
+	 */
+	bool isEditable() const {
+		return true;
+	};
+
 private:
 
 	/**
@@ -11,6 +11,11 @@
 #include <stdexcept>
 #include <iostream>
 #include <cmath>
+#include <cstdint>
+#include <algorithm>
+#include <numeric>
+#include <utility>
+#include <vector>
 
 #include "../../core/OriginalType.hpp"
 #include "../../core/Player.hpp"
@@ -20,6 +25,9 @@
 #include "../../param/InitParameter.hpp"
 #include "../../param/NeighborhoodParameter.hpp"
 #include "../../param/RandomParameter.hpp"
+#include "../../param/PhiloxEngine.hpp"
+
+#include "../../rule/WorkerPool.hpp"
 
 #include "../../output/OutputVisitor.hpp"
 
@@ -49,13 +57,7 @@ void Random::connectPlayers(const spd::core::AllPlayer& players,
 	auto memory = param.getInitialParameter()->getMemory() + usedMemory;
 	param.getInitialParameter()->setMemory(memory);
 
-	if (this->connectionProbability > DIVIDE_POINT) {
-		// 減少
-		decrementCreate(players, param);
-	} else {
-		// 増加
-		incrementCreate(players, param);
-	}
+	sampleCreate(players, param);
 }
 
 /*
@@ -78,13 +80,21 @@ void Random::setProp(std::vector<std::string> properties) {
 };
 
 /*
- * ノードの追加型接続生成
+ * 全域木と、辺ごとに独立な接続による接続生成
  *
- * メモリ容量が足りない場合、プログラムを終了する。
+ * @par
+ * 連結にするため、プレイヤをランダムな順に並べ、それぞれをそれより前のランダムなプレイヤにつなぐ全域木を作る。
+ * 全域木以外の辺は、接続確率から決まる辺数が期待値になるように、辺ごとに独立な確率で接続する。
+ * 接続する辺は、次に接続する辺までの間隔を幾何分布から求めて直接選ぶ(Batagelj-Brandes 法)ので、
+ * 時間は辺数に比例する。
+ * @par
+ * 辺は行(大きい方の位置座標)のブロックに分けて並列に選ぶ。
+ * ブロックごとの乱数列は、生成エンジンから取った鍵とブロック番号で決めるので、結果はコア数によらない。
+ * 生成エンジンから取るのは鍵の1つだけなので、再開時に読み飛ばす数にはそれだけを加える。
  * @param[in] players すべてのプレイヤ
  * @param[in] param パラメタ
  */
-void Random::incrementCreate(const spd::core::AllPlayer& players,
+void Random::sampleCreate(const spd::core::AllPlayer& players,
 		const spd::param::Parameter& param) {
 
 	// プレイヤ数
@@ -101,7 +111,7 @@ void Random::incrementCreate(const spd::core::AllPlayer& players,
 			(static_cast<unsigned long long>(allPlayerNum) - 1)
 				) / 2;
 
-	// 生成するエッジ数
+	// 生成するエッジ数(の期待値)
 	unsigned long long generateEdge = maxEdge * (this->connectionProbability * 100) / 100;
 
 	// プレイヤ数-1 より少ないエッジでは、接続グラフを作れないので修了
@@ -111,214 +121,149 @@ void Random::incrementCreate(const spd::core::AllPlayer& players,
 		std::exit(EXIT_FAILURE);
 	}
 
-	// 生成する乱数の数(最低数はエッジの数 * 2)
-	unsigned long long genRnd = 0;
-
-	// 接続したら表示する単位(5%ごと)
-	auto persent = 5;
-	auto displayUnit = generateEdge / (100 / persent);
-	auto displayTiming = displayUnit;
-
-	// メモリの確認(双方向分)
-	unsigned long int requiredMemory = sizeof(std::weak_ptr<Player>) * generateEdge * 2;
-
-
-	availableMemory -= requiredMemory;
-
-	if (availableMemory < 0) {
+	// メモリが足りない場合は終了する
+	auto checkMemory = [&](unsigned long long edgeNum) {
+		unsigned long int requiredMemory = sizeof(std::weak_ptr<Player>) * edgeNum * 2;
+		if (availableMemory - static_cast<long long int>(requiredMemory) >= 0) {
+			return;
+		}
 
 		std::cerr << "maxEdge : " << maxEdge << "\nconnection probability : " << this->connectionProbability <<
-				"\ngenerateEdge : " <<  generateEdge << "\nrequired memory : " << requiredMemory << std::endl;
+				"\ngenerateEdge : " <<  edgeNum << "\nrequired memory : " << requiredMemory << std::endl;
 
 
 		std::cerr << "\nThis program could not construct a spatial structure due to insufficient memory.\n"
 				<< "Please input a sufficient available memory size or run on other machines.\n\n"
 				<< "To simulate this setting, add more than "
-				<< std::abs(availableMemory) << " byte(s) of memory.\n";
+				<< std::abs(availableMemory - static_cast<long long int>(requiredMemory)) << " byte(s) of memory.\n";
 		std::exit(EXIT_FAILURE);
-	}
-	iniParam->setMemory(availableMemory);
-	// 使用メモリの記憶
-	this->usedMemory = requiredMemory;
+	};
+
+	// 全域木以外の辺の接続確率
+	unsigned long long treeEdge = allPlayerNum - 1;
+	double probability = (maxEdge > treeEdge) ?
+			static_cast<double>(generateEdge - treeEdge) / (maxEdge - treeEdge) : 0.0;
 
-	// プレイヤ数の一様分布
-	std::uniform_int_distribution<> dist(0, allPlayerNum - 1);
+	// 辺を選ぶ前に、辺数の上側の見積もり(期待値 + 標準偏差の6倍)で確認する
+	double extraSd = std::sqrt((maxEdge - treeEdge) * probability * (1.0 - probability));
+	checkMemory(std::min(maxEdge, generateEdge + static_cast<unsigned long long>(std::ceil(6.0 * extraSd))));
 
+	// 乱数列の鍵
 	auto randParam = param.getRandomParameter();
-	auto& engine = randParam->getEngine();
-
-
-	// ノードの接続を管理する配列
-	// 中央のグラフに接続されているノード
-	std::vector<int> connectedNodes;
-	connectedNodes.reserve(allPlayerNum);
-	// 中央グラフに入っていないノード
-	std::vector<int> unconnectedNodes;
-	unconnectedNodes.reserve(allPlayerNum - 1);
-
-	// あるノードを選択し、接続グラフへ入れる
-	int firstNode = dist(engine);
-	genRnd++;
-	connectedNodes.push_back(firstNode);
-	// 残りを未接続にする
-	for (int i = 0; i < allPlayerNum; ++i) {
-		if (i != firstNode) {
-			unconnectedNodes.push_back(i);
+	std::uint64_t key = randParam->getEngine()();
+	randParam->addGenerated(1);
+	auto purpose = static_cast<std::uint32_t>(spd::param::RandomPurpose::TOPOLOGY);
+
+	// 全域木(プレイヤごとの親の位置座標、根は -1)
+	std::vector<int> parents(allPlayerNum, -1);
+	{
+		spd::param::PhiloxEngine engine(key, 0, TREE_STAGE, purpose);
+		std::vector<int> order(allPlayerNum);
+		std::iota(order.begin(), order.end(), 0);
+		std::shuffle(order.begin(), order.end(), engine);
+		for (int i = 1; i < allPlayerNum; ++i) {
+			std::uniform_int_distribution<int> dist(0, i - 1);
+			parents[order[i]] = order[dist(engine)];
 		}
 	}
 
-
-	// 最初に必ず一つのランダムグラフを作る
-	while (unconnectedNodes.size() != 0) {
-
-		std::uniform_int_distribution<> connectDist(0, connectedNodes.size() - 1);
-		std::uniform_int_distribution<> unconnectDist(0, unconnectedNodes.size() - 1);
-
-		int src = connectDist(engine);
-		int dest = unconnectDist(engine);
-
-		int srcPlayer = connectedNodes.at(src);
-		int destPlayer = unconnectedNodes.at(dest);
-
-		players.at(srcPlayer)->linkTo(players.at(destPlayer));
-		players.at(destPlayer)->linkTo(players.at(srcPlayer));
-
-		// 接続したのを接続済みへ設定し、未接続から削除
-		connectedNodes.push_back(unconnectedNodes.at(dest));
-		unconnectedNodes.erase(std::begin(unconnectedNodes) + dest);
+	// 行 v の辺(列 w < v)は v 本なので、辺数が均等になるように行を区切る
+	int blockNum = std::min(BLOCK_NUM, allPlayerNum);
+	std::vector<int> rowBounds(blockNum + 1);
+	for (int b = 0; b < blockNum; ++b) {
+		rowBounds[b] = static_cast<int>(allPlayerNum * std::sqrt(static_cast<double>(b) / blockNum));
 	}
-
-	// 接続エッジ数
-	// この時点、プレイヤ数-1 のエッジが作成済み
-	unsigned long long edge = allPlayerNum - 1;
-
-	genRnd += 2 * (allPlayerNum - 1);
-
-
-	// あとは適当に接続
-	while(edge < generateEdge) {
-
-		int src = dist(engine);
-		int dest = dist(engine);
-		genRnd += 2;
-
-		if (players.at(src)->linkTo(players.at(dest))) {
-			players.at(dest)->linkTo(players.at(src));
-			++edge;
-
-			if (edge > displayTiming) {
-				std::cout << "Stage 1/1: connect " << displayTiming / displayUnit * persent << "% finish" << "   \r" << std::flush;
-				displayTiming += displayUnit;
+	rowBounds[blockNum] = allPlayerNum;
+
+	// ブロックごとに選んだ辺
+	spd::rule::WorkerPool pool(std::max(1, param.getCore()));
+	std::vector<std::vector<std::pair<int, int>>> sampledEdges(blockNum);
+	if (probability > 0) {
+		double logSkip = std::log(1.0 - probability);
+		double maxSkip = static_cast<double>(maxEdge);
+
+		pool.run(blockNum, [&](int worker, int from, int to) {
+			for (int b = from; b < to; ++b) {
+				spd::param::PhiloxEngine engine(key, b, SAMPLE_STAGE, purpose);
+				std::uniform_real_distribution<double> uniform(0.0, 1.0);
+				auto& edges = sampledEdges[b];
+
+				long long v = rowBounds[b];
+				long long w = -1;
+				long long vEnd = rowBounds[b + 1];
+				while (v < vEnd) {
+					// 次に接続する辺までの間隔(幾何分布)
+					double skip = std::floor(std::log(1.0 - uniform(engine)) / logSkip);
+					w += 1 + static_cast<long long>(std::min(skip, maxSkip));
+					while ((w >= v) && (v < vEnd)) {
+						w -= v;
+						++v;
+					}
+					// 全域木の辺は接続済み
+					if ((v < vEnd) && (parents[v] != w) && (parents[w] != v)) {
+						edges.push_back(std::make_pair(static_cast<int>(v), static_cast<int>(w)));
+					}
+				}
 			}
-		}
+		});
 	}
 
-	randParam->addGenerated(genRnd);
-}
-
-/*
- * ノードの減少生成型接続生成
- *
- * メモリ容量が足りない場合、追加型生成に切り替える
- * @param[in] players すべてのプレイヤ
- * @param[in] param パラメタ
- */
-void Random::decrementCreate(const spd::core::AllPlayer& players,
-		const spd::param::Parameter& param) {
-
-	// プレイヤ数
-	int allPlayerNum = players.size();
-
-	auto iniParam = param.getInitialParameter();
-
-	// 使用可能メモリ
-	unsigned long long int availableMemory = iniParam->getMemory();
-
-	// 総当たりでの最大エッジ数
-	unsigned long long maxEdge = (
-				static_cast<unsigned long long>(allPlayerNum) *
-				(static_cast<unsigned long long>(allPlayerNum) - 1)
-			) / 2;
-
-	// 最大のメモリ(双方向分)
-	unsigned long long int maxMemory = sizeof(std::weak_ptr<Player>) * maxEdge * 2;
-
-	// 減少生成出来ないので、増加作成を行う
-	if (maxMemory > availableMemory) {
-		std::cerr << "The network is structured by incremental generation, "
-				"due to insufficient memory. It might take a long time to construction." << std::endl;
-		incrementCreate(players, param);
+	// CSR 形式の隣接リストへまとめる
+	std::vector<int> offsets(allPlayerNum + 1, 0);
+	for (int id = 0; id < allPlayerNum; ++id) {
+		if (parents[id] >= 0) {
+			++offsets[id + 1];
+			++offsets[parents[id] + 1];
+		}
 	}
-
-	// 削除するエッジ数
-	unsigned long long deleteEdge = maxEdge * (100 - (this->connectionProbability * 100)) / 100;
-
-	// 生成する乱数の数
-	unsigned long long genRnd = 0;
-
-	// 削除したら表示する単位(5%ごと)
-	auto persent = 5;
-	auto displayUnit = deleteEdge / (100 / persent);
-	auto displayTiming = displayUnit;
-
-	// 使用するメモリ(双方向分)
-	unsigned long long int requiredMemory = sizeof(std::weak_ptr<Player>) * (maxEdge - deleteEdge) * 2;
-
-	availableMemory -= requiredMemory;
-
-
-	iniParam->setMemory(availableMemory);
-	// 使用メモリの記憶
-	this->usedMemory = requiredMemory;
-
-	// プレイヤ数の一様分布
-	std::uniform_int_distribution<> dist(0, allPlayerNum - 1);
-
-	auto randParam = param.getRandomParameter();
-	auto& engine = randParam->getEngine();
-
-	// 完全グラフの生成
-	std::cout << "Stage 1/2: Generating a perfect graph\n";
-	for (int i = 0; i < allPlayerNum - 1; ++i) {
-		for (int j = i + 1; j < allPlayerNum; ++j) {
-			// 接続
-			players.at(i)->linkTo(players.at(j));
-			players.at(j)->linkTo(players.at(i));
+	for (auto& edges : sampledEdges) {
+		for (auto& edge : edges) {
+			++offsets[edge.first + 1];
+			++offsets[edge.second + 1];
 		}
-		std::cout << (static_cast<double>((allPlayerNum - 1) + (allPlayerNum - i - 1)) * (i + 1) / 2) / (maxEdge) * 100 <<
-				"% finish\r" << std::flush;
+	}
+	for (int id = 0; id < allPlayerNum; ++id) {
+		offsets[id + 1] += offsets[id];
 	}
 
-	std::cout << "Stage 2/2: disconnect the edges\n";
-	unsigned long long edge = 0;
-	while(edge < deleteEdge) {
-
-		int src = dist(engine);
-		int dest = dist(engine);
-		genRnd += 2;
-
-		// 削除したときに、未連結グラフにならないようにする
-		if ((players.at(src)->getLinkedPlayers()->size() > 1)
-				&& (players.at(dest)->getLinkedPlayers()->size() > 1)) {
+	// 実際に選んだ辺数で確認する(見積もりは確率的な上限なので)
+	checkMemory(offsets.back() / 2);
 
-			if (players.at(src)->deleteLinkTo(players.at(dest))) {
-				players.at(dest)->deleteLinkTo(players.at(src));
-				++edge;
+	std::vector<int> adjacency(offsets.back());
+	std::vector<int> filled(offsets.begin(), offsets.end() - 1);
+	for (int id = 0; id < allPlayerNum; ++id) {
+		if (parents[id] >= 0) {
+			adjacency[filled[id]++] = parents[id];
+			adjacency[filled[parents[id]]++] = id;
+		}
+	}
+	for (auto& edges : sampledEdges) {
+		for (auto& edge : edges) {
+			adjacency[filled[edge.first]++] = edge.second;
+			adjacency[filled[edge.second]++] = edge.first;
+		}
+		std::vector<std::pair<int, int>>().swap(edges);
+	}
 
-				if (edge > displayTiming) {
-					std::cout << displayTiming / displayUnit * persent << "% finish" << "      \r" << std::flush;
-					displayTiming += displayUnit;
-				}
-				continue;
+	// 隣接リストから、重複を調べずにそのまま接続する
+	pool.run(allPlayerNum, [&](int worker, int from, int to) {
+		for (int id = from; id < to; ++id) {
+			auto& player = players[id];
+			player->resetLink();
+			auto& links = *(player->getLinkedPlayers());
+			links.reserve(offsets[id + 1] - offsets[id]);
+			for (int i = offsets[id]; i < offsets[id + 1]; ++i) {
+				links.push_back(players[adjacency[i]]);
 			}
 		}
+	});
 
-	}
-
-	randParam->addGenerated(genRnd);
+	// 実際に使ったメモリ
+	unsigned long int requiredMemory = sizeof(std::weak_ptr<Player>) * offsets.back();
+	iniParam->setMemory(availableMemory - static_cast<long long int>(requiredMemory));
+	// 使用メモリの記憶
+	this->usedMemory = requiredMemory;
 }
 
-
-
 } /* namespace topology */
 } /* namespace spd */
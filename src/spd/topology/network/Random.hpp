@@ -8,6 +8,7 @@
 #ifndef RANDOM_HPP_
 #define RANDOM_HPP_
 
+#include <cstdint>
 #include <memory>
 #include <string>
 #include "Network.hpp"
@@ -60,34 +61,33 @@ public :
 private :
 
 	/**
-	 * 追加生成か減少生成かの閾値
+	 * 辺を選ぶ行のブロック数(結果がコア数によらないように固定する)
 	 */
-	static constexpr double DIVIDE_POINT = 0.6;
+	static constexpr int BLOCK_NUM = 64;
 
 	/**
-	 * デフォルトの接続確率
+	 * 全域木を作る乱数列の番号
 	 */
-	static constexpr double DEFAULT_CONNECTION_PROBABILITY = 0.01;
+	static constexpr std::uint32_t TREE_STAGE = 0;
 
 	/**
-	 * ノードの追加型接続生成
-	 *
-	 * メモリ容量が足りない場合、プログラムを終了する。
-	 * @param[in] players すべてのプレイヤ
-	 * @param[in] param パラメタ
+	 * 辺を選ぶ乱数列の番号
 	 */
-	void incrementCreate(const spd::core::AllPlayer& players,
-			const spd::param::Parameter& param);
+	static constexpr std::uint32_t SAMPLE_STAGE = 1;
 
+	/**
+	 * デフォルトの接続確率
+	 */
+	static constexpr double DEFAULT_CONNECTION_PROBABILITY = 0.01;
 
 	/**
-	 * ノードの減少生成型接続生成
+	 * 全域木と、辺ごとに独立な接続による接続生成
 	 *
-	 * メモリ容量が足りない場合、追加型生成に切り替える
+	 * 時間は辺数に比例し、メモリ容量が足りない場合、プログラムを終了する。
 	 * @param[in] players すべてのプレイヤ
 	 * @param[in] param パラメタ
 	 */
-	void decrementCreate(const spd::core::AllPlayer& players,
+	void sampleCreate(const spd::core::AllPlayer& players,
 			const spd::param::Parameter& param);
 
 	/**